@@ -0,0 +1,334 @@
+// Per-stage benchmarks over deterministic synthetic workbooks.
+//
+//   turboxl_benchmarks [--rows=1000,100000] [--shapes=numeric,strings,...]
+//                      [--benchmark_format=json] [--benchmark_out=results.json]
+//
+// Row counts can also come from TURBOXL_BENCH_ROWS. Workbooks are generated
+// once into the system temp directory and reused while the generator version
+// is unchanged. Every benchmark reports items (rows or cells) and bytes per
+// second, so regressions show up directly in the JSON counters.
+
+#include "workbook_generator.hpp"
+#include "xlsxcsv.hpp"
+#include "xlsxcsv/core.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace xlsxcsv::core;
+using xlsxcsv::bench::WorkbookShape;
+
+namespace {
+
+constexpr const char* SHEET_ENTRY = "xl/worksheets/sheet1.xml";
+
+// Generated workbooks exceed the default per-entry limit at the top row counts
+ZipSecurityLimits benchmarkLimits() {
+    ZipSecurityLimits limits;
+    limits.maxEntrySize = 8ULL * 1024 * 1024 * 1024;
+    limits.maxTotalUncompressed = 16ULL * 1024 * 1024 * 1024;
+    return limits;
+}
+
+const std::string& workbookPath(WorkbookShape shape, size_t rows) {
+    static std::map<std::pair<WorkbookShape, size_t>, std::string> paths;
+    auto& path = paths[{shape, rows}];
+    if (path.empty()) {
+        const fs::path dir = fs::temp_directory_path() / "turboxl_benchmarks";
+        fs::create_directories(dir);
+        const fs::path file = dir / (std::string(xlsxcsv::bench::shapeName(shape)) + "_" + std::to_string(rows) +
+                                     "_v" + std::to_string(xlsxcsv::bench::GENERATOR_VERSION) + ".xlsx");
+        if (!fs::exists(file)) {
+            const fs::path partial = fs::path(file).concat(".partial");
+            xlsxcsv::bench::writeWorkbook(partial.string(), shape, rows);
+            fs::rename(partial, file);
+        }
+        path = file.string();
+    }
+    return path;
+}
+
+// Inflated worksheet XML, shared by the parse benchmarks of one workbook
+const ByteVector& worksheetXml(WorkbookShape shape, size_t rows) {
+    static std::map<std::pair<WorkbookShape, size_t>, ByteVector> cache;
+    auto& xml = cache[{shape, rows}];
+    if (xml.empty()) {
+        ZipReader reader(benchmarkLimits());
+        reader.open(workbookPath(shape, rows));
+        xml = reader.readEntry(SHEET_ENTRY);
+    }
+    return xml;
+}
+
+class CountingHandler : public SheetRowHandler {
+public:
+    void handleRow(const RowData& row) override {
+        ++rows;
+        cells += row.cells.size();
+    }
+    void handleError(const std::string& message) override { error = message; }
+
+    size_t rows = 0;
+    size_t cells = 0;
+    std::string error;
+};
+
+// Discards output but keeps the byte count
+class CountingSink : public xlsxcsv::OutputSink {
+public:
+    void write(const char*, size_t size) override { bytes += size; }
+    size_t bytes = 0;
+};
+
+void zipReadEntry(benchmark::State& state, WorkbookShape shape, size_t rows) {
+    ZipReader reader(benchmarkLimits());
+    reader.open(workbookPath(shape, rows));
+    size_t bytes = 0;
+    for (auto _ : state) {
+        ByteVector xml = reader.readEntry(SHEET_ENTRY);
+        bytes += xml.size();
+        benchmark::DoNotOptimize(xml.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+void sharedStringsParse(benchmark::State& state, WorkbookShape shape, size_t rows, SharedStringsMode mode) {
+    OpcPackage package;
+    package.open(workbookPath(shape, rows));
+    size_t strings = 0;
+    for (auto _ : state) {
+        SharedStringsConfig config;
+        config.mode = mode;
+        SharedStringsProvider provider(config);
+        provider.parse(package);
+        strings += provider.getStringCount();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(strings));
+}
+
+void stylesParse(benchmark::State& state, StylesParseMode mode) {
+    OpcPackage package;
+    package.open(workbookPath(WorkbookShape::Dates, 1000));
+    for (auto _ : state) {
+        StylesRegistry styles;
+        styles.parse(package, mode);
+        benchmark::DoNotOptimize(styles.getStyleCount());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+void parseSheetData(benchmark::State& state, WorkbookShape shape, size_t rows, SheetParserBackend backend) {
+    const ByteVector& xml = worksheetXml(shape, rows);
+    SheetStreamReader reader;
+    reader.setParserBackend(backend);
+    size_t parsedRows = 0;
+    for (auto _ : state) {
+        CountingHandler handler;
+        reader.parseSheetData(xml, handler);
+        if (!handler.error.empty()) {
+            state.SkipWithError(handler.error.c_str());
+            return;
+        }
+        parsedRows += handler.rows;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(parsedRows));
+    state.SetBytesProcessed(static_cast<int64_t>(xml.size() * state.iterations()));
+}
+
+// Whole pipeline into a sink that only counts; bytes are CSV output bytes
+void convertToCsv(benchmark::State& state, WorkbookShape shape, size_t rows, unsigned sheetThreads,
+                  bool pipelinedInflate) {
+    const std::string& path = workbookPath(shape, rows);
+    xlsxcsv::CsvOptions options;
+    options.sheetParseThreads = sheetThreads;
+    options.pipelinedInflate = pipelinedInflate;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        CountingSink sink;
+        try {
+            xlsxcsv::convertSheet(path, 0, sink, options);
+        } catch (const std::exception& e) {
+            state.SkipWithError(e.what());
+            return;
+        }
+        bytes += sink.bytes;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(rows * state.iterations()));
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+// Cells of column `column` from the first rows of a workbook, owning their text
+std::vector<CellData> sampleCells(WorkbookShape shape, int column) {
+    class Collector : public SheetRowHandler {
+    public:
+        explicit Collector(int column) : m_column(column) {}
+        void handleRow(const RowData& row) override {
+            for (const CellData& cell : row.cells) {
+                if (cell.coordinate.column == m_column) {
+                    cells.push_back(cell);
+                    cells.back().makeOwned();
+                }
+            }
+        }
+        void handleError(const std::string&) override {}
+        std::vector<CellData> cells;
+
+    private:
+        int m_column;
+    };
+    Collector collector(column);
+    SheetStreamReader reader;
+    reader.parseSheetData(worksheetXml(shape, 1000), collector);
+    return collector.cells;
+}
+
+void formatCells(benchmark::State& state, WorkbookShape shape, int column, NumberFormatMode mode) {
+    const std::vector<CellData> cells = sampleCells(shape, column);
+    OpcPackage package;
+    package.open(workbookPath(shape, 1000));
+    StylesRegistry styles;
+    styles.parse(package, StylesParseMode::NumberFormatsOnly);
+    size_t bytes = 0;
+    for (auto _ : state) {
+        for (const CellData& cell : cells) {
+            const std::string text = formatCellText(cell, nullptr, &styles, DateSystem::Date1900, mode);
+            bytes += text.size();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(cells.size() * state.iterations()));
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+// CSV encoding of one row of inline strings; quoted rows contain delimiters and quotes
+void csvEscape(benchmark::State& state, bool needsQuoting) {
+    RowData row;
+    row.rowNumber = 1;
+    for (int c = 1; c <= 10; ++c) {
+        CellData& cell = row.cells.emplace_back();
+        cell.coordinate = {1, c};
+        cell.type = CellType::InlineString;
+        const std::string text = needsQuoting ? "say \"hi\", item " + std::to_string(c * 1000)
+                                              : "plain item " + std::to_string(c * 1000);
+        cell.value = row.appendText(text);
+    }
+    CountingSink sink;
+    CsvRowCollector collector(nullptr, nullptr, DateSystem::Date1900, nullptr, &sink);
+    for (auto _ : state) {
+        collector.handleRow(row);
+    }
+    collector.finish();
+    state.SetItemsProcessed(static_cast<int64_t>(row.cells.size() * state.iterations()));
+    state.SetBytesProcessed(static_cast<int64_t>(sink.bytes));
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+void registerBenchmarks(const std::vector<size_t>& rowCounts, const std::vector<WorkbookShape>& shapes) {
+    const std::pair<const char*, SheetParserBackend> backends[] = {
+        {"fast", SheetParserBackend::Fast}, {"libxml", SheetParserBackend::LibXml}};
+
+    for (WorkbookShape shape : shapes) {
+        const std::string shapeName = xlsxcsv::bench::shapeName(shape);
+        for (size_t rows : rowCounts) {
+            const std::string suffix = "/" + shapeName + "/" + std::to_string(rows);
+            benchmark::RegisterBenchmark(("zip_read_entry" + suffix).c_str(), zipReadEntry, shape, rows)
+                ->Unit(benchmark::kMillisecond);
+            if (shape == WorkbookShape::Strings || shape == WorkbookShape::Wide) {
+                benchmark::RegisterBenchmark(("shared_strings_parse/in_memory" + suffix).c_str(),
+                                             sharedStringsParse, shape, rows, SharedStringsMode::InMemory)
+                    ->Unit(benchmark::kMillisecond);
+                benchmark::RegisterBenchmark(("shared_strings_parse/lazy" + suffix).c_str(),
+                                             sharedStringsParse, shape, rows, SharedStringsMode::Lazy)
+                    ->Unit(benchmark::kMillisecond);
+            }
+            for (const auto& [backendName, backend] : backends) {
+                benchmark::RegisterBenchmark(("parse_sheet_data/" + std::string(backendName) + suffix).c_str(),
+                                             parseSheetData, shape, rows, backend)
+                    ->Unit(benchmark::kMillisecond);
+            }
+            benchmark::RegisterBenchmark(("convert_to_csv" + suffix).c_str(), convertToCsv, shape, rows, 1u, false)
+                ->Unit(benchmark::kMillisecond);
+            benchmark::RegisterBenchmark(("convert_to_csv_pipelined" + suffix).c_str(),
+                                         convertToCsv, shape, rows, 1u, true)
+                ->Unit(benchmark::kMillisecond)
+                ->UseRealTime();
+            benchmark::RegisterBenchmark(("convert_to_csv_parallel" + suffix).c_str(),
+                                         convertToCsv, shape, rows, 0u, false)
+                ->Unit(benchmark::kMillisecond)
+                ->UseRealTime();
+        }
+    }
+
+    benchmark::RegisterBenchmark("styles_parse/full", stylesParse, StylesParseMode::Full);
+    benchmark::RegisterBenchmark("styles_parse/number_formats_only", stylesParse, StylesParseMode::NumberFormatsOnly);
+    benchmark::RegisterBenchmark("format_number/fixed6", formatCells, WorkbookShape::Numeric, 2,
+                                 NumberFormatMode::Fixed6);
+    benchmark::RegisterBenchmark("format_number/shortest", formatCells, WorkbookShape::Numeric, 2,
+                                 NumberFormatMode::Shortest);
+    benchmark::RegisterBenchmark("format_date/date", formatCells, WorkbookShape::Dates, 1, NumberFormatMode::Fixed6);
+    benchmark::RegisterBenchmark("format_date/date_time", formatCells, WorkbookShape::Dates, 2,
+                                 NumberFormatMode::Fixed6);
+    benchmark::RegisterBenchmark("format_date/time", formatCells, WorkbookShape::Dates, 3, NumberFormatMode::Fixed6);
+    benchmark::RegisterBenchmark("csv_escape/plain", csvEscape, false);
+    benchmark::RegisterBenchmark("csv_escape/quoted", csvEscape, true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    std::string rowsList = "1000,100000";
+    if (const char* env = std::getenv("TURBOXL_BENCH_ROWS")) {
+        rowsList = env;
+    }
+    std::string shapesList;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--rows=", 0) == 0) {
+            rowsList = arg.substr(7);
+        } else if (arg.rfind("--shapes=", 0) == 0) {
+            shapesList = arg.substr(9);
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<size_t> rowCounts;
+    for (const std::string& item : splitList(rowsList)) {
+        rowCounts.push_back(static_cast<size_t>(std::stoull(item)));
+    }
+    std::vector<WorkbookShape> shapes;
+    for (WorkbookShape shape : xlsxcsv::bench::allShapes()) {
+        const auto wanted = splitList(shapesList);
+        if (wanted.empty() || std::find(wanted.begin(), wanted.end(), xlsxcsv::bench::shapeName(shape)) != wanted.end()) {
+            shapes.push_back(shape);
+        }
+    }
+
+    benchmark::AddCustomContext("turboxl_generator_version", std::to_string(xlsxcsv::bench::GENERATOR_VERSION));
+    benchmark::AddCustomContext("turboxl_rows", rowsList);
+    registerBenchmarks(rowCounts, shapes);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
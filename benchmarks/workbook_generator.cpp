@@ -0,0 +1,509 @@
+#include "workbook_generator.hpp"
+#include <zlib.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+namespace xlsxcsv::bench {
+
+namespace {
+
+constexpr size_t SLICE_BYTES = 1024 * 1024; // Worksheet XML deflated per write
+constexpr int SHARED_STRING_COLUMNS = 10;
+constexpr int WIDE_COLUMNS = 120;
+constexpr int WIDE_UNIQUE_STRINGS = 1000;
+constexpr int SPARSE_SPAN = 1000;
+constexpr int SPARSE_CELLS = 8;
+constexpr int MERGED_COLUMNS = 6;
+
+// splitmix64: tiny, fast and identical on every platform
+class Random {
+public:
+    explicit Random(uint64_t seed) : m_state(seed) {}
+    uint64_t next() {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    uint64_t below(uint64_t bound) { return next() % bound; }
+
+private:
+    uint64_t m_state;
+};
+
+// Minimal ZIP writer: deflated entries without data descriptors or ZIP64.
+// Sizes and CRC are patched into each local header once the entry is done.
+class ZipWriter {
+public:
+    explicit ZipWriter(const std::string& path) : m_file(std::fopen(path.c_str(), "wb")) {
+        if (!m_file) {
+            throw std::runtime_error("Cannot create workbook: " + path);
+        }
+    }
+    ~ZipWriter() {
+        if (m_file) {
+            std::fclose(m_file);
+        }
+    }
+    ZipWriter(const ZipWriter&) = delete;
+    ZipWriter& operator=(const ZipWriter&) = delete;
+
+    void beginEntry(const std::string& name) {
+        m_entry = Entry{name, static_cast<uint64_t>(offset()), 0, 0, 0};
+        writeLocalHeader();
+        m_stream = z_stream{};
+        if (deflateInit2(&m_stream, 6, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("deflateInit2 failed");
+        }
+    }
+
+    void write(std::string_view data) {
+        m_entry.crc = static_cast<uint32_t>(crc32(m_entry.crc, reinterpret_cast<const Bytef*>(data.data()),
+                                                  static_cast<uInt>(data.size())));
+        m_entry.uncompressed += data.size();
+        m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        m_stream.avail_in = static_cast<uInt>(data.size());
+        deflateAll(Z_NO_FLUSH);
+    }
+
+    void endEntry() {
+        deflateAll(Z_FINISH);
+        deflateEnd(&m_stream);
+        if (m_entry.uncompressed > std::numeric_limits<uint32_t>::max() ||
+            m_entry.compressed > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Generated entry exceeds 4 GiB (ZIP64 is not supported): " + m_entry.name);
+        }
+        const long end = offset();
+        std::fseek(m_file, static_cast<long>(m_entry.headerOffset) + 14, SEEK_SET);
+        put32(m_entry.crc);
+        put32(static_cast<uint32_t>(m_entry.compressed));
+        put32(static_cast<uint32_t>(m_entry.uncompressed));
+        std::fseek(m_file, end, SEEK_SET);
+        m_entries.push_back(m_entry);
+    }
+
+    void addEntry(const std::string& name, std::string_view data) {
+        beginEntry(name);
+        write(data);
+        endEntry();
+    }
+
+    void close() {
+        const long directoryStart = offset();
+        for (const Entry& entry : m_entries) {
+            put32(0x02014b50);
+            put16(20);  // Version made by
+            put16(20);  // Version needed
+            put16(0);   // Flags
+            put16(8);   // Deflate
+            put16(0);   // Time
+            put16(0x21); // Date: 1980-01-01
+            put32(entry.crc);
+            put32(static_cast<uint32_t>(entry.compressed));
+            put32(static_cast<uint32_t>(entry.uncompressed));
+            put16(static_cast<uint16_t>(entry.name.size()));
+            put16(0);   // Extra field length
+            put16(0);   // Comment length
+            put16(0);   // Disk number
+            put16(0);   // Internal attributes
+            put32(0);   // External attributes
+            put32(static_cast<uint32_t>(entry.headerOffset));
+            std::fwrite(entry.name.data(), 1, entry.name.size(), m_file);
+        }
+        const long directoryEnd = offset();
+        put32(0x06054b50);
+        put16(0);
+        put16(0);
+        put16(static_cast<uint16_t>(m_entries.size()));
+        put16(static_cast<uint16_t>(m_entries.size()));
+        put32(static_cast<uint32_t>(directoryEnd - directoryStart));
+        put32(static_cast<uint32_t>(directoryStart));
+        put16(0);
+        const bool failed = std::ferror(m_file) != 0;
+        std::fclose(m_file);
+        m_file = nullptr;
+        if (failed) {
+            throw std::runtime_error("Failed writing workbook");
+        }
+    }
+
+private:
+    struct Entry {
+        std::string name;
+        uint64_t headerOffset;
+        uint32_t crc;
+        uint64_t compressed;
+        uint64_t uncompressed;
+    };
+
+    long offset() const { return std::ftell(m_file); }
+
+    void put16(uint16_t value) {
+        const unsigned char bytes[2] = {static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8)};
+        std::fwrite(bytes, 1, 2, m_file);
+    }
+    void put32(uint32_t value) {
+        put16(static_cast<uint16_t>(value));
+        put16(static_cast<uint16_t>(value >> 16));
+    }
+
+    void writeLocalHeader() {
+        put32(0x04034b50);
+        put16(20);   // Version needed
+        put16(0);    // Flags
+        put16(8);    // Deflate
+        put16(0);    // Time
+        put16(0x21); // Date
+        put32(0);    // CRC, patched by endEntry()
+        put32(0);    // Compressed size
+        put32(0);    // Uncompressed size
+        put16(static_cast<uint16_t>(m_entry.name.size()));
+        put16(0);
+        std::fwrite(m_entry.name.data(), 1, m_entry.name.size(), m_file);
+    }
+
+    void deflateAll(int flush) {
+        std::array<Bytef, 64 * 1024> out;
+        int status = Z_OK;
+        do {
+            m_stream.next_out = out.data();
+            m_stream.avail_out = static_cast<uInt>(out.size());
+            status = deflate(&m_stream, flush);
+            if (status == Z_STREAM_ERROR) {
+                throw std::runtime_error("deflate failed");
+            }
+            const size_t produced = out.size() - m_stream.avail_out;
+            std::fwrite(out.data(), 1, produced, m_file);
+            m_entry.compressed += produced;
+        } while (m_stream.avail_out == 0 || (flush == Z_FINISH && status != Z_STREAM_END));
+    }
+
+    std::FILE* m_file;
+    z_stream m_stream{};
+    Entry m_entry{};
+    std::vector<Entry> m_entries;
+};
+
+void appendColumnName(std::string& out, int column) {
+    char letters[4];
+    int count = 0;
+    while (column > 0) {
+        const int rem = (column - 1) % 26;
+        letters[count++] = static_cast<char>('A' + rem);
+        column = (column - 1) / 26;
+    }
+    while (count > 0) {
+        out.push_back(letters[--count]);
+    }
+}
+
+template <typename T>
+void appendNumber(std::string& out, T value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void appendDecimal(std::string& out, double value, int precision) {
+    char buffer[48];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision);
+    out.append(buffer, result.ptr);
+}
+
+void beginCell(std::string& out, int column, size_t row) {
+    out += "<c r=\"";
+    appendColumnName(out, column);
+    appendNumber(out, row);
+    out += '"';
+}
+
+void appendNumberCell(std::string& out, int column, size_t row, std::string_view value, int style = 0) {
+    beginCell(out, column, row);
+    if (style > 0) {
+        out += " s=\"";
+        appendNumber(out, style);
+        out += '"';
+    }
+    out += "><v>";
+    out += value;
+    out += "</v></c>";
+}
+
+void appendSharedStringCell(std::string& out, int column, size_t row, uint64_t index) {
+    beginCell(out, column, row);
+    out += " t=\"s\"><v>";
+    appendNumber(out, index);
+    out += "</v></c>";
+}
+
+// Shared string i as stored in sharedStrings.xml (already XML-escaped)
+void appendSharedStringText(std::string& out, uint64_t i) {
+    if (i % 11 == 0) {
+        out += "R&amp;D ";
+    } else if (i % 7 == 0) {
+        out += "say \"hi\", item ";
+    } else if (i % 13 == 0) {
+        out += "two\nlines ";
+    } else {
+        out += "item ";
+    }
+    appendNumber(out, i);
+}
+
+uint64_t sharedStringCount(WorkbookShape shape, size_t rows) {
+    switch (shape) {
+        case WorkbookShape::Strings:
+            return std::max<uint64_t>(16, std::min<uint64_t>(rows * 2, 500000));
+        case WorkbookShape::Wide:
+            return WIDE_UNIQUE_STRINGS;
+        default:
+            return 0;
+    }
+}
+
+int columnCount(WorkbookShape shape) {
+    switch (shape) {
+        case WorkbookShape::Numeric: return 10;
+        case WorkbookShape::Strings: return SHARED_STRING_COLUMNS;
+        case WorkbookShape::Wide: return WIDE_COLUMNS;
+        case WorkbookShape::Sparse: return SPARSE_SPAN;
+        case WorkbookShape::Merged: return MERGED_COLUMNS;
+        case WorkbookShape::Dates: return 5;
+    }
+    return 1;
+}
+
+void appendRow(std::string& out, WorkbookShape shape, size_t row, Random& random, uint64_t uniqueStrings) {
+    out += "<row r=\"";
+    appendNumber(out, row);
+    out += "\" spans=\"1:";
+    appendNumber(out, columnCount(shape));
+    out += "\">";
+    std::string value;
+
+    switch (shape) {
+        case WorkbookShape::Numeric:
+            for (int c = 1; c <= 10; ++c) {
+                value.clear();
+                if (c % 2 == 1) {
+                    appendNumber(value, random.below(1000000));
+                } else {
+                    appendDecimal(value, static_cast<double>(random.below(200000000)) / 1000.0 - 100000.0, 3);
+                }
+                appendNumberCell(out, c, row, value);
+            }
+            break;
+
+        case WorkbookShape::Strings:
+            for (int c = 1; c <= SHARED_STRING_COLUMNS; ++c) {
+                appendSharedStringCell(out, c, row, random.below(uniqueStrings));
+            }
+            break;
+
+        case WorkbookShape::Wide:
+            for (int c = 1; c <= WIDE_COLUMNS; ++c) {
+                if (c % 2 == 0) {
+                    appendSharedStringCell(out, c, row, random.below(uniqueStrings));
+                } else {
+                    value.clear();
+                    appendNumber(value, random.below(100000));
+                    appendNumberCell(out, c, row, value);
+                }
+            }
+            break;
+
+        case WorkbookShape::Sparse: {
+            // One cell in each of SPARSE_CELLS bands keeps the columns ordered
+            const int band = SPARSE_SPAN / SPARSE_CELLS;
+            for (int i = 0; i < SPARSE_CELLS; ++i) {
+                const int column = i * band + 1 + static_cast<int>(random.below(band));
+                value.clear();
+                appendNumber(value, random.below(1000));
+                appendNumberCell(out, column, row, value);
+            }
+            break;
+        }
+
+        case WorkbookShape::Merged:
+            for (int c = 1; c <= MERGED_COLUMNS; ++c) {
+                // B and C are covered by the A:C merge on even rows
+                if (row % 2 == 0 && (c == 2 || c == 3)) {
+                    continue;
+                }
+                beginCell(out, c, row);
+                out += " t=\"inlineStr\"><is><t>cell ";
+                appendNumber(out, random.below(100000));
+                out += "</t></is></c>";
+            }
+            break;
+
+        case WorkbookShape::Dates: {
+            const double day = 36526.0 + static_cast<double>(random.below(20000));
+            const double fraction = static_cast<double>(random.below(86400)) / 86400.0;
+            value.clear();
+            appendNumber(value, static_cast<int>(day));
+            appendNumberCell(out, 1, row, value, 1);
+            value.clear();
+            appendDecimal(value, day + fraction, 8);
+            appendNumberCell(out, 2, row, value, 2);
+            value.clear();
+            appendDecimal(value, fraction, 8);
+            appendNumberCell(out, 3, row, value, 3);
+            value.clear();
+            appendDecimal(value, day + fraction, 8);
+            appendNumberCell(out, 4, row, value, 4);
+            value.clear();
+            appendDecimal(value, static_cast<double>(random.below(10000000)) / 100.0, 2);
+            appendNumberCell(out, 5, row, value);
+            break;
+        }
+    }
+    out += "</row>";
+}
+
+constexpr std::string_view CONTENT_TYPES =
+    R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>)"
+    R"(<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">)"
+    R"(<Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>)"
+    R"(<Default Extension="xml" ContentType="application/xml"/>)"
+    R"(<Override PartName="/xl/workbook.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml"/>)"
+    R"(<Override PartName="/xl/worksheets/sheet1.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml"/>)"
+    R"(<Override PartName="/xl/styles.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml"/>)"
+    R"(<Override PartName="/xl/sharedStrings.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.sharedStrings+xml"/>)"
+    R"(</Types>)";
+
+constexpr std::string_view ROOT_RELS =
+    R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>)"
+    R"(<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">)"
+    R"(<Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument" Target="xl/workbook.xml"/>)"
+    R"(</Relationships>)";
+
+constexpr std::string_view WORKBOOK =
+    R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>)"
+    R"(<workbook xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" xmlns:r="http://schemas.openxmlformats.org/officeDocument/2006/relationships">)"
+    R"(<sheets><sheet name="Sheet1" sheetId="1" r:id="rId1"/></sheets></workbook>)";
+
+constexpr std::string_view WORKBOOK_RELS =
+    R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>)"
+    R"(<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">)"
+    R"(<Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet" Target="worksheets/sheet1.xml"/>)"
+    R"(<Relationship Id="rId2" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/styles" Target="styles.xml"/>)"
+    R"(<Relationship Id="rId3" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/sharedStrings" Target="sharedStrings.xml"/>)"
+    R"(</Relationships>)";
+
+// Styles 1-4: built-in date, date-time and time formats, then a custom one
+constexpr std::string_view STYLES =
+    R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>)"
+    R"(<styleSheet xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main">)"
+    R"(<numFmts count="1"><numFmt numFmtId="164" formatCode="dd/mm/yyyy\ hh:mm"/></numFmts>)"
+    R"(<fonts count="1"><font><sz val="11"/><name val="Calibri"/></font></fonts>)"
+    R"(<fills count="2"><fill><patternFill patternType="none"/></fill><fill><patternFill patternType="gray125"/></fill></fills>)"
+    R"(<borders count="1"><border><left/><right/><top/><bottom/><diagonal/></border></borders>)"
+    R"(<cellStyleXfs count="1"><xf numFmtId="0" fontId="0" fillId="0" borderId="0"/></cellStyleXfs>)"
+    R"(<cellXfs count="5">)"
+    R"(<xf numFmtId="0" fontId="0" fillId="0" borderId="0" xfId="0"/>)"
+    R"(<xf numFmtId="14" fontId="0" fillId="0" borderId="0" xfId="0" applyNumberFormat="1"/>)"
+    R"(<xf numFmtId="22" fontId="0" fillId="0" borderId="0" xfId="0" applyNumberFormat="1"/>)"
+    R"(<xf numFmtId="21" fontId="0" fillId="0" borderId="0" xfId="0" applyNumberFormat="1"/>)"
+    R"(<xf numFmtId="164" fontId="0" fillId="0" borderId="0" xfId="0" applyNumberFormat="1"/>)"
+    R"(</cellXfs></styleSheet>)";
+
+void writeSharedStrings(ZipWriter& zip, uint64_t count) {
+    zip.beginEntry("xl/sharedStrings.xml");
+    std::string out = R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>)"
+                      R"(<sst xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" uniqueCount=")";
+    appendNumber(out, count);
+    out += "\">";
+    for (uint64_t i = 0; i < count; ++i) {
+        out += "<si><t>";
+        appendSharedStringText(out, i);
+        out += "</t></si>";
+        if (out.size() >= SLICE_BYTES) {
+            zip.write(out);
+            out.clear();
+        }
+    }
+    out += "</sst>";
+    zip.write(out);
+    zip.endEntry();
+}
+
+void writeWorksheet(ZipWriter& zip, WorkbookShape shape, size_t rows, uint64_t uniqueStrings) {
+    zip.beginEntry("xl/worksheets/sheet1.xml");
+    std::string out = R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>)"
+                      R"(<worksheet xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main"><sheetData>)";
+    Random random(0x5EED0000ULL + static_cast<uint64_t>(shape));
+    size_t rowNumber = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        // Sparse sheets skip every third row number
+        rowNumber += (shape == WorkbookShape::Sparse && i % 3 == 2) ? 2 : 1;
+        appendRow(out, shape, rowNumber, random, uniqueStrings);
+        if (out.size() >= SLICE_BYTES) {
+            zip.write(out);
+            out.clear();
+        }
+    }
+    out += "</sheetData>";
+    if (shape == WorkbookShape::Merged && rows >= 2) {
+        out += "<mergeCells count=\"";
+        appendNumber(out, rows / 2);
+        out += "\">";
+        for (size_t row = 2; row <= rows; row += 2) {
+            out += "<mergeCell ref=\"A";
+            appendNumber(out, row);
+            out += ":C";
+            appendNumber(out, row);
+            out += "\"/>";
+            if (out.size() >= SLICE_BYTES) {
+                zip.write(out);
+                out.clear();
+            }
+        }
+        out += "</mergeCells>";
+    }
+    out += "</worksheet>";
+    zip.write(out);
+    zip.endEntry();
+}
+
+} // namespace
+
+const char* shapeName(WorkbookShape shape) {
+    switch (shape) {
+        case WorkbookShape::Numeric: return "numeric";
+        case WorkbookShape::Strings: return "strings";
+        case WorkbookShape::Wide: return "wide";
+        case WorkbookShape::Sparse: return "sparse";
+        case WorkbookShape::Merged: return "merged";
+        case WorkbookShape::Dates: return "dates";
+    }
+    return "unknown";
+}
+
+const std::vector<WorkbookShape>& allShapes() {
+    static const std::vector<WorkbookShape> shapes = {
+        WorkbookShape::Numeric, WorkbookShape::Strings, WorkbookShape::Wide,
+        WorkbookShape::Sparse, WorkbookShape::Merged, WorkbookShape::Dates};
+    return shapes;
+}
+
+void writeWorkbook(const std::string& path, WorkbookShape shape, size_t rows) {
+    ZipWriter zip(path);
+    zip.addEntry("[Content_Types].xml", CONTENT_TYPES);
+    zip.addEntry("_rels/.rels", ROOT_RELS);
+    zip.addEntry("xl/workbook.xml", WORKBOOK);
+    zip.addEntry("xl/_rels/workbook.xml.rels", WORKBOOK_RELS);
+    zip.addEntry("xl/styles.xml", STYLES);
+    const uint64_t uniqueStrings = sharedStringCount(shape, rows);
+    writeSharedStrings(zip, uniqueStrings);
+    writeWorksheet(zip, shape, rows, uniqueStrings);
+    zip.close();
+}
+
+} // namespace xlsxcsv::bench
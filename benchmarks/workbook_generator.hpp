@@ -0,0 +1,33 @@
+#pragma once
+
+// Deterministic synthetic workbooks for the benchmark suite. The same shape
+// and row count always produce byte-identical files, so timings taken on
+// different revisions compare like for like.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace xlsxcsv::bench {
+
+enum class WorkbookShape {
+    Numeric,  // 10 columns of integers and decimals
+    Strings,  // 10 columns of shared strings, some needing CSV quoting
+    Wide,     // 120 columns alternating numbers and shared strings
+    Sparse,   // 8 cells per row scattered over 1000 columns, with row gaps
+    Merged,   // Inline strings with a horizontal merge on every other row
+    Dates     // Date, date-time, time and custom-format serials
+};
+
+const char* shapeName(WorkbookShape shape);
+const std::vector<WorkbookShape>& allShapes();
+
+// Bumped whenever the generated content changes, so results can be matched
+constexpr int GENERATOR_VERSION = 1;
+
+// Writes a single-sheet workbook ("Sheet1", xl/worksheets/sheet1.xml). The
+// worksheet is generated and deflated in slices, so row counts in the
+// millions need no more memory than small ones.
+void writeWorkbook(const std::string& path, WorkbookShape shape, size_t rows);
+
+} // namespace xlsxcsv::bench
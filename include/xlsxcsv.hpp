@@ -3,8 +3,81 @@
 #include <string>
 #include <variant>
 #include <cstdint>
+#include <cstdio>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
 #include <vector>
 #include <map>
+#include <memory>
+#include <span>
+
+// Arrow C data and stream interfaces, as specified at
+// https://arrow.apache.org/docs/format/CDataInterface.html. The guards let
+// this header coexist with Arrow's own copy of the definitions.
+extern "C" {
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+#ifndef ARROW_C_STREAM_INTERFACE
+#define ARROW_C_STREAM_INTERFACE
+
+struct ArrowArrayStream {
+    // Callbacks providing stream functionality
+    int (*get_schema)(struct ArrowArrayStream*, struct ArrowSchema* out);
+    int (*get_next)(struct ArrowArrayStream*, struct ArrowArray* out);
+    const char* (*get_last_error)(struct ArrowArrayStream*);
+
+    // Release callback
+    void (*release)(struct ArrowArrayStream*);
+
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif  // ARROW_C_STREAM_INTERFACE
+
+} // extern "C"
 
 namespace xlsxcsv {
 
@@ -26,9 +99,11 @@ struct CsvOptions {
     enum class DateMode { ISO, RAW };   // Date formatting mode
     DateMode dateMode = DateMode::ISO;  // Default to ISO format
     bool quoteAll = false;              // Quote all fields
+    enum class NumberFormat { FIXED6, SHORTEST }; // SHORTEST round-trips every double exactly
+    NumberFormat numberFormat = NumberFormat::FIXED6; // Default: at most six decimals
     
     // Shared strings handling
-    enum class SharedStringsMode { AUTO, IN_MEMORY, EXTERNAL };
+    enum class SharedStringsMode { AUTO, IN_MEMORY, EXTERNAL, LAZY }; // LAZY decodes strings on first use
     SharedStringsMode sharedStringsMode = SharedStringsMode::AUTO;
     
     // Merged cells handling
@@ -39,6 +114,55 @@ struct CsvOptions {
     bool includeHiddenRows = true;      // Include hidden rows (default: true)
     bool includeHiddenColumns = true;   // Include hidden columns (default: true)
     
+    // Row range and column selection, applied while the worksheet is parsed:
+    // skipped rows and unselected cells are never converted, and parsing stops
+    // once rowLimit rows are written. Rows are counted in sheet order after
+    // hidden-row filtering; selected columns keep their sheet order.
+    size_t rowOffset = 0;               // Rows skipped before the first one written
+    size_t rowLimit = 0;                // Most rows written (0 = no limit)
+    std::vector<std::variant<std::string, int>> columns; // By letter ("C"), range ("B:D") or
+                                        // 0-based index; empty keeps every column
+    
+    // Input
+    bool memoryMap = false;             // Map path inputs read-only instead of reading them through a
+                                        // file handle; entries then inflate straight from the mapping
+    bool pipelinedInflate = false;      // Inflate worksheets and sharedStrings.xml on a background thread
+                                        // while they are parsed (one extra thread per part being read)
+    
+    // Result cache: single-sheet conversions and readMultipleSheets store each
+    // sheet's CSV under the CRC32 and sizes of the parts it was converted from
+    // (worksheet, shared strings, styles) and the options above, and serve it
+    // again without inflating or parsing while those are unchanged
+    std::string resultCacheDir;         // Cache directory, created on first store (empty = no caching)
+    uint64_t resultCacheLimit = 1ULL << 30; // Bytes the directory may hold; least recently used results go first
+    
+    // Compression of streamed output (convertSheet to a sink, convertSheetToFile
+    // and Document's equivalents). Blocks are compressed as the encoder
+    // flushes them, so no uncompressed copy of the CSV is kept; the string
+    // APIs reject it. Stats and the result cache see the uncompressed CSV.
+    enum class OutputCompression { NONE, GZIP, ZSTD }; // ZSTD needs a build with libzstd
+    OutputCompression outputCompression = OutputCompression::NONE;
+    int compressionLevel = -1;          // -1 = codec default (gzip 6, zstd 3)
+    unsigned compressionThreads = 1;    // Above 1, blocks are compressed concurrently (0 = all cores)
+    
+    // Memory accounting: inflated parts, inflate rings, the shared string
+    // table, output buffers and (after installMemoryHooks()) libxml2's
+    // allocations are charged to one tracker per conversion. Document
+    // conversions take these from the per-call options, with the resident
+    // shared string table charged up front.
+    bool trackMemory = false;           // Report ConversionStats::peakMemoryBytes
+    uint64_t memoryLimit = 0;           // Fail a conversion whose tracked memory would exceed this many
+                                        // bytes (0 = no limit; a limit implies trackMemory)
+    
+    // Worksheet parsing
+    enum class ParserBackend { AUTO, FAST, LIBXML }; // AUTO uses the fast scanner, libxml2 for DTD/non-UTF-8 input
+    ParserBackend parserBackend = ParserBackend::AUTO;
+    
+    // Parallelism
+    unsigned maxThreads = 1;            // Worker threads for multi-sheet reads (0 = all cores)
+    unsigned sheetParseThreads = 1;     // Workers splitting one sheet's rows in readSheetToCsv (0 = all cores);
+                                        // above 1 the worksheet XML is inflated whole before parsing
+    
     // Security limits
     uint32_t maxEntries = 10000;                    // Max ZIP entries
     uint64_t maxEntrySize = 256 * 1024 * 1024;     // Max entry size (256 MB)
@@ -55,19 +179,365 @@ struct SheetMetadata {
     std::string target = "";     // Internal target path (e.g., "worksheets/sheet1.xml")
 };
 
+/**
+ * @brief Destination for streamed CSV output
+ * 
+ * The converter hands output to a sink in fixed-size blocks as rows are
+ * encoded, so memory stays flat regardless of sheet size. BOM and newline
+ * style are already applied to the bytes a sink receives.
+ */
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+    virtual void write(const char* data, size_t size) = 0;
+    virtual void flush() {}
+};
+
+/**
+ * @brief Sink writing to a file it creates (truncating any existing file)
+ */
+class FileOutputSink : public OutputSink {
+public:
+    explicit FileOutputSink(const std::string& path);
+    ~FileOutputSink() override;
+    
+    FileOutputSink(const FileOutputSink&) = delete;
+    FileOutputSink& operator=(const FileOutputSink&) = delete;
+    
+    void write(const char* data, size_t size) override;
+    void flush() override;
+    void close();
+
+private:
+    std::string m_path;
+    std::FILE* m_file = nullptr;
+};
+
+/**
+ * @brief Sink writing to a caller-owned stdio stream (not closed by the sink)
+ */
+class StdioOutputSink : public OutputSink {
+public:
+    explicit StdioOutputSink(std::FILE* file);
+    void write(const char* data, size_t size) override;
+    void flush() override;
+
+private:
+    std::FILE* m_file;
+};
+
+/**
+ * @brief Sink writing to a caller-owned file descriptor (not closed by the sink)
+ */
+class FdOutputSink : public OutputSink {
+public:
+    explicit FdOutputSink(int fd);
+    void write(const char* data, size_t size) override;
+
+private:
+    int m_fd;
+};
+
+/**
+ * @brief Sink writing to a caller-owned std::ostream
+ */
+class StreamOutputSink : public OutputSink {
+public:
+    explicit StreamOutputSink(std::ostream& stream);
+    void write(const char* data, size_t size) override;
+    void flush() override;
+
+private:
+    std::ostream& m_stream;
+};
+
+/**
+ * @brief Sink forwarding each output block to a user callback
+ * 
+ * The data pointer is only valid for the duration of the callback.
+ */
+class CallbackOutputSink : public OutputSink {
+public:
+    using Callback = std::function<void(const char* data, size_t size)>;
+    explicit CallbackOutputSink(Callback callback);
+    void write(const char* data, size_t size) override;
+
+private:
+    Callback m_callback;
+};
+
+/**
+ * @brief Sink appending to a caller-owned std::string
+ */
+class StringOutputSink : public OutputSink {
+public:
+    explicit StringOutputSink(std::string& target);
+    void write(const char* data, size_t size) override;
+
+private:
+    std::string& m_target;
+};
+
+/**
+ * @brief Sink compressing everything written to it into another sink
+ * 
+ * Produces a gzip member or a zstd frame. With several threads, gzip input
+ * is cut into blocks deflated concurrently (each primed with the preceding
+ * 32 KiB, as pigz does) into one ordinary gzip stream, and zstd uses its
+ * own worker threads. flush() passes on the bytes compressed so far;
+ * finish() compresses the rest and ends the stream. A sink destroyed
+ * without finish() leaves a truncated stream that decompressors reject.
+ */
+class CompressedOutputSink : public OutputSink {
+public:
+    CompressedOutputSink(OutputSink& target,
+                         CsvOptions::OutputCompression codec,
+                         int level = -1,
+                         unsigned threads = 1);
+    ~CompressedOutputSink() override;
+    
+    CompressedOutputSink(const CompressedOutputSink&) = delete;
+    CompressedOutputSink& operator=(const CompressedOutputSink&) = delete;
+    
+    void write(const char* data, size_t size) override;
+    void flush() override;
+    void finish();
+    
+    uint64_t compressedBytes() const; // Bytes handed to the target so far
+    
+    // Whether this build can produce the codec (NONE and GZIP always)
+    static bool supports(CsvOptions::OutputCompression codec);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief Stage timings and counters reported by a conversion
+ * 
+ * Pass a pointer to the conversion functions to have it filled in. Fields
+ * are written as each stage completes, so after a failure the stats show how
+ * far the conversion got. For readMultipleSheets the parse time and counters
+ * are summed over all sheets, so parseSheetMs can exceed totalMs when sheets
+ * run concurrently.
+ */
+struct ConversionStats {
+    // Wall time per stage, in milliseconds
+    double openMs = 0.0;             // ZIP central directory and content types
+    double workbookMs = 0.0;         // workbook.xml and its relationships
+    double stylesMs = 0.0;           // styles.xml number formats
+    double sharedStringsMs = 0.0;    // sharedStrings.xml
+    double parseSheetMs = 0.0;       // Inflate, parse and encode rows (including sink writes)
+    double assembleCsvMs = 0.0;      // Final flush or hand-off of the CSV
+    double totalMs = 0.0;
+    
+    // Sizes of the parts read, from the ZIP central directory
+    uint64_t worksheetCompressedBytes = 0;
+    uint64_t worksheetUncompressedBytes = 0;
+    uint64_t sharedStringsCompressedBytes = 0;
+    uint64_t sharedStringsUncompressedBytes = 0;
+    
+    // Content
+    size_t sheets = 0;               // Worksheets converted
+    uint64_t rows = 0;               // CSV rows written
+    uint64_t cells = 0;              // Cells read, including those in skipped hidden rows
+    uint64_t numberCells = 0;
+    uint64_t sharedStringCells = 0;
+    uint64_t inlineStringCells = 0;
+    uint64_t formulaStringCells = 0; // t="str"
+    uint64_t booleanCells = 0;
+    uint64_t errorCells = 0;
+    
+    // Shared strings
+    uint64_t sharedStringCount = 0;       // Strings in the table
+    uint64_t sharedStringLookups = 0;     // Shared-string cells resolved
+    uint64_t spillReads = 0;              // Lookups served from the EXTERNAL mode spill file
+    uint64_t sharedStringsMemoryBytes = 0; // Peak table size, inflated sharedStrings.xml included
+    
+    uint64_t outputBytes = 0;        // CSV bytes produced, BOM included
+    uint64_t compressedBytes = 0;    // Bytes written with CsvOptions::outputCompression
+    size_t resultCacheHits = 0;      // Sheets served from CsvOptions::resultCacheDir (no parse counters)
+    uint64_t peakMemoryBytes = 0;    // Peak tracked memory (CsvOptions::trackMemory or memoryLimit)
+};
+
+/**
+ * @brief Route libxml2's allocator through the memory tracking hooks
+ * 
+ * Without this, CsvOptions::trackMemory and memoryLimit only see the buffers
+ * turboxl charges explicitly. libxml2's allocator is process-wide and can't be
+ * swapped while another thread is inside libxml2, so call it once at startup,
+ * before any conversion or other libxml2 user starts; later calls are no-ops.
+ * 
+ * @return false where heap block sizes can't be queried or libxml2 already has
+ *         custom allocators
+ */
+bool installMemoryHooks();
+
 /**
  * @brief Convert a worksheet from XLSX to CSV
  * 
  * @param xlsxPath Path to the XLSX file
  * @param sheetSelector Sheet name or index (-1 for first sheet)
  * @param options CSV conversion options
+ * @param stats Receives stage timings and counters when not null
  * @return CSV string
  * @throws std::runtime_error on file errors or parsing failures
  */
 std::string readSheetToCsv(
     const std::string& xlsxPath,
     const std::variant<std::string, int>& sheetSelector,
-    const CsvOptions& options = {}
+    const CsvOptions& options = {},
+    ConversionStats* stats = nullptr
+);
+
+/**
+ * @brief Convert a worksheet from XLSX to CSV, streaming output to a sink
+ * 
+ * Output is handed to the sink in fixed-size blocks while the sheet is parsed,
+ * so no full CSV string is ever materialized. If conversion fails part way,
+ * the sink may already have received some rows.
+ * 
+ * @param xlsxPath Path to the XLSX file
+ * @param sheetSelector Sheet name or index (-1 for first sheet)
+ * @param sink Destination for the CSV bytes
+ * @param options CSV conversion options
+ * @param stats Receives stage timings and counters when not null
+ * @throws std::runtime_error on file errors, parsing failures or sink errors
+ */
+void convertSheet(
+    const std::string& xlsxPath,
+    const std::variant<std::string, int>& sheetSelector,
+    OutputSink& sink,
+    const CsvOptions& options = {},
+    ConversionStats* stats = nullptr
+);
+
+/**
+ * @brief Convert a worksheet of a workbook held in memory
+ * 
+ * The bytes are read in place, never copied, and must stay valid and
+ * unchanged until the call returns.
+ * 
+ * @param data The whole XLSX file
+ * @param sheetSelector Sheet name or index (-1 for first sheet)
+ * @param options CSV conversion options (memoryMap is ignored)
+ * @param stats Receives stage timings and counters when not null
+ * @return CSV string
+ * @throws std::runtime_error on parsing failures
+ */
+std::string readSheetToCsv(
+    std::span<const std::byte> data,
+    const std::variant<std::string, int>& sheetSelector,
+    const CsvOptions& options = {},
+    ConversionStats* stats = nullptr
+);
+
+/**
+ * @brief Stream a worksheet of a workbook held in memory to a sink
+ * 
+ * Like readSheetToCsv for a buffer; the bytes must outlive the call.
+ * @throws std::runtime_error on parsing failures or sink errors
+ */
+void convertSheet(
+    std::span<const std::byte> data,
+    const std::variant<std::string, int>& sheetSelector,
+    OutputSink& sink,
+    const CsvOptions& options = {},
+    ConversionStats* stats = nullptr
+);
+
+/**
+ * @brief Convert a worksheet from XLSX directly into a CSV file
+ * 
+ * @param xlsxPath Path to the XLSX file
+ * @param sheetSelector Sheet name or index (-1 for first sheet)
+ * @param outPath Path of the CSV file to create. It is written under a
+ *        temporary name in the same directory and renamed into place on
+ *        success, so a failed conversion leaves any existing file untouched.
+ * @param options CSV conversion options
+ * @param stats Receives stage timings and counters when not null
+ * @throws std::runtime_error on file errors, parsing failures or write errors
+ */
+void convertSheetToFile(
+    const std::string& xlsxPath,
+    const std::variant<std::string, int>& sheetSelector,
+    const std::string& outPath,
+    const CsvOptions& options = {},
+    ConversionStats* stats = nullptr
+);
+
+/**
+ * @brief Pull-based CSV conversion running on a background thread
+ * 
+ * The conversion starts when the reader is constructed and runs ahead of the
+ * consumer by at most maxQueuedChunks chunks, so memory stays bounded while
+ * parsing overlaps with whatever the caller does with each chunk. Every chunk
+ * holds whole CSV rows (BOM and newline style applied) and is at least
+ * chunkBytes long, except possibly the last. With outputCompression set,
+ * chunks are consecutive pieces of the compressed stream instead.
+ */
+class CsvChunkReader {
+public:
+    CsvChunkReader(const std::string& xlsxPath,
+                   const std::variant<std::string, int>& sheetSelector,
+                   const CsvOptions& options = {},
+                   size_t chunkBytes = 1024 * 1024,
+                   size_t maxQueuedChunks = 4);
+    ~CsvChunkReader(); // Stops a conversion that is still running
+    
+    CsvChunkReader(const CsvChunkReader&) = delete;
+    CsvChunkReader& operator=(const CsvChunkReader&) = delete;
+    
+    /**
+     * @brief Wait for the next chunk
+     * 
+     * @param chunk Receives the chunk, replacing its contents
+     * @return false once the whole sheet has been returned
+     * @throws std::runtime_error with the conversion error, once the chunks
+     *         produced before the failure have been returned
+     */
+    bool next(std::string& chunk);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief Options for columnar (Arrow) output
+ */
+struct ColumnarOptions {
+    size_t batchSize = 65536;   // Rows per record batch
+    bool headerRow = false;     // Name columns from the first row instead of A, B, C...
+};
+
+/**
+ * @brief Convert a worksheet into typed Arrow record batches
+ * 
+ * Each column gets one type for the whole sheet: float64 for numbers, bool
+ * for booleans, timestamp[ms] for date-styled numbers (with DateMode::ISO),
+ * dictionary<int32, utf8> for strings, null when every cell is empty, and
+ * plain utf8 holding the CSV text when a column mixes kinds. Empty and error
+ * cells are nulls. Hidden rows/columns and merged cells follow the CSV options.
+ * 
+ * The caller owns the returned stream and must call out->release(out). Its
+ * batches reference the converted buffers directly, so importing them into
+ * pyarrow, polars or pandas copies nothing.
+ * 
+ * @param xlsxPath Path to the XLSX file
+ * @param sheetSelector Sheet name or index (-1 for first sheet)
+ * @param out Stream to initialize
+ * @param options Sheet selection and content options (CSV formatting is ignored)
+ * @param columnar Batch size and header handling
+ * @throws std::runtime_error on file errors or parsing failures
+ */
+void readSheetToArrow(
+    const std::string& xlsxPath,
+    const std::variant<std::string, int>& sheetSelector,
+    ArrowArrayStream* out,
+    const CsvOptions& options = {},
+    const ColumnarOptions& columnar = {}
 );
 
 /**
@@ -107,31 +577,275 @@ std::vector<SheetMetadata> getVisibleSheets(const std::string& xlsxPath);
  * @param xlsxPath Path to the XLSX file
  * @param sheetName Name of the sheet to convert
  * @param options CSV conversion options
+ * @param stats Receives stage timings and counters when not null
  * @return CSV string
  * @throws std::runtime_error on file errors, parsing failures, or if sheet not found
  */
 std::string readSpecificSheet(
     const std::string& xlsxPath,
     const std::string& sheetName,
-    const CsvOptions& options = {}
+    const CsvOptions& options = {},
+    ConversionStats* stats = nullptr
 );
 
 /**
  * @brief Convert multiple worksheets to CSV by name
  * 
  * More efficient than calling readSpecificSheet multiple times as it reuses
- * the ZIP file parsing and workbook structure.
+ * the ZIP file parsing and workbook structure. With options.maxThreads > 1 the
+ * sheets are converted concurrently on a worker pool sharing the parsed styles
+ * and shared strings read-only; the first failure is rethrown.
  * 
  * @param xlsxPath Path to the XLSX file
  * @param sheetNames Vector of sheet names to convert
  * @param options CSV conversion options
+ * @param stats Receives stage timings and counters, summed over sheets, when not null
  * @return Map of sheet name to CSV string
  * @throws std::runtime_error on file errors or parsing failures
  */
 std::map<std::string, std::string> readMultipleSheets(
     const std::string& xlsxPath,
     const std::vector<std::string>& sheetNames,
-    const CsvOptions& options = {}
+    const CsvOptions& options = {},
+    ConversionStats* stats = nullptr
+);
+
+/**
+ * @brief An opened workbook whose parsed parts are kept for repeated conversions
+ * 
+ * Opening parses the package, workbook structure, styles and shared strings
+ * once; every conversion afterwards only parses the requested worksheet.
+ * Conversions are const and may run concurrently on one Document. Options
+ * given to the conversion methods apply per call, except sharedStringsMode,
+ * which is fixed by the options the Document was opened with; the open-time
+ * trackMemory and memoryLimit only cover the open itself. Strings decoded
+ * lazily by a conversion are charged to that conversion. Stats from a
+ * Document report zero for the open, workbook, styles and shared strings
+ * stages.
+ */
+class Document {
+public:
+    /**
+     * @brief Open a workbook
+     * 
+     * @param xlsxPath Path to the XLSX file
+     * @param options Only sharedStringsMode is used when opening
+     * @throws std::runtime_error on file errors or parsing failures
+     */
+    explicit Document(const std::string& xlsxPath, const CsvOptions& options = {});
+    ~Document();
+    
+    Document(Document&&) noexcept;
+    Document& operator=(Document&&) noexcept;
+    Document(const Document&) = delete;
+    Document& operator=(const Document&) = delete;
+    
+    const std::string& path() const;
+    std::vector<SheetMetadata> getSheetList() const;
+    std::vector<SheetMetadata> getVisibleSheets() const;
+    
+    std::string readSheetToCsv(
+        const std::variant<std::string, int>& sheetSelector,
+        const CsvOptions& options = {},
+        ConversionStats* stats = nullptr) const;
+    
+    void convertSheet(
+        const std::variant<std::string, int>& sheetSelector,
+        OutputSink& sink,
+        const CsvOptions& options = {},
+        ConversionStats* stats = nullptr) const;
+    
+    void convertSheetToFile(
+        const std::variant<std::string, int>& sheetSelector,
+        const std::string& outPath,
+        const CsvOptions& options = {},
+        ConversionStats* stats = nullptr) const;
+    
+    std::map<std::string, std::string> readMultipleSheets(
+        const std::vector<std::string>& sheetNames,
+        const CsvOptions& options = {},
+        ConversionStats* stats = nullptr) const;
+    
+    void readSheetToArrow(
+        const std::variant<std::string, int>& sheetSelector,
+        ArrowArrayStream* out,
+        const CsvOptions& options = {},
+        const ColumnarOptions& columnar = {}) const;
+    
+    /**
+     * @brief Approximate bytes held by the parsed parts, mostly shared strings
+     */
+    size_t getMemoryUsage() const;
+    
+    /**
+     * @brief Open a workbook through the process-wide document cache
+     * 
+     * Entries are keyed by canonical path, file size, modification time,
+     * sharedStringsMode, trackMemory and memoryLimit, so a rewritten file is
+     * opened afresh. The least
+     * recently used entries are dropped once the summed getMemoryUsage()
+     * exceeds the cache limit; a document larger than the whole limit is
+     * returned without being cached. Dropped documents stay valid for as
+     * long as callers hold them.
+     * 
+     * @throws std::runtime_error on file errors or parsing failures
+     */
+    static std::shared_ptr<const Document> openCached(const std::string& xlsxPath,
+                                                      const CsvOptions& options = {});
+    
+    // Bytes the cache may retain (default 512 MiB); 0 disables caching. Sizes
+    // are re-read on every open, so Lazy documents count their decoded strings
+    static void setCacheLimit(size_t bytes);
+    static void clearCache();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief One worksheet conversion in a convertFiles batch
+ */
+struct FileConversionJob {
+    std::string xlsxPath;
+    std::variant<std::string, int> sheet = -1; // Sheet name or index (-1 for first sheet)
+    std::string outputPath;                     // CSV file to write; empty returns the CSV in the result
+};
+
+/**
+ * @brief Outcome of one FileConversionJob
+ */
+struct FileConversionResult {
+    size_t index = 0;             // Position of the job in the batch
+    std::string xlsxPath;
+    bool ok = false;
+    std::string error;            // Failure message when ok is false
+    std::string csv;              // CSV text of jobs without an outputPath
+    ConversionStats stats;
+    uint64_t estimatedMemory = 0; // Bytes reserved against the memory budget
+};
+
+/**
+ * @brief Estimate the peak memory of converting one workbook
+ * 
+ * Read from the ZIP central directory without inflating anything: the shared
+ * string table and styles are held for the whole conversion, and parallel row
+ * parsing inflates the worksheet whole. Streaming buffers are covered by a
+ * fixed allowance, which is all that is returned for an archive that cannot
+ * be read (its conversion reports the actual error).
+ * 
+ * Without a sheet selection the largest worksheet is assumed and the CSV is
+ * assumed to be streamed out, as when converting every sheet to files.
+ */
+uint64_t estimateConversionMemory(const std::string& xlsxPath, const CsvOptions& options = {});
+
+/**
+ * @brief Estimate the peak memory of one convertFiles job
+ * 
+ * As above, sized by the worksheet the job selects (which also takes reading
+ * workbook.xml). A job without an outputPath returns its CSV as a string, so
+ * the worksheet's uncompressed size is added as a stand-in for the CSV held.
+ */
+uint64_t estimateConversionMemory(const FileConversionJob& job, const CsvOptions& options = {});
+
+class ConversionScheduler;
+
+/**
+ * @brief Scheduling options for convertFiles
+ */
+struct BatchOptions {
+    ConversionScheduler* scheduler = nullptr; // nullptr = ConversionScheduler::shared()
+    bool failFast = false;                    // After the first failure, skip jobs not yet started
+};
+
+/**
+ * @brief Worker pool with a memory budget, shared by convertFiles batches
+ * 
+ * Jobs of every batch submitted to a scheduler share its threads and its
+ * budget. A job starts once its estimated memory fits in what the running
+ * jobs leave of the budget; a job larger than the whole budget runs alone.
+ * Smaller jobs may start ahead of a larger one waiting for room, but only a
+ * bounded number of times, so large files are never starved.
+ * 
+ * A scheduler must outlive the convertFiles calls using it.
+ */
+class ConversionScheduler {
+public:
+    /**
+     * @param threads Worker threads (0 = one per core)
+     * @param memoryBudget Estimated bytes shared by running jobs (0 = unlimited)
+     */
+    explicit ConversionScheduler(unsigned threads = 0, uint64_t memoryBudget = 0);
+    ~ConversionScheduler();
+    
+    ConversionScheduler(const ConversionScheduler&) = delete;
+    ConversionScheduler& operator=(const ConversionScheduler&) = delete;
+    
+    unsigned threadCount() const;
+    
+    // Jobs are estimated when submitted, so a new budget applies to batches
+    // submitted afterwards
+    void setMemoryBudget(uint64_t bytes);
+    uint64_t getMemoryBudget() const;
+    uint64_t getReservedMemory() const;     // Estimates of the jobs running now
+    uint64_t getPeakReservedMemory() const;
+    
+    /**
+     * @brief The process-wide scheduler convertFiles uses by default
+     * 
+     * One thread per core and no memory budget until one is set.
+     */
+    static ConversionScheduler& shared();
+    
+    /**
+     * @brief Run caller-defined work on the pool, under the memory budget
+     * 
+     * The batch convertFiles runs, for work that is not a single sheet per
+     * job. Calls task(i, false) once per estimate, from pool threads, as the
+     * budget admits it, and blocks until every task has been called. Once a
+     * task returns false the tasks not yet started are called with skipped
+     * set instead, reserving nothing, so they can be reported. When a task
+     * throws, those not yet started are dropped and the first exception is
+     * rethrown here. Tasks must not run a batch on the same scheduler.
+     * 
+     * @param estimates Bytes each task reserves against the budget
+     */
+    void run(const std::vector<uint64_t>& estimates,
+             const std::function<bool(size_t index, bool skipped)>& task);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief Convert many workbooks on a shared worker pool
+ * 
+ * Blocks until every job has been reported. onResult is called once per job
+ * in completion order, one call at a time, from pool threads; it must not
+ * call convertFiles on the same scheduler. Failed conversions are reported
+ * in their result rather than thrown, and jobs skipped by failFast report
+ * an error too.
+ * 
+ * @throws The first exception thrown by onResult, after which remaining jobs
+ *         are skipped without being reported
+ */
+void convertFiles(
+    const std::vector<FileConversionJob>& jobs,
+    const std::function<void(FileConversionResult&)>& onResult,
+    const CsvOptions& options = {},
+    const BatchOptions& batch = {}
+);
+
+/**
+ * @brief Convert many workbooks on a shared worker pool
+ * 
+ * @return One result per job, in job order
+ */
+std::vector<FileConversionResult> convertFiles(
+    const std::vector<FileConversionJob>& jobs,
+    const CsvOptions& options = {},
+    const BatchOptions& batch = {}
 );
 
 } // namespace xlsxcsv
@@ -1,14 +1,23 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
+#include <cstddef>
 #include <functional>
 #include <optional>
+#include <span>
 #include <variant>
 #include <stdexcept>
 
+namespace xlsxcsv {
+class OutputSink; // Defined in xlsxcsv.hpp
+}
+struct ArrowArrayStream; // Arrow C stream interface, defined in xlsxcsv.hpp
+
 namespace xlsxcsv::core {
 
 // Common types
@@ -21,6 +30,95 @@ public:
     explicit XlsxError(const std::string& message) : std::runtime_error(message) {}
 };
 
+// Thrown when a conversion's tracked memory would exceed its limit
+class MemoryLimitError : public XlsxError {
+public:
+    explicit MemoryLimitError(const std::string& message) : XlsxError(message) {}
+};
+
+// Memory accounting for one conversion. Readers, collectors and providers
+// given a tracker charge their large buffers to it (inflated parts, output
+// blocks, string tables, inflate rings), and libxml2 allocations made on a
+// thread inside a Scope are charged too once installLibxmlHooks() succeeded.
+// Thread-safe, so parallel workers share their conversion's tracker.
+class MemoryTracker {
+public:
+    explicit MemoryTracker(uint64_t limit = 0); // 0 = no limit
+
+    MemoryTracker(const MemoryTracker&) = delete;
+    MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+    // Records an allocation; over the limit nothing is recorded and
+    // MemoryLimitError is thrown
+    void charge(uint64_t bytes);
+    // Like charge() for callers that cannot throw; false over the limit
+    bool tryCharge(uint64_t bytes) noexcept;
+    void release(uint64_t bytes) noexcept;
+
+    uint64_t current() const;
+    uint64_t peak() const;
+    uint64_t limit() const { return m_limit; }
+
+    // Once a charge has been refused the conversion is aborting: parsers turn
+    // the refusal into an error message, so callers check this afterwards
+    bool limitExceeded() const;
+    void throwIfLimitExceeded() const;
+
+    // Charges libxml2 allocations and Lazy shared-string decodes on the
+    // calling thread to a tracker for the Scope's lifetime; scopes nest, and a
+    // null tracker keeps the current one
+    class Scope {
+    public:
+        explicit Scope(MemoryTracker* tracker);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        MemoryTracker* m_previous;
+    };
+
+    // Routes libxml2's allocator through the tracking hooks, once per process.
+    // Returns false where heap block sizes can't be queried or libxml2
+    // already has custom allocators; explicit charges still work then. Call
+    // it before other threads start using libxml2.
+    static bool installLibxmlHooks();
+
+    // The tracker of the innermost Scope on the calling thread, or nullptr
+    static MemoryTracker* active();
+
+private:
+    void adjust(int64_t delta) noexcept; // No limit check
+    friend struct LibxmlMemoryHooks;
+
+    const uint64_t m_limit;
+    std::atomic<int64_t> m_current{0};
+    std::atomic<uint64_t> m_peak{0};
+    std::atomic<bool> m_exceeded{false};
+};
+
+// A buffer's share of a MemoryTracker, released on destruction. Without a
+// tracker every operation is a no-op.
+class MemoryCharge {
+public:
+    MemoryCharge() = default;
+    explicit MemoryCharge(MemoryTracker* tracker, uint64_t bytes = 0);
+    ~MemoryCharge();
+
+    MemoryCharge(const MemoryCharge&) = delete;
+    MemoryCharge& operator=(const MemoryCharge&) = delete;
+
+    // Charges or releases the difference; throws like MemoryTracker::charge
+    void resize(uint64_t bytes);
+    uint64_t size() const { return m_bytes; }
+    MemoryTracker* tracker() const { return m_tracker; }
+
+private:
+    MemoryTracker* m_tracker = nullptr;
+    uint64_t m_bytes = 0;
+};
+
 // Security limits for ZIP operations
 struct ZipSecurityLimits {
     size_t maxEntries = 10000;
@@ -34,9 +132,45 @@ struct ZipEntry {
     size_t compressedSize;
     size_t uncompressedSize;
     bool isEncrypted;
+    uint16_t compressionMethod = 0; // 0 = stored, 8 = deflate
+    uint32_t crc32 = 0;             // Verified when the entry is fully read
 };
 
-// Forward declarations
+// Incremental reader over the decompressed bytes of a single ZIP entry.
+// Obtained from ZipReader::openEntryStream; must not outlive its ZipReader.
+// Each stream has its own inflate state, so streams are independent of each
+// other, but a single stream must not be shared between threads.
+class ZipEntryStream {
+public:
+    ZipEntryStream();
+    ~ZipEntryStream();
+    
+    // Non-copyable but movable
+    ZipEntryStream(const ZipEntryStream&) = delete;
+    ZipEntryStream& operator=(const ZipEntryStream&) = delete;
+    ZipEntryStream(ZipEntryStream&&) noexcept;
+    ZipEntryStream& operator=(ZipEntryStream&&) noexcept;
+    
+    // Read up to size decompressed bytes into buffer; returns 0 at end of entry
+    size_t read(uint8_t* buffer, size_t size);
+    void close();
+    bool isOpen() const;
+    
+    const std::string& path() const;
+    size_t uncompressedSize() const; // Size declared in the ZIP directory
+    size_t bytesRead() const;
+
+private:
+    friend class ZipReader;
+    class Impl;
+    explicit ZipEntryStream(std::unique_ptr<Impl> impl);
+    std::unique_ptr<Impl> m_impl;
+};
+
+// ZIP archive reader. The central directory is indexed once at open(); all
+// const methods may then be called concurrently from multiple threads, as
+// entries are read with positional I/O and independent inflate streams.
+// open() and close() must not race with reads.
 class ZipReader {
 public:
     ZipReader(const ZipSecurityLimits& limits = {});
@@ -49,17 +183,37 @@ public:
     ZipReader& operator=(ZipReader&&) noexcept;
     
     void open(const std::string& path);
+    // Maps the file read-only instead of reading it through a file handle
+    void openMapped(const std::string& path);
+    // Reads a whole archive held by the caller. The bytes are not copied and
+    // must stay valid and unchanged until close(), destruction, or re-open.
+    void open(std::span<const std::byte> data);
     void close();
     bool isOpen() const;
     
     std::vector<ZipEntry> listEntries() const;
     bool hasEntry(const std::string& path) const;
+    // Central directory record of one entry by indexed lookup, or nullptr;
+    // valid until close() or re-open
+    const ZipEntry* findEntry(const std::string& path) const;
     ByteVector readEntry(const std::string& path) const;
     std::string readEntryAsString(const std::string& path) const;
     
+    // Stream an entry chunk by chunk instead of inflating it into one buffer.
+    // Any number of streams may be open at once alongside other reads.
+    ZipEntryStream openEntryStream(const std::string& path) const;
+    // Like openEntryStream, but a background thread inflates the entry into a
+    // bounded ring of chunkCount reusable buffers of chunkSize bytes while the
+    // stream is read, so inflating overlaps the reader's parsing. Errors found
+    // while inflating are thrown by read() after the bytes that precede them.
+    ZipEntryStream openPipelinedEntryStream(const std::string& path,
+                                            size_t chunkSize = 256 * 1024,
+                                            size_t chunkCount = 4) const;
+    
     const ZipSecurityLimits& getSecurityLimits() const;
 
 private:
+    friend class ZipEntryStream;
     class Impl;
     std::unique_ptr<Impl> m_impl;
 };
@@ -76,10 +230,17 @@ public:
     OpcPackage& operator=(OpcPackage&&) noexcept;
     
     void open(const std::string& path);
+    void openMapped(const std::string& path);
+    // The bytes must outlive the package, as for ZipReader::open
+    void open(std::span<const std::byte> data);
     void close();
     bool isOpen() const;
     
     std::string findWorkbookPath() const;
+    // Zip entry of the workbook part whose relationship type ends in "/<type>"
+    // (e.g. "sharedStrings", "styles"), or xl/<type>.xml when the workbook
+    // declares none; the entry itself may be absent
+    std::string findWorkbookPartPath(const std::string& type) const;
     std::vector<std::string> getContentTypes() const;
     
     // Access to the underlying ZipReader for advanced operations
@@ -90,6 +251,10 @@ private:
     std::unique_ptr<Impl> m_impl;
 };
 
+// OpcPackage::findWorkbookPartPath for a bare archive; parses the workbook
+// relationships on every call
+std::string findWorkbookPartPath(const ZipReader& zip, const std::string& type);
+
 // Date system enumeration for Excel workbooks
 enum class DateSystem {
     Date1900 = 0,  // Default Excel date system (Windows)
@@ -162,6 +327,15 @@ enum class NumberFormatType {
     Custom = 12
 };
 
+// Which parts of a date-styled serial a cell style shows, settled once per
+// style when styles.xml is parsed
+enum class DateTimeKind : uint8_t {
+    None = 0,      // Not a date/time style; render as a number
+    Date = 1,      // YYYY-MM-DD
+    Time = 2,      // HH:MM:SS (full timestamp for durations of a day or more)
+    DateTime = 3   // YYYY-MM-DDTHH:MM:SS
+};
+
 // Font information structure
 struct FontInfo {
     std::string name = "Calibri";
@@ -211,6 +385,12 @@ struct CellStyle {
     int alignment = 0; // For future use
 };
 
+// How much of styles.xml StylesRegistry materializes
+enum class StylesParseMode {
+    Full = 0,              // Fonts, fills, borders and number formats
+    NumberFormatsOnly = 1  // Only what value conversion needs; getCellStyle() fills styleIndex and numberFormat
+};
+
 class StylesRegistry {
 public:
     StylesRegistry();
@@ -222,7 +402,7 @@ public:
     StylesRegistry(StylesRegistry&&) noexcept;
     StylesRegistry& operator=(StylesRegistry&&) noexcept;
     
-    void parse(const OpcPackage& package);
+    void parse(const OpcPackage& package, StylesParseMode mode = StylesParseMode::Full);
     bool isOpen() const;
     void close();
     
@@ -231,6 +411,7 @@ public:
     std::optional<NumberFormat> getNumberFormat(int formatId) const;
     NumberFormatType detectNumberFormatType(const std::string& formatCode) const;
     bool isDateTimeStyle(int styleIndex) const;
+    DateTimeKind getDateTimeKind(int styleIndex) const;
     
     // Utility methods
     bool isDateTimeFormat(int formatId) const;
@@ -247,7 +428,9 @@ private:
 enum class SharedStringsMode {
     Auto = 0,      // Automatically choose based on size thresholds
     InMemory = 1,  // Force in-memory storage
-    External = 2   // Force external (spill-to-disk) storage
+    External = 2,  // Force external (spill-to-disk) storage
+    Lazy = 3       // Index <si> offsets only; decode each string on first lookup (past
+                   // memoryThreshold the raw items are kept in a mapped spill file)
 };
 
 // Configuration for SharedStringsProvider
@@ -256,6 +439,10 @@ struct SharedStringsConfig {
     size_t memoryThreshold = 50 * 1024 * 1024; // 50MB threshold for spill-to-disk
     size_t maxStringLength = 32767; // Excel's maximum string length
     bool flattenRichText = true;    // Flatten rich text runs to plain text
+    std::string tempDirectory;      // Directory for the External spill file (empty = system temp)
+    bool pipelinedInflate = false;  // Inflate on a background thread while parsing (not Lazy mode)
+    MemoryTracker* memoryTracker = nullptr; // Charged for the parsed table until close();
+                                            // Lazy decodes go to the lookup's Scope instead
 };
 
 class SharedStringsProvider {
@@ -277,6 +464,11 @@ public:
     // String lookup methods
     std::string getString(size_t index) const;
     std::optional<std::string> tryGetString(size_t index) const;
+    
+    // Zero-copy lookups, valid until close() or parse(). Views point into the
+    // in-memory arena or, for external storage, the memory-mapped spill file.
+    std::string_view getStringView(size_t index) const;
+    std::optional<std::string_view> tryGetStringView(size_t index) const;
     size_t getStringCount() const;
     bool hasStrings() const;
     
@@ -284,7 +476,10 @@ public:
     const SharedStringsConfig& getConfig() const;
     SharedStringsMode getActiveMode() const;
     size_t getMemoryUsage() const;
+    size_t getPeakMemoryUsage() const; // Includes the inflated XML held while parsing
     bool isUsingDisk() const;
+    uint64_t getSpillReadCount() const;   // Lookups served from the External spill file since parse()
+    size_t getMaterializedCount() const; // Strings decoded so far (all of them unless Lazy)
 
 private:
     class Impl;
@@ -304,7 +499,7 @@ struct CellCoordinate {
 };
 
 // Excel cell types
-enum class CellType {
+enum class CellType : uint8_t {
     Unknown = 0,
     Boolean,        // b
     Error,          // e  
@@ -320,34 +515,60 @@ using CellValue = std::variant<
     bool,              // Boolean value
     double,            // Numeric value  
     std::string,       // String value (resolved or inline)
-    int                // Shared string index (before resolution)
+    int,               // Shared string index (before resolution)
+    std::string_view   // Text stored in the owning RowData's arena (parsed rows)
 >;
 
-// Parsed cell data
+// Parsed cell data. Type and style share the first padding slot so the
+// value starts at offset 16.
 struct CellData {
     CellCoordinate coordinate;
     CellType type = CellType::Unknown;
-    CellValue value;
     int styleIndex = 0;        // Style reference for date/formatting
+    CellValue value;
     
     // Helper methods
     bool isEmpty() const { return std::holds_alternative<std::monostate>(value); }
     bool isBoolean() const { return std::holds_alternative<bool>(value); }
     bool isNumber() const { return std::holds_alternative<double>(value); }
-    bool isString() const { return std::holds_alternative<std::string>(value); }
+    bool isString() const {
+        return std::holds_alternative<std::string>(value) || std::holds_alternative<std::string_view>(value);
+    }
     bool isSharedStringIndex() const { return std::holds_alternative<int>(value) && type == CellType::SharedString; }
     
     std::string getString() const;
+    // Text of a string cell without copying; a view into a row arena is only
+    // valid while that row is
+    std::string_view getText() const;
     double getNumber() const;
     bool getBoolean() const;
     int getSharedStringIndex() const;
+    
+    // Replaces an arena view with an owned string, for cells kept after handleRow
+    void makeOwned();
 };
 
-// Row of cells - sparse representation
+// Row of cells - sparse representation. Readers reuse one RowData for the
+// whole sheet: cell text lives in textArena and the cells hold views into it.
+// Copying a row rebases those views onto the copy's arena; moving keeps them.
 struct RowData {
     int rowNumber = 0;
     std::vector<CellData> cells;
     bool hidden = false;               // Row visibility (true = hidden)
+    std::vector<char> textArena;       // Backing storage of string_view cell values
+    
+    RowData() = default;
+    RowData(const RowData& other);
+    RowData& operator=(const RowData& other);
+    RowData(RowData&&) noexcept = default;
+    RowData& operator=(RowData&&) noexcept = default;
+    
+    // Empties the row for reuse, keeping the cell and arena capacity
+    void clear();
+    
+    // Copies text into the arena and returns a view of it; views already
+    // held by cells are rebased if the arena has to grow
+    std::string_view appendText(std::string_view text);
     
     // Find cell by column number (1-based)
     const CellData* findCell(int column) const;
@@ -372,11 +593,16 @@ struct MergedCellRange {
     std::vector<CellCoordinate> getAllCoordinates() const;
 };
 
-// Column information
+// Column information for one <col min max> range
 struct ColumnInfo {
-    int columnIndex = 0;              // 1-based column index
+    int columnIndex = 0;              // 1-based first column of the range
+    int lastColumn = 0;               // 1-based last column; 0 means columnIndex only
     bool hidden = false;              // Column visibility (true = hidden)
     double width = 0.0;               // Column width (optional)
+    
+    bool covers(int column) const {
+        return column >= columnIndex && column <= (lastColumn > columnIndex ? lastColumn : columnIndex);
+    }
 };
 
 // Worksheet metadata including merged cells and hidden elements
@@ -384,22 +610,97 @@ struct WorksheetMetadata {
     std::vector<MergedCellRange> mergedCells;
     std::vector<ColumnInfo> columnInfo;
     
-    // Check if a coordinate is part of any merged cell
+    // Rebuilds the lookup indexes below; call after changing mergedCells or
+    // columnInfo. Without it the lookups fall back to linear scans.
+    void buildIndex();
+    
+    // Check if a coordinate is part of any merged cell; O(log n) once indexed
     const MergedCellRange* findMergedCellRange(const CellCoordinate& coord) const;
     
-    // Check if a column is hidden
+    // Position of a range in mergedCells, a stable key for per-range caches
+    size_t mergedRangeId(const MergedCellRange& range) const {
+        return static_cast<size_t>(&range - mergedCells.data());
+    }
+    
+    // Check if a column is hidden; O(1) once indexed
     bool isColumnHidden(int column) const;
+    
+    // Lookup indexes maintained by buildIndex()
+    bool indexed = false;
+    std::vector<uint32_t> mergesByTopRow;   // mergedCells ids sorted by top row
+    std::vector<int> mergeMaxBottomRow;     // Max-bottom-row segment tree over mergesByTopRow
+    std::vector<uint64_t> hiddenColumnBits; // Bit c set when column c is hidden
 };
 
 // Callback interface for row-by-row processing
 class SheetRowHandler {
 public:
     virtual ~SheetRowHandler() = default;
+    // The row and the text its cells point to are only valid during the call;
+    // readers reuse the buffer for the next row. Copy the RowData (or call
+    // CellData::makeOwned on copied cells) to keep anything.
     virtual void handleRow(const RowData& row) = 0;
     virtual void handleError(const std::string& message) = 0;
     virtual void handleWorksheetMetadata([[maybe_unused]] const WorksheetMetadata& metadata) {}  // Optional
 };
 
+// Target of a parallel parse (SheetStreamReader::parseSheetParallel). Rows are
+// split into chunks at <row> boundaries and every chunk gets its own handler,
+// which sees the same metadata calls a serial handler would have seen by then.
+// All three methods are called on the thread that started the parse; only the
+// chunk handlers' own callbacks run on worker threads.
+class ChunkedRowHandler {
+public:
+    virtual ~ChunkedRowHandler() = default;
+    virtual std::unique_ptr<SheetRowHandler> createChunkHandler() = 0;
+    // A parsed chunk, handed back in document order
+    virtual void completeChunk(SheetRowHandler& chunk) = 0;
+    // Whether rows may be split given the metadata known before the first row;
+    // false parses the rows as a single chunk
+    virtual bool canSplitRows([[maybe_unused]] const WorksheetMetadata& metadata) const { return true; }
+};
+
+// Worksheet tokenizer used by SheetStreamReader
+enum class SheetParserBackend {
+    Auto = 0,   // Fast scanner, falling back to libxml2 for DTDs or non-UTF-8 input
+    Fast = 1,   // Fast scanner only; documents it cannot handle report an error
+    LibXml = 2  // libxml2 xmlTextReader
+};
+
+// Rows and cells a SheetStreamReader reports. Rows are counted in document
+// order, leaving out hidden rows when skipHiddenRows is set. Rows before
+// skipRows are passed over without reading their cells, unselected cells are
+// passed over without reading their values, and parsing stops as soon as
+// maxRows rows have been reported.
+struct SheetReadFilter {
+    static constexpr int MAX_COLUMNS = 16384; // Excel's column limit (XFD)
+    
+    size_t skipRows = 0;
+    size_t maxRows = SIZE_MAX;
+    bool skipHiddenRows = false;
+    std::vector<uint64_t> columnBits; // Bit c set for each kept 1-based column; empty keeps all
+    
+    void keepColumn(int column) {
+        if (column < 1 || column > MAX_COLUMNS) {
+            return;
+        }
+        if (columnBits.empty()) {
+            columnBits.assign(MAX_COLUMNS / 64 + 1, 0);
+        }
+        columnBits[static_cast<size_t>(column) / 64] |= uint64_t{1} << (column % 64);
+    }
+    bool keepsColumn(int column) const {
+        if (columnBits.empty()) {
+            return true;
+        }
+        return column >= 1 && column <= MAX_COLUMNS &&
+               (columnBits[static_cast<size_t>(column) / 64] >> (column % 64)) & 1;
+    }
+    bool selectsColumns() const { return !columnBits.empty(); }
+    bool limitsRows() const { return skipRows > 0 || maxRows != SIZE_MAX; }
+    bool isActive() const { return limitsRows() || skipHiddenRows || selectsColumns(); }
+};
+
 // Sheet streaming parser
 class SheetStreamReader {
 public:
@@ -424,6 +725,49 @@ public:
                         SheetRowHandler& handler,
                         const SharedStringsProvider* sharedStrings = nullptr,
                         const StylesRegistry* styles = nullptr);
+    
+    // Parse worksheet XML incrementally as it is decompressed
+    void parseSheetStream(ZipEntryStream& stream,
+                          SheetRowHandler& handler,
+                          const SharedStringsProvider* sharedStrings = nullptr,
+                          const StylesRegistry* styles = nullptr);
+    
+    // Parse with up to threads workers (0 = all cores). The worksheet is
+    // inflated whole, then its rows are parsed in chunks concurrently. Falls
+    // back to a serial parse into one chunk for a single thread, the libxml2
+    // backend, or documents the fast scanner does not handle.
+    void parseSheetParallel(const OpcPackage& package,
+                            const std::string& sheetPath,
+                            ChunkedRowHandler& handler,
+                            unsigned threads,
+                            const SharedStringsProvider* sharedStrings = nullptr,
+                            const StylesRegistry* styles = nullptr);
+    
+    void parseSheetDataParallel(const std::vector<uint8_t>& xmlData,
+                                ChunkedRowHandler& handler,
+                                unsigned threads,
+                                const SharedStringsProvider* sharedStrings = nullptr,
+                                const StylesRegistry* styles = nullptr);
+    
+    void setParserBackend(SheetParserBackend backend);
+    SheetParserBackend getParserBackend() const;
+    
+    // Applies to every later parse. Parallel parses with a row range run
+    // serially, since rows can only be counted in document order.
+    void setReadFilter(const SheetReadFilter& filter);
+    const SheetReadFilter& getReadFilter() const;
+    
+    // Inflate worksheets on a background thread while their rows are parsed
+    // (see ZipReader::openPipelinedEntryStream). Applies to parseSheet and to
+    // parallel parses that fall back to it.
+    void setPipelinedInflate(bool enabled);
+    bool getPipelinedInflate() const;
+    
+    // Charges inflated worksheets, inflate rings, libxml2 allocations and Lazy
+    // shared-string decodes of later parses to a tracker that must outlive
+    // them (nullptr = untracked)
+    void setMemoryTracker(MemoryTracker* tracker);
+    MemoryTracker* getMemoryTracker() const;
 
 private:
     class Impl;
@@ -438,13 +782,69 @@ class DataConverter;
 // We'll use void* and cast appropriately in the implementation
 class CsvOptions; // Forward declaration
 
-// CSV Row Handler that collects data into CSV format
-class CsvRowCollector : public SheetRowHandler {
+// CSV field and row encoding for the delimiter, quoteAll, newline and BOM
+// settings of CsvOptions. A field is classified in one vectorized pass over
+// delimiter, quote, CR and LF; clean runs are appended in bulk and embedded
+// quotes are doubled run by run.
+class CsvEncoder {
+public:
+    explicit CsvEncoder(const void* csvOptions = nullptr);
+
+    // Whether the field contains the delimiter, a quote, CR or LF
+    bool needsQuoting(std::string_view field) const;
+
+    // Appends the field, quoted when it needs to be or quoteAll is set
+    void appendField(std::string& out, std::string_view field) const;
+    // Appends a field already known to need no quoting
+    void appendPlainField(std::string& out, std::string_view field) const {
+        if (m_quoteAll) {
+            out.push_back('"');
+            out.append(field);
+            out.push_back('"');
+        } else {
+            out.append(field);
+        }
+    }
+    // Appends the field in quotes with embedded quotes doubled
+    static void appendQuoted(std::string& out, std::string_view field);
+
+    void appendDelimiter(std::string& out) const { out.push_back(m_delimiter); }
+    void appendRowEnd(std::string& out) const { out.append(m_newline); }
+    void appendBom(std::string& out) const; // No-op unless includeBom is set
+
+    // Encodes whole rows, starting with the BOM when one is configured
+    std::string encode(const std::vector<std::vector<std::string>>& rows) const;
+
+    char delimiter() const { return m_delimiter; }
+    bool quotesAll() const { return m_quoteAll; }
+
+private:
+    char m_delimiter = ',';
+    bool m_quoteAll = false;
+    bool m_includeBom = false;
+    std::string_view m_newline = "\n";
+};
+
+// Cell and lookup counts kept by a CsvRowCollector, including rows it skipped
+struct CsvCollectorCounters {
+    uint64_t cellsByType[7] = {};     // Indexed by CellType
+    uint64_t sharedStringLookups = 0; // Shared-string cells resolved through the provider
+};
+
+// CSV Row Handler that collects data into CSV format.
+// BOM and newline style from the options are applied inline as rows are
+// emitted. With an output sink, encoded rows are handed to the sink in
+// fixed-size blocks instead of accumulating; call finish() after parsing.
+// As a ChunkedRowHandler, chunk collectors encode rows into buffers of their
+// own; completed chunks are appended here with their row counts, errors and
+// merged-cell values.
+class CsvRowCollector : public SheetRowHandler, public ChunkedRowHandler {
 public:
     explicit CsvRowCollector(const SharedStringsProvider* sharedStrings = nullptr,
                            const StylesRegistry* styles = nullptr,
                            DateSystem dateSystem = DateSystem::Date1900,
-                           const void* csvOptions = nullptr);
+                           const void* csvOptions = nullptr,
+                           ::xlsxcsv::OutputSink* sink = nullptr);
     ~CsvRowCollector();
     
     // SheetRowHandler interface
@@ -452,10 +852,116 @@ public:
     void handleError(const std::string& message) override;
     void handleWorksheetMetadata(const WorksheetMetadata& metadata) override;
     
+    // ChunkedRowHandler interface
+    std::unique_ptr<SheetRowHandler> createChunkHandler() override;
+    void completeChunk(SheetRowHandler& chunk) override;
+    bool canSplitRows(const WorksheetMetadata& metadata) const override;
+    
+    // Flush buffered output to the sink (no-op without a sink)
+    void finish();
+    
     // Get results
     std::string getCsvString() const;
+    std::string takeCsvString(); // Moves the buffered CSV out without copying
+    const std::vector<std::string>& getErrors() const;
+    size_t getRowCount() const;
+    size_t getBytesWritten() const; // Total CSV bytes produced so far
+    const CsvCollectorCounters& getCounters() const;
+    
+    // Charges buffered output and the shared-string field cache to a tracker;
+    // chunk handlers created afterwards charge it too. Set before parsing.
+    void setMemoryTracker(MemoryTracker* tracker);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+// Reader filter for the row range, column selection and hidden-row handling
+// of CsvOptions. Throws std::invalid_argument for a malformed column selection.
+SheetReadFilter makeSheetReadFilter(const void* csvOptions);
+
+// Text rendering of numbers that are not date-styled
+enum class NumberFormatMode {
+    Fixed6 = 0,    // At most six decimals, trailing zeros trimmed (historical output)
+    Shortest = 1   // Shortest text that parses back to the same double
+};
+
+// Text of a cell exactly as the CSV output renders it
+std::string formatCellText(const CellData& cell,
+                           const SharedStringsProvider* sharedStrings = nullptr,
+                           const StylesRegistry* styles = nullptr,
+                           DateSystem dateSystem = DateSystem::Date1900,
+                           NumberFormatMode numberMode = NumberFormatMode::Fixed6);
+
+// Row handler accumulating typed columns for Arrow export. A column's type is
+// settled over the whole sheet (see readSheetToArrow in xlsxcsv.hpp), so the
+// record batches are zero-copy slices of the finished columns. Hidden rows and
+// columns and merged cells follow the same CsvOptions as CSV output.
+class ColumnarBatchBuilder : public SheetRowHandler {
+public:
+    explicit ColumnarBatchBuilder(const SharedStringsProvider* sharedStrings = nullptr,
+                                  const StylesRegistry* styles = nullptr,
+                                  DateSystem dateSystem = DateSystem::Date1900,
+                                  const void* csvOptions = nullptr,
+                                  size_t batchSize = 65536,
+                                  bool headerRow = false);
+    ~ColumnarBatchBuilder();
+    
+    // SheetRowHandler interface
+    void handleRow(const RowData& row) override;
+    void handleError(const std::string& message) override;
+    void handleWorksheetMetadata(const WorksheetMetadata& metadata) override;
+    
+    // Finish the columns and export them as a stream of record batches. The
+    // stream owns copies of all strings; the builder is empty afterwards.
+    void exportStream(::ArrowArrayStream* out);
+    
+    const std::vector<std::string>& getErrors() const;
+    size_t getRowCount() const; // Data rows, excluding a header row
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+// Distinct shared strings of one worksheet column
+struct SharedStringDictionary {
+    int column = 0;                 // 1-based worksheet column
+    std::vector<uint32_t> indexes;  // Distinct shared-string indexes, in order of first appearance
+    std::vector<uint64_t> counts;   // Cells referring to each entry of indexes
+    std::vector<int32_t> codes;     // Per row, the position in indexes or -1 (only with emitCodes)
+    uint64_t otherCells = 0;        // Non-empty cells holding anything but a shared string
+};
+
+// Row handler building per-column dictionaries from the shared-string
+// indexes the reader leaves unresolved, without looking any string up, so
+// categorical columns cost one lookup per distinct value rather than per
+// cell. Hidden rows and columns and the column selection follow CsvOptions;
+// merged cells are not propagated. The provider, if given, only has to stay
+// open for resolveValues() and to range-check indexes.
+class SharedStringDictionaryCollector : public SheetRowHandler {
+public:
+    explicit SharedStringDictionaryCollector(const SharedStringsProvider* sharedStrings = nullptr,
+                                             const void* csvOptions = nullptr,
+                                             bool emitCodes = false);
+    ~SharedStringDictionaryCollector();
+    
+    // SheetRowHandler interface
+    void handleRow(const RowData& row) override;
+    void handleError(const std::string& message) override;
+    void handleWorksheetMetadata(const WorksheetMetadata& metadata) override;
+    
+    // Columns with at least one shared-string cell, in column order. The
+    // collector is empty afterwards.
+    std::vector<SharedStringDictionary> takeDictionaries();
+    
+    // Text of a dictionary's entries, in the order of its indexes
+    std::vector<std::string_view> resolveValues(const SharedStringDictionary& dictionary) const;
+    
     const std::vector<std::string>& getErrors() const;
     size_t getRowCount() const;
+    size_t getMemoryUsage() const; // Approximate bytes held, proportional to distinct values per column
 
 private:
     class Impl;
@@ -1,4 +1,5 @@
 #include "xlsxcsv/core.hpp"
+#include <algorithm>
 #include <regex>
 #include <sstream>
 #include <cctype>
@@ -71,10 +72,23 @@ std::string CellCoordinate::toReference() const {
 
 // CellData helper method implementations
 std::string CellData::getString() const {
-    if (std::holds_alternative<std::string>(value)) {
-        return std::get<std::string>(value);
+    return std::string(getText());
+}
+
+std::string_view CellData::getText() const {
+    if (const auto* text = std::get_if<std::string_view>(&value)) {
+        return *text;
+    }
+    if (const auto* text = std::get_if<std::string>(&value)) {
+        return *text;
+    }
+    return {};
+}
+
+void CellData::makeOwned() {
+    if (const auto* text = std::get_if<std::string_view>(&value)) {
+        value = std::string(*text);
     }
-    return "";
 }
 
 double CellData::getNumber() const {
@@ -99,6 +113,59 @@ int CellData::getSharedStringIndex() const {
 }
 
 // RowData implementation
+namespace {
+
+// Points views that referred into one arena at the same offsets of another
+void rebaseTextViews(std::vector<CellData>& cells, const char* oldBegin, size_t oldSize, const char* newBegin) {
+    for (auto& cell : cells) {
+        auto* text = std::get_if<std::string_view>(&cell.value);
+        if (text && !text->empty() && text->data() >= oldBegin && text->data() < oldBegin + oldSize) {
+            *text = std::string_view(newBegin + (text->data() - oldBegin), text->size());
+        }
+    }
+}
+
+} // namespace
+
+RowData::RowData(const RowData& other)
+    : rowNumber(other.rowNumber)
+    , cells(other.cells)
+    , hidden(other.hidden)
+    , textArena(other.textArena) {
+    rebaseTextViews(cells, other.textArena.data(), other.textArena.size(), textArena.data());
+}
+
+RowData& RowData::operator=(const RowData& other) {
+    if (this != &other) {
+        rowNumber = other.rowNumber;
+        cells = other.cells;
+        hidden = other.hidden;
+        textArena = other.textArena;
+        rebaseTextViews(cells, other.textArena.data(), other.textArena.size(), textArena.data());
+    }
+    return *this;
+}
+
+void RowData::clear() {
+    rowNumber = 0;
+    hidden = false;
+    cells.clear();
+    textArena.clear();
+}
+
+std::string_view RowData::appendText(std::string_view text) {
+    if (text.empty()) {
+        return {};
+    }
+    const char* oldBegin = textArena.data();
+    const size_t oldSize = textArena.size();
+    textArena.insert(textArena.end(), text.begin(), text.end());
+    if (textArena.data() != oldBegin) {
+        rebaseTextViews(cells, oldBegin, oldSize, textArena.data());
+    }
+    return std::string_view(textArena.data() + oldSize, text.size());
+}
+
 const CellData* RowData::findCell(int column) const {
     for (const auto& cell : cells) {
         if (cell.coordinate.column == column) {
@@ -168,18 +235,104 @@ std::vector<CellCoordinate> MergedCellRange::getAllCoordinates() const {
 }
 
 // WorksheetMetadata implementation
+namespace {
+
+constexpr int MAX_SHEET_COLUMN = 16384; // XFD
+
+// Finds the range containing coord among the first `end` ranges in top-row
+// order, descending only into subtrees whose maximum bottom row reaches coord
+const MergedCellRange* findInMergeTree(const WorksheetMetadata& metadata, const CellCoordinate& coord,
+                                       size_t end, size_t node, size_t lo, size_t hi) {
+    if (lo >= end || metadata.mergeMaxBottomRow[node] < coord.row) {
+        return nullptr;
+    }
+    if (hi - lo == 1) {
+        const MergedCellRange& range = metadata.mergedCells[metadata.mergesByTopRow[lo]];
+        return range.contains(coord) ? &range : nullptr;
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    if (const MergedCellRange* found = findInMergeTree(metadata, coord, end, 2 * node, lo, mid)) {
+        return found;
+    }
+    return findInMergeTree(metadata, coord, end, 2 * node + 1, mid, hi);
+}
+
+} // namespace
+
+void WorksheetMetadata::buildIndex() {
+    // Merges: ids sorted by top row plus a segment tree of the maximum bottom
+    // row, so a point lookup only visits ranges that span the row
+    mergesByTopRow.resize(mergedCells.size());
+    for (size_t i = 0; i < mergedCells.size(); ++i) {
+        mergesByTopRow[i] = static_cast<uint32_t>(i);
+    }
+    std::stable_sort(mergesByTopRow.begin(), mergesByTopRow.end(), [&](uint32_t a, uint32_t b) {
+        return mergedCells[a].topLeft.row < mergedCells[b].topLeft.row;
+    });
+    size_t leaves = 1;
+    while (leaves < mergesByTopRow.size()) {
+        leaves <<= 1;
+    }
+    mergeMaxBottomRow.assign(2 * leaves, 0);
+    for (size_t i = 0; i < mergesByTopRow.size(); ++i) {
+        mergeMaxBottomRow[leaves + i] = mergedCells[mergesByTopRow[i]].bottomRight.row;
+    }
+    for (size_t node = leaves - 1; node >= 1; --node) {
+        mergeMaxBottomRow[node] = std::max(mergeMaxBottomRow[2 * node], mergeMaxBottomRow[2 * node + 1]);
+    }
+    
+    // Hidden columns: one bit per column up to the last hidden one
+    hiddenColumnBits.clear();
+    for (const auto& col : columnInfo) {
+        if (!col.hidden) {
+            continue;
+        }
+        const int first = std::max(col.columnIndex, 1);
+        const int last = std::min(std::max(col.columnIndex, col.lastColumn), MAX_SHEET_COLUMN);
+        if (last < first) {
+            continue;
+        }
+        const size_t words = static_cast<size_t>(last) / 64 + 1;
+        if (hiddenColumnBits.size() < words) {
+            hiddenColumnBits.resize(words, 0);
+        }
+        for (int c = first; c <= last; ++c) {
+            hiddenColumnBits[static_cast<size_t>(c) / 64] |= uint64_t{1} << (c % 64);
+        }
+    }
+    
+    indexed = true;
+}
+
 const MergedCellRange* WorksheetMetadata::findMergedCellRange(const CellCoordinate& coord) const {
-    for (const auto& range : mergedCells) {
-        if (range.contains(coord)) {
-            return &range;
+    if (!indexed) {
+        for (const auto& range : mergedCells) {
+            if (range.contains(coord)) {
+                return &range;
+            }
         }
+        return nullptr;
     }
-    return nullptr;
+    if (mergesByTopRow.empty()) {
+        return nullptr;
+    }
+    
+    // Only ranges starting at or above the row can contain it
+    const auto end = std::upper_bound(mergesByTopRow.begin(), mergesByTopRow.end(), coord.row,
+                                      [&](int row, uint32_t id) { return row < mergedCells[id].topLeft.row; });
+    const size_t leaves = mergeMaxBottomRow.size() / 2;
+    return findInMergeTree(*this, coord, static_cast<size_t>(end - mergesByTopRow.begin()), 1, 0, leaves);
 }
 
 bool WorksheetMetadata::isColumnHidden(int column) const {
+    if (indexed) {
+        if (column < 1 || static_cast<size_t>(column) / 64 >= hiddenColumnBits.size()) {
+            return false;
+        }
+        return (hiddenColumnBits[static_cast<size_t>(column) / 64] >> (column % 64)) & 1;
+    }
     for (const auto& col : columnInfo) {
-        if (col.columnIndex == column) {
+        if (col.covers(column)) {
             return col.hidden;
         }
     }
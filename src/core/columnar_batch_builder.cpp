@@ -0,0 +1,837 @@
+#include "xlsxcsv/core.hpp"
+#include "xlsxcsv.hpp"  // For CsvOptions and the Arrow C structures
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace xlsxcsv::core {
+
+namespace {
+
+constexpr int64_t MILLIS_PER_DAY = 86400000;
+
+enum class ColumnType : uint8_t { Null, Float64, Boolean, Timestamp, Dictionary, Utf8 };
+
+// What a single cell contributes to a column
+enum class CellKind : uint8_t { Null, Number, Boolean, DateTime, String };
+
+// Growable little-endian bitmap in Arrow's layout
+class BitBuilder {
+public:
+    void append(bool bit) {
+        if ((m_length & 7) == 0) {
+            m_bytes.push_back(0);
+        }
+        if (bit) {
+            m_bytes.back() |= static_cast<uint8_t>(1u << (m_length & 7));
+        }
+        ++m_length;
+    }
+
+    void appendRepeated(bool bit, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            append(bit);
+        }
+    }
+
+    bool get(size_t index) const {
+        return (m_bytes[index >> 3] >> (index & 7)) & 1u;
+    }
+
+    // Unset bits in [offset, offset + length)
+    int64_t countZeros(size_t offset, size_t length) const {
+        int64_t zeros = 0;
+        size_t i = offset;
+        const size_t end = offset + length;
+        while (i < end && (i & 7) != 0) {
+            zeros += get(i) ? 0 : 1;
+            ++i;
+        }
+        while (i + 8 <= end) {
+            zeros += 8 - std::popcount(static_cast<unsigned>(m_bytes[i >> 3]));
+            i += 8;
+        }
+        while (i < end) {
+            zeros += get(i) ? 0 : 1;
+            ++i;
+        }
+        return zeros;
+    }
+
+    const uint8_t* data() const { return m_bytes.data(); }
+
+private:
+    std::vector<uint8_t> m_bytes;
+    size_t m_length = 0;
+};
+
+// One worksheet column in Arrow layout. Rows are appended as the sheet is
+// parsed; every buffer keeps a slot for null rows so batches can slice it.
+struct Column {
+    int sheetColumn = 0;        // 1-based worksheet column
+    std::string name;
+    ColumnType type = ColumnType::Null;
+    size_t length = 0;
+    size_t nullCount = 0;
+    BitBuilder validity;
+
+    std::vector<double> numbers;        // Float64, or Timestamp serials until finish()
+    std::vector<int64_t> timestamps;    // Timestamp milliseconds after finish()
+    BitBuilder booleans;
+    int dateStyle = 0;                  // A date style seen in the column, for text rendering
+
+    // Dictionary: codes plus distinct values. Shared strings map straight to
+    // codes by index and are only resolved in finish(), once per distinct
+    // index; other text is hashed as it arrives.
+    struct DictionaryEntry {
+        const std::string* text = nullptr; // Key in dictionaryIndex, or null for a shared string
+        size_t sharedIndex = 0;
+    };
+    std::vector<int32_t> codes;
+    std::unordered_map<std::string, int32_t> dictionaryIndex;
+    std::vector<DictionaryEntry> dictionaryEntries;
+    std::unordered_map<size_t, int32_t> sharedToCode; // Hashed: few strings of a possibly huge table
+
+    // Utf8 (also the dictionary values after finish())
+    std::vector<int64_t> offsets{0};
+    std::string text;
+    std::vector<int32_t> offsets32;     // Narrowed offsets when the text fits
+    std::vector<int32_t> dictionaryOffsets;
+    std::string dictionaryData;
+};
+
+struct ColumnarTable {
+    std::vector<Column> columns;
+    size_t rowCount = 0;
+    size_t batchSize = 65536;
+};
+
+std::string columnLetters(int column) {
+    std::string letters;
+    while (column > 0) {
+        --column;
+        letters.insert(letters.begin(), static_cast<char>('A' + column % 26));
+        column /= 26;
+    }
+    return letters;
+}
+
+// Unix milliseconds of an Excel serial date. Serial 60 is the phantom
+// 1900-02-29, so later 1900-system serials are one day further along.
+int64_t serialToUnixMillis(double serial, DateSystem dateSystem) {
+    double unixDays = 0.0;
+    if (dateSystem == DateSystem::Date1904) {
+        unixDays = serial - 24107.0;
+    } else if (serial < 60.0) {
+        unixDays = serial - 25568.0;
+    } else {
+        unixDays = serial - 25569.0;
+    }
+    return std::llround(unixDays * static_cast<double>(MILLIS_PER_DAY));
+}
+
+// --- Arrow C data interface export ---
+
+struct SchemaHolder {
+    std::string format;
+    std::string name;
+    std::vector<ArrowSchema*> children;
+    ArrowSchema* dictionary = nullptr;
+};
+
+void releaseSchema(ArrowSchema* schema) {
+    auto* holder = static_cast<SchemaHolder*>(schema->private_data);
+    for (ArrowSchema* child : holder->children) {
+        if (child->release) {
+            child->release(child);
+        }
+        delete child;
+    }
+    if (holder->dictionary) {
+        if (holder->dictionary->release) {
+            holder->dictionary->release(holder->dictionary);
+        }
+        delete holder->dictionary;
+    }
+    delete holder;
+    schema->release = nullptr;
+}
+
+void initSchema(ArrowSchema* schema, std::string format, std::string name, int64_t flags) {
+    auto* holder = new SchemaHolder{std::move(format), std::move(name), {}, nullptr};
+    schema->format = holder->format.c_str();
+    schema->name = holder->name.c_str();
+    schema->metadata = nullptr;
+    schema->flags = flags;
+    schema->n_children = 0;
+    schema->children = nullptr;
+    schema->dictionary = nullptr;
+    schema->release = &releaseSchema;
+    schema->private_data = holder;
+}
+
+ArrowSchema* addChildSchema(ArrowSchema* parent, std::string format, std::string name, int64_t flags) {
+    auto* holder = static_cast<SchemaHolder*>(parent->private_data);
+    auto* child = new ArrowSchema;
+    initSchema(child, std::move(format), std::move(name), flags);
+    holder->children.push_back(child);
+    parent->n_children = static_cast<int64_t>(holder->children.size());
+    parent->children = holder->children.data();
+    return child;
+}
+
+const char* columnFormat(const Column& column) {
+    switch (column.type) {
+        case ColumnType::Float64: return "g";
+        case ColumnType::Boolean: return "b";
+        case ColumnType::Timestamp: return "tsm:";
+        case ColumnType::Dictionary: return "i";
+        case ColumnType::Utf8: return column.offsets32.empty() && column.length > 0 ? "U" : "u";
+        case ColumnType::Null:
+        default:
+            return "n";
+    }
+}
+
+void exportSchema(const ColumnarTable& table, ArrowSchema* out) {
+    initSchema(out, "+s", "", 0);
+    for (const Column& column : table.columns) {
+        ArrowSchema* child = addChildSchema(out, columnFormat(column), column.name, ARROW_FLAG_NULLABLE);
+        if (column.type == ColumnType::Dictionary) {
+            auto* holder = static_cast<SchemaHolder*>(child->private_data);
+            holder->dictionary = new ArrowSchema;
+            initSchema(holder->dictionary, "u", "", 0);
+            child->dictionary = holder->dictionary;
+        }
+    }
+}
+
+// Array holders keep the whole table alive, so every exported array (and any
+// child a consumer moves out) stays valid until its own release
+struct ArrayHolder {
+    std::shared_ptr<const ColumnarTable> table;
+    const void* buffers[3] = {nullptr, nullptr, nullptr};
+    std::vector<ArrowArray*> children;
+    ArrowArray* dictionary = nullptr;
+};
+
+void releaseArray(ArrowArray* array) {
+    auto* holder = static_cast<ArrayHolder*>(array->private_data);
+    for (ArrowArray* child : holder->children) {
+        if (child->release) {
+            child->release(child);
+        }
+        delete child;
+    }
+    if (holder->dictionary) {
+        if (holder->dictionary->release) {
+            holder->dictionary->release(holder->dictionary);
+        }
+        delete holder->dictionary;
+    }
+    delete holder;
+    array->release = nullptr;
+}
+
+ArrayHolder* initArray(ArrowArray* array, const std::shared_ptr<const ColumnarTable>& table,
+                       int64_t length, int64_t offset, int64_t nullCount, int64_t bufferCount) {
+    auto* holder = new ArrayHolder;
+    holder->table = table;
+    array->length = length;
+    array->null_count = nullCount;
+    array->offset = offset;
+    array->n_buffers = bufferCount;
+    array->n_children = 0;
+    array->buffers = holder->buffers;
+    array->children = nullptr;
+    array->dictionary = nullptr;
+    array->release = &releaseArray;
+    array->private_data = holder;
+    return holder;
+}
+
+void exportColumnSlice(const std::shared_ptr<const ColumnarTable>& table, const Column& column,
+                       size_t offset, size_t length, ArrowArray* out) {
+    const auto arrowLength = static_cast<int64_t>(length);
+    const auto arrowOffset = static_cast<int64_t>(offset);
+    if (column.type == ColumnType::Null) {
+        initArray(out, table, arrowLength, arrowOffset, arrowLength, 0);
+        return;
+    }
+
+    const int64_t nullCount = column.nullCount == 0 ? 0 : column.validity.countZeros(offset, length);
+    const void* validity = column.nullCount == 0 ? nullptr : column.validity.data();
+    switch (column.type) {
+        case ColumnType::Float64: {
+            ArrayHolder* holder = initArray(out, table, arrowLength, arrowOffset, nullCount, 2);
+            holder->buffers[0] = validity;
+            holder->buffers[1] = column.numbers.data();
+            break;
+        }
+        case ColumnType::Boolean: {
+            ArrayHolder* holder = initArray(out, table, arrowLength, arrowOffset, nullCount, 2);
+            holder->buffers[0] = validity;
+            holder->buffers[1] = column.booleans.data();
+            break;
+        }
+        case ColumnType::Timestamp: {
+            ArrayHolder* holder = initArray(out, table, arrowLength, arrowOffset, nullCount, 2);
+            holder->buffers[0] = validity;
+            holder->buffers[1] = column.timestamps.data();
+            break;
+        }
+        case ColumnType::Utf8: {
+            ArrayHolder* holder = initArray(out, table, arrowLength, arrowOffset, nullCount, 3);
+            holder->buffers[0] = validity;
+            holder->buffers[1] = column.offsets32.empty()
+                ? static_cast<const void*>(column.offsets.data())
+                : static_cast<const void*>(column.offsets32.data());
+            holder->buffers[2] = column.text.data();
+            break;
+        }
+        case ColumnType::Dictionary: {
+            ArrayHolder* holder = initArray(out, table, arrowLength, arrowOffset, nullCount, 2);
+            holder->buffers[0] = validity;
+            holder->buffers[1] = column.codes.data();
+            holder->dictionary = new ArrowArray;
+            const auto dictionaryLength = static_cast<int64_t>(column.dictionaryOffsets.size() - 1);
+            ArrayHolder* values = initArray(holder->dictionary, table, dictionaryLength, 0, 0, 3);
+            values->buffers[1] = column.dictionaryOffsets.data();
+            values->buffers[2] = column.dictionaryData.data();
+            out->dictionary = holder->dictionary;
+            break;
+        }
+        case ColumnType::Null:
+            break;
+    }
+}
+
+void exportBatch(const std::shared_ptr<const ColumnarTable>& table, size_t batchIndex, ArrowArray* out) {
+    const size_t offset = batchIndex * table->batchSize;
+    const size_t length = std::min(table->batchSize, table->rowCount - offset);
+    ArrayHolder* holder = initArray(out, table, static_cast<int64_t>(length), 0, 0, 1);
+    holder->children.reserve(table->columns.size());
+    for (const Column& column : table->columns) {
+        auto* child = new ArrowArray;
+        exportColumnSlice(table, column, offset, length, child);
+        holder->children.push_back(child);
+    }
+    out->n_children = static_cast<int64_t>(holder->children.size());
+    out->children = holder->children.data();
+}
+
+struct StreamHolder {
+    std::shared_ptr<const ColumnarTable> table;
+    size_t nextBatch = 0;
+    std::string lastError;
+};
+
+int streamGetSchema(ArrowArrayStream* stream, ArrowSchema* out) {
+    auto* holder = static_cast<StreamHolder*>(stream->private_data);
+    try {
+        exportSchema(*holder->table, out);
+        return 0;
+    } catch (const std::exception& e) {
+        holder->lastError = e.what();
+        return ENOMEM;
+    }
+}
+
+int streamGetNext(ArrowArrayStream* stream, ArrowArray* out) {
+    auto* holder = static_cast<StreamHolder*>(stream->private_data);
+    const ColumnarTable& table = *holder->table;
+    const size_t batchCount = (table.rowCount + table.batchSize - 1) / table.batchSize;
+    if (holder->nextBatch >= batchCount) {
+        out->release = nullptr; // End of stream
+        return 0;
+    }
+    try {
+        exportBatch(holder->table, holder->nextBatch, out);
+        ++holder->nextBatch;
+        return 0;
+    } catch (const std::exception& e) {
+        holder->lastError = e.what();
+        return ENOMEM;
+    }
+}
+
+const char* streamGetLastError(ArrowArrayStream* stream) {
+    auto* holder = static_cast<StreamHolder*>(stream->private_data);
+    return holder->lastError.empty() ? nullptr : holder->lastError.c_str();
+}
+
+void streamRelease(ArrowArrayStream* stream) {
+    delete static_cast<StreamHolder*>(stream->private_data);
+    stream->release = nullptr;
+}
+
+} // namespace
+
+class ColumnarBatchBuilder::Impl {
+public:
+    Impl(const SharedStringsProvider* sharedStrings,
+         const StylesRegistry* styles,
+         DateSystem dateSystem,
+         const void* options,
+         size_t batchSize,
+         bool headerRow)
+        : m_sharedStrings(sharedStrings)
+        , m_styles(styles)
+        , m_dateSystem(dateSystem)
+        , m_options(static_cast<const ::xlsxcsv::CsvOptions*>(options))
+        , m_readFilter(makeSheetReadFilter(options))
+        , m_headerPending(headerRow)
+        , m_table(std::make_shared<ColumnarTable>()) {
+        m_table->batchSize = batchSize > 0 ? batchSize : 65536;
+    }
+
+    void handleRow(const RowData& row) {
+        // Check if row should be skipped due to hidden row filtering
+        if (row.hidden && m_options && !m_options->includeHiddenRows) {
+            return;
+        }
+
+        int maxColumn = 0;
+        for (const auto& cell : row.cells) {
+            maxColumn = std::max(maxColumn, cell.coordinate.column);
+        }
+
+        if (m_headerPending) {
+            m_headerPending = false;
+            for (const auto& cell : row.cells) {
+                if (cell.coordinate.column > 0) {
+                    m_headerNames[cell.coordinate.column] = renderText(cell);
+                }
+            }
+            ensureColumns(maxColumn);
+            return;
+        }
+
+        ensureColumns(maxColumn);
+        std::size_t cellIndex = 0;
+        for (int col = 1; col <= static_cast<int>(m_table->columns.size()); ++col) {
+            const CellData* cell = nullptr;
+            while (cellIndex < row.cells.size() && row.cells[cellIndex].coordinate.column < col) {
+                ++cellIndex;
+            }
+            if (cellIndex < row.cells.size() && row.cells[cellIndex].coordinate.column == col) {
+                cell = &row.cells[cellIndex];
+                ++cellIndex;
+            }
+
+            if (propagateMerges()) {
+                const CellCoordinate coord{row.rowNumber, col};
+                const MergedCellRange* range = m_metadata.findMergedCellRange(coord);
+                if (range) {
+                    if (cell && range->topLeft.row == coord.row && range->topLeft.column == coord.column) {
+                        CellData& cached = m_mergedCellValues[m_metadata.mergedRangeId(*range)];
+                        cached = *cell;
+                        cached.makeOwned(); // The row arena is reused after handleRow
+                    } else if (!cell) {
+                        auto it = m_mergedCellValues.find(m_metadata.mergedRangeId(*range));
+                        if (it != m_mergedCellValues.end()) {
+                            cell = &it->second;
+                        }
+                    }
+                }
+            }
+
+            appendCell(m_table->columns[static_cast<size_t>(col - 1)], cell);
+        }
+        ++m_table->rowCount;
+    }
+
+    void handleError(const std::string& message) {
+        m_errorMessages.push_back(message);
+    }
+
+    void handleWorksheetMetadata(const WorksheetMetadata& metadata) {
+        m_metadata = metadata;
+    }
+
+    void exportStream(ArrowArrayStream* out) {
+        finish();
+        auto* holder = new StreamHolder;
+        holder->table = std::move(m_table);
+        m_table = std::make_shared<ColumnarTable>();
+        out->get_schema = &streamGetSchema;
+        out->get_next = &streamGetNext;
+        out->get_last_error = &streamGetLastError;
+        out->release = &streamRelease;
+        out->private_data = holder;
+    }
+
+    const std::vector<std::string>& getErrors() const {
+        return m_errorMessages;
+    }
+
+    size_t getRowCount() const {
+        return m_table->rowCount;
+    }
+
+private:
+    bool propagateMerges() const {
+        return m_options && m_options->mergedHandling == ::xlsxcsv::CsvOptions::MergedHandling::PROPAGATE;
+    }
+
+    void ensureColumns(int count) {
+        auto& columns = m_table->columns;
+        while (static_cast<int>(columns.size()) < count) {
+            Column column;
+            column.sheetColumn = static_cast<int>(columns.size()) + 1;
+            column.length = m_table->rowCount; // Earlier rows are nulls
+            column.nullCount = m_table->rowCount;
+            columns.push_back(std::move(column));
+        }
+    }
+
+    CellKind classify(const CellData& cell) const {
+        if (cell.isEmpty()) {
+            return CellKind::Null;
+        }
+        switch (cell.type) {
+            case CellType::Boolean:
+                return CellKind::Boolean;
+            case CellType::Error:
+                return CellKind::Null;
+            case CellType::SharedString:
+                if (cell.isSharedStringIndex()) {
+                    // A range check, so lazily decoded strings are not decoded here
+                    const bool known = m_sharedStrings && cell.getSharedStringIndex() >= 0 &&
+                        static_cast<size_t>(cell.getSharedStringIndex()) < m_sharedStrings->getStringCount();
+                    return known ? CellKind::String : CellKind::Null;
+                }
+                return CellKind::String;
+            case CellType::Number:
+                if (!cell.isNumber()) {
+                    return CellKind::Null;
+                }
+                if (m_styles && cell.styleIndex > 0 && m_styles->isDateTimeStyle(cell.styleIndex) &&
+                    !(m_options && m_options->dateMode == ::xlsxcsv::CsvOptions::DateMode::RAW)) {
+                    return CellKind::DateTime;
+                }
+                return CellKind::Number;
+            default:
+                return CellKind::String;
+        }
+    }
+
+    std::string renderText(const CellData& cell) const {
+        if (cell.type == CellType::Number && cell.isNumber() &&
+            m_options && m_options->dateMode == ::xlsxcsv::CsvOptions::DateMode::RAW) {
+            CellData plain = cell;
+            plain.styleIndex = 0; // Raw serials render as plain numbers
+            return formatCellText(plain, m_sharedStrings, m_styles, m_dateSystem, numberMode());
+        }
+        return formatCellText(cell, m_sharedStrings, m_styles, m_dateSystem, numberMode());
+    }
+
+    NumberFormatMode numberMode() const {
+        return (m_options && m_options->numberFormat == ::xlsxcsv::CsvOptions::NumberFormat::SHORTEST)
+            ? NumberFormatMode::Shortest : NumberFormatMode::Fixed6;
+    }
+
+    static ColumnType typeFor(CellKind kind) {
+        switch (kind) {
+            case CellKind::Number: return ColumnType::Float64;
+            case CellKind::Boolean: return ColumnType::Boolean;
+            case CellKind::DateTime: return ColumnType::Timestamp;
+            case CellKind::String: return ColumnType::Dictionary;
+            case CellKind::Null:
+            default:
+                return ColumnType::Null;
+        }
+    }
+
+    // Gives a column of nulls its first real type, back-filling null slots
+    static void assignType(Column& column, ColumnType type) {
+        column.type = type;
+        const size_t rows = column.length;
+        column.validity.appendRepeated(false, rows);
+        switch (type) {
+            case ColumnType::Float64:
+            case ColumnType::Timestamp:
+                column.numbers.assign(rows, 0.0);
+                break;
+            case ColumnType::Boolean:
+                column.booleans.appendRepeated(false, rows);
+                break;
+            case ColumnType::Dictionary:
+                column.codes.assign(rows, 0);
+                break;
+            case ColumnType::Utf8:
+                column.offsets.assign(rows + 1, 0);
+                break;
+            case ColumnType::Null:
+                break;
+        }
+    }
+
+    void appendNull(Column& column) {
+        ++column.length;
+        ++column.nullCount;
+        switch (column.type) {
+            case ColumnType::Null:
+                return;
+            case ColumnType::Float64:
+            case ColumnType::Timestamp:
+                column.numbers.push_back(0.0);
+                break;
+            case ColumnType::Boolean:
+                column.booleans.append(false);
+                break;
+            case ColumnType::Dictionary:
+                column.codes.push_back(0);
+                break;
+            case ColumnType::Utf8:
+                column.offsets.push_back(static_cast<int64_t>(column.text.size()));
+                break;
+        }
+        column.validity.append(false);
+    }
+
+    int32_t dictionaryCode(Column& column, const CellData& cell) {
+        const auto nextCode = static_cast<int32_t>(column.dictionaryEntries.size());
+        if (cell.isSharedStringIndex()) {
+            const auto index = static_cast<size_t>(cell.getSharedStringIndex());
+            auto [it, inserted] = column.sharedToCode.try_emplace(index, nextCode);
+            if (inserted) {
+                column.dictionaryEntries.push_back({nullptr, index}); // Resolved in finish()
+            }
+            return it->second;
+        }
+
+        auto [it, inserted] = column.dictionaryIndex.try_emplace(renderText(cell), nextCode);
+        if (inserted) {
+            column.dictionaryEntries.push_back({&it->first, 0});
+        }
+        return it->second;
+    }
+
+    std::string_view dictionaryText(const Column& column, int32_t code) const {
+        const Column::DictionaryEntry& entry = column.dictionaryEntries[static_cast<size_t>(code)];
+        return entry.text ? std::string_view(*entry.text) : m_sharedStrings->getStringView(entry.sharedIndex);
+    }
+
+    void appendText(Column& column, std::string_view value) {
+        column.text.append(value);
+        column.offsets.push_back(static_cast<int64_t>(column.text.size()));
+    }
+
+    // Re-renders a typed column as CSV text once it turns out to mix kinds
+    void convertToUtf8(Column& column) {
+        std::vector<int64_t> offsets{0};
+        offsets.reserve(column.length + 1);
+        std::string text;
+        for (size_t i = 0; i < column.length; ++i) {
+            if (column.validity.get(i)) {
+                CellData cell;
+                switch (column.type) {
+                    case ColumnType::Float64:
+                        cell.type = CellType::Number;
+                        cell.value = column.numbers[i];
+                        break;
+                    case ColumnType::Timestamp:
+                        cell.type = CellType::Number;
+                        cell.value = column.numbers[i];
+                        cell.styleIndex = column.dateStyle;
+                        break;
+                    case ColumnType::Boolean:
+                        cell.type = CellType::Boolean;
+                        cell.value = column.booleans.get(i);
+                        break;
+                    case ColumnType::Dictionary:
+                        cell.type = CellType::String;
+                        cell.value = dictionaryText(column, column.codes[i]);
+                        break;
+                    default:
+                        break;
+                }
+                text.append(renderText(cell));
+            }
+            offsets.push_back(static_cast<int64_t>(text.size()));
+        }
+        column.numbers = {};
+        column.booleans = {};
+        column.codes = {};
+        column.dictionaryIndex = {};
+        column.dictionaryEntries = {};
+        column.sharedToCode = {};
+        column.offsets = std::move(offsets);
+        column.text = std::move(text);
+        column.type = ColumnType::Utf8;
+    }
+
+    void appendCell(Column& column, const CellData* cell) {
+        const CellKind kind = cell ? classify(*cell) : CellKind::Null;
+        if (kind == CellKind::Null) {
+            appendNull(column);
+            return;
+        }
+
+        const ColumnType wanted = typeFor(kind);
+        if (column.type == ColumnType::Null) {
+            assignType(column, wanted);
+        } else if (column.type != wanted && column.type != ColumnType::Utf8) {
+            convertToUtf8(column);
+        }
+
+        switch (column.type) {
+            case ColumnType::Float64:
+                column.numbers.push_back(cell->getNumber());
+                break;
+            case ColumnType::Timestamp:
+                column.numbers.push_back(cell->getNumber());
+                column.dateStyle = cell->styleIndex;
+                break;
+            case ColumnType::Boolean:
+                column.booleans.append(cell->getBoolean());
+                break;
+            case ColumnType::Dictionary:
+                column.codes.push_back(dictionaryCode(column, *cell));
+                break;
+            case ColumnType::Utf8:
+                if (cell->isSharedStringIndex()) {
+                    appendText(column, *m_sharedStrings->tryGetStringView(
+                        static_cast<size_t>(cell->getSharedStringIndex())));
+                } else {
+                    appendText(column, renderText(*cell));
+                }
+                break;
+            case ColumnType::Null:
+                break;
+        }
+        column.validity.append(true);
+        ++column.length;
+    }
+
+    // Settles names, drops hidden and unselected columns and lays out the final buffers
+    void finish() {
+        auto& columns = m_table->columns;
+        const bool dropHidden = m_options && !m_options->includeHiddenColumns;
+        if (dropHidden || m_readFilter.selectsColumns()) {
+            columns.erase(std::remove_if(columns.begin(), columns.end(), [&](const Column& column) {
+                return (dropHidden && m_metadata.isColumnHidden(column.sheetColumn)) ||
+                       !m_readFilter.keepsColumn(column.sheetColumn);
+            }), columns.end());
+        }
+
+        for (Column& column : columns) {
+            auto header = m_headerNames.find(column.sheetColumn);
+            column.name = header != m_headerNames.end() && !header->second.empty()
+                ? header->second : columnLetters(column.sheetColumn);
+
+            switch (column.type) {
+                case ColumnType::Timestamp:
+                    column.timestamps.reserve(column.numbers.size());
+                    for (double serial : column.numbers) {
+                        column.timestamps.push_back(serialToUnixMillis(serial, m_dateSystem));
+                    }
+                    column.numbers = {};
+                    break;
+                case ColumnType::Utf8:
+                    if (column.text.size() <= static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+                        column.offsets32.assign(column.offsets.begin(), column.offsets.end());
+                        column.offsets = {};
+                    }
+                    break;
+                case ColumnType::Dictionary:
+                    finishDictionary(column);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    // Lays out the dictionary values, resolving each shared string once.
+    // Entries with the same text (repeated <si> items, or a shared and an
+    // inline string) are merged so the dictionary stays unique.
+    void finishDictionary(Column& column) const {
+        const size_t entries = column.dictionaryEntries.size();
+        std::unordered_map<std::string_view, int32_t> unique;
+        unique.reserve(entries);
+        std::vector<int32_t> remap(entries);
+        bool merged = false;
+        column.dictionaryOffsets.reserve(entries + 1);
+        column.dictionaryOffsets.push_back(0);
+        for (size_t code = 0; code < entries; ++code) {
+            const std::string_view value = dictionaryText(column, static_cast<int32_t>(code));
+            auto [it, inserted] = unique.try_emplace(value, static_cast<int32_t>(column.dictionaryOffsets.size() - 1));
+            remap[code] = it->second;
+            if (!inserted) {
+                merged = true;
+                continue;
+            }
+            column.dictionaryData.append(value);
+            if (column.dictionaryData.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+                throw XlsxError("Column " + column.name + " has more than 2 GB of distinct strings");
+            }
+            column.dictionaryOffsets.push_back(static_cast<int32_t>(column.dictionaryData.size()));
+        }
+        if (merged) {
+            for (int32_t& code : column.codes) {
+                code = remap[static_cast<size_t>(code)];
+            }
+        }
+        column.dictionaryIndex = {};
+        column.dictionaryEntries = {};
+        column.sharedToCode = {};
+    }
+
+    const SharedStringsProvider* m_sharedStrings;
+    const StylesRegistry* m_styles;
+    DateSystem m_dateSystem;
+    const ::xlsxcsv::CsvOptions* m_options;
+    SheetReadFilter m_readFilter; // Column selection; the reader already applied the row range
+    bool m_headerPending;
+
+    std::shared_ptr<ColumnarTable> m_table;
+    WorksheetMetadata m_metadata;
+    std::unordered_map<int, std::string> m_headerNames;
+    std::unordered_map<size_t, CellData> m_mergedCellValues; // By merged range id
+    std::vector<std::string> m_errorMessages;
+};
+
+// ColumnarBatchBuilder PIMPL wrapper
+ColumnarBatchBuilder::ColumnarBatchBuilder(const SharedStringsProvider* sharedStrings,
+                                           const StylesRegistry* styles,
+                                           DateSystem dateSystem,
+                                           const void* csvOptions,
+                                           size_t batchSize,
+                                           bool headerRow)
+    : m_impl(std::make_unique<Impl>(sharedStrings, styles, dateSystem, csvOptions, batchSize, headerRow)) {
+}
+
+ColumnarBatchBuilder::~ColumnarBatchBuilder() = default;
+
+void ColumnarBatchBuilder::handleRow(const RowData& row) {
+    m_impl->handleRow(row);
+}
+
+void ColumnarBatchBuilder::handleError(const std::string& message) {
+    m_impl->handleError(message);
+}
+
+void ColumnarBatchBuilder::handleWorksheetMetadata(const WorksheetMetadata& metadata) {
+    m_impl->handleWorksheetMetadata(metadata);
+}
+
+void ColumnarBatchBuilder::exportStream(::ArrowArrayStream* out) {
+    m_impl->exportStream(out);
+}
+
+const std::vector<std::string>& ColumnarBatchBuilder::getErrors() const {
+    return m_impl->getErrors();
+}
+
+size_t ColumnarBatchBuilder::getRowCount() const {
+    return m_impl->getRowCount();
+}
+
+} // namespace xlsxcsv::core
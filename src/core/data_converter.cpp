@@ -1,99 +1,130 @@
 #include "xlsxcsv/core.hpp"
 #include "xlsxcsv.hpp"  // For CsvOptions
-#include <sstream>
-#include <iomanip>
 #include <cmath>
-#include <chrono>
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <optional>
 #include <unordered_map>
 
 namespace xlsxcsv::core {
 
 // Excel date constants
-[[maybe_unused]] constexpr double EXCEL_EPOCH_1900 = 1.0;    // January 1, 1900 (Excel day 1)
-constexpr double EXCEL_EPOCH_1904 = 1462.0; // January 1, 1904 (Mac Excel)
-constexpr double SECONDS_PER_DAY = 86400.0;
+constexpr int64_t SECONDS_PER_DAY = 86400;
+constexpr int64_t MAX_EXCEL_SERIAL_DAY = 2958465;    // 9999-12-31, the last day Excel renders
+constexpr int64_t EXCEL_1900_PHANTOM_LEAP_DAY = 60;  // Serial of the nonexistent 1900-02-29
+constexpr int64_t UNIX_DAYS_BEFORE_1900_LEAP_BUG = 25568; // Serial 1 = 1900-01-01
+constexpr int64_t UNIX_DAYS_AFTER_1900_LEAP_BUG = 25569;  // Serial 61 = 1900-03-01
+constexpr int64_t UNIX_DAYS_1904 = 24107;                 // Serial 0 = 1904-01-01
 
-// Date conversion class
+// Date conversion class. Serials are converted with integer civil-calendar
+// arithmetic and written as fixed-width ISO 8601 text; which parts are shown
+// is decided per style by StylesRegistry::getDateTimeKind.
 class DateConverter {
 public:
-    static std::string convertExcelSerial(double serialDate, 
-                                         DateSystem dateSystem,
-                                         [[maybe_unused]] const std::string& formatCode = "") {
-        
-        // Handle zero and negative values
-        if (serialDate <= 0.0) {
-            return "1900-01-01";
-        }
-        
-        // Adjust for date system
-        double adjustedSerial = serialDate;
-        if (dateSystem == DateSystem::Date1904) {
-            adjustedSerial += EXCEL_EPOCH_1904;
-        }
-        
-        // Excel 1900 date system has a bug - it considers 1900 a leap year
-        // We need to account for this when converting
-        if (dateSystem == DateSystem::Date1900 && serialDate >= 60.0) {
-            adjustedSerial -= 1.0; // Account for the phantom Feb 29, 1900
+    // Longest output is "YYYY-MM-DDTHH:MM:SS"
+    static constexpr size_t DATE_BUFFER_SIZE = 19;
+
+    // Writes the serial into buffer and returns the text, or an empty view for
+    // serials outside Excel's date range (negative or after 9999-12-31)
+    static std::string_view formatExcelSerial(char (&buffer)[DATE_BUFFER_SIZE],
+                                              double serialDate,
+                                              DateSystem dateSystem,
+                                              DateTimeKind kind) {
+        if (!(serialDate >= 0.0) || serialDate >= static_cast<double>(MAX_EXCEL_SERIAL_DAY + 1)) {
+            return {};
         }
         
-        // Convert to days since Unix epoch (January 1, 1970)
-        // Excel epoch 1900 = December 30, 1899 (not January 1, 1900 due to the bug)
-        constexpr double DAYS_BETWEEN_1899_AND_1970 = 25567.0;
-        double daysSinceUnixEpoch = adjustedSerial - DAYS_BETWEEN_1899_AND_1970;
-        
-        // Convert to seconds and create time_point
-        int64_t secondsSinceEpoch = static_cast<int64_t>(daysSinceUnixEpoch * SECONDS_PER_DAY);
-        auto timePoint = std::chrono::system_clock::from_time_t(secondsSinceEpoch);
-        
-        // Get fractional part for time
-        double fractionalPart = adjustedSerial - std::floor(adjustedSerial);
-        int hours = static_cast<int>(fractionalPart * 24.0);
-        int minutes = static_cast<int>((fractionalPart * 24.0 - hours) * 60.0);
-        int seconds = static_cast<int>(((fractionalPart * 24.0 - hours) * 60.0 - minutes) * 60.0);
-        
-        // Convert to tm structure for formatting
-        time_t timeT = std::chrono::system_clock::to_time_t(timePoint);
-        std::tm* tm = std::gmtime(&timeT);
+        // Round to the nearest second so 0.9999999 of a day shows as the next midnight
+        const int64_t totalSeconds = std::llround(serialDate * static_cast<double>(SECONDS_PER_DAY));
+        const int64_t serialDay = totalSeconds / SECONDS_PER_DAY;
+        const int64_t secondOfDay = totalSeconds % SECONDS_PER_DAY;
         
-        if (!tm) {
-            return "1900-01-01";
+        // Durations of a day or more cannot be shown as a bare time of day
+        if (kind == DateTimeKind::Time && serialDay > 0) {
+            kind = DateTimeKind::DateTime;
         }
         
-        // Override time components with calculated values
-        tm->tm_hour = hours;
-        tm->tm_min = minutes;
-        tm->tm_sec = seconds;
-        
-        // Determine output format based on format code analysis
-        bool hasDatePart = fractionalPart < 0.999;  // Has date if not purely time
-        bool hasTimePart = fractionalPart > 0.001;  // Has time if significant fractional part
-        
-        std::ostringstream oss;
-        
-        if (hasDatePart && hasTimePart) {
-            // Date and time
-            oss << std::put_time(tm, "%Y-%m-%dT%H:%M:%S");
-        } else if (hasTimePart) {
-            // Time only
-            oss << std::put_time(tm, "%H:%M:%S");
-        } else {
-            // Date only
-            oss << std::put_time(tm, "%Y-%m-%d");
+        char* out = buffer;
+        if (kind != DateTimeKind::Time) {
+            int64_t year = 0;
+            unsigned month = 0;
+            unsigned day = 0;
+            if (dateSystem == DateSystem::Date1900 && serialDay == EXCEL_1900_PHANTOM_LEAP_DAY) {
+                // Excel treats 1900 as a leap year; keep its phantom day rather than shifting it
+                year = 1900;
+                month = 2;
+                day = 29;
+            } else {
+                int64_t unixDay = 0;
+                if (dateSystem == DateSystem::Date1904) {
+                    unixDay = serialDay - UNIX_DAYS_1904;
+                } else if (serialDay < EXCEL_1900_PHANTOM_LEAP_DAY) {
+                    unixDay = serialDay - UNIX_DAYS_BEFORE_1900_LEAP_BUG;
+                } else {
+                    unixDay = serialDay - UNIX_DAYS_AFTER_1900_LEAP_BUG;
+                }
+                civilFromDays(unixDay, year, month, day);
+            }
+            if (year > 9999) {
+                return {}; // Only reachable through the 1904 offset
+            }
+            out = writeDigits(out, static_cast<unsigned>(year), 4);
+            *out++ = '-';
+            out = writeDigits(out, month, 2);
+            *out++ = '-';
+            out = writeDigits(out, day, 2);
+            if (kind == DateTimeKind::Date) {
+                return std::string_view(buffer, static_cast<size_t>(out - buffer));
+            }
+            *out++ = 'T';
         }
         
-        return oss.str();
+        const auto seconds = static_cast<unsigned>(secondOfDay);
+        out = writeDigits(out, seconds / 3600, 2);
+        *out++ = ':';
+        out = writeDigits(out, (seconds / 60) % 60, 2);
+        *out++ = ':';
+        out = writeDigits(out, seconds % 60, 2);
+        return std::string_view(buffer, static_cast<size_t>(out - buffer));
+    }
+
+private:
+    // Days since 1970-01-01 to a proleptic Gregorian date (H. Hinnant's civil_from_days)
+    static void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+        days += 719468;
+        const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const auto dayOfEra = static_cast<unsigned>(days - era * 146097);
+        const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const unsigned monthIndex = (5 * dayOfYear + 2) / 153; // March-based
+        day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+        month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+        year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0);
     }
     
+    static char* writeDigits(char* out, unsigned value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        return out + width;
+    }
 };
 
 // Main data conversion class
 class DataConverter {
 public:
+    // Large enough for the fixed notation of any finite double (309 integer
+    // digits, a sign, the point and six decimals)
+    static constexpr size_t NUMBER_BUFFER_SIZE = 400;
+    using NumberBuffer = char[NUMBER_BUFFER_SIZE];
+
     static std::string convertCellValue(const CellData& cell,
                                        const SharedStringsProvider* sharedStrings,
                                        const StylesRegistry* styles,
-                                       DateSystem dateSystem = DateSystem::Date1900) {
+                                       DateSystem dateSystem = DateSystem::Date1900,
+                                       NumberFormatMode numberMode = NumberFormatMode::Fixed6) {
         
         // Handle empty cells
         if (cell.isEmpty()) {
@@ -120,7 +151,7 @@ public:
                 return cell.getString(); // Fallback to resolved string
                 
             case CellType::Number:
-                return convertNumericValue(cell.getNumber(), cell.styleIndex, styles, dateSystem);
+                return convertNumericValue(cell.getNumber(), cell.styleIndex, styles, dateSystem, numberMode);
                 
             case CellType::Unknown:
             default:
@@ -128,6 +159,45 @@ public:
         }
     }
 
+    // Formats a number that is not date-styled into buffer and returns a view
+    // of the text (or of a static literal for NaN and infinities)
+    static std::string_view formatNumericValue(NumberBuffer& buffer, double value, NumberFormatMode mode) {
+        // Handle special cases
+        if (std::isnan(value)) return "#NUM!";
+        if (std::isinf(value)) return value > 0 ? "#DIV/0!" : "-#DIV/0!";
+        
+        char* const begin = buffer;
+        char* const end = buffer + NUMBER_BUFFER_SIZE;
+        
+        // Check if it's effectively an integer
+        if (value == std::floor(value) && std::abs(value) < 1e15) {
+            auto result = std::to_chars(begin, end, static_cast<long long>(value));
+            return std::string_view(begin, static_cast<size_t>(result.ptr - begin));
+        }
+        
+        if (mode == NumberFormatMode::Shortest) {
+            auto result = std::to_chars(begin, end, value);
+            return std::string_view(begin, static_cast<size_t>(result.ptr - begin));
+        }
+        
+        auto result = std::to_chars(begin, end, value, std::chars_format::fixed, 6);
+        const char* last = result.ptr;
+        
+        // Remove trailing zeros and decimal point if not needed
+        while (last[-1] == '0') {
+            --last;
+        }
+        if (last[-1] == '.') {
+            --last;
+        }
+        return std::string_view(begin, static_cast<size_t>(last - begin));
+    }
+    
+    static std::string formatNumericValue(double value, NumberFormatMode mode = NumberFormatMode::Fixed6) {
+        NumberBuffer buffer;
+        return std::string(formatNumericValue(buffer, value, mode));
+    }
+
 private:
     static std::string formatErrorValue(const std::string& errorCode) {
         // Return Excel error codes as-is
@@ -138,42 +208,21 @@ private:
     static std::string convertNumericValue(double value, 
                                          int styleIndex,
                                          const StylesRegistry* styles,
-                                         DateSystem dateSystem) {
+                                         DateSystem dateSystem,
+                                         NumberFormatMode numberMode) {
         
         // Check if this should be formatted as a date/time
-        if (styles && styleIndex > 0 && styles->isDateTimeStyle(styleIndex)) {
-            return DateConverter::convertExcelSerial(value, dateSystem);
-        }
-        
-        // Format as regular number
-        return formatNumericValue(value);
-    }
-    
-    static std::string formatNumericValue(double value) {
-        // Handle special cases
-        if (std::isnan(value)) return "#NUM!";
-        if (std::isinf(value)) return value > 0 ? "#DIV/0!" : "-#DIV/0!";
-        
-        // Check if it's effectively an integer
-        if (value == std::floor(value) && std::abs(value) < 1e15) {
-            // Format as integer
-            return std::to_string(static_cast<long long>(value));
-        }
-        
-        // Use stream formatting for maximum standard-library portability.
-        std::ostringstream oss;
-        oss << std::fixed << std::setprecision(6) << value;
-        std::string result = oss.str();
-        
-        // Remove trailing zeros and decimal point if not needed
-        if (result.find('.') != std::string::npos) {
-            result.erase(result.find_last_not_of('0') + 1);
-            if (result.back() == '.') {
-                result.pop_back();
+        const DateTimeKind kind = styles && styleIndex > 0 ? styles->getDateTimeKind(styleIndex) : DateTimeKind::None;
+        if (kind != DateTimeKind::None) {
+            char buffer[DateConverter::DATE_BUFFER_SIZE];
+            const std::string_view date = DateConverter::formatExcelSerial(buffer, value, dateSystem, kind);
+            if (!date.empty()) {
+                return std::string(date);
             }
         }
         
-        return result;
+        // Format as regular number (also used for serials outside the date range)
+        return formatNumericValue(value, numberMode);
     }
 };
 
@@ -183,17 +232,34 @@ public:
     explicit CsvRowCollectorImpl(const SharedStringsProvider* sharedStrings = nullptr,
                                const StylesRegistry* styles = nullptr,
                                DateSystem dateSystem = DateSystem::Date1900,
-                               const void* options = nullptr)
+                               const void* options = nullptr,
+                               ::xlsxcsv::OutputSink* sink = nullptr)
         : m_sharedStrings(sharedStrings)
         , m_styles(styles) 
         , m_dateSystem(dateSystem)
-        , m_options(static_cast<const ::xlsxcsv::CsvOptions*>(options)) {
+        , m_options(static_cast<const ::xlsxcsv::CsvOptions*>(options))
+        , m_sink(sink)
+        , m_readFilter(makeSheetReadFilter(options))
+        , m_encoder(options) {
+        
+        m_numberMode = (m_options && m_options->numberFormat == ::xlsxcsv::CsvOptions::NumberFormat::SHORTEST)
+            ? NumberFormatMode::Shortest : NumberFormatMode::Fixed6;
+        // Finite numbers only contain these characters, so unless one of them
+        // is the delimiter they never need quoting
+        m_numbersNeedNoQuoting = std::string_view("0123456789.-+e").find(m_encoder.delimiter()) == std::string_view::npos;
+        m_datesNeedNoQuoting = std::string_view("0123456789-:T").find(m_encoder.delimiter()) == std::string_view::npos;
         
-        // Set delimiter from options or default
-        m_delimiter = (m_options && m_options->delimiter != '\0') ? m_options->delimiter : ',';
+        if (m_sink) {
+            m_csvOutput.reserve(OUTPUT_BLOCK_SIZE + OUTPUT_BLOCK_SLACK);
+        }
+        m_encoder.appendBom(m_csvOutput);
     }
     
     void handleRow(const RowData& row) {
+        for (const auto& cell : row.cells) {
+            ++m_counters.cellsByType[static_cast<size_t>(cell.type)];
+        }
+        
         // Check if row should be skipped due to hidden row filtering
         if (row.hidden && m_options && !m_options->includeHiddenRows) {
             return; // Skip hidden row
@@ -201,8 +267,7 @@ public:
         
         if (row.cells.empty()) {
             // Empty row
-            m_csvOutput.push_back('\n');
-            ++m_rowCount;
+            endRow();
             return;
         }
 
@@ -222,6 +287,9 @@ public:
             if (m_worksheetMetadata.isColumnHidden(col) && m_options && !m_options->includeHiddenColumns) {
                 continue; // Skip hidden column
             }
+            if (!m_readFilter.keepsColumn(col)) {
+                continue; // Not among the selected columns
+            }
 
             const CellData* cell = nullptr;
             while (cellIndex < row.cells.size() && row.cells[cellIndex].coordinate.column < col) {
@@ -233,9 +301,41 @@ public:
             }
 
             std::string cellValue;
+            DataConverter::NumberBuffer numberBuffer;
+            char dateBuffer[DateConverter::DATE_BUFFER_SIZE];
+            std::string_view field;
+            bool fieldIsPlain = false;
+            size_t sharedIndex = NO_SHARED_INDEX;
 
             if (cell) {
-                cellValue = DataConverter::convertCellValue(*cell, m_sharedStrings, m_styles, m_dateSystem);
+                // Shared strings are escaped straight out of the arena when possible
+                std::optional<std::string_view> sharedView;
+                if (m_sharedStrings && cell->isSharedStringIndex()) {
+                    ++m_counters.sharedStringLookups;
+                    sharedIndex = static_cast<size_t>(cell->getSharedStringIndex());
+                    sharedView = m_sharedStrings->tryGetStringView(sharedIndex);
+                }
+                if (sharedView.has_value()) {
+                    field = *sharedView;
+                } else if (cell->type == CellType::Number && cell->isNumber()) {
+                    // Numbers and dates are formatted on the stack and copied straight into the output
+                    const double number = cell->getNumber();
+                    const DateTimeKind kind = dateTimeKind(*cell);
+                    if (kind != DateTimeKind::None) {
+                        field = DateConverter::formatExcelSerial(dateBuffer, number, m_dateSystem, kind);
+                        fieldIsPlain = m_datesNeedNoQuoting;
+                    }
+                    if (field.empty()) {
+                        field = DataConverter::formatNumericValue(numberBuffer, number, m_numberMode);
+                        fieldIsPlain = m_numbersNeedNoQuoting && std::isfinite(number);
+                    }
+                } else if (cell->isString() && cell->type != CellType::Error) {
+                    // Inline and formula strings are escaped straight out of the row arena
+                    field = cell->getText();
+                } else {
+                    cellValue = DataConverter::convertCellValue(*cell, m_sharedStrings, m_styles, m_dateSystem, m_numberMode);
+                    field = cellValue;
+                }
 
                 // If this cell is the top-left of a merged range, cache its value
                 if (m_options && m_options->mergedHandling == ::xlsxcsv::CsvOptions::MergedHandling::PROPAGATE) {
@@ -243,23 +343,28 @@ public:
                     if (mergedRange && mergedRange->topLeft.row == cell->coordinate.row && 
                         mergedRange->topLeft.column == cell->coordinate.column) {
                         // This is the top-left cell of a merged range - cache the value
-                        m_mergedCellValues[mergedRange->toReference()] = cellValue;
+                        m_mergedCellValues[m_worksheetMetadata.mergedRangeId(*mergedRange)] = std::string(field);
                     }
                 }
             } else {
                 // Check for merged cell propagation
-                cellValue = handleMergedCell(CellCoordinate{row.rowNumber, col});
+                field = handleMergedCell(CellCoordinate{row.rowNumber, col});
             }
 
             if (!firstField) {
-                m_csvOutput.push_back(m_delimiter);
+                m_encoder.appendDelimiter(m_csvOutput);
             }
             firstField = false;
-            appendEscapedCsvField(cellValue);
+            if (fieldIsPlain) {
+                m_encoder.appendPlainField(m_csvOutput, field);
+            } else if (sharedIndex != NO_SHARED_INDEX && !field.empty()) {
+                appendSharedStringField(sharedIndex, field);
+            } else {
+                m_encoder.appendField(m_csvOutput, field);
+            }
         }
 
-        m_csvOutput.push_back('\n');
-        ++m_rowCount;
+        endRow();
     }
     
     void handleError(const std::string& message) {
@@ -270,10 +375,29 @@ public:
         m_worksheetMetadata = metadata;
     }
     
+    void finish() {
+        if (m_sink) {
+            flushToSink();
+            m_sink->flush();
+        }
+    }
+    
     std::string getCsvString() const {
         return m_csvOutput;
     }
     
+    std::string takeCsvString() {
+        m_flushedBytes += m_csvOutput.size();
+        std::string csv = std::move(m_csvOutput);
+        m_csvOutput = std::string();
+        updateMemoryCharge();
+        return csv;
+    }
+    
+    size_t getBytesWritten() const {
+        return m_flushedBytes + m_csvOutput.size();
+    }
+    
     const std::vector<std::string>& getErrors() const {
         return m_errorMessages;
     }
@@ -281,31 +405,168 @@ public:
     size_t getRowCount() const {
         return m_rowCount;
     }
+    
+    const CsvCollectorCounters& getCounters() const {
+        return m_counters;
+    }
+    
+    // Options for chunk collectors: the BOM belongs to the start of the output only
+    const ::xlsxcsv::CsvOptions* chunkOptions() {
+        if (!m_options) {
+            return nullptr;
+        }
+        if (!m_chunkOptions) {
+            m_chunkOptions = *m_options;
+            m_chunkOptions->includeBom = false;
+        }
+        return &*m_chunkOptions;
+    }
+    
+    bool canSplitRows(const WorksheetMetadata& metadata) const {
+        // Propagated values would have to flow from one chunk into the next
+        return !(m_options && m_options->mergedHandling == ::xlsxcsv::CsvOptions::MergedHandling::PROPAGATE &&
+                 !metadata.mergedCells.empty());
+    }
+    
+    void appendChunk(CsvRowCollectorImpl& chunk) {
+        if (m_sink) {
+            // Whole chunks go straight to the sink instead of through the block buffer
+            flushToSink();
+            if (!chunk.m_csvOutput.empty()) {
+                m_sink->write(chunk.m_csvOutput.data(), chunk.m_csvOutput.size());
+                m_flushedBytes += chunk.m_csvOutput.size();
+            }
+        } else {
+            m_csvOutput.append(chunk.m_csvOutput);
+        }
+        chunk.m_csvOutput = std::string();
+        chunk.updateMemoryCharge();
+        updateMemoryCharge();
+        m_rowCount += chunk.m_rowCount;
+        for (size_t type = 0; type < std::size(m_counters.cellsByType); ++type) {
+            m_counters.cellsByType[type] += chunk.m_counters.cellsByType[type];
+        }
+        m_counters.sharedStringLookups += chunk.m_counters.sharedStringLookups;
+        m_errorMessages.insert(m_errorMessages.end(),
+                               std::make_move_iterator(chunk.m_errorMessages.begin()),
+                               std::make_move_iterator(chunk.m_errorMessages.end()));
+        for (auto& [rangeId, value] : chunk.m_mergedCellValues) {
+            m_mergedCellValues.insert_or_assign(rangeId, std::move(value));
+        }
+        m_worksheetMetadata = std::move(chunk.m_worksheetMetadata);
+    }
+    
+    // Chunk collectors live alongside several others, so they only cache
+    // the CSV form of tables small enough to duplicate per chunk
+    void limitSharedFormCache() { m_sharedFormCacheLimit = CHUNK_SHARED_FORM_STRINGS; }
+    
+    void setMemoryTracker(MemoryTracker* tracker) {
+        m_memoryCharge.emplace(tracker);
+        updateMemoryCharge();
+    }
+    MemoryTracker* memoryTracker() const { return m_memoryCharge ? m_memoryCharge->tracker() : nullptr; }
+    
+    const SharedStringsProvider* sharedStrings() const { return m_sharedStrings; }
+    const StylesRegistry* styles() const { return m_styles; }
+    DateSystem dateSystem() const { return m_dateSystem; }
 
 private:
-    void appendEscapedCsvField(const std::string& field) {
-        // Check if field needs quoting
-        bool needsQuoting = field.find(m_delimiter) != std::string::npos ||
-                           field.find('"') != std::string::npos ||
-                           field.find('\n') != std::string::npos ||
-                           field.find('\r') != std::string::npos;
-
-        if (!needsQuoting) {
-            m_csvOutput.append(field);
+    // Rows are handed to the sink in blocks of roughly this size; a block is
+    // only flushed at a row boundary, so it may overshoot by one row.
+    static constexpr size_t OUTPUT_BLOCK_SIZE = 256 * 1024;
+    static constexpr size_t OUTPUT_BLOCK_SLACK = 4 * 1024;
+    
+    static constexpr size_t NO_SHARED_INDEX = SIZE_MAX;
+    
+    // Values of m_sharedForms; larger values are FIRST_CACHED_FORM plus the
+    // string's entry in m_escapedOffsets
+    static constexpr uint32_t UNKNOWN_FORM = 0;
+    static constexpr uint32_t PLAIN_FORM = 1;          // Copied as is
+    static constexpr uint32_t QUOTED_FORM = 2;         // Needs quoting, escaped on every use
+    static constexpr uint32_t FIRST_CACHED_FORM = 3;   // Escaped bytes kept in m_escapedBytes
+    static constexpr size_t MAX_SHARED_FORM_STRINGS = 16 * 1024 * 1024;  // 64 MiB of forms
+    static constexpr size_t CHUNK_SHARED_FORM_STRINGS = 1024 * 1024;     // 4 MiB per chunk
+    static constexpr size_t MAX_ESCAPED_BYTES = 64 * 1024 * 1024;
+    
+    DateTimeKind dateTimeKind(const CellData& cell) const {
+        return m_styles && cell.styleIndex > 0 ? m_styles->getDateTimeKind(cell.styleIndex) : DateTimeKind::None;
+    }
+    
+    void endRow() {
+        m_encoder.appendRowEnd(m_csvOutput);
+        ++m_rowCount;
+        if (m_sink && m_csvOutput.size() >= OUTPUT_BLOCK_SIZE) {
+            flushToSink();
+        }
+        updateMemoryCharge();
+    }
+    
+    // Buffers only grow between rows, so charging them once a row keeps the
+    // tracker within a row of the truth
+    void updateMemoryCharge() {
+        if (m_memoryCharge) {
+            m_memoryCharge->resize(m_csvOutput.capacity() + m_escapedBytes.capacity() +
+                                   m_sharedForms.capacity() * sizeof(uint32_t) +
+                                   m_escapedOffsets.capacity() * sizeof(size_t));
+        }
+    }
+    
+    void flushToSink() {
+        if (m_csvOutput.empty()) {
             return;
         }
-
-        m_csvOutput.push_back('"');
-        for (char ch : field) {
-            if (ch == '"') {
-                m_csvOutput.push_back('"');
+        m_sink->write(m_csvOutput.data(), m_csvOutput.size());
+        m_flushedBytes += m_csvOutput.size();
+        m_csvOutput.clear(); // Keeps capacity, so the block buffer is reused
+    }
+    
+    // Shared strings repeat, so each one is classified (and, when it needs
+    // quoting, escaped) on first use; later uses are a single append
+    void appendSharedStringField(size_t index, std::string_view text) {
+        if (m_sharedForms.empty()) {
+            const size_t count = m_sharedStrings->getStringCount();
+            if (count > m_sharedFormCacheLimit) {
+                m_encoder.appendField(m_csvOutput, text);
+                return;
             }
-            m_csvOutput.push_back(ch);
+            m_sharedForms.assign(count, UNKNOWN_FORM);
+        }
+        
+        uint32_t& form = m_sharedForms[index];
+        if (form == UNKNOWN_FORM) {
+            form = classifySharedString(text);
+        }
+        if (form == PLAIN_FORM) {
+            m_encoder.appendPlainField(m_csvOutput, text);
+        } else if (form == QUOTED_FORM) {
+            CsvEncoder::appendQuoted(m_csvOutput, text);
+        } else {
+            const size_t entry = form - FIRST_CACHED_FORM;
+            const size_t begin = m_escapedOffsets[entry];
+            m_csvOutput.append(m_escapedBytes, begin, m_escapedOffsets[entry + 1] - begin);
+        }
+    }
+    
+    uint32_t classifySharedString(std::string_view text) {
+        if (!m_encoder.needsQuoting(text)) {
+            return PLAIN_FORM;
         }
-        m_csvOutput.push_back('"');
+        // Worst case every character is a quote, doubled, plus the enclosing pair
+        const bool fits = m_escapedBytes.size() + 2 * text.size() + 2 <= MAX_ESCAPED_BYTES &&
+                          m_escapedOffsets.size() < UINT32_MAX - FIRST_CACHED_FORM;
+        if (!fits) {
+            return QUOTED_FORM;
+        }
+        if (m_escapedOffsets.empty()) {
+            m_escapedOffsets.push_back(0);
+        }
+        CsvEncoder::appendQuoted(m_escapedBytes, text);
+        m_escapedOffsets.push_back(m_escapedBytes.size());
+        return FIRST_CACHED_FORM + static_cast<uint32_t>(m_escapedOffsets.size() - 2);
     }
     
-    std::string handleMergedCell(const CellCoordinate& coord) {
+    // The view points into m_mergedCellValues, whose nodes never move
+    std::string_view handleMergedCell(const CellCoordinate& coord) {
         // Check if merged cell propagation is enabled
         if (!m_options || m_options->mergedHandling != ::xlsxcsv::CsvOptions::MergedHandling::PROPAGATE) {
             return ""; // No propagation, return empty
@@ -318,7 +579,7 @@ private:
         }
         
         // Look for cached value for this merged range
-        auto it = m_mergedCellValues.find(mergedRange->toReference());
+        auto it = m_mergedCellValues.find(m_worksheetMetadata.mergedRangeId(*mergedRange));
         if (it != m_mergedCellValues.end()) {
             return it->second; // Return cached value
         }
@@ -334,15 +595,92 @@ private:
     const StylesRegistry* m_styles;
     DateSystem m_dateSystem;
     const ::xlsxcsv::CsvOptions* m_options;
-    char m_delimiter;
+    ::xlsxcsv::OutputSink* m_sink;
+    SheetReadFilter m_readFilter; // Only the column selection applies here; the reader handles rows
+    std::optional<::xlsxcsv::CsvOptions> m_chunkOptions;
+    CsvEncoder m_encoder;
+    NumberFormatMode m_numberMode = NumberFormatMode::Fixed6;
+    bool m_numbersNeedNoQuoting = true;
+    bool m_datesNeedNoQuoting = true;
     
     WorksheetMetadata m_worksheetMetadata;
-    std::unordered_map<std::string, std::string> m_mergedCellValues; // Cache for merged cell values
+    std::unordered_map<size_t, std::string> m_mergedCellValues; // Top-left values by merged range id
     std::string m_csvOutput;
+    size_t m_flushedBytes = 0;
     size_t m_rowCount = 0;
+    CsvCollectorCounters m_counters;
     std::vector<std::string> m_errorMessages;
+    
+    // CSV form of each shared string, indexed like the shared string table
+    size_t m_sharedFormCacheLimit = MAX_SHARED_FORM_STRINGS;
+    std::vector<uint32_t> m_sharedForms;
+    std::vector<size_t> m_escapedOffsets; // Cached entry i spans [offsets[i], offsets[i + 1])
+    std::string m_escapedBytes;
+    
+    std::optional<MemoryCharge> m_memoryCharge; // Set when tracking memory
 };
 
+// 1-based column of letters such as "C" or "ab", 0 when they are not a column
+static int columnFromLetters(std::string_view letters) {
+    if (letters.empty() || letters.size() > 3) {
+        return 0;
+    }
+    int column = 0;
+    for (char ch : letters) {
+        if (ch >= 'a' && ch <= 'z') {
+            ch = static_cast<char>(ch - 'a' + 'A');
+        }
+        if (ch < 'A' || ch > 'Z') {
+            return 0;
+        }
+        column = column * 26 + (ch - 'A' + 1);
+    }
+    return column <= SheetReadFilter::MAX_COLUMNS ? column : 0;
+}
+
+SheetReadFilter makeSheetReadFilter(const void* csvOptions) {
+    SheetReadFilter filter;
+    const auto* options = static_cast<const ::xlsxcsv::CsvOptions*>(csvOptions);
+    if (!options) {
+        return filter;
+    }
+    
+    filter.skipRows = options->rowOffset;
+    filter.maxRows = options->rowLimit > 0 ? options->rowLimit : SIZE_MAX;
+    filter.skipHiddenRows = !options->includeHiddenRows;
+    
+    for (const auto& selection : options->columns) {
+        if (const int* index = std::get_if<int>(&selection)) {
+            if (*index < 0 || *index >= SheetReadFilter::MAX_COLUMNS) {
+                throw std::invalid_argument("Column index out of range: " + std::to_string(*index));
+            }
+            filter.keepColumn(*index + 1);
+            continue;
+        }
+        
+        const std::string& text = std::get<std::string>(selection);
+        const size_t colon = text.find(':');
+        const std::string_view spec(text);
+        const int first = columnFromLetters(spec.substr(0, colon));
+        const int last = colon == std::string::npos ? first : columnFromLetters(spec.substr(colon + 1));
+        if (first == 0 || last == 0 || last < first) {
+            throw std::invalid_argument("Invalid column selection: '" + text + "'");
+        }
+        for (int column = first; column <= last; ++column) {
+            filter.keepColumn(column);
+        }
+    }
+    return filter;
+}
+
+std::string formatCellText(const CellData& cell,
+                           const SharedStringsProvider* sharedStrings,
+                           const StylesRegistry* styles,
+                           DateSystem dateSystem,
+                           NumberFormatMode numberMode) {
+    return DataConverter::convertCellValue(cell, sharedStrings, styles, dateSystem, numberMode);
+}
+
 // CsvRowCollector PIMPL wrapper
 class CsvRowCollector::Impl : public CsvRowCollectorImpl {
 public:
@@ -352,8 +690,9 @@ public:
 CsvRowCollector::CsvRowCollector(const SharedStringsProvider* sharedStrings,
                                const StylesRegistry* styles,
                                DateSystem dateSystem,
-                               const void* csvOptions)
-    : m_impl(std::make_unique<Impl>(sharedStrings, styles, dateSystem, csvOptions)) {
+                               const void* csvOptions,
+                               ::xlsxcsv::OutputSink* sink)
+    : m_impl(std::make_unique<Impl>(sharedStrings, styles, dateSystem, csvOptions, sink)) {
 }
 
 CsvRowCollector::~CsvRowCollector() = default;
@@ -370,10 +709,41 @@ void CsvRowCollector::handleWorksheetMetadata(const WorksheetMetadata& metadata)
     m_impl->handleWorksheetMetadata(metadata);
 }
 
+void CsvRowCollector::finish() {
+    m_impl->finish();
+}
+
 std::string CsvRowCollector::getCsvString() const {
     return m_impl->getCsvString();
 }
 
+std::string CsvRowCollector::takeCsvString() {
+    return m_impl->takeCsvString();
+}
+
+std::unique_ptr<SheetRowHandler> CsvRowCollector::createChunkHandler() {
+    auto chunk = std::make_unique<CsvRowCollector>(m_impl->sharedStrings(), m_impl->styles(),
+                                                   m_impl->dateSystem(), m_impl->chunkOptions());
+    chunk->m_impl->limitSharedFormCache();
+    if (MemoryTracker* tracker = m_impl->memoryTracker()) {
+        chunk->m_impl->setMemoryTracker(tracker);
+    }
+    return chunk;
+}
+
+void CsvRowCollector::completeChunk(SheetRowHandler& chunk) {
+    // Chunks always come from createChunkHandler()
+    m_impl->appendChunk(*static_cast<CsvRowCollector&>(chunk).m_impl);
+}
+
+bool CsvRowCollector::canSplitRows(const WorksheetMetadata& metadata) const {
+    return m_impl->canSplitRows(metadata);
+}
+
+size_t CsvRowCollector::getBytesWritten() const {
+    return m_impl->getBytesWritten();
+}
+
 const std::vector<std::string>& CsvRowCollector::getErrors() const {
     return m_impl->getErrors();
 }
@@ -382,4 +752,12 @@ size_t CsvRowCollector::getRowCount() const {
     return m_impl->getRowCount();
 }
 
+const CsvCollectorCounters& CsvRowCollector::getCounters() const {
+    return m_impl->getCounters();
+}
+
+void CsvRowCollector::setMemoryTracker(MemoryTracker* tracker) {
+    m_impl->setMemoryTracker(tracker);
+}
+
 } // namespace xlsxcsv::core
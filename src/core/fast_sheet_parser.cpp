@@ -0,0 +1,957 @@
+#include "fast_sheet_parser.hpp"
+#include "sheet_cell_parsing.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define TURBOXL_SCAN_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define TURBOXL_SCAN_NEON 1
+#endif
+
+namespace xlsxcsv::core {
+
+namespace {
+
+constexpr size_t kInitialBufferSize = 256 * 1024;
+constexpr size_t kMaxReferenceLength = 16;  // "&#x10FFFF;" plus slack
+constexpr size_t kMaxElementDepth = 256;    // Same nesting cap libxml2 applies by default
+
+// Thrown while still in the prolog when the document needs the libxml2 backend
+struct FallbackRequired {};
+
+// Thrown after the last row a filter allows, ending the parse early
+struct RowLimitReached {};
+
+[[noreturn]] void throwMalformed(const char* detail) {
+    throw std::runtime_error(std::string("XML parsing error in worksheet: ") + detail);
+}
+
+inline bool isXmlSpace(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+inline bool isNameTerminator(char ch) {
+    return isXmlSpace(ch) || ch == '>' || ch == '/' || ch == '=';
+}
+
+// First byte in [p, end) equal to a, b or c, or end. Markup and references are
+// sparse in cell data, so comparing 16 bytes per step skips most text at once.
+inline const char* findFirstOf3(const char* p, const char* end, char a, char b, char c) {
+#if defined(TURBOXL_SCAN_SSE2)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c);
+    while (end - p >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, va),
+                                                       _mm_cmpeq_epi8(chunk, vb)),
+                                          _mm_cmpeq_epi8(chunk, vc));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return p + std::countr_zero(mask);
+        }
+        p += 16;
+    }
+#elif defined(TURBOXL_SCAN_NEON)
+    const uint8x16_t va = vdupq_n_u8(static_cast<uint8_t>(a));
+    const uint8x16_t vb = vdupq_n_u8(static_cast<uint8_t>(b));
+    const uint8x16_t vc = vdupq_n_u8(static_cast<uint8_t>(c));
+    while (end - p >= 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        const uint8x16_t hits = vorrq_u8(vorrq_u8(vceqq_u8(chunk, va), vceqq_u8(chunk, vb)),
+                                         vceqq_u8(chunk, vc));
+        // Narrow each byte lane to a nibble so the first hit is a trailing-zero count
+        const uint64_t mask = vget_lane_u64(
+            vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+        if (mask != 0) {
+            return p + (std::countr_zero(mask) >> 2);
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && *p != a && *p != b && *p != c) {
+        ++p;
+    }
+    return p;
+}
+
+void appendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+// Appends the expansion of the reference body between '&' and ';'
+void appendReference(std::string_view name, std::string& out) {
+    if (name == "amp") { out.push_back('&'); return; }
+    if (name == "lt") { out.push_back('<'); return; }
+    if (name == "gt") { out.push_back('>'); return; }
+    if (name == "quot") { out.push_back('"'); return; }
+    if (name == "apos") { out.push_back('\''); return; }
+
+    if (name.size() < 2 || name[0] != '#') {
+        throwMalformed("undefined entity reference");
+    }
+    uint32_t codePoint = 0;
+    const bool hex = name[1] == 'x';
+    const size_t digitsStart = hex ? 2 : 1;
+    if (digitsStart >= name.size()) {
+        throwMalformed("invalid character reference");
+    }
+    for (size_t i = digitsStart; i < name.size(); ++i) {
+        const char ch = name[i];
+        uint32_t digit = 0;
+        if (ch >= '0' && ch <= '9') {
+            digit = static_cast<uint32_t>(ch - '0');
+        } else if (hex && ch >= 'a' && ch <= 'f') {
+            digit = static_cast<uint32_t>(ch - 'a' + 10);
+        } else if (hex && ch >= 'A' && ch <= 'F') {
+            digit = static_cast<uint32_t>(ch - 'A' + 10);
+        } else {
+            throwMalformed("invalid character reference");
+        }
+        codePoint = codePoint * (hex ? 16 : 10) + digit;
+        if (codePoint > 0x10FFFF) {
+            throwMalformed("invalid character reference");
+        }
+    }
+    if (codePoint == 0 || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+        throwMalformed("invalid character reference");
+    }
+    appendUtf8(out, codePoint);
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i];
+        char y = b[i];
+        if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+        if (y >= 'A' && y <= 'Z') y = static_cast<char>(y - 'A' + 'a');
+        if (x != y) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+class FastSheetParser::Impl {
+public:
+    Impl(const char* data, size_t size) : m_data(data), m_end(size), m_eof(true) {}
+
+    explicit Impl(ZipEntryStream& stream) : m_stream(&stream), m_storage(kInitialBufferSize) {
+        m_data = m_storage.data();
+    }
+
+    bool parse(SheetRowHandler& handler) {
+        try {
+            checkEncoding();
+            parseWorksheet(handler);
+        } catch (const FallbackRequired&) {
+            return false;
+        } catch (const RowLimitReached&) {
+            // The rest of the document is never read
+        }
+        return true;
+    }
+
+    bool parseHead(SheetRowHandler& handler, size_t& rowsBegin) {
+        m_stopAtSheetData = true;
+        try {
+            checkEncoding();
+            rowsBegin = parseWorksheet(handler) ? m_pos : 0;
+        } catch (const FallbackRequired&) {
+            return false;
+        }
+        m_stopAtSheetData = false;
+        return true;
+    }
+
+    void parseTail(size_t from, SheetRowHandler& handler) {
+        m_pos = from;
+        parseWorksheet(handler);
+    }
+
+    void parseRows(size_t begin, size_t end, SheetRowHandler& handler) {
+        m_pos = begin;
+        m_end = end;
+        m_rootSeen = true;
+        m_retainAll = false;
+        m_openElements.assign(1, "sheetData");
+        m_baseDepth = 1;
+        try {
+            for (;;) {
+                const Token kind = next(nullptr);
+                if (kind == Token::EndOfInput) {
+                    break;
+                }
+                if (kind != Token::EndTag && m_name == "row") {
+                    parseRow(kind == Token::EmptyTag, handler);
+                }
+            }
+        } catch (const RowLimitReached&) {
+        }
+    }
+
+    void setFilter(const SheetReadFilter* filter) {
+        m_filter = filter && filter->isActive() ? filter : nullptr;
+    }
+
+    const char* consumedData() const { return m_data; }
+    size_t consumedSize() const { return m_end; }
+
+private:
+    enum class Token { StartTag, EmptyTag, EndTag, EndOfInput };
+
+    struct Attribute {
+        std::string_view name;
+        std::string_view rawValue;
+    };
+
+    // Pulls more input, keeping the unconsumed bytes from m_pos. Until the root
+    // element opens nothing is discarded so a fallback can replay the prolog.
+    bool refill() {
+        if (m_eof) {
+            return false;
+        }
+        if (!m_retainAll && m_pos > 0) {
+            std::memmove(m_storage.data(), m_storage.data() + m_pos, m_end - m_pos);
+            m_end -= m_pos;
+            m_pos = 0;
+        }
+        if (m_end == m_storage.size()) {
+            m_storage.resize(m_storage.size() * 2);
+        }
+        const size_t got = m_stream->read(reinterpret_cast<uint8_t*>(m_storage.data()) + m_end,
+                                          m_storage.size() - m_end);
+        m_data = m_storage.data();
+        if (got == 0) {
+            m_eof = true;
+            return false;
+        }
+        m_end += got;
+        return true;
+    }
+
+    // Ensures at least count unconsumed bytes are buffered; false at end of input
+    bool ensure(size_t count) {
+        while (m_end - m_pos < count) {
+            if (!refill()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Offset of needle at or after m_pos + from, refilling until it is buffered
+    size_t findSequence(std::string_view needle, size_t from) {
+        for (;;) {
+            std::string_view window(m_data + m_pos, m_end - m_pos);
+            const size_t found = window.find(needle, from);
+            if (found != std::string_view::npos) {
+                return found;
+            }
+            if (!refill()) {
+                throwMalformed("unterminated markup");
+            }
+        }
+    }
+
+    // UTF-16 input or a declared non-UTF-8 encoding needs libxml2's transcoding
+    void checkEncoding() {
+        ensure(5);
+        std::string_view head(m_data, m_end);
+        if (head.size() >= 2 && ((head[0] == '\xFE' && head[1] == '\xFF') ||
+                                 (head[0] == '\xFF' && head[1] == '\xFE') ||
+                                 head[0] == '\0' || head[1] == '\0')) {
+            throw FallbackRequired{};
+        }
+        size_t start = 0;
+        if (head.size() >= 3 && head.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+            start = 3;
+        }
+        m_pos = start;
+        if (!ensure(6) || std::string_view(m_data + m_pos, 6) != "<?xml ") {
+            return;
+        }
+        const size_t declEnd = findSequence("?>", 0);
+        std::string_view decl(m_data + m_pos, declEnd);
+        const size_t key = decl.find("encoding");
+        if (key == std::string_view::npos) {
+            return;
+        }
+        const size_t quote = decl.find_first_of("\"'", key);
+        if (quote == std::string_view::npos) {
+            return;
+        }
+        const size_t close = decl.find(decl[quote], quote + 1);
+        if (close == std::string_view::npos) {
+            return;
+        }
+        std::string_view encoding = decl.substr(quote + 1, close - quote - 1);
+        if (!equalsIgnoreCase(encoding, "UTF-8") && !equalsIgnoreCase(encoding, "UTF8") &&
+            !equalsIgnoreCase(encoding, "US-ASCII") && !equalsIgnoreCase(encoding, "ASCII")) {
+            throw FallbackRequired{};
+        }
+    }
+
+    // Consumes the reference starting at the '&' under m_pos
+    void decodeReference(std::string& out) {
+        const char* semicolon = nullptr;
+        for (;;) {
+            const size_t window = std::min(m_end - m_pos, kMaxReferenceLength);
+            semicolon = static_cast<const char*>(std::memchr(m_data + m_pos, ';', window));
+            if (semicolon) {
+                break;
+            }
+            if (m_end - m_pos >= kMaxReferenceLength || !refill()) {
+                throwMalformed("malformed entity reference");
+            }
+        }
+        const char* nameStart = m_data + m_pos + 1;
+        appendReference(std::string_view(nameStart, static_cast<size_t>(semicolon - nameStart)), out);
+        m_pos = static_cast<size_t>(semicolon - m_data) + 1;
+    }
+
+    // Consumes character data up to the next '<' (or end of input). With a text
+    // target, references are expanded and line ends normalised as XML requires.
+    void consumeText(std::string* text) {
+        for (;;) {
+            const char* begin = m_data + m_pos;
+            const char* end = m_data + m_end;
+            if (!text) {
+                const void* lt = std::memchr(begin, '<', static_cast<size_t>(end - begin));
+                if (lt) {
+                    m_pos = static_cast<size_t>(static_cast<const char*>(lt) - m_data);
+                    return;
+                }
+                m_pos = m_end;
+                if (!refill()) {
+                    return;
+                }
+                continue;
+            }
+
+            const char* hit = findFirstOf3(begin, end, '<', '&', '\r');
+            text->append(begin, hit);
+            m_pos = static_cast<size_t>(hit - m_data);
+            if (hit == end) {
+                if (!refill()) {
+                    return;
+                }
+                continue;
+            }
+            if (*hit == '<') {
+                return;
+            }
+            if (*hit == '&') {
+                decodeReference(*text);
+                continue;
+            }
+            // "\r\n" and a lone "\r" both become "\n"
+            text->push_back('\n');
+            ++m_pos;
+            if (ensure(1) && m_data[m_pos] == '\n') {
+                ++m_pos;
+            }
+        }
+    }
+
+    // Drops a text node made only of whitespace; libxml2 reports those as
+    // whitespace nodes, which the element text readers skip
+    static void closeTextNode(std::string* text, size_t& nodeStart) {
+        if (!text) {
+            return;
+        }
+        bool blank = true;
+        for (size_t i = nodeStart; i < text->size(); ++i) {
+            if (!isXmlSpace((*text)[i])) {
+                blank = false;
+                break;
+            }
+        }
+        if (blank) {
+            text->resize(nodeStart);
+        }
+        nodeStart = text->size();
+    }
+
+    static void appendNormalized(std::string& out, std::string_view data) {
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (data[i] == '\r') {
+                out.push_back('\n');
+                if (i + 1 < data.size() && data[i + 1] == '\n') {
+                    ++i;
+                }
+            } else {
+                out.push_back(data[i]);
+            }
+        }
+    }
+
+    // Parses the element tag under m_pos into m_name/m_attributes. Returns its
+    // length, or 0 when the tag is not fully buffered yet.
+    size_t tryParseElementTag(Token& kind) {
+        const char* start = m_data + m_pos;
+        const char* end = m_data + m_end;
+        const char* p = start + 1;
+        const bool isEndTag = p < end && *p == '/';
+        if (isEndTag) {
+            ++p;
+        }
+        const char* nameStart = p;
+        while (p < end && !isNameTerminator(*p)) {
+            ++p;
+        }
+        if (p == end) {
+            return 0;
+        }
+        m_name = std::string_view(nameStart, static_cast<size_t>(p - nameStart));
+        if (m_name.empty()) {
+            throwMalformed("invalid element name");
+        }
+        m_attributes.clear();
+
+        for (;;) {
+            while (p < end && isXmlSpace(*p)) {
+                ++p;
+            }
+            if (p == end) {
+                return 0;
+            }
+            if (*p == '>') {
+                kind = isEndTag ? Token::EndTag : Token::StartTag;
+                return static_cast<size_t>(p + 1 - start);
+            }
+            if (isEndTag) {
+                throwMalformed("malformed end tag");
+            }
+            if (*p == '/') {
+                if (p + 1 == end) {
+                    return 0;
+                }
+                if (p[1] != '>') {
+                    throwMalformed("malformed empty element");
+                }
+                kind = Token::EmptyTag;
+                return static_cast<size_t>(p + 2 - start);
+            }
+
+            const char* attrStart = p;
+            while (p < end && !isNameTerminator(*p)) {
+                ++p;
+            }
+            std::string_view attrName(attrStart, static_cast<size_t>(p - attrStart));
+            while (p < end && isXmlSpace(*p)) {
+                ++p;
+            }
+            if (p == end) {
+                return 0;
+            }
+            if (attrName.empty() || *p != '=') {
+                throwMalformed("malformed attribute");
+            }
+            ++p;
+            while (p < end && isXmlSpace(*p)) {
+                ++p;
+            }
+            if (p == end) {
+                return 0;
+            }
+            const char quote = *p;
+            if (quote != '"' && quote != '\'') {
+                throwMalformed("unquoted attribute value");
+            }
+            ++p;
+            const void* close = std::memchr(p, quote, static_cast<size_t>(end - p));
+            if (!close) {
+                return 0;
+            }
+            const char* valueEnd = static_cast<const char*>(close);
+            m_attributes.push_back({attrName, std::string_view(p, static_cast<size_t>(valueEnd - p))});
+            p = valueEnd + 1;
+        }
+    }
+
+    // Skips comments, processing instructions and CDATA sections at m_pos; CDATA
+    // content is character data and goes to text. Returns false for an element tag.
+    bool consumeSpecialMarkup(std::string* text, size_t& nodeStart) {
+        if (!ensure(2)) {
+            throwMalformed("unterminated markup");
+        }
+        const char next = m_data[m_pos + 1];
+        if (next == '?') {
+            m_pos += findSequence("?>", 2) + 2;
+            closeTextNode(text, nodeStart);
+            return true;
+        }
+        if (next != '!') {
+            return false;
+        }
+        ensure(9);
+        std::string_view head(m_data + m_pos, m_end - m_pos);
+        if (head.substr(0, 4) == "<!--") {
+            m_pos += findSequence("-->", 4) + 3;
+            closeTextNode(text, nodeStart);
+            return true;
+        }
+        if (head.substr(0, 9) == "<![CDATA[") {
+            const size_t close = findSequence("]]>", 9);
+            if (text) {
+                appendNormalized(*text, std::string_view(m_data + m_pos + 9, close - 9));
+            }
+            m_pos += close + 3;
+            return true;
+        }
+        // A DTD may declare entities or defaults the scanner cannot honour
+        if (!m_rootSeen) {
+            throw FallbackRequired{};
+        }
+        throwMalformed("unexpected markup declaration");
+    }
+
+    // Advances to the next element tag, collecting the character data before it
+    // into text when given. Element nesting is checked as tags are consumed.
+    Token next(std::string* text) {
+        size_t nodeStart = text ? text->size() : 0;
+        for (;;) {
+            consumeText(text);
+            if (m_pos >= m_end) {
+                closeTextNode(text, nodeStart);
+                if (!m_rootSeen || m_openElements.size() != m_baseDepth) {
+                    throwMalformed("unexpected end of document");
+                }
+                return Token::EndOfInput;
+            }
+            if (consumeSpecialMarkup(text, nodeStart)) {
+                continue;
+            }
+
+            Token kind = Token::EndOfInput;
+            size_t length = 0;
+            while ((length = tryParseElementTag(kind)) == 0) {
+                if (!refill()) {
+                    throwMalformed("unterminated tag");
+                }
+            }
+            closeTextNode(text, nodeStart);
+            m_pos += length;
+
+            if (kind == Token::EndTag) {
+                if (m_openElements.size() <= m_baseDepth || m_openElements.back() != m_name) {
+                    throwMalformed("mismatched end tag");
+                }
+                m_openElements.pop_back();
+            } else {
+                if (m_openElements.empty()) {
+                    if (m_rootSeen) {
+                        throwMalformed("content after the root element");
+                    }
+                    m_rootSeen = true;
+                    m_retainAll = false;
+                }
+                if (kind == Token::StartTag) {
+                    if (m_openElements.size() >= kMaxElementDepth) {
+                        throwMalformed("elements nested too deeply");
+                    }
+                    m_openElements.emplace_back(m_name);
+                }
+            }
+            return kind;
+        }
+    }
+
+    // Attribute value with references expanded and whitespace normalised; only
+    // values containing '&' or control characters are copied
+    std::string_view attributeValue(const Attribute& attribute) {
+        const std::string_view raw = attribute.rawValue;
+        const bool plain = std::none_of(raw.begin(), raw.end(), [](char ch) {
+            return ch == '&' || ch == '\t' || ch == '\n' || ch == '\r';
+        });
+        if (plain) {
+            return raw;
+        }
+        m_attributeScratch.clear();
+        for (size_t i = 0; i < raw.size(); ++i) {
+            const char ch = raw[i];
+            if (ch == '&') {
+                const size_t semicolon = raw.find(';', i);
+                if (semicolon == std::string_view::npos) {
+                    throwMalformed("malformed entity reference");
+                }
+                appendReference(raw.substr(i + 1, semicolon - i - 1), m_attributeScratch);
+                i = semicolon;
+            } else if (ch == '\r') {
+                m_attributeScratch.push_back(' ');
+                if (i + 1 < raw.size() && raw[i + 1] == '\n') {
+                    ++i;
+                }
+            } else if (ch == '\t' || ch == '\n') {
+                m_attributeScratch.push_back(' ');
+            } else {
+                m_attributeScratch.push_back(ch);
+            }
+        }
+        return m_attributeScratch;
+    }
+
+    // Collects text nodes up to the first end tag, like the libxml2 reader's
+    // readElementText, leaving the result in m_text
+    void readElementText() {
+        m_text.clear();
+        Token kind;
+        do {
+            kind = next(&m_text);
+        } while (kind != Token::EndTag);
+    }
+
+    // Parses from m_pos to the end of the document. In head mode it stops right
+    // after a <sheetData> start tag and returns true, leaving the rows to
+    // parseRows() and the remainder to parseTail().
+    bool parseWorksheet(SheetRowHandler& handler) {
+        WorksheetMetadata& metadata = m_metadata;
+
+        for (;;) {
+            const Token kind = next(nullptr);
+            if (kind == Token::EndOfInput) {
+                break;
+            }
+            if (kind == Token::EndTag) {
+                continue;
+            }
+            const bool empty = kind == Token::EmptyTag;
+            if (m_name == "row") {
+                parseRow(empty, handler);
+            } else if (m_name == "mergeCells") {
+                if (!empty) {
+                    parseMergedCells(metadata);
+                }
+                // Send updated metadata immediately after parsing merged cells
+                handler.handleWorksheetMetadata(metadata);
+            } else if (m_name == "cols") {
+                if (!empty) {
+                    parseColumns(metadata);
+                }
+                // Send updated metadata immediately after parsing cols
+                handler.handleWorksheetMetadata(metadata);
+            } else if (m_stopAtSheetData && !empty && m_name == "sheetData") {
+                return true;
+            }
+        }
+
+        handler.handleWorksheetMetadata(metadata);
+        return false;
+    }
+
+    void parseRow(bool empty, SheetRowHandler& handler) {
+        int rowNumber = 1; // Default to row 1
+        bool isHidden = false;
+        int spanReserveHint = 0;
+
+        for (const Attribute& attribute : m_attributes) {
+            if (attribute.name == "r") {
+                int parsedRow = 0;
+                if (sheet_parsing::parseInt(attributeValue(attribute), parsedRow) && parsedRow > 0) {
+                    rowNumber = parsedRow;
+                }
+            } else if (attribute.name == "hidden") {
+                isHidden = sheet_parsing::parseBooleanAttribute(attributeValue(attribute));
+            } else if (attribute.name == "spans") {
+                spanReserveHint = sheet_parsing::parseSpansHint(attributeValue(attribute));
+            }
+        }
+
+        if (m_filter && !acceptRow(isHidden)) {
+            if (!empty) {
+                skipElement();
+            }
+            return;
+        }
+
+        // The row is reused so cell storage keeps its capacity across rows
+        m_row.clear();
+        m_row.rowNumber = rowNumber;
+        m_row.hidden = isHidden;
+        if (spanReserveHint > 0) {
+            m_row.cells.reserve(static_cast<size_t>(spanReserveHint));
+        }
+
+        if (!empty) {
+            const size_t rowDepth = m_openElements.size();
+            for (;;) {
+                const Token kind = next(nullptr);
+                if (kind == Token::EndTag) {
+                    if (m_openElements.size() < rowDepth) {
+                        break;
+                    }
+                } else if (m_name == "c") {
+                    parseCell(kind == Token::EmptyTag, rowNumber);
+                }
+            }
+        }
+
+        handler.handleRow(m_row);
+        if (m_filter && ++m_rowsReported >= m_filter->maxRows) {
+            throw RowLimitReached{};
+        }
+    }
+
+    // Counts the row against the filter's range; false when it is not reported
+    bool acceptRow(bool hidden) {
+        if (m_rowsReported >= m_filter->maxRows) {
+            throw RowLimitReached{};
+        }
+        if (hidden && m_filter->skipHiddenRows) {
+            return false;
+        }
+        if (m_rowsSkipped < m_filter->skipRows) {
+            ++m_rowsSkipped;
+            return false;
+        }
+        return true;
+    }
+
+    // Consumes the content and end tag of the element just opened, without
+    // collecting any text
+    void skipElement() {
+        const size_t depth = m_openElements.size();
+        for (;;) {
+            if (next(nullptr) == Token::EndTag && m_openElements.size() < depth) {
+                return;
+            }
+        }
+    }
+
+    // Whether the filter selects the column of the cell tag just parsed
+    bool keepCell() {
+        for (const Attribute& attribute : m_attributes) {
+            if (attribute.name == "r") {
+                int column = 0;
+                return sheet_parsing::parseCellColumn(attributeValue(attribute), column) &&
+                       m_filter->keepsColumn(column);
+            }
+        }
+        return false; // Cells without a reference are never written
+    }
+
+    void parseCell(bool empty, int rowNumber) {
+        if (m_filter && m_filter->selectsColumns() && !keepCell()) {
+            if (!empty) {
+                skipElement();
+            }
+            return;
+        }
+
+        CellData& cell = m_row.cells.emplace_back();
+        bool hasTypeAttribute = false;
+
+        for (const Attribute& attribute : m_attributes) {
+            if (attribute.name == "r") {
+                int column = 0;
+                if (sheet_parsing::parseCellColumn(attributeValue(attribute), column)) {
+                    cell.coordinate.row = rowNumber;
+                    cell.coordinate.column = column;
+                }
+            } else if (attribute.name == "t") {
+                hasTypeAttribute = true;
+                cell.type = sheet_parsing::parseCellType(attributeValue(attribute));
+            } else if (attribute.name == "s") {
+                int parsedStyle = 0;
+                if (sheet_parsing::parseInt(attributeValue(attribute), parsedStyle) && parsedStyle >= 0) {
+                    cell.styleIndex = parsedStyle;
+                }
+            }
+        }
+
+        if (!hasTypeAttribute) {
+            // No type attribute; default Excel type is numeric.
+            cell.type = CellType::Number;
+        }
+
+        if (empty) {
+            return;
+        }
+
+        const size_t cellDepth = m_openElements.size();
+        for (;;) {
+            const Token kind = next(nullptr);
+            if (kind == Token::EndTag) {
+                if (m_openElements.size() < cellDepth) {
+                    break;
+                }
+                continue;
+            }
+            const bool emptyChild = kind == Token::EmptyTag;
+            if (m_name == "v") {
+                if (emptyChild) {
+                    cell.value = std::monostate{};
+                } else {
+                    readElementText();
+                    cell.value = sheet_parsing::convertCellValue(m_text, cell.type, m_row);
+                }
+            } else if (m_name == "is") {
+                if (emptyChild) {
+                    cell.value = std::string_view();
+                } else {
+                    readElementText();
+                    cell.value = m_row.appendText(m_text);
+                }
+                cell.type = CellType::InlineString;
+            }
+        }
+    }
+
+    void parseMergedCells(WorksheetMetadata& metadata) {
+        const size_t depth = m_openElements.size();
+        for (;;) {
+            const Token kind = next(nullptr);
+            if (kind == Token::EndTag) {
+                if (m_openElements.size() < depth) {
+                    break;
+                }
+                continue;
+            }
+            if (m_name != "mergeCell") {
+                continue;
+            }
+            for (const Attribute& attribute : m_attributes) {
+                if (attribute.name == "ref") {
+                    auto range = MergedCellRange::fromReference(std::string(attributeValue(attribute)));
+                    if (range.has_value()) {
+                        metadata.mergedCells.push_back(range.value());
+                    }
+                    break;
+                }
+            }
+        }
+        metadata.buildIndex();
+    }
+
+    void parseColumns(WorksheetMetadata& metadata) {
+        const size_t depth = m_openElements.size();
+        for (;;) {
+            const Token kind = next(nullptr);
+            if (kind == Token::EndTag) {
+                if (m_openElements.size() < depth) {
+                    break;
+                }
+                continue;
+            }
+            if (m_name != "col") {
+                continue;
+            }
+
+            int minCol = 1, maxCol = 1;
+            bool isHidden = false;
+            double width = 0.0;
+            for (const Attribute& attribute : m_attributes) {
+                if (attribute.name == "min") {
+                    minCol = std::atoi(std::string(attributeValue(attribute)).c_str());
+                } else if (attribute.name == "max") {
+                    maxCol = std::atoi(std::string(attributeValue(attribute)).c_str());
+                } else if (attribute.name == "hidden") {
+                    isHidden = sheet_parsing::parseBooleanAttribute(attributeValue(attribute));
+                } else if (attribute.name == "width") {
+                    width = std::stod(std::string(attributeValue(attribute)));
+                }
+            }
+
+            // One entry per <col> range; lookups go through the metadata index
+            if (maxCol >= minCol) {
+                ColumnInfo colInfo;
+                colInfo.columnIndex = minCol;
+                colInfo.lastColumn = maxCol;
+                colInfo.hidden = isHidden;
+                colInfo.width = width;
+                metadata.columnInfo.push_back(colInfo);
+            }
+        }
+        metadata.buildIndex();
+    }
+
+    ZipEntryStream* m_stream = nullptr;
+    std::vector<char> m_storage;
+    const char* m_data = nullptr;
+    size_t m_pos = 0;
+    size_t m_end = 0;
+    bool m_eof = false;
+    bool m_retainAll = true;
+    bool m_rootSeen = false;
+    bool m_stopAtSheetData = false;
+    size_t m_baseDepth = 0; // Elements a row range is nested in, closed outside it
+
+    const SheetReadFilter* m_filter = nullptr;
+    size_t m_rowsSkipped = 0;
+    size_t m_rowsReported = 0;
+
+    std::string_view m_name;
+    std::vector<Attribute> m_attributes;
+    std::vector<std::string> m_openElements;
+    std::string m_attributeScratch;
+    std::string m_text;
+    RowData m_row;
+    WorksheetMetadata m_metadata;
+};
+
+FastSheetParser::FastSheetParser(const char* data, size_t size)
+    : m_impl(std::make_unique<Impl>(data, size)) {
+}
+
+FastSheetParser::FastSheetParser(ZipEntryStream& stream)
+    : m_impl(std::make_unique<Impl>(stream)) {
+}
+
+FastSheetParser::~FastSheetParser() = default;
+
+bool FastSheetParser::parse(SheetRowHandler& handler) {
+    return m_impl->parse(handler);
+}
+
+bool FastSheetParser::parseHead(SheetRowHandler& handler, size_t& rowsBegin) {
+    return m_impl->parseHead(handler, rowsBegin);
+}
+
+void FastSheetParser::parseTail(size_t from, SheetRowHandler& handler) {
+    m_impl->parseTail(from, handler);
+}
+
+void FastSheetParser::parseRows(size_t begin, size_t end, SheetRowHandler& handler) {
+    m_impl->parseRows(begin, end, handler);
+}
+
+void FastSheetParser::setFilter(const SheetReadFilter* filter) {
+    m_impl->setFilter(filter);
+}
+
+const char* FastSheetParser::consumedData() const {
+    return m_impl->consumedData();
+}
+
+size_t FastSheetParser::consumedSize() const {
+    return m_impl->consumedSize();
+}
+
+} // namespace xlsxcsv::core
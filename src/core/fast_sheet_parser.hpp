@@ -0,0 +1,56 @@
+#pragma once
+
+// Worksheet tokenizer specialised for the small SpreadsheetML subset the
+// converter reads (<row>, <c>, <v>, <is><t>, <cols>, <mergeCells>). It scans
+// the raw bytes for markup with SIMD and only decodes entities where an '&'
+// is present, producing the same handler calls as the libxml2 backend.
+
+#include "xlsxcsv/core.hpp"
+#include <memory>
+#include <string>
+
+namespace xlsxcsv::core {
+
+class FastSheetParser {
+public:
+    // Parse an in-memory worksheet; the data must outlive the parser
+    FastSheetParser(const char* data, size_t size);
+    // Parse a worksheet as it is decompressed
+    explicit FastSheetParser(ZipEntryStream& stream);
+    ~FastSheetParser();
+
+    FastSheetParser(const FastSheetParser&) = delete;
+    FastSheetParser& operator=(const FastSheetParser&) = delete;
+
+    // Returns false, before any handler call, when the document uses XML the
+    // scanner does not implement (a DTD or a non-UTF-8 encoding) and has to be
+    // re-parsed by libxml2. Malformed input throws std::runtime_error.
+    bool parse(SheetRowHandler& handler);
+
+    // Split parsing of an in-memory worksheet for parallel parsing. parseHead()
+    // runs like parse() up to the <sheetData> start tag and sets rowsBegin to
+    // the offset just past it. When the sheet has no sheetData content the
+    // whole document is parsed and rowsBegin is 0.
+    bool parseHead(SheetRowHandler& handler, size_t& rowsBegin);
+    // After parseHead(), parses from offset from (the "</sheetData>" tag) to the
+    // end of the document, reporting the merged metadata as parse() does
+    void parseTail(size_t from, SheetRowHandler& handler);
+    // Parses the rows in [begin, end), a run of whole <row> elements inside
+    // sheetData. Each range needs a parser of its own; ranges are independent.
+    void parseRows(size_t begin, size_t end, SheetRowHandler& handler);
+
+    // Rows and cells to report; the filter must outlive the parse. parse()
+    // returns normally once the filter's row limit is reached.
+    void setFilter(const SheetReadFilter* filter);
+
+    // Bytes already pulled from the stream, for replaying into the fallback
+    // parser after parse() returned false
+    const char* consumedData() const;
+    size_t consumedSize() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace xlsxcsv::core
@@ -0,0 +1,208 @@
+#include "xlsxcsv/core.hpp"
+#include <libxml/xmlmemory.h>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#if defined(__linux__)
+#  include <malloc.h>
+#  define XLSXCSV_BLOCK_SIZE(p) malloc_usable_size(p)
+#elif defined(__APPLE__)
+#  include <malloc/malloc.h>
+#  define XLSXCSV_BLOCK_SIZE(p) malloc_size(p)
+#elif defined(_WIN32)
+#  include <malloc.h>
+#  define XLSXCSV_BLOCK_SIZE(p) _msize(p)
+#endif
+
+namespace xlsxcsv::core {
+
+namespace {
+
+// Tracker charged for libxml2 allocations made on this thread
+thread_local MemoryTracker* t_current = nullptr;
+
+std::string limitMessage(uint64_t limit) {
+    return "Conversion exceeded its memory limit of " + std::to_string(limit) + " bytes";
+}
+
+} // namespace
+
+MemoryTracker::MemoryTracker(uint64_t limit) : m_limit(limit) {}
+
+void MemoryTracker::charge(uint64_t bytes) {
+    if (!tryCharge(bytes)) {
+        throw MemoryLimitError(limitMessage(m_limit));
+    }
+}
+
+bool MemoryTracker::tryCharge(uint64_t bytes) noexcept {
+    if (m_limit == 0) {
+        adjust(static_cast<int64_t>(bytes));
+        return true;
+    }
+    int64_t current = m_current.load(std::memory_order_relaxed);
+    for (;;) {
+        const int64_t next = current + static_cast<int64_t>(bytes);
+        if (next > 0 && static_cast<uint64_t>(next) > m_limit) {
+            m_exceeded.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        if (m_current.compare_exchange_weak(current, next, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    adjust(0); // Records the new peak
+    return true;
+}
+
+void MemoryTracker::release(uint64_t bytes) noexcept {
+    adjust(-static_cast<int64_t>(bytes));
+}
+
+void MemoryTracker::adjust(int64_t delta) noexcept {
+    const int64_t now = m_current.fetch_add(delta, std::memory_order_relaxed) + delta;
+    if (now <= 0) {
+        return;
+    }
+    uint64_t peak = m_peak.load(std::memory_order_relaxed);
+    while (static_cast<uint64_t>(now) > peak &&
+           !m_peak.compare_exchange_weak(peak, static_cast<uint64_t>(now), std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t MemoryTracker::current() const {
+    // libxml2 blocks allocated outside a Scope may be freed inside one
+    const int64_t current = m_current.load(std::memory_order_relaxed);
+    return current > 0 ? static_cast<uint64_t>(current) : 0;
+}
+
+uint64_t MemoryTracker::peak() const {
+    return m_peak.load(std::memory_order_relaxed);
+}
+
+bool MemoryTracker::limitExceeded() const {
+    return m_exceeded.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::throwIfLimitExceeded() const {
+    if (limitExceeded()) {
+        throw MemoryLimitError(limitMessage(m_limit));
+    }
+}
+
+MemoryTracker::Scope::Scope(MemoryTracker* tracker) : m_previous(t_current) {
+    if (tracker) {
+        t_current = tracker;
+    }
+}
+
+MemoryTracker::Scope::~Scope() {
+    t_current = m_previous;
+}
+
+MemoryTracker* MemoryTracker::active() {
+    return t_current;
+}
+
+// libxml2 allocator that charges heap blocks to the calling thread's tracker.
+// Blocks are charged by their usable size rather than tagged with a header,
+// so blocks allocated before installation can still be freed safely.
+struct LibxmlMemoryHooks {
+#ifdef XLSXCSV_BLOCK_SIZE
+    static void* allocate(size_t size) {
+        void* block = std::malloc(size);
+        MemoryTracker* tracker = t_current;
+        if (block && tracker && !tracker->tryCharge(XLSXCSV_BLOCK_SIZE(block))) {
+            std::free(block);
+            return nullptr; // libxml2 reports it as an out-of-memory error
+        }
+        return block;
+    }
+
+    static void deallocate(void* block) {
+        MemoryTracker* tracker = t_current;
+        if (block && tracker) {
+            tracker->release(XLSXCSV_BLOCK_SIZE(block));
+        }
+        std::free(block);
+    }
+
+    static void* reallocate(void* block, size_t size) {
+        MemoryTracker* tracker = t_current;
+        if (!tracker) {
+            return std::realloc(block, size);
+        }
+        const uint64_t oldSize = block ? XLSXCSV_BLOCK_SIZE(block) : 0;
+        // Growth is reserved first so a refusal leaves the block untouched
+        const uint64_t reserved = size > oldSize ? size - oldSize : 0;
+        if (!tracker->tryCharge(reserved)) {
+            return nullptr;
+        }
+        void* resized = std::realloc(block, size);
+        if (!resized) {
+            tracker->release(reserved);
+            return nullptr;
+        }
+        tracker->adjust(static_cast<int64_t>(XLSXCSV_BLOCK_SIZE(resized)) -
+                        static_cast<int64_t>(oldSize + reserved));
+        return resized;
+    }
+
+    static char* duplicate(const char* text) {
+        const size_t size = std::strlen(text) + 1;
+        char* copy = static_cast<char*>(allocate(size));
+        if (copy) {
+            std::memcpy(copy, text, size);
+        }
+        return copy;
+    }
+#endif
+};
+
+bool MemoryTracker::installLibxmlHooks() {
+#ifdef XLSXCSV_BLOCK_SIZE
+    static std::once_flag once;
+    static bool installed = false;
+    std::call_once(once, [] {
+        // Replacing an allocator someone else installed would hand their
+        // blocks to the wrong free function
+        xmlFreeFunc freeFunc = nullptr;
+        xmlMallocFunc mallocFunc = nullptr;
+        xmlReallocFunc reallocFunc = nullptr;
+        xmlStrdupFunc strdupFunc = nullptr;
+        if (xmlMemGet(&freeFunc, &mallocFunc, &reallocFunc, &strdupFunc) != 0 ||
+            freeFunc != &std::free || mallocFunc != &std::malloc || reallocFunc != &std::realloc) {
+            return;
+        }
+        installed = xmlMemSetup(&LibxmlMemoryHooks::deallocate, &LibxmlMemoryHooks::allocate,
+                                &LibxmlMemoryHooks::reallocate, &LibxmlMemoryHooks::duplicate) == 0;
+    });
+    return installed;
+#else
+    return false;
+#endif
+}
+
+MemoryCharge::MemoryCharge(MemoryTracker* tracker, uint64_t bytes) : m_tracker(tracker) {
+    resize(bytes);
+}
+
+MemoryCharge::~MemoryCharge() {
+    if (m_tracker) {
+        m_tracker->release(m_bytes);
+    }
+}
+
+void MemoryCharge::resize(uint64_t bytes) {
+    if (!m_tracker || bytes == m_bytes) {
+        return;
+    }
+    if (bytes > m_bytes) {
+        m_tracker->charge(bytes - m_bytes);
+    } else {
+        m_tracker->release(m_bytes - bytes);
+    }
+    m_bytes = bytes;
+}
+
+} // namespace xlsxcsv::core
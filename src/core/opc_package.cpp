@@ -6,6 +6,83 @@
 
 namespace xlsxcsv::core {
 
+namespace {
+
+struct Relationship {
+    std::string id;
+    std::string type;
+    std::string target;
+};
+
+std::map<std::string, Relationship> parseRelationships(const ByteVector& xmlData, const std::string& relsPath) {
+    // Initialize libxml2 reader
+    xmlTextReaderPtr reader = xmlReaderForMemory(
+        reinterpret_cast<const char*>(xmlData.data()),
+        xmlData.size(),
+        nullptr,
+        nullptr,
+        XML_PARSE_NOENT | XML_PARSE_NONET | XML_PARSE_COMPACT
+    );
+    
+    if (!reader) {
+        throw XlsxError("Failed to create XML reader for " + relsPath);
+    }
+    
+    std::map<std::string, Relationship> relationships;
+    int result = xmlTextReaderRead(reader);
+    while (result == 1) {
+        if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
+            xmlChar* name = xmlTextReaderName(reader);
+            
+            if (name && xmlStrcmp(name, BAD_CAST "Relationship") == 0) {
+                xmlChar* id = xmlTextReaderGetAttribute(reader, BAD_CAST "Id");
+                xmlChar* type = xmlTextReaderGetAttribute(reader, BAD_CAST "Type");
+                xmlChar* target = xmlTextReaderGetAttribute(reader, BAD_CAST "Target");
+                
+                if (id && type && target) {
+                    Relationship rel;
+                    rel.id = reinterpret_cast<const char*>(id);
+                    rel.type = reinterpret_cast<const char*>(type);
+                    rel.target = reinterpret_cast<const char*>(target);
+                    
+                    relationships[rel.id] = rel;
+                }
+                
+                if (id) xmlFree(id);
+                if (type) xmlFree(type);
+                if (target) xmlFree(target);
+            }
+            
+            if (name) xmlFree(name);
+        }
+        result = xmlTextReaderRead(reader);
+    }
+    
+    xmlFreeTextReader(reader);
+    
+    if (result < 0) {
+        throw XlsxError("Error parsing " + relsPath);
+    }
+    return relationships;
+}
+
+// Targets in workbook.xml.rels are relative to xl/, or absolute from the root
+std::string workbookPartPath(const std::map<std::string, Relationship>& relationships,
+                             const std::string& type) {
+    const std::string suffix = "/" + type;
+    for (const auto& [id, rel] : relationships) {
+        if (rel.type.size() >= suffix.size() &&
+            rel.type.compare(rel.type.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            return rel.target.rfind('/', 0) == 0 ? rel.target.substr(1) : "xl/" + rel.target;
+        }
+    }
+    return "xl/" + type + ".xml";
+}
+
+constexpr const char* WORKBOOK_RELS_PATH = "xl/_rels/workbook.xml.rels";
+
+} // namespace
+
 class OpcPackage::Impl {
 public:
     Impl() = default;
@@ -14,17 +91,20 @@ public:
         close();
     }
     
-    void open(const std::string& path) {
+    // openArchive opens m_zipReader from one of the supported sources
+    template <typename OpenArchive>
+    void open(OpenArchive&& openArchive) {
         if (m_zipReader.isOpen()) {
             close();
         }
         
         // Open the ZIP file using our secure ZipReader
-        m_zipReader.open(path);
+        openArchive(m_zipReader);
         
         // Parse the OPC package structure
         parseContentTypes();
         parseMainRelationships();
+        parseWorkbookRelationships();
         
         m_isOpen = true;
     }
@@ -34,6 +114,7 @@ public:
         m_isOpen = false;
         m_contentTypes.clear();
         m_relationships.clear();
+        m_workbookRelationships.clear();
     }
     
     bool isOpen() const {
@@ -55,6 +136,13 @@ public:
         throw XlsxError("Workbook not found in OPC package relationships");
     }
     
+    std::string findWorkbookPartPath(const std::string& type) const {
+        if (!m_isOpen) {
+            throw XlsxError("OPC package is not open");
+        }
+        return workbookPartPath(m_workbookRelationships, type);
+    }
+    
     std::vector<std::string> getContentTypes() {
         if (!m_isOpen) {
             throw XlsxError("OPC package is not open");
@@ -75,12 +163,6 @@ public:
     }
 
 private:
-    struct Relationship {
-        std::string id;
-        std::string type;
-        std::string target;
-    };
-    
     void parseContentTypes() {
         const std::string contentTypesPath = "[Content_Types].xml";
         
@@ -100,7 +182,24 @@ private:
         }
         
         auto xmlData = m_zipReader.readEntry(relsPath);
-        parseXmlForRelationships(xmlData);
+        m_relationships = parseRelationships(xmlData, relsPath);
+        if (m_relationships.empty()) {
+            throw XlsxError("No relationships found in _rels/.rels");
+        }
+    }
+    
+    // Workbook reports a missing or broken file itself; here it only means
+    // parts are looked for where they conventionally live
+    void parseWorkbookRelationships() {
+        if (!m_zipReader.hasEntry(WORKBOOK_RELS_PATH)) {
+            return;
+        }
+        try {
+            m_workbookRelationships = parseRelationships(m_zipReader.readEntry(WORKBOOK_RELS_PATH),
+                                                         WORKBOOK_RELS_PATH);
+        } catch (const XlsxError&) {
+            m_workbookRelationships.clear();
+        }
     }
     
     void parseXmlForContentTypes(const ByteVector& xmlData) {
@@ -164,65 +263,11 @@ private:
         }
     }
     
-    void parseXmlForRelationships(const ByteVector& xmlData) {
-        // Initialize libxml2 reader
-        xmlTextReaderPtr reader = xmlReaderForMemory(
-            reinterpret_cast<const char*>(xmlData.data()),
-            xmlData.size(),
-            nullptr,
-            nullptr,
-            XML_PARSE_NOENT | XML_PARSE_NONET | XML_PARSE_COMPACT
-        );
-        
-        if (!reader) {
-            throw XlsxError("Failed to create XML reader for _rels/.rels");
-        }
-        
-        // Parse the XML
-        int result = xmlTextReaderRead(reader);
-        while (result == 1) {
-            if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
-                xmlChar* name = xmlTextReaderName(reader);
-                
-                if (name && xmlStrcmp(name, BAD_CAST "Relationship") == 0) {
-                    xmlChar* id = xmlTextReaderGetAttribute(reader, BAD_CAST "Id");
-                    xmlChar* type = xmlTextReaderGetAttribute(reader, BAD_CAST "Type");
-                    xmlChar* target = xmlTextReaderGetAttribute(reader, BAD_CAST "Target");
-                    
-                    if (id && type && target) {
-                        Relationship rel;
-                        rel.id = reinterpret_cast<const char*>(id);
-                        rel.type = reinterpret_cast<const char*>(type);
-                        rel.target = reinterpret_cast<const char*>(target);
-                        
-                        m_relationships[rel.id] = rel;
-                    }
-                    
-                    if (id) xmlFree(id);
-                    if (type) xmlFree(type);
-                    if (target) xmlFree(target);
-                }
-                
-                if (name) xmlFree(name);
-            }
-            result = xmlTextReaderRead(reader);
-        }
-        
-        xmlFreeTextReader(reader);
-        
-        if (result < 0) {
-            throw XlsxError("Error parsing _rels/.rels");
-        }
-        
-        if (m_relationships.empty()) {
-            throw XlsxError("No relationships found in _rels/.rels");
-        }
-    }
-    
     ZipReader m_zipReader;
     bool m_isOpen = false;
     std::map<std::string, std::string> m_contentTypes;
     std::map<std::string, Relationship> m_relationships;
+    std::map<std::string, Relationship> m_workbookRelationships;
 };
 
 // OpcPackage implementation
@@ -234,7 +279,15 @@ OpcPackage::OpcPackage(OpcPackage&&) noexcept = default;
 OpcPackage& OpcPackage::operator=(OpcPackage&&) noexcept = default;
 
 void OpcPackage::open(const std::string& path) {
-    m_impl->open(path);
+    m_impl->open([&](ZipReader& zip) { zip.open(path); });
+}
+
+void OpcPackage::openMapped(const std::string& path) {
+    m_impl->open([&](ZipReader& zip) { zip.openMapped(path); });
+}
+
+void OpcPackage::open(std::span<const std::byte> data) {
+    m_impl->open([&](ZipReader& zip) { zip.open(data); });
 }
 
 void OpcPackage::close() {
@@ -249,6 +302,10 @@ std::string OpcPackage::findWorkbookPath() const {
     return m_impl->findWorkbookPath();
 }
 
+std::string OpcPackage::findWorkbookPartPath(const std::string& type) const {
+    return m_impl->findWorkbookPartPath(type);
+}
+
 std::vector<std::string> OpcPackage::getContentTypes() const {
     return m_impl->getContentTypes();
 }
@@ -257,4 +314,16 @@ const ZipReader& OpcPackage::getZipReader() const {
     return m_impl->getZipReader();
 }
 
+std::string findWorkbookPartPath(const ZipReader& zip, const std::string& type) {
+    std::map<std::string, Relationship> relationships;
+    if (zip.hasEntry(WORKBOOK_RELS_PATH)) {
+        try {
+            relationships = parseRelationships(zip.readEntry(WORKBOOK_RELS_PATH), WORKBOOK_RELS_PATH);
+        } catch (const XlsxError&) {
+            // Looked for where it conventionally lives
+        }
+    }
+    return workbookPartPath(relationships, type);
+}
+
 } // namespace xlsxcsv::core
@@ -0,0 +1,185 @@
+#include "xlsxcsv/core.hpp"
+#include "xlsxcsv.hpp"  // For CsvOptions
+#include <unordered_map>
+
+namespace xlsxcsv::core {
+
+class SharedStringDictionaryCollector::Impl {
+public:
+    Impl(const SharedStringsProvider* sharedStrings, const void* options, bool emitCodes)
+        : m_sharedStrings(sharedStrings)
+        , m_options(static_cast<const ::xlsxcsv::CsvOptions*>(options))
+        , m_readFilter(makeSheetReadFilter(options))
+        , m_emitCodes(emitCodes) {}
+
+    void handleRow(const RowData& row) {
+        if (row.hidden && m_options && !m_options->includeHiddenRows) {
+            return;
+        }
+        for (const auto& cell : row.cells) {
+            if (cell.coordinate.column <= 0 || cell.isEmpty()) {
+                continue;
+            }
+            Column& column = columnAt(cell.coordinate.column);
+            if (!cell.isSharedStringIndex()) {
+                ++column.dictionary.otherCells;
+                continue;
+            }
+            const int index = cell.getSharedStringIndex();
+            if (index < 0 || (m_sharedStrings && static_cast<size_t>(index) >= m_sharedStrings->getStringCount())) {
+                continue; // Renders as an empty field
+            }
+            const int32_t code = codeFor(column, static_cast<uint32_t>(index));
+            ++column.dictionary.counts[static_cast<size_t>(code)];
+            if (m_emitCodes) {
+                // Rows without a shared string in this column are filled in lazily
+                column.dictionary.codes.resize(m_rowCount, -1);
+                column.dictionary.codes.push_back(code);
+            }
+        }
+        ++m_rowCount;
+    }
+
+    void handleError(const std::string& message) {
+        m_errorMessages.push_back(message);
+    }
+
+    void handleWorksheetMetadata(const WorksheetMetadata& metadata) {
+        m_metadata = metadata;
+    }
+
+    std::vector<SharedStringDictionary> takeDictionaries() {
+        const bool dropHidden = m_options && !m_options->includeHiddenColumns;
+        std::vector<SharedStringDictionary> result;
+        for (Column& column : m_columns) {
+            SharedStringDictionary& dictionary = column.dictionary;
+            if (dictionary.indexes.empty() ||
+                (dropHidden && m_metadata.isColumnHidden(dictionary.column)) ||
+                !m_readFilter.keepsColumn(dictionary.column)) {
+                continue;
+            }
+            if (m_emitCodes) {
+                dictionary.codes.resize(m_rowCount, -1);
+            }
+            result.push_back(std::move(dictionary));
+        }
+        m_columns.clear();
+        m_rowCount = 0;
+        return result;
+    }
+
+    std::vector<std::string_view> resolveValues(const SharedStringDictionary& dictionary) const {
+        if (!m_sharedStrings) {
+            throw XlsxError("Shared string dictionaries need a shared strings provider to resolve values");
+        }
+        std::vector<std::string_view> values;
+        values.reserve(dictionary.indexes.size());
+        for (uint32_t index : dictionary.indexes) {
+            values.push_back(m_sharedStrings->getStringView(index));
+        }
+        return values;
+    }
+
+    const std::vector<std::string>& getErrors() const {
+        return m_errorMessages;
+    }
+
+    size_t getRowCount() const {
+        return m_rowCount;
+    }
+    
+    size_t getMemoryUsage() const {
+        // Hash nodes hold the pair plus a next pointer and cached hash
+        constexpr size_t NODE_BYTES = sizeof(std::pair<const uint32_t, int32_t>) + 2 * sizeof(void*);
+        size_t bytes = m_columns.capacity() * sizeof(Column);
+        for (const Column& column : m_columns) {
+            const SharedStringDictionary& dictionary = column.dictionary;
+            bytes += dictionary.indexes.capacity() * sizeof(uint32_t) +
+                     dictionary.counts.capacity() * sizeof(uint64_t) +
+                     dictionary.codes.capacity() * sizeof(int32_t) +
+                     column.sharedToCode.size() * NODE_BYTES +
+                     column.sharedToCode.bucket_count() * sizeof(void*);
+        }
+        return bytes;
+    }
+
+private:
+    struct Column {
+        SharedStringDictionary dictionary;
+        // Position in dictionary.indexes by shared index. Hashed, as a column
+        // refers to a few strings of a table that may hold millions.
+        std::unordered_map<uint32_t, int32_t> sharedToCode;
+    };
+
+    Column& columnAt(int sheetColumn) {
+        while (static_cast<int>(m_columns.size()) < sheetColumn) {
+            m_columns.emplace_back();
+            m_columns.back().dictionary.column = static_cast<int>(m_columns.size());
+        }
+        return m_columns[static_cast<size_t>(sheetColumn - 1)];
+    }
+
+    int32_t codeFor(Column& column, uint32_t index) {
+        const auto nextCode = static_cast<int32_t>(column.dictionary.indexes.size());
+        auto [it, inserted] = column.sharedToCode.try_emplace(index, nextCode);
+        if (inserted) {
+            column.dictionary.indexes.push_back(index);
+            column.dictionary.counts.push_back(0);
+        }
+        return it->second;
+    }
+
+    const SharedStringsProvider* m_sharedStrings;
+    const ::xlsxcsv::CsvOptions* m_options;
+    SheetReadFilter m_readFilter; // Column selection; the reader already applied the row range
+    const bool m_emitCodes;
+
+    std::vector<Column> m_columns; // By worksheet column - 1
+    size_t m_rowCount = 0;
+    WorksheetMetadata m_metadata;
+    std::vector<std::string> m_errorMessages;
+};
+
+// SharedStringDictionaryCollector PIMPL wrapper
+SharedStringDictionaryCollector::SharedStringDictionaryCollector(const SharedStringsProvider* sharedStrings,
+                                                                 const void* csvOptions,
+                                                                 bool emitCodes)
+    : m_impl(std::make_unique<Impl>(sharedStrings, csvOptions, emitCodes)) {
+}
+
+SharedStringDictionaryCollector::~SharedStringDictionaryCollector() = default;
+
+void SharedStringDictionaryCollector::handleRow(const RowData& row) {
+    m_impl->handleRow(row);
+}
+
+void SharedStringDictionaryCollector::handleError(const std::string& message) {
+    m_impl->handleError(message);
+}
+
+void SharedStringDictionaryCollector::handleWorksheetMetadata(const WorksheetMetadata& metadata) {
+    m_impl->handleWorksheetMetadata(metadata);
+}
+
+std::vector<SharedStringDictionary> SharedStringDictionaryCollector::takeDictionaries() {
+    return m_impl->takeDictionaries();
+}
+
+std::vector<std::string_view> SharedStringDictionaryCollector::resolveValues(
+    const SharedStringDictionary& dictionary) const {
+    return m_impl->resolveValues(dictionary);
+}
+
+const std::vector<std::string>& SharedStringDictionaryCollector::getErrors() const {
+    return m_impl->getErrors();
+}
+
+size_t SharedStringDictionaryCollector::getRowCount() const {
+    return m_impl->getRowCount();
+}
+
+size_t SharedStringDictionaryCollector::getMemoryUsage() const {
+    return m_impl->getMemoryUsage();
+}
+
+} // namespace xlsxcsv::core
@@ -1,15 +1,182 @@
 #include "xlsxcsv/core.hpp"
 #include <libxml/xmlreader.h>
 #include <vector>
-#include <fstream>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
 #include <memory>
+#include <random>
 #include <sstream>
 #include <regex>
 #include <filesystem>
 #include <algorithm>
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
 
 namespace xlsxcsv::core {
 
+namespace {
+
+// Spill file for External mode: string bytes are appended sequentially while
+// parsing, then the finished file is mapped read-only so lookups are plain
+// memory reads from the page cache.
+class SpillFile {
+public:
+    SpillFile() = default;
+    ~SpillFile() {
+        close();
+    }
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    // Create a uniquely named file in directory; exclusive creation makes the
+    // name race-free even with other processes using the same directory
+    void create(const std::filesystem::path& directory) {
+        close();
+        std::random_device random;
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            const uint64_t token = (static_cast<uint64_t>(random()) << 32) ^ random();
+            char name[48];
+            std::snprintf(name, sizeof(name), "turboxl_strings_%016llx.tmp",
+                          static_cast<unsigned long long>(token));
+            auto candidate = directory / name;
+            m_writer = std::fopen(candidate.string().c_str(), "wbx");
+            if (m_writer) {
+                m_path = candidate;
+                std::setvbuf(m_writer, nullptr, _IOFBF, WRITE_BUFFER_SIZE);
+                return;
+            }
+            if (!std::filesystem::is_directory(directory)) {
+                break;
+            }
+        }
+        throw XlsxError("Failed to create temporary file for shared strings storage in " + directory.string());
+    }
+
+    void append(std::string_view value) {
+        if (!value.empty() && std::fwrite(value.data(), 1, value.size(), m_writer) != value.size()) {
+            throw XlsxError("Failed to write shared strings spill file");
+        }
+        m_size += value.size();
+    }
+
+    uint64_t size() const {
+        return m_size;
+    }
+
+    // Finish writing and map the file for reading
+    void map() {
+        if (std::fclose(m_writer) != 0) {
+            m_writer = nullptr;
+            throw XlsxError("Failed to write shared strings spill file");
+        }
+        m_writer = nullptr;
+        if (m_size == 0) {
+            return; // Nothing to map; every string is empty
+        }
+        if (m_size > static_cast<uint64_t>(SIZE_MAX)) {
+            throw XlsxError("Shared strings spill file too large to map");
+        }
+#ifdef _WIN32
+        m_fileHandle = CreateFileW(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (m_fileHandle == INVALID_HANDLE_VALUE) {
+            throw XlsxError("Failed to open shared strings spill file for mapping");
+        }
+        m_mappingHandle = CreateFileMappingW(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = m_mappingHandle ? MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            throw XlsxError("Failed to map shared strings spill file");
+        }
+        m_data = static_cast<const char*>(view);
+#else
+        int fd = ::open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw XlsxError("Failed to open shared strings spill file for mapping");
+        }
+        void* view = ::mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps the file alive
+        if (view == MAP_FAILED) {
+            throw XlsxError("Failed to map shared strings spill file");
+        }
+        // Sheets reference strings in arbitrary order, so readahead mostly wastes I/O
+        ::madvise(view, static_cast<size_t>(m_size), MADV_RANDOM);
+        m_data = static_cast<const char*>(view);
+
+        // Unlink right away; the mapping stays valid and nothing leaks on a crash
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+        m_path.clear();
+#endif
+    }
+
+    std::string_view view(uint64_t offset, uint64_t length) const {
+        if (length == 0) {
+            return std::string_view();
+        }
+        return std::string_view(m_data + offset, static_cast<size_t>(length));
+    }
+
+    void close() {
+        if (m_writer) {
+            std::fclose(m_writer);
+            m_writer = nullptr;
+        }
+#ifdef _WIN32
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mappingHandle) {
+            CloseHandle(m_mappingHandle);
+            m_mappingHandle = nullptr;
+        }
+        if (m_fileHandle != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_fileHandle);
+            m_fileHandle = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_data) {
+            ::munmap(const_cast<char*>(m_data), static_cast<size_t>(m_size));
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+        if (!m_path.empty()) {
+            std::error_code ec;
+            std::filesystem::remove(m_path, ec);
+            m_path.clear();
+        }
+    }
+
+private:
+    static constexpr size_t WRITE_BUFFER_SIZE = 1024 * 1024;
+
+    std::filesystem::path m_path;
+    std::FILE* m_writer = nullptr;
+    const char* m_data = nullptr;
+    uint64_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE m_mappingHandle = nullptr;
+#endif
+};
+
+} // namespace
+
 class SharedStringsProvider::Impl {
 public:
     Impl() : m_config(), m_isOpen(false), m_activeMode(SharedStringsMode::Auto), 
@@ -29,7 +196,7 @@ public:
         }
         
         // Check if sharedStrings.xml exists
-        std::string sharedStringsPath = "xl/sharedStrings.xml";
+        const std::string sharedStringsPath = package.findWorkbookPartPath("sharedStrings");
         if (!package.getZipReader().hasEntry(sharedStringsPath)) {
             // No shared strings - this is valid for some XLSX files
             m_isOpen = true;
@@ -37,8 +204,38 @@ public:
             return;
         }
         
+        MemoryTracker* tracker = m_config.memoryTracker;
+        MemoryTracker::Scope trackLibxml(tracker);
+        if (m_config.pipelinedInflate && m_config.mode != SharedStringsMode::Lazy) {
+            // Lazy mode indexes the whole document, so only eager parsing streams
+            MemoryCharge ring(tracker, PIPELINE_RING_BYTES);
+            auto stream = package.getZipReader().openPipelinedEntryStream(sharedStringsPath);
+            parseSharedStringsStream(stream);
+            notePeak(PIPELINE_RING_BYTES);
+            chargeTable();
+            m_isOpen = true;
+            return;
+        }
+        
+        MemoryCharge inflated(tracker, tracker ? declaredSize(package.getZipReader(), sharedStringsPath) : 0);
         ByteVector xmlData = package.getZipReader().readEntry(sharedStringsPath);
-        parseSharedStringsXml(xmlData);
+        if (m_config.mode == SharedStringsMode::Lazy && indexStringItems(xmlData)) {
+            // Keep the raw items; strings are decoded the first time a cell asks
+            // for them. Past memoryThreshold they are kept in the spill file.
+            m_activeMode = SharedStringsMode::Lazy;
+            if (xmlData.size() > m_config.memoryThreshold) {
+                spillStringItems(xmlData);
+            } else {
+                m_lazyXml = std::move(xmlData);
+                inflated.resize(0); // Now part of the table
+            }
+            m_memoryUsage = m_lazyXml.size() + m_lazyBounds.size() * sizeof(LazyBounds) +
+                            m_stringCount * sizeof(LazySlot);
+        } else {
+            parseSharedStringsXml(xmlData);
+        }
+        notePeak(m_lazyXml.empty() ? xmlData.size() : 0);
+        chargeTable();
         
         m_isOpen = true;
     }
@@ -47,16 +244,28 @@ public:
         m_isOpen = false;
         m_arena.clear();
         m_offsets.clear();
+        m_lengths.clear();
         m_arenaCapacity = 0;
         m_stringCount = 0;
         m_memoryUsage = 0;
+        m_peakMemoryUsage = 0;
         
-        if (m_isUsingDisk && !m_diskFilePath.empty()) {
-            std::filesystem::remove(m_diskFilePath);
-            m_diskFilePath.clear();
-        }
+        m_spillFile.close();
+        m_diskOffsets.clear();
         m_isUsingDisk = false;
+        m_spillReads = 0;
+        
+        m_lazyXml.clear();
+        m_lazyBounds.clear();
+        m_lazySlots.reset();
+        m_lazyChunks.clear();
+        m_lazyChunkUsed = 0;
+        m_lazyChunkCapacity = 0;
+        m_lazyChunkBytes = 0;
+        m_materializedCount = 0;
+        
         m_activeMode = m_config.mode;
+        m_tableCharge.reset();
     }
     
     bool isOpen() const {
@@ -80,14 +289,38 @@ public:
             return std::nullopt;
         }
         
+        auto view = tryGetStringView(index);
+        if (!view.has_value()) {
+            return std::nullopt;
+        }
+        return std::string(*view);
+    }
+    
+    std::string_view getStringView(size_t index) const {
+        if (!m_isOpen || index >= m_stringCount) {
+            throw XlsxError("Shared string index " + std::to_string(index) + " out of range");
+        }
+        auto result = tryGetStringView(index);
+        if (!result.has_value()) {
+            throw XlsxError("Shared string index " + std::to_string(index) + " out of range");
+        }
+        return *result;
+    }
+    
+    std::optional<std::string_view> tryGetStringView(size_t index) const {
+        if (!m_isOpen || index >= m_stringCount) {
+            return std::nullopt;
+        }
+        if (m_activeMode == SharedStringsMode::Lazy) {
+            return getStringViewLazy(index);
+        }
         if (m_isUsingDisk) {
-            return readStringFromDisk(index);
-        } else {
-            return getStringFromArena(index);
+            return getStringViewFromDisk(index);
         }
+        return getStringViewFromArena(index);
     }
     
-    std::optional<std::string> getStringFromArena(size_t index) const {
+    std::optional<std::string_view> getStringViewFromArena(size_t index) const {
         if (index >= m_offsets.size()) {
             return std::nullopt;
         }
@@ -97,9 +330,8 @@ public:
             return std::nullopt;
         }
         
-        // Strings are null-terminated in arena
-        const char* str = reinterpret_cast<const char*>(&m_arena[offset]);
-        return std::string(str);
+        // The arena is never reallocated after parsing, so views stay valid until close()
+        return std::string_view(reinterpret_cast<const char*>(&m_arena[offset]), m_lengths[index]);
     }
     
     size_t getStringCount() const {
@@ -119,14 +351,300 @@ public:
     }
     
     size_t getMemoryUsage() const {
-        return m_memoryUsage;
+        return m_memoryUsage + m_lazyChunkBytes.load(std::memory_order_relaxed);
+    }
+    
+    size_t getPeakMemoryUsage() const {
+        return std::max(m_peakMemoryUsage, getMemoryUsage());
+    }
+    
+    uint64_t getSpillReadCount() const {
+        return m_spillReads.load(std::memory_order_relaxed);
     }
     
     bool isUsingDisk() const {
         return m_isUsingDisk;
     }
+    
+    size_t getMaterializedCount() const {
+        if (m_activeMode != SharedStringsMode::Lazy) {
+            return m_stringCount;
+        }
+        std::lock_guard<std::mutex> lock(m_lazyMutex);
+        return m_materializedCount;
+    }
 
 private:
+    // Byte range of one <si> element inside m_lazyXml
+    struct LazyBounds {
+        uint64_t begin;
+        uint64_t end;
+    };
+    
+    // Publication slot for a lazily decoded string. The pointer is stored last
+    // with release ordering, so a non-null load sees the matching length.
+    struct LazySlot {
+        std::atomic<const char*> data{nullptr};
+        uint32_t length = 0;
+    };
+    
+    // Chunks start small so a selective read stays cheap, then double
+    static constexpr size_t LAZY_FIRST_CHUNK_SIZE = 64 * 1024;
+    static constexpr size_t LAZY_CHUNK_SIZE = 1024 * 1024;
+    
+    // Fast scan recording where each <si> element starts and ends. Returns
+    // false for documents the scanner does not handle (namespace-prefixed
+    // elements, comments, CDATA); those are parsed eagerly instead.
+    bool indexStringItems(const ByteVector& xmlData) {
+        const std::string_view xml(reinterpret_cast<const char*>(xmlData.data()), xmlData.size());
+        
+        size_t root = xml.find("<sst");
+        if (root == std::string_view::npos || xml.find("<!", 0) != std::string_view::npos) {
+            return false;
+        }
+        const size_t afterRootName = root + 4;
+        if (afterRootName >= xml.size() || !isTagNameEnd(xml[afterRootName])) {
+            return false;
+        }
+        
+        std::vector<LazyBounds> bounds;
+        size_t pos = afterRootName;
+        while ((pos = xml.find("<si", pos)) != std::string_view::npos) {
+            const size_t nameEnd = pos + 3;
+            if (nameEnd >= xml.size() || !isTagNameEnd(xml[nameEnd])) {
+                pos = nameEnd;
+                continue;
+            }
+            
+            const size_t tagEnd = findTagEnd(xml, nameEnd);
+            if (tagEnd == std::string_view::npos) {
+                return false;
+            }
+            
+            size_t itemEnd;
+            if (xml[tagEnd - 1] == '/') {
+                itemEnd = tagEnd + 1; // <si/>
+            } else {
+                size_t close = xml.find("</si", tagEnd);
+                if (close == std::string_view::npos) {
+                    return false;
+                }
+                itemEnd = findTagEnd(xml, close + 4);
+                if (itemEnd == std::string_view::npos) {
+                    return false;
+                }
+                ++itemEnd;
+            }
+            
+            bounds.push_back({pos, itemEnd});
+            pos = itemEnd;
+        }
+        
+        m_lazyBounds = std::move(bounds);
+        m_stringCount = m_lazyBounds.size();
+        m_lazySlots = std::make_unique<LazySlot[]>(m_stringCount);
+        return true;
+    }
+    
+    static bool isTagNameEnd(char ch) {
+        return ch == '>' || ch == '/' || ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+    
+    // Copies the indexed items back to back into a mapped spill file and
+    // rebases their bounds onto it, so the inflated XML can be dropped
+    void spillStringItems(const ByteVector& xmlData) {
+        initializeDiskStorage();
+        const std::string_view xml(reinterpret_cast<const char*>(xmlData.data()), xmlData.size());
+        for (LazyBounds& bounds : m_lazyBounds) {
+            const uint64_t begin = m_spillFile.size();
+            m_spillFile.append(xml.substr(static_cast<size_t>(bounds.begin),
+                                          static_cast<size_t>(bounds.end - bounds.begin)));
+            bounds = {begin, m_spillFile.size()};
+        }
+        m_spillFile.map();
+        m_diskOffsets.clear(); // Only the eager External layout uses offsets
+    }
+    
+    // Position of the '>' closing the tag that contains pos, skipping quoted attribute values
+    static size_t findTagEnd(std::string_view xml, size_t pos) {
+        char quote = 0;
+        for (; pos < xml.size(); ++pos) {
+            const char ch = xml[pos];
+            if (quote) {
+                if (ch == quote) {
+                    quote = 0;
+                }
+            } else if (ch == '"' || ch == '\'') {
+                quote = ch;
+            } else if (ch == '>') {
+                return pos;
+            }
+        }
+        return std::string_view::npos;
+    }
+    
+    std::optional<std::string_view> getStringViewLazy(size_t index) const {
+        LazySlot& slot = m_lazySlots[index];
+        const char* data = slot.data.load(std::memory_order_acquire);
+        if (!data) {
+            data = materialize(index);
+        }
+        return std::string_view(data, slot.length);
+    }
+    
+    // Decode string index on first reference. Decoded bytes go into fixed
+    // chunks that are never moved, so published views stay valid.
+    const char* materialize(size_t index) const {
+        std::string value = decodeStringItem(index);
+        
+        std::lock_guard<std::mutex> lock(m_lazyMutex);
+        LazySlot& slot = m_lazySlots[index];
+        if (const char* existing = slot.data.load(std::memory_order_relaxed)) {
+            return existing; // Another thread won the race
+        }
+        
+        const size_t needed = value.size() + 1;
+        if (m_lazyChunks.empty() || m_lazyChunkCapacity - m_lazyChunkUsed < needed) {
+            // An oversized string gets a chunk of its own size
+            const size_t grown = m_lazyChunks.empty() ? LAZY_FIRST_CHUNK_SIZE
+                                                      : std::min(m_lazyChunkCapacity * 2, LAZY_CHUNK_SIZE);
+            const size_t capacity = std::max(grown, needed);
+            const size_t chunkBytes = m_lazyChunkBytes.load(std::memory_order_relaxed) + capacity;
+            // Charged to the conversion doing the lookup, which for a reused
+            // table need not be the one that opened it. Throws over the limit,
+            // before allocating; the chunk then outlives the charge's tracker.
+            if (MemoryTracker* tracker = MemoryTracker::active()) {
+                tracker->charge(capacity);
+            }
+            m_lazyChunks.push_back(std::make_unique<char[]>(capacity));
+            m_lazyChunkCapacity = capacity;
+            m_lazyChunkUsed = 0;
+            m_lazyChunkBytes.store(chunkBytes, std::memory_order_relaxed);
+        }
+        char* dest = m_lazyChunks.back().get() + m_lazyChunkUsed;
+        std::copy(value.begin(), value.end(), dest);
+        dest[value.size()] = '\0';
+        m_lazyChunkUsed += needed;
+        
+        slot.length = static_cast<uint32_t>(value.size());
+        slot.data.store(dest, std::memory_order_release);
+        ++m_materializedCount;
+        return dest;
+    }
+    
+    // Concatenate the text of every <t> inside the item, matching the eager
+    // parser (which also flattens rich text runs)
+    std::string decodeStringItem(size_t index) const {
+        const LazyBounds& bounds = m_lazyBounds[index];
+        const uint64_t length = bounds.end - bounds.begin;
+        std::string_view item;
+        if (m_isUsingDisk) {
+            m_spillReads.fetch_add(1, std::memory_order_relaxed);
+            item = m_spillFile.view(bounds.begin, length);
+        } else {
+            item = std::string_view(reinterpret_cast<const char*>(m_lazyXml.data()) + bounds.begin,
+                                    static_cast<size_t>(length));
+        }
+        std::string result;
+        
+        size_t pos = 0;
+        while ((pos = item.find("<t", pos)) != std::string_view::npos) {
+            const size_t nameEnd = pos + 2;
+            if (nameEnd >= item.size() || !isTagNameEnd(item[nameEnd])) {
+                pos = nameEnd;
+                continue;
+            }
+            const size_t tagEnd = findTagEnd(item, nameEnd);
+            if (tagEnd == std::string_view::npos) {
+                break;
+            }
+            pos = tagEnd + 1;
+            if (item[tagEnd - 1] == '/') {
+                continue; // <t/>
+            }
+            
+            const size_t textEnd = item.find('<', pos);
+            appendDecodedText(result, item.substr(pos, textEnd == std::string_view::npos ? std::string_view::npos : textEnd - pos));
+            if (textEnd == std::string_view::npos) {
+                break;
+            }
+            pos = textEnd;
+        }
+        
+        // Truncate if too long
+        if (result.length() > m_config.maxStringLength) {
+            result.resize(m_config.maxStringLength);
+        }
+        return result;
+    }
+    
+    // Resolve XML entities and normalize line endings as an XML parser would
+    static void appendDecodedText(std::string& out, std::string_view text) {
+        for (size_t i = 0; i < text.size(); ++i) {
+            const char ch = text[i];
+            if (ch == '\r') {
+                out.push_back('\n');
+                if (i + 1 < text.size() && text[i + 1] == '\n') {
+                    ++i;
+                }
+                continue;
+            }
+            if (ch != '&') {
+                out.push_back(ch);
+                continue;
+            }
+            
+            const size_t semi = text.find(';', i + 1);
+            if (semi == std::string_view::npos) {
+                out.push_back(ch);
+                continue;
+            }
+            const std::string_view entity = text.substr(i + 1, semi - i - 1);
+            if (entity == "lt") {
+                out.push_back('<');
+            } else if (entity == "gt") {
+                out.push_back('>');
+            } else if (entity == "amp") {
+                out.push_back('&');
+            } else if (entity == "quot") {
+                out.push_back('"');
+            } else if (entity == "apos") {
+                out.push_back('\'');
+            } else if (entity.size() > 1 && entity[0] == '#') {
+                const bool hex = entity[1] == 'x' || entity[1] == 'X';
+                const std::string digits(entity.substr(hex ? 2 : 1));
+                char* end = nullptr;
+                const unsigned long codePoint = std::strtoul(digits.c_str(), &end, hex ? 16 : 10);
+                if (digits.empty() || *end != '\0' || codePoint > 0x10FFFF) {
+                    out.append(text.substr(i, semi - i + 1));
+                } else {
+                    appendUtf8(out, static_cast<uint32_t>(codePoint));
+                }
+            } else {
+                out.append(text.substr(i, semi - i + 1)); // Unknown entity, keep verbatim
+            }
+            i = semi;
+        }
+    }
+    
+    static void appendUtf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+    
     void parseSharedStringsXml(const ByteVector& xmlData) {
         // Heuristic estimate: extracted string payload is often in the same order
         // of magnitude as sharedStrings.xml.
@@ -153,8 +671,56 @@ private:
         xmlFreeTextReader(reader);
     }
     
+    // Parses sharedStrings.xml while it is being inflated
+    void parseSharedStringsStream(ZipEntryStream& stream) {
+        decideStorageMode(stream.uncompressedSize());
+        
+        StreamInput input{&stream, {}};
+        xmlTextReaderPtr reader = xmlReaderForIO(
+            &readStreamCallback, nullptr, &input,
+            nullptr, nullptr,
+            XML_PARSE_RECOVER | XML_PARSE_NONET | XML_PARSE_NOENT
+        );
+        
+        if (!reader) {
+            throw XlsxError("Failed to create XML reader for sharedStrings.xml");
+        }
+        
+        try {
+            parseStrings(reader);
+        } catch (...) {
+            xmlFreeTextReader(reader);
+            throw;
+        }
+        
+        xmlFreeTextReader(reader);
+        if (!input.error.empty()) {
+            throw XlsxError("Failed to read sharedStrings.xml: " + input.error);
+        }
+    }
+    
+    struct StreamInput {
+        ZipEntryStream* stream;
+        std::string error; // Exceptions must not cross the libxml2 C boundary
+    };
+    
+    static int readStreamCallback(void* context, char* buffer, int len) {
+        auto* input = static_cast<StreamInput*>(context);
+        if (len <= 0) {
+            return 0;
+        }
+        try {
+            return static_cast<int>(input->stream->read(reinterpret_cast<uint8_t*>(buffer),
+                                                        static_cast<size_t>(len)));
+        } catch (const std::exception& e) {
+            input->error = e.what();
+            return -1;
+        }
+    }
+    
     void decideStorageMode(size_t estimatedSize) {
         switch (m_config.mode) {
+            case SharedStringsMode::Lazy: // Document not suited to lazy indexing
             case SharedStringsMode::InMemory:
                 m_activeMode = SharedStringsMode::InMemory;
                 m_isUsingDisk = false;
@@ -179,6 +745,7 @@ private:
             m_arenaCapacity = std::max(INITIAL_ARENA_SIZE, estimatedSize * 2);
             m_arena.reserve(m_arenaCapacity);
             m_offsets.reserve(1024);
+            m_lengths.reserve(1024);
         }
     }
     
@@ -186,13 +753,11 @@ private:
         m_isUsingDisk = true;
         
         // Create temporary file for disk storage
-        auto tempDir = std::filesystem::temp_directory_path();
-        m_diskFilePath = tempDir / ("turboxl_strings_" + std::to_string(reinterpret_cast<uintptr_t>(this)) + ".tmp");
-        
-        m_diskFile.open(m_diskFilePath, std::ios::binary | std::ios::out | std::ios::in | std::ios::trunc);
-        if (!m_diskFile.is_open()) {
-            throw XlsxError("Failed to create temporary file for shared strings storage");
-        }
+        std::filesystem::path tempDir = m_config.tempDirectory.empty()
+            ? std::filesystem::temp_directory_path()
+            : std::filesystem::path(m_config.tempDirectory);
+        m_spillFile.create(tempDir);
+        m_diskOffsets.assign(1, 0);
     }
     
     void parseStrings(xmlTextReaderPtr reader) {
@@ -202,7 +767,9 @@ private:
             if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
                 auto nodeName = getNodeName(reader);
                 if (nodeName == "si") {
-                    auto stringValue = parseStringItem(reader);
+                    // <si/> has no subtree to read; descending would swallow the next item
+                    auto stringValue = xmlTextReaderIsEmptyElement(reader) == 1
+                        ? std::string() : parseStringItem(reader);
                     storeString(currentIndex, stringValue);
                     currentIndex++;
                 }
@@ -212,7 +779,7 @@ private:
         m_stringCount = currentIndex;
         
         if (m_isUsingDisk) {
-            m_diskFile.flush();
+            m_spillFile.map();
         }
     }
     
@@ -301,8 +868,10 @@ private:
         uint32_t offset = static_cast<uint32_t>(m_arena.size());
         if (index >= m_offsets.size()) {
             m_offsets.resize(index + 1);
+            m_lengths.resize(index + 1);
         }
         m_offsets[index] = offset;
+        m_lengths[index] = static_cast<uint32_t>(value.size());
         
         // Append string to arena with null terminator
         m_arena.insert(m_arena.end(), value.begin(), value.end());
@@ -312,41 +881,23 @@ private:
     }
     
     void storeStringToDisk(size_t index, const std::string& value) {
-        // Simple format: [length][string] for each entry
-        uint32_t length = static_cast<uint32_t>(value.size());
-        
-        m_diskFile.seekp(0, std::ios::end);
-        m_diskFile.write(reinterpret_cast<const char*>(&length), sizeof(length));
-        m_diskFile.write(value.data(), length);
-        
-        // Store offset for quick lookup
-        if (index >= m_diskOffsets.size()) {
-            m_diskOffsets.resize(index + 1);
+        // Strings are stored back to back; the index keeps one extra end offset
+        // so a string's length is the distance to the next offset
+        if (index + 1 != m_diskOffsets.size()) {
+            throw XlsxError("Shared strings must be stored in order");
         }
-        m_diskOffsets[index] = m_diskFile.tellp() - static_cast<std::streampos>(sizeof(length) + length);
+        m_spillFile.append(value);
+        m_diskOffsets.push_back(m_spillFile.size());
     }
     
-    std::optional<std::string> readStringFromDisk(size_t index) const {
-        if (!m_isUsingDisk || index >= m_diskOffsets.size()) {
-            return std::nullopt;
-        }
-        
-        auto& file = const_cast<std::fstream&>(m_diskFile);
-        file.seekg(m_diskOffsets[index]);
-        
-        uint32_t length;
-        file.read(reinterpret_cast<char*>(&length), sizeof(length));
-        if (file.gcount() != sizeof(length)) {
-            return std::nullopt;
-        }
-        
-        std::string result(length, '\0');
-        file.read(result.data(), length);
-        if (file.gcount() != static_cast<std::streamsize>(length)) {
+    std::optional<std::string_view> getStringViewFromDisk(size_t index) const {
+        if (index + 1 >= m_diskOffsets.size()) {
             return std::nullopt;
         }
         
-        return result;
+        m_spillReads.fetch_add(1, std::memory_order_relaxed);
+        const uint64_t begin = m_diskOffsets[index];
+        return m_spillFile.view(begin, m_diskOffsets[index + 1] - begin);
     }
     
     std::string getNodeName(xmlTextReaderPtr reader) {
@@ -377,23 +928,65 @@ private:
     }
 
 private:
+    // Buffers of a pipelined stream with the default chunk size and count
+    static constexpr uint64_t PIPELINE_RING_BYTES = 4 * 256 * 1024;
+    
+    static uint64_t declaredSize(const ZipReader& zip, const std::string& path) {
+        const ZipEntry* entry = zip.findEntry(path);
+        return entry ? entry->uncompressedSize : 0;
+    }
+    
+    // The table plus whatever parse() held alongside it (inflated XML or the
+    // pipeline ring) while it was being built
+    void notePeak(size_t transientBytes) {
+        m_peakMemoryUsage = std::max(m_peakMemoryUsage, m_memoryUsage + transientBytes);
+    }
+    
+    // Charges the parsed table to the tracker. A refused libxml2 allocation
+    // only truncates a recovering parse, so the refusal is raised here.
+    void chargeTable() {
+        MemoryTracker* tracker = m_config.memoryTracker;
+        if (!tracker) {
+            return;
+        }
+        tracker->throwIfLimitExceeded();
+        if (!m_tableCharge) {
+            m_tableCharge.emplace(tracker);
+        }
+        m_tableCharge->resize(m_memoryUsage);
+    }
+    
     SharedStringsConfig m_config;
+    std::optional<MemoryCharge> m_tableCharge;
     bool m_isOpen;
     SharedStringsMode m_activeMode;
     size_t m_stringCount;
     size_t m_memoryUsage;
+    size_t m_peakMemoryUsage = 0;
     
     // Arena-based storage (performance optimization)
     std::vector<uint8_t> m_arena;          // Single arena buffer for all strings
     std::vector<uint32_t> m_offsets;       // Start offset of each string in arena
+    std::vector<uint32_t> m_lengths;       // Byte length of each string (excluding terminator)
     size_t m_arenaCapacity;                // Current arena capacity
     static constexpr size_t INITIAL_ARENA_SIZE = 8 * 1024 * 1024;  // 8MB initial
     
     // Disk storage
     bool m_isUsingDisk;
-    std::filesystem::path m_diskFilePath;
-    mutable std::fstream m_diskFile;
-    std::vector<std::streampos> m_diskOffsets;
+    SpillFile m_spillFile;                 // Mapped read-only once parsing finishes
+    std::vector<uint64_t> m_diskOffsets;   // String i spans [offsets[i], offsets[i + 1])
+    mutable std::atomic<uint64_t> m_spillReads{0}; // Lookups served from the mapped file
+    
+    // Lazy storage: raw XML plus per-item bounds, decoded on first lookup
+    ByteVector m_lazyXml;
+    std::vector<LazyBounds> m_lazyBounds;
+    std::unique_ptr<LazySlot[]> m_lazySlots;
+    mutable std::vector<std::unique_ptr<char[]>> m_lazyChunks;
+    mutable size_t m_lazyChunkUsed = 0;
+    mutable size_t m_lazyChunkCapacity = 0;
+    mutable std::atomic<size_t> m_lazyChunkBytes{0}; // Read without the lock by getMemoryUsage()
+    mutable size_t m_materializedCount = 0;
+    mutable std::mutex m_lazyMutex;
     
 };
 
@@ -430,6 +1023,14 @@ std::optional<std::string> SharedStringsProvider::tryGetString(size_t index) con
     return m_impl->tryGetString(index);
 }
 
+std::string_view SharedStringsProvider::getStringView(size_t index) const {
+    return m_impl->getStringView(index);
+}
+
+std::optional<std::string_view> SharedStringsProvider::tryGetStringView(size_t index) const {
+    return m_impl->tryGetStringView(index);
+}
+
 size_t SharedStringsProvider::getStringCount() const {
     return m_impl->getStringCount();
 }
@@ -450,8 +1051,20 @@ size_t SharedStringsProvider::getMemoryUsage() const {
     return m_impl->getMemoryUsage();
 }
 
+size_t SharedStringsProvider::getPeakMemoryUsage() const {
+    return m_impl->getPeakMemoryUsage();
+}
+
+uint64_t SharedStringsProvider::getSpillReadCount() const {
+    return m_impl->getSpillReadCount();
+}
+
 bool SharedStringsProvider::isUsingDisk() const {
     return m_impl->isUsingDisk();
 }
 
+size_t SharedStringsProvider::getMaterializedCount() const {
+    return m_impl->getMaterializedCount();
+}
+
 } // namespace xlsxcsv::core
@@ -0,0 +1,117 @@
+#pragma once
+
+// Attribute and value interpretation shared by the libxml2 and fast worksheet
+// parsers, so both backends produce identical RowData for the same input.
+
+#include "xlsxcsv/core.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <string_view>
+#include <system_error>
+
+namespace xlsxcsv::core::sheet_parsing {
+
+inline bool parseInt(std::string_view text, int& out) {
+    if (text.empty()) {
+        return false;
+    }
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, out);
+    return ec == std::errc{} && ptr == end;
+}
+
+// Column of a cell reference such as "BC42"; the row digits are only checked
+// for a valid leading digit since the enclosing <row> supplies the row number
+inline bool parseCellColumn(std::string_view ref, int& outColumn) {
+    int column = 0;
+    size_t i = 0;
+    while (i < ref.size() && ref[i] >= 'A' && ref[i] <= 'Z') {
+        column = (column * 26) + (ref[i] - 'A' + 1);
+        ++i;
+    }
+    if (column == 0) {
+        return false;
+    }
+    if (i >= ref.size() || ref[i] < '1' || ref[i] > '9') {
+        return false;
+    }
+    outColumn = column;
+    return true;
+}
+
+inline bool parseBooleanAttribute(std::string_view value) {
+    return value == "1" || value == "true";
+}
+
+// Reserve hint from a row "spans" attribute ("first:last"), 0 when absent or invalid
+inline int parseSpansHint(std::string_view value) {
+    const size_t colon = value.find(':');
+    if (colon == std::string_view::npos) {
+        return 0;
+    }
+    int first = 0;
+    int last = 0;
+    if (parseInt(value.substr(0, colon), first) &&
+        parseInt(value.substr(colon + 1), last) &&
+        last >= first) {
+        return std::min(last - first + 1, 16384);
+    }
+    return 0;
+}
+
+inline CellType parseCellType(std::string_view value) {
+    if (value == "b") return CellType::Boolean;
+    if (value == "e") return CellType::Error;
+    if (value == "n") return CellType::Number;
+    if (value == "s") return CellType::SharedString;
+    if (value == "str") return CellType::String;
+    if (value == "inlineStr") return CellType::InlineString;
+    return CellType::Unknown;
+}
+
+// Converts the text of a <v> element; text values are copied into the row's
+// arena. valueText must be followed in memory by a byte that cannot continue a
+// number (a NUL or the '<' of the next tag) because numbers are parsed with strtod.
+inline CellValue convertCellValue(std::string_view valueText, CellType type, RowData& row) {
+    if (valueText.empty()) {
+        return std::monostate{};
+    }
+
+    switch (type) {
+        case CellType::Boolean: {
+            // Excel booleans: "0" = false, "1" = true
+            return valueText == "1";
+        }
+
+        case CellType::Number: {
+            const char* begin = valueText.data();
+            char* parseEnd = nullptr;
+            double parsed = std::strtod(begin, &parseEnd);
+            if (parseEnd == begin + valueText.size()) {
+                return parsed;
+            }
+            return std::monostate{};
+        }
+
+        case CellType::SharedString: {
+            int index = 0;
+            const char* begin = valueText.data();
+            const char* end = begin + valueText.size();
+            auto [ptr, ec] = std::from_chars(begin, end, index);
+            if (ec == std::errc{} && ptr == end) {
+                // Keep shared-string index and defer lookup to CSV conversion.
+                return index;
+            }
+            return std::monostate{};
+        }
+
+        case CellType::Error:
+        case CellType::String:
+        case CellType::InlineString:
+        default:
+            return row.appendText(valueText);
+    }
+}
+
+} // namespace xlsxcsv::core::sheet_parsing
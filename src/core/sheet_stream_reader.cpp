@@ -1,13 +1,22 @@
 #include "xlsxcsv/core.hpp"
+#include "fast_sheet_parser.hpp"
+#include "sheet_cell_parsing.hpp"
+#include <libxml/parser.h>
+#include <libxml/xmlerror.h>
 #include <libxml/xmlreader.h>
 #include <libxml/xmlstring.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <stdexcept>
 #include <memory>
 #include <sstream>
-#include <charconv>
 #include <cstring>
+#include <cstdarg>
+#include <cstdio>
 #include <cstdlib>
-#include <system_error>
+#include <string_view>
 
 namespace xlsxcsv::core {
 
@@ -22,14 +31,251 @@ public:
                    const SharedStringsProvider* sharedStrings,
                    const StylesRegistry* styles) {
         
-        // Read worksheet XML from package
-        // The sheetPath is relative to xl/ directory, so prefix it
-        std::string fullPath = sheetPath;
-        if (fullPath.find("xl/") != 0) {
-            fullPath = "xl/" + fullPath;
+        // Stream the entry so inflate and parse run in lockstep instead of
+        // materializing the whole worksheet XML first, or side by side when
+        // inflating is pipelined onto its own thread
+        const ZipReader& zip = package.getZipReader();
+        MemoryCharge ring(m_tracker, m_pipelinedInflate ? PIPELINE_RING_BYTES : 0);
+        auto stream = m_pipelinedInflate ? zip.openPipelinedEntryStream(entryPath(sheetPath))
+                                         : zip.openEntryStream(entryPath(sheetPath));
+        parseSheetStream(stream, handler, sharedStrings, styles);
+    }
+    
+    void parseSheetParallel(const OpcPackage& package,
+                            const std::string& sheetPath,
+                            ChunkedRowHandler& handler,
+                            unsigned threads,
+                            const SharedStringsProvider* sharedStrings,
+                            const StylesRegistry* styles) {
+        threads = resolveThreadCount(threads);
+        if (threads <= 1 || m_backend == SheetParserBackend::LibXml || m_filter.limitsRows()) {
+            auto chunk = handler.createChunkHandler();
+            parseSheet(package, sheetPath, *chunk, sharedStrings, styles);
+            handler.completeChunk(*chunk);
+            return;
         }
-        auto xmlData = package.getZipReader().readEntry(fullPath);
-        parseSheetData(xmlData, handler, sharedStrings, styles);
+        // Splitting needs random access to the rows, so the entry is inflated whole
+        const ZipReader& zip = package.getZipReader();
+        MemoryCharge inflated(m_tracker, m_tracker ? declaredSize(zip, entryPath(sheetPath)) : 0);
+        const ByteVector xmlData = zip.readEntry(entryPath(sheetPath));
+        parseSheetDataParallel(xmlData, handler, threads, sharedStrings, styles);
+    }
+    
+    void parseSheetDataParallel(const std::vector<uint8_t>& xmlData,
+                                ChunkedRowHandler& handler,
+                                unsigned threads,
+                                const SharedStringsProvider* sharedStrings,
+                                const StylesRegistry* styles) {
+        threads = resolveThreadCount(threads);
+        auto first = handler.createChunkHandler();
+        if (xmlData.empty() || threads <= 1 || m_backend == SheetParserBackend::LibXml || m_filter.limitsRows()) {
+            parseSheetData(xmlData, *first, sharedStrings, styles);
+            handler.completeChunk(*first);
+            return;
+        }
+        
+        const char* data = reinterpret_cast<const char*>(xmlData.data());
+        FastSheetParser head(data, xmlData.size());
+        MetadataCapture capture(*first);
+        size_t rowsBegin = 0;
+        bool handled = false;
+        try {
+            handled = head.parseHead(capture, rowsBegin);
+        } catch (const std::exception& e) {
+            first->handleError("Worksheet parsing error: " + std::string(e.what()));
+            handler.completeChunk(*first);
+            return;
+        }
+        if (!handled) {
+            // The scanner stopped in the prolog before any handler call
+            if (m_backend == SheetParserBackend::Fast) {
+                first->handleError("Worksheet parsing error: document requires the libxml2 parser backend");
+            } else {
+                parseWithLibXml(xmlData, *first, sharedStrings, styles);
+            }
+            handler.completeChunk(*first);
+            return;
+        }
+        if (rowsBegin == 0) {
+            handler.completeChunk(*first);
+            return;
+        }
+        
+        const std::string_view document(data, xmlData.size());
+        size_t rowsEnd = document.rfind("</sheetData>");
+        if (rowsEnd == std::string_view::npos || rowsEnd < rowsBegin) {
+            // Truncated document; the tail parse reports where it ends
+            rowsEnd = document.size();
+        }
+        std::vector<size_t> bounds{rowsBegin};
+        if (handler.canSplitRows(capture.metadata)) {
+            splitRows(document, rowsBegin, rowsEnd, threads, bounds);
+        }
+        bounds.push_back(rowsEnd);
+        
+        const size_t chunkCount = bounds.size() - 1;
+        std::vector<std::unique_ptr<SheetRowHandler>> chunks(chunkCount);
+        chunks[0] = std::move(first);
+        for (size_t i = 1; i < chunkCount; ++i) {
+            chunks[i] = createChunk(handler, capture);
+        }
+        
+        // Workers claim chunks in order but stay at most a window ahead of the
+        // chunk being completed, so finished output does not pile up
+        struct ChunkState {
+            bool done = false;
+            bool failed = false;
+        };
+        std::vector<ChunkState> states(chunkCount);
+        const size_t window = static_cast<size_t>(threads) * 2;
+        std::mutex mutex;
+        std::condition_variable changed;
+        size_t nextChunk = 0;
+        size_t completed = 0;
+        bool cancelled = false;
+        
+        auto worker = [&]() {
+            MemoryTracker::Scope track(m_tracker);
+            for (;;) {
+                size_t i = 0;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&]() {
+                        return cancelled || nextChunk >= chunkCount || nextChunk < completed + window;
+                    });
+                    if (cancelled || nextChunk >= chunkCount) {
+                        return;
+                    }
+                    i = nextChunk++;
+                }
+                bool failed = false;
+                try {
+                    FastSheetParser parser(data, xmlData.size());
+                    parser.setFilter(&m_filter);
+                    parser.parseRows(bounds[i], bounds[i + 1], *chunks[i]);
+                } catch (...) {
+                    failed = true;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    states[i].done = true;
+                    states[i].failed = failed;
+                }
+                changed.notify_all();
+            }
+        };
+        
+        std::vector<std::thread> workers;
+        const size_t workerCount = std::min(static_cast<size_t>(threads), chunkCount);
+        workers.reserve(workerCount);
+        for (size_t t = 0; t < workerCount; ++t) {
+            workers.emplace_back(worker);
+        }
+        auto stopWorkers = [&]() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                cancelled = true;
+            }
+            changed.notify_all();
+            for (auto& w : workers) {
+                w.join();
+            }
+            workers.clear();
+        };
+        
+        try {
+            for (size_t i = 0; i < chunkCount; ++i) {
+                bool failed = false;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&]() { return states[i].done; });
+                    failed = states[i].failed;
+                }
+                if (failed) {
+                    // A split point can land inside a comment or CDATA section;
+                    // re-parse everything from this chunk on as one range so a
+                    // genuine error is reported just as a serial parse would
+                    stopWorkers();
+                    auto rest = createChunk(handler, capture);
+                    try {
+                        FastSheetParser parser(data, xmlData.size());
+                        parser.setFilter(&m_filter);
+                        parser.parseRows(bounds[i], rowsEnd, *rest);
+                        head.parseTail(rowsEnd, *rest);
+                    } catch (const std::exception& e) {
+                        rest->handleError("Worksheet parsing error: " + std::string(e.what()));
+                    }
+                    handler.completeChunk(*rest);
+                    return;
+                }
+                if (i + 1 == chunkCount) {
+                    try {
+                        head.parseTail(rowsEnd, *chunks[i]);
+                    } catch (const std::exception& e) {
+                        chunks[i]->handleError("Worksheet parsing error: " + std::string(e.what()));
+                    }
+                }
+                handler.completeChunk(*chunks[i]);
+                chunks[i].reset();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    completed = i + 1;
+                }
+                changed.notify_all();
+            }
+        } catch (...) {
+            stopWorkers();
+            throw;
+        }
+        stopWorkers();
+    }
+    
+    void parseSheetStream(ZipEntryStream& stream,
+                         SheetRowHandler& handler,
+                         const SharedStringsProvider* sharedStrings,
+                         const StylesRegistry* styles) {
+        
+        if (stream.uncompressedSize() == 0) {
+            handler.handleError("Empty worksheet data");
+            return;
+        }
+        
+        StreamInput input{&stream, nullptr, 0, {}};
+        std::unique_ptr<FastSheetParser> fastParser;
+        if (m_backend != SheetParserBackend::LibXml) {
+            fastParser = std::make_unique<FastSheetParser>(stream);
+            fastParser->setFilter(&m_filter);
+            if (runFastParser(*fastParser, handler)) {
+                return;
+            }
+            // The fast scanner stopped in the prolog; replay what it consumed
+            input.replay = fastParser->consumedData();
+            input.replayRemaining = fastParser->consumedSize();
+        }
+        
+        XmlErrorCapture xmlErrors;
+        xmlTextReaderPtr reader = xmlReaderForIO(
+            &Impl::readStreamCallback, nullptr, &input,
+            nullptr, nullptr, XML_PARSE_NOENT | XML_PARSE_NOCDATA);
+        
+        if (!reader) {
+            handler.handleError(xmlErrors.describe("Failed to create XML reader for worksheet"));
+            return;
+        }
+        xmlErrors.attach(reader);
+        
+        // Parse worksheet
+        try {
+            parseWorksheetXml(reader, handler, sharedStrings, styles);
+        } catch (const std::exception& e) {
+            if (!input.error.empty()) {
+                handler.handleError("Worksheet parsing error: " + input.error);
+            } else {
+                handler.handleError("Worksheet parsing error: " + xmlErrors.describe(e.what()));
+            }
+        }
+        
+        xmlFreeTextReader(reader);
     }
     
     void parseSheetData(const std::vector<uint8_t>& xmlData,
@@ -42,75 +288,254 @@ public:
             return;
         }
         
+        if (m_backend != SheetParserBackend::LibXml) {
+            FastSheetParser fastParser(reinterpret_cast<const char*>(xmlData.data()), xmlData.size());
+            fastParser.setFilter(&m_filter);
+            if (runFastParser(fastParser, handler)) {
+                return;
+            }
+        }
+        parseWithLibXml(xmlData, handler, sharedStrings, styles);
+    }
+
+    SheetParserBackend m_backend = SheetParserBackend::Auto;
+    SheetReadFilter m_filter;
+    bool m_pipelinedInflate = false;
+    MemoryTracker* m_tracker = nullptr;
+
+private:
+    // Row ranges below this size are not worth a chunk of their own
+    static constexpr size_t MIN_CHUNK_BYTES = 1024 * 1024;
+    // Buffers of a pipelined stream with the default chunk size and count
+    static constexpr uint64_t PIPELINE_RING_BYTES = 4 * 256 * 1024;
+    
+    static uint64_t declaredSize(const ZipReader& zip, const std::string& path) {
+        const ZipEntry* entry = zip.findEntry(path);
+        return entry ? entry->uncompressedSize : 0; // readEntry reports the missing entry
+    }
+    // Chunks per worker, so uneven row density still balances out
+    static constexpr size_t CHUNKS_PER_THREAD = 4;
+    
+    // Forwards parse callbacks, keeping the metadata seen before the first row
+    class MetadataCapture : public SheetRowHandler {
+    public:
+        explicit MetadataCapture(SheetRowHandler& target) : m_target(target) {}
+        void handleRow(const RowData& row) override { m_target.handleRow(row); }
+        void handleError(const std::string& message) override { m_target.handleError(message); }
+        void handleWorksheetMetadata(const WorksheetMetadata& data) override {
+            metadata = data;
+            seen = true;
+            m_target.handleWorksheetMetadata(data);
+        }
+        
+        WorksheetMetadata metadata;
+        bool seen = false;
+        
+    private:
+        SheetRowHandler& m_target;
+    };
+    
+    // The sheetPath is relative to the xl/ directory
+    static std::string entryPath(const std::string& sheetPath) {
+        if (sheetPath.find("xl/") != 0) {
+            return "xl/" + sheetPath;
+        }
+        return sheetPath;
+    }
+    
+    static unsigned resolveThreadCount(unsigned threads) {
+        return threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads;
+    }
+    
+    // Chunk handler primed with the metadata a serial handler had at the first row
+    static std::unique_ptr<SheetRowHandler> createChunk(ChunkedRowHandler& handler,
+                                                        const MetadataCapture& capture) {
+        auto chunk = handler.createChunkHandler();
+        if (capture.seen) {
+            chunk->handleWorksheetMetadata(capture.metadata);
+        }
+        return chunk;
+    }
+    
+    // Appends chunk start offsets after begin, each at a "<row" tag
+    static void splitRows(std::string_view document, size_t begin, size_t end,
+                          unsigned threads, std::vector<size_t>& bounds) {
+        const size_t chunkBytes = std::max(MIN_CHUNK_BYTES, (end - begin) / (threads * CHUNKS_PER_THREAD));
+        size_t pos = begin + chunkBytes;
+        while (pos < end) {
+            size_t found = document.find("<row", pos);
+            while (found != std::string_view::npos && found + 4 < end) {
+                const char next = document[found + 4];
+                if (next == ' ' || next == '>' || next == '/' || next == '\t' || next == '\n' || next == '\r') {
+                    break;
+                }
+                found = document.find("<row", found + 4);
+            }
+            if (found == std::string_view::npos || found + 4 >= end) {
+                break;
+            }
+            bounds.push_back(found);
+            pos = found + chunkBytes;
+        }
+    }
+    
+    void parseWithLibXml(const std::vector<uint8_t>& xmlData,
+                         SheetRowHandler& handler,
+                         const SharedStringsProvider* sharedStrings,
+                         const StylesRegistry* styles) {
         // Create XML reader from memory
+        XmlErrorCapture xmlErrors;
         xmlTextReaderPtr reader = xmlReaderForMemory(
             reinterpret_cast<const char*>(xmlData.data()),
             static_cast<int>(xmlData.size()),
             nullptr, nullptr, XML_PARSE_NOENT | XML_PARSE_NOCDATA);
         
         if (!reader) {
-            handler.handleError("Failed to create XML reader for worksheet");
+            handler.handleError(xmlErrors.describe("Failed to create XML reader for worksheet"));
             return;
         }
+        xmlErrors.attach(reader);
         
         // Parse worksheet
         try {
             parseWorksheetXml(reader, handler, sharedStrings, styles);
         } catch (const std::exception& e) {
-            handler.handleError("Worksheet parsing error: " + std::string(e.what()));
+            handler.handleError("Worksheet parsing error: " + xmlErrors.describe(e.what()));
         }
         
         xmlFreeTextReader(reader);
     }
+    
+    // Reused across rows so cell storage, the text arena and the text scratch
+    // keep their capacity
+    RowData m_row;
+    std::string m_text;
+    size_t m_rowsSkipped = 0;   // Filter progress of the current libxml2 parse
+    size_t m_rowsReported = 0;
 
-private:
-    static bool parseIntRange(const char* begin, const char* end, int& out) {
-        if (!begin || !end || begin >= end) {
-            return false;
+    // Collects libxml2's messages for a parse on the calling thread instead of
+    // letting it print them to stderr (e.g. "Memory allocation failed" once a
+    // memory limit refuses its allocations). The reader's own handler covers
+    // parse errors; the thread's handlers cover creating the reader.
+    class XmlErrorCapture {
+    public:
+        XmlErrorCapture()
+            : m_generic(xmlGenericError), m_genericContext(xmlGenericErrorContext),
+              m_structured(xmlStructuredError), m_structuredContext(xmlStructuredErrorContext) {
+            xmlSetGenericErrorFunc(this, &XmlErrorCapture::genericError);
+            xmlSetStructuredErrorFunc(this, &XmlErrorCapture::structuredError);
         }
-        auto [ptr, ec] = std::from_chars(begin, end, out);
-        return ec == std::errc{} && ptr == end;
-    }
-
-    static bool parseCellColumn(const char* ref, int& outColumn) {
-        if (!ref || *ref == '\0') {
-            return false;
+        
+        ~XmlErrorCapture() {
+            xmlSetGenericErrorFunc(m_genericContext, m_generic);
+            xmlSetStructuredErrorFunc(m_structuredContext, m_structured);
         }
-
-        int column = 0;
-        const char* p = ref;
-
-        while (*p >= 'A' && *p <= 'Z') {
-            column = (column * 26) + (*p - 'A' + 1);
-            ++p;
+        
+        XmlErrorCapture(const XmlErrorCapture&) = delete;
+        XmlErrorCapture& operator=(const XmlErrorCapture&) = delete;
+        
+        void attach(xmlTextReaderPtr reader) {
+            xmlTextReaderSetStructuredErrorHandler(reader, &XmlErrorCapture::structuredError, this);
         }
-        if (column == 0) {
-            return false;
+        
+        // The message with libxml2's first error appended, if it reported one
+        std::string describe(const std::string& message) const {
+            return m_first.empty() ? message : message + " (" + m_first + ")";
+        }
+        
+    private:
+#if LIBXML_VERSION >= 21200
+        static void structuredError(void* context, const xmlError* error) {
+#else
+        static void structuredError(void* context, xmlErrorPtr error) {
+#endif
+            auto* capture = static_cast<XmlErrorCapture*>(context);
+            if (error && error->message) {
+                capture->record(error->message);
+            } else if (error && error->code == XML_ERR_NO_MEMORY) {
+                capture->record("Memory allocation failed"); // No memory left to format it
+            }
         }
+        
+        static void genericError(void* context, const char* format, ...) {
+            char buffer[256];
+            va_list args;
+            va_start(args, format);
+            std::vsnprintf(buffer, sizeof(buffer), format, args);
+            va_end(args);
+            static_cast<XmlErrorCapture*>(context)->record(buffer);
+        }
+        
+        void record(std::string_view message) {
+            while (!message.empty() && (message.back() == '\n' || message.back() == ' ')) {
+                message.remove_suffix(1);
+            }
+            if (m_first.empty()) {
+                m_first = message;
+            }
+        }
+        
+        xmlGenericErrorFunc m_generic;
+        void* m_genericContext;
+        xmlStructuredErrorFunc m_structured;
+        void* m_structuredContext;
+        std::string m_first;
+    };
 
-        if (*p < '1' || *p > '9') {
-            return false;
+    struct StreamInput {
+        ZipEntryStream* stream;
+        const char* replay;     // Bytes the fast scanner read before falling back
+        size_t replayRemaining;
+        std::string error; // Exceptions must not cross the libxml2 C boundary
+    };
+    
+    // Returns true when the fast scanner handled the worksheet, including
+    // reporting any parse error; false when libxml2 should parse it instead
+    bool runFastParser(FastSheetParser& parser, SheetRowHandler& handler) {
+        try {
+            if (parser.parse(handler)) {
+                return true;
+            }
+        } catch (const std::exception& e) {
+            handler.handleError("Worksheet parsing error: " + std::string(e.what()));
+            return true;
         }
-        outColumn = column;
-        return true;
+        if (m_backend == SheetParserBackend::Fast) {
+            handler.handleError("Worksheet parsing error: document requires the libxml2 parser backend");
+            return true;
+        }
+        return false;
     }
-
-    static bool parseInt(const char* s, int& out) {
-        if (!s || *s == '\0') {
-            return false;
+    
+    static int readStreamCallback(void* context, char* buffer, int len) {
+        auto* input = static_cast<StreamInput*>(context);
+        if (len <= 0) {
+            return 0;
+        }
+        if (input->replayRemaining > 0) {
+            const size_t count = std::min(input->replayRemaining, static_cast<size_t>(len));
+            std::memcpy(buffer, input->replay, count);
+            input->replay += count;
+            input->replayRemaining -= count;
+            return static_cast<int>(count);
+        }
+        try {
+            return static_cast<int>(input->stream->read(reinterpret_cast<uint8_t*>(buffer),
+                                                        static_cast<size_t>(len)));
+        } catch (const std::exception& e) {
+            input->error = e.what();
+            return -1;
         }
-        const char* begin = s;
-        const char* end = begin + std::strlen(s);
-        auto [ptr, ec] = std::from_chars(begin, end, out);
-        return ec == std::errc{} && ptr == end;
     }
-
+    
     void parseWorksheetXml(xmlTextReaderPtr reader,
                           SheetRowHandler& handler,
                           const SharedStringsProvider* sharedStrings,
                           const StylesRegistry* styles) {
         
         WorksheetMetadata metadata;
+        m_rowsSkipped = 0;
+        m_rowsReported = 0;
         
         int ret;
         while ((ret = xmlTextReaderRead(reader)) == 1) {
@@ -121,8 +546,10 @@ private:
             
             if (nodeType == XML_READER_TYPE_ELEMENT) {
                 if (strcmp(name, "row") == 0) {
-                    // Parse row element
-                    parseRow(reader, handler, sharedStrings, styles);
+                    // Parse row element; false once the filter's row limit is reached
+                    if (!parseRow(reader, handler, sharedStrings, styles)) {
+                        return;
+                    }
                 } else if (strcmp(name, "mergeCells") == 0) {
                     // Parse merged cells section
                     parseMergedCells(reader, metadata);
@@ -145,10 +572,13 @@ private:
         }
     }
     
-    void parseRow(xmlTextReaderPtr reader,
+    bool parseRow(xmlTextReaderPtr reader,
                   SheetRowHandler& handler,
                   const SharedStringsProvider* sharedStrings,
                   const StylesRegistry* styles) {
+        if (m_rowsReported >= m_filter.maxRows) {
+            return false;
+        }
         
         int rowNumber = 1; // Default to row 1
         bool isHidden = false;
@@ -164,35 +594,36 @@ private:
 
                 if (attrName[0] == 'r' && attrName[1] == '\0') {
                     int parsedRow = 0;
-                    if (parseInt(attrValue, parsedRow) && parsedRow > 0) {
+                    if (sheet_parsing::parseInt(attrValue, parsedRow) && parsedRow > 0) {
                         rowNumber = parsedRow;
                     }
                     continue;
                 }
 
                 if (attrName[0] == 'h' && std::strcmp(attrName, "hidden") == 0) {
-                    isHidden = (attrValue[0] == '1' && attrValue[1] == '\0') || std::strcmp(attrValue, "true") == 0;
+                    isHidden = sheet_parsing::parseBooleanAttribute(attrValue);
                     continue;
                 }
 
                 if (attrName[0] == 's' && std::strcmp(attrName, "spans") == 0) {
-                    const char* colon = std::strchr(attrValue, ':');
-                    if (!colon) {
-                        continue;
-                    }
-                    int first = 0;
-                    int last = 0;
-                    if (parseIntRange(attrValue, colon, first) &&
-                        parseInt(colon + 1, last) &&
-                        last >= first) {
-                        spanReserveHint = std::min(last - first + 1, 16384);
-                    }
+                    spanReserveHint = sheet_parsing::parseSpansHint(attrValue);
                 }
             } while (xmlTextReaderMoveToNextAttribute(reader) == 1);
             xmlTextReaderMoveToElement(reader);
         }
 
-        RowData rowData;
+        // Hidden rows left out of the output do not count towards the range
+        const bool skipHidden = isHidden && m_filter.skipHiddenRows;
+        if (skipHidden || m_rowsSkipped < m_filter.skipRows) {
+            if (!skipHidden) {
+                ++m_rowsSkipped;
+            }
+            skipElement(reader, "row");
+            return true;
+        }
+        
+        RowData& rowData = m_row;
+        rowData.clear();
         rowData.rowNumber = rowNumber;
         rowData.hidden = isHidden;
         if (spanReserveHint > 0) {
@@ -203,7 +634,7 @@ private:
         if (xmlTextReaderIsEmptyElement(reader)) {
             // Empty row
             handler.handleRow(rowData);
-            return;
+            return ++m_rowsReported < m_filter.maxRows;
         }
         
         int ret;
@@ -214,11 +645,12 @@ private:
             if (!name) continue;
             
             if (nodeType == XML_READER_TYPE_ELEMENT && strcmp(name, "c") == 0) {
-                // Parse cell
-                auto cell = parseCell(reader, rowNumber, sharedStrings, styles);
-                if (cell.has_value()) {
-                    rowData.cells.push_back(std::move(*cell));
+                if (m_filter.selectsColumns() && !keepCell(reader)) {
+                    skipElement(reader, "c");
+                    continue;
                 }
+                // Parse cell
+                parseCell(reader, rowNumber, rowData.cells.emplace_back(), sharedStrings, styles);
             } else if (nodeType == XML_READER_TYPE_END_ELEMENT && strcmp(name, "row") == 0) {
                 // End of row
                 break;
@@ -226,14 +658,42 @@ private:
         }
         
         handler.handleRow(rowData);
+        return ++m_rowsReported < m_filter.maxRows;
     }
     
-    std::optional<CellData> parseCell(xmlTextReaderPtr reader,
-                                      int rowNumber,
-                                      const SharedStringsProvider* sharedStrings,
-                                      [[maybe_unused]] const StylesRegistry* styles) {
+    // Whether the filter selects the column of the cell element under the reader
+    bool keepCell(xmlTextReaderPtr reader) const {
+        xmlChar* ref = xmlTextReaderGetAttribute(reader, BAD_CAST "r");
+        if (!ref) {
+            return false; // Cells without a reference are never written
+        }
+        int column = 0;
+        const bool keep = sheet_parsing::parseCellColumn(reinterpret_cast<const char*>(ref), column) &&
+                          m_filter.keepsColumn(column);
+        xmlFree(ref);
+        return keep;
+    }
+    
+    // Reads past the end of the element under the reader without collecting its text
+    static void skipElement(xmlTextReaderPtr reader, const char* elementName) {
+        if (xmlTextReaderIsEmptyElement(reader)) {
+            return;
+        }
+        while (xmlTextReaderRead(reader) == 1) {
+            const char* name = reinterpret_cast<const char*>(xmlTextReaderConstName(reader));
+            if (name && xmlTextReaderNodeType(reader) == XML_READER_TYPE_END_ELEMENT &&
+                strcmp(name, elementName) == 0) {
+                return;
+            }
+        }
+    }
+    
+    void parseCell(xmlTextReaderPtr reader,
+                   int rowNumber,
+                   CellData& cell,
+                   [[maybe_unused]] const SharedStringsProvider* sharedStrings,
+                   [[maybe_unused]] const StylesRegistry* styles) {
         
-        CellData cell;
         bool hasTypeAttribute = false;
         
         if (xmlTextReaderMoveToFirstAttribute(reader) == 1) {
@@ -246,7 +706,7 @@ private:
 
                 if (attrName[0] == 'r' && attrName[1] == '\0') {
                     int column = 0;
-                    if (parseCellColumn(attrValue, column)) {
+                    if (sheet_parsing::parseCellColumn(attrValue, column)) {
                         cell.coordinate.row = rowNumber;
                         cell.coordinate.column = column;
                     }
@@ -255,27 +715,13 @@ private:
 
                 if (attrName[0] == 't' && attrName[1] == '\0') {
                     hasTypeAttribute = true;
-                    if (attrValue[0] == 'b' && attrValue[1] == '\0') {
-                        cell.type = CellType::Boolean;
-                    } else if (attrValue[0] == 'e' && attrValue[1] == '\0') {
-                        cell.type = CellType::Error;
-                    } else if (attrValue[0] == 'n' && attrValue[1] == '\0') {
-                        cell.type = CellType::Number;
-                    } else if (attrValue[0] == 's' && attrValue[1] == '\0') {
-                        cell.type = CellType::SharedString;
-                    } else if (std::strcmp(attrValue, "str") == 0) {
-                        cell.type = CellType::String;
-                    } else if (std::strcmp(attrValue, "inlineStr") == 0) {
-                        cell.type = CellType::InlineString;
-                    } else {
-                        cell.type = CellType::Unknown;
-                    }
+                    cell.type = sheet_parsing::parseCellType(attrValue);
                     continue;
                 }
 
                 if (attrName[0] == 's' && attrName[1] == '\0') {
                     int parsedStyle = 0;
-                    if (parseInt(attrValue, parsedStyle) && parsedStyle >= 0) {
+                    if (sheet_parsing::parseInt(attrValue, parsedStyle) && parsedStyle >= 0) {
                         cell.styleIndex = parsedStyle;
                     }
                     continue;
@@ -293,7 +739,7 @@ private:
         if (xmlTextReaderIsEmptyElement(reader)) {
             // Empty cell
             cell.value = std::monostate{};
-            return cell;
+            return;
         }
         
         // Read cell content (v or is elements)
@@ -307,11 +753,12 @@ private:
             if (nodeType == XML_READER_TYPE_ELEMENT) {
                 if (strcmp(name, "v") == 0) {
                     // Cell value
-                    std::string valueStr = readElementText(reader);
-                    cell.value = convertCellValue(valueStr, cell.type, sharedStrings);
+                    readElementText(reader);
+                    cell.value = sheet_parsing::convertCellValue(m_text, cell.type, m_row);
                 } else if (strcmp(name, "is") == 0) {
                     // Inline string
-                    cell.value = parseInlineString(reader);
+                    parseInlineString(reader);
+                    cell.value = m_row.appendText(m_text);
                     cell.type = CellType::InlineString;
                 }
             } else if (nodeType == XML_READER_TYPE_END_ELEMENT && strcmp(name, "c") == 0) {
@@ -319,56 +766,12 @@ private:
                 break;
             }
         }
-        
-        return cell;
-    }
-    
-    CellValue convertCellValue(const std::string& valueStr, 
-                              CellType type,
-                              [[maybe_unused]] const SharedStringsProvider* sharedStrings) {
-        
-        if (valueStr.empty()) {
-            return std::monostate{};
-        }
-        
-        switch (type) {
-            case CellType::Boolean: {
-                // Excel booleans: "0" = false, "1" = true
-                return valueStr == "1";
-            }
-            
-            case CellType::Number: {
-                const char* begin = valueStr.data();
-                char* parseEnd = nullptr;
-                double parsed = std::strtod(begin, &parseEnd);
-                if (parseEnd == begin + valueStr.size()) {
-                    return parsed;
-                }
-                return std::monostate{};
-            }
-            
-            case CellType::SharedString: {
-                int index = 0;
-                const char* begin = valueStr.data();
-                const char* end = begin + valueStr.size();
-                auto [ptr, ec] = std::from_chars(begin, end, index);
-                if (ec == std::errc{} && ptr == end) {
-                    // Keep shared-string index and defer lookup to CSV conversion.
-                    return index;
-                }
-                return std::monostate{};
-            }
-            
-            case CellType::Error:
-            case CellType::String:
-            case CellType::InlineString:
-            default:
-                return valueStr;
-        }
     }
     
-    std::string readElementText(xmlTextReaderPtr reader) {
-        std::string result;
+    // Collects the element's text into m_text
+    void readElementText(xmlTextReaderPtr reader) {
+        std::string& result = m_text;
+        result.clear();
         
         int ret;
         while ((ret = xmlTextReaderRead(reader)) == 1) {
@@ -384,14 +787,12 @@ private:
                 break;
             }
         }
-        
-        return result;
     }
     
-    std::string parseInlineString(xmlTextReaderPtr reader) {
+    void parseInlineString(xmlTextReaderPtr reader) {
         // For now, just extract text content
         // TODO: Handle rich text formatting if needed
-        return readElementText(reader);
+        readElementText(reader);
     }
     
     void parseMergedCells(xmlTextReaderPtr reader, WorksheetMetadata& metadata) {
@@ -423,6 +824,7 @@ private:
                 break;
             }
         }
+        metadata.buildIndex();
     }
     
     void parseColumns(xmlTextReaderPtr reader, WorksheetMetadata& metadata) {
@@ -473,9 +875,10 @@ private:
                     xmlFree(widthAttr);
                 }
                 
-                // Add column info for all columns in the range
-                for (int col = minCol; col <= maxCol; ++col) {
-                    colInfo.columnIndex = col;
+                // One entry per <col> range; lookups go through the metadata index
+                if (maxCol >= minCol) {
+                    colInfo.columnIndex = minCol;
+                    colInfo.lastColumn = maxCol;
                     colInfo.hidden = isHidden;
                     colInfo.width = width;
                     metadata.columnInfo.push_back(colInfo);
@@ -486,6 +889,7 @@ private:
                 break;
             }
         }
+        metadata.buildIndex();
     }
 };
 
@@ -504,6 +908,7 @@ void SheetStreamReader::parseSheet(const OpcPackage& package,
                                   SheetRowHandler& handler,
                                   const SharedStringsProvider* sharedStrings,
                                   const StylesRegistry* styles) {
+    MemoryTracker::Scope track(m_impl->m_tracker);
     m_impl->parseSheet(package, sheetPath, handler, sharedStrings, styles);
 }
 
@@ -511,7 +916,67 @@ void SheetStreamReader::parseSheetData(const std::vector<uint8_t>& xmlData,
                                       SheetRowHandler& handler,
                                       const SharedStringsProvider* sharedStrings,
                                       const StylesRegistry* styles) {
+    MemoryTracker::Scope track(m_impl->m_tracker);
     m_impl->parseSheetData(xmlData, handler, sharedStrings, styles);
 }
 
+void SheetStreamReader::parseSheetParallel(const OpcPackage& package,
+                                           const std::string& sheetPath,
+                                           ChunkedRowHandler& handler,
+                                           unsigned threads,
+                                           const SharedStringsProvider* sharedStrings,
+                                           const StylesRegistry* styles) {
+    MemoryTracker::Scope track(m_impl->m_tracker);
+    m_impl->parseSheetParallel(package, sheetPath, handler, threads, sharedStrings, styles);
+}
+
+void SheetStreamReader::parseSheetDataParallel(const std::vector<uint8_t>& xmlData,
+                                               ChunkedRowHandler& handler,
+                                               unsigned threads,
+                                               const SharedStringsProvider* sharedStrings,
+                                               const StylesRegistry* styles) {
+    MemoryTracker::Scope track(m_impl->m_tracker);
+    m_impl->parseSheetDataParallel(xmlData, handler, threads, sharedStrings, styles);
+}
+
+void SheetStreamReader::setParserBackend(SheetParserBackend backend) {
+    m_impl->m_backend = backend;
+}
+
+SheetParserBackend SheetStreamReader::getParserBackend() const {
+    return m_impl->m_backend;
+}
+
+void SheetStreamReader::setReadFilter(const SheetReadFilter& filter) {
+    m_impl->m_filter = filter;
+}
+
+const SheetReadFilter& SheetStreamReader::getReadFilter() const {
+    return m_impl->m_filter;
+}
+
+void SheetStreamReader::setPipelinedInflate(bool enabled) {
+    m_impl->m_pipelinedInflate = enabled;
+}
+
+bool SheetStreamReader::getPipelinedInflate() const {
+    return m_impl->m_pipelinedInflate;
+}
+
+void SheetStreamReader::setMemoryTracker(MemoryTracker* tracker) {
+    m_impl->m_tracker = tracker;
+}
+
+MemoryTracker* SheetStreamReader::getMemoryTracker() const {
+    return m_impl->m_tracker;
+}
+
+void SheetStreamReader::parseSheetStream(ZipEntryStream& stream,
+                                        SheetRowHandler& handler,
+                                        const SharedStringsProvider* sharedStrings,
+                                        const StylesRegistry* styles) {
+    MemoryTracker::Scope track(m_impl->m_tracker);
+    m_impl->parseSheetStream(stream, handler, sharedStrings, styles);
+}
+
 } // namespace xlsxcsv::core
@@ -1,12 +1,229 @@
 #include "xlsxcsv/core.hpp"
 #include <libxml/xmlreader.h>
+#include <array>
 #include <map>
 #include <vector>
-#include <regex>
 #include <algorithm>
+#include <string_view>
 
 namespace xlsxcsv::core {
 
+namespace {
+
+struct BuiltInNumberFormat {
+    int formatId;
+    std::string_view formatCode;
+    NumberFormatType type;
+};
+
+// Excel built-in number formats, sorted by id
+constexpr std::array<BuiltInNumberFormat, 28> BUILT_IN_NUMBER_FORMATS = {{
+    {0, "General", NumberFormatType::General},
+    {1, "0", NumberFormatType::Integer},
+    {2, "0.00", NumberFormatType::Decimal},
+    {3, "#,##0", NumberFormatType::Integer},
+    {4, "#,##0.00", NumberFormatType::Decimal},
+    {9, "0%", NumberFormatType::Percentage},
+    {10, "0.00%", NumberFormatType::Percentage},
+    {11, "0.00E+00", NumberFormatType::Scientific},
+    {12, "# ?/?", NumberFormatType::Fraction},
+    {13, "# ?\x3f/?\x3f", NumberFormatType::Fraction},
+    {14, "mm-dd-yy", NumberFormatType::Date},
+    {15, "d-mmm-yy", NumberFormatType::Date},
+    {16, "d-mmm", NumberFormatType::Date},
+    {17, "mmm-yy", NumberFormatType::Date},
+    {18, "h:mm AM/PM", NumberFormatType::Time},
+    {19, "h:mm:ss AM/PM", NumberFormatType::Time},
+    {20, "h:mm", NumberFormatType::Time},
+    {21, "h:mm:ss", NumberFormatType::Time},
+    {22, "m/d/yy h:mm", NumberFormatType::DateTime},
+    {37, "#,##0 ;(#,##0)", NumberFormatType::Currency},
+    {38, "#,##0 ;[Red](#,##0)", NumberFormatType::Currency},
+    {39, "#,##0.00;(#,##0.00)", NumberFormatType::Currency},
+    {40, "#,##0.00;[Red](#,##0.00)", NumberFormatType::Currency},
+    {45, "mm:ss", NumberFormatType::Time},
+    {46, "[h]:mm:ss", NumberFormatType::Time},
+    {47, "mmss.0", NumberFormatType::Time},
+    {48, "##0.0E+0", NumberFormatType::Scientific},
+    {49, "@", NumberFormatType::Text}
+}};
+
+const BuiltInNumberFormat* findBuiltInNumberFormat(int formatId) {
+    auto it = std::lower_bound(BUILT_IN_NUMBER_FORMATS.begin(), BUILT_IN_NUMBER_FORMATS.end(), formatId,
+                               [](const BuiltInNumberFormat& entry, int id) { return entry.formatId < id; });
+    return (it != BUILT_IN_NUMBER_FORMATS.end() && it->formatId == formatId) ? &*it : nullptr;
+}
+
+char asciiLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool startsWithIgnoreCase(std::string_view text, size_t pos, std::string_view prefix) {
+    if (text.size() - pos < prefix.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < prefix.size(); ++i) {
+        if (asciiLower(text[pos + i]) != asciiLower(prefix[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Single pass over a format code. Quoted literals, escaped characters and
+// bracketed colours/conditions are skipped, so "[Red]" or a quoted "days" no longer
+// look like date tokens. An "m" run is a minute when it follows an hour or
+// precedes a second, and a month otherwise, as in Excel.
+NumberFormatType classifyFormatCode(std::string_view code) {
+    if (code.empty() || (code.size() == 7 && startsWithIgnoreCase(code, 0, "General"))) {
+        return NumberFormatType::General;
+    }
+    
+    bool date = false, time = false, percent = false, currency = false;
+    bool scientific = false, fraction = false, text = false, decimal = false, digit = false;
+    char previous = 0;        // Last date/time token: 'y', 'd', 'h', 'M' (month), 'm' (minute), 's'
+    bool pendingM = false;    // An "m" run that the next token decides
+    
+    auto resolvePending = [&](bool asMinute) {
+        if (pendingM) {
+            (asMinute ? time : date) = true;
+            previous = asMinute ? 'm' : 'M';
+            pendingM = false;
+        }
+    };
+    
+    for (size_t i = 0; i < code.size(); ++i) {
+        const char c = code[i];
+        switch (asciiLower(c)) {
+            case '"': {
+                const size_t close = code.find('"', i + 1);
+                i = close == std::string_view::npos ? code.size() : close;
+                break;
+            }
+            case '\\':
+            case '_':
+            case '*':
+                ++i; // The next character is a literal, a padding width or a fill
+                break;
+            case '[': {
+                const size_t close = code.find(']', i + 1);
+                const std::string_view content = code.substr(i + 1, close == std::string_view::npos
+                                                                        ? std::string_view::npos : close - i - 1);
+                i = close == std::string_view::npos ? code.size() : close;
+                if (!content.empty() && content[0] == '$') {
+                    // [$EUR-407] carries a symbol; [$-409] is a bare locale
+                    currency = currency || (content.size() > 1 && content[1] != '-');
+                } else if (content.size() == 8 && startsWithIgnoreCase(content, 0, "Currency")) {
+                    currency = true;
+                } else if (!content.empty() && std::all_of(content.begin(), content.end(), [](char x) {
+                               const char lower = asciiLower(x);
+                               return lower == 'h' || lower == 'm' || lower == 's';
+                           }) && std::all_of(content.begin(), content.end(), [&](char x) {
+                               return asciiLower(x) == asciiLower(content[0]);
+                           })) {
+                    // Elapsed time: [h], [mm], [ss]
+                    resolvePending(asciiLower(content[0]) == 's');
+                    time = true;
+                    previous = asciiLower(content[0]);
+                }
+                break; // Colours and conditions carry no type information
+            }
+            case 'a':
+                if (startsWithIgnoreCase(code, i, "AM/PM")) {
+                    time = true;
+                    i += 4;
+                } else if (startsWithIgnoreCase(code, i, "A/P")) {
+                    time = true;
+                    i += 2;
+                }
+                break;
+            case 'g':
+                if (startsWithIgnoreCase(code, i, "General")) {
+                    digit = true;
+                    i += 6;
+                }
+                break;
+            case 'y':
+            case 'd':
+                resolvePending(false);
+                date = true;
+                previous = asciiLower(c);
+                break;
+            case 'h':
+                resolvePending(false);
+                time = true;
+                previous = 'h';
+                break;
+            case 's':
+                resolvePending(true);
+                time = true;
+                previous = 's';
+                break;
+            case 'm': {
+                resolvePending(false);
+                size_t run = 1;
+                while (i + run < code.size() && asciiLower(code[i + run]) == 'm') {
+                    ++run;
+                }
+                i += run - 1;
+                if (run >= 3) {
+                    date = true; // mmm, mmmm and mmmmm are month names
+                    previous = 'M';
+                } else if (previous == 'h') {
+                    time = true;
+                    previous = 'm';
+                } else {
+                    pendingM = true;
+                }
+                break;
+            }
+            case 'e':
+                if (i + 1 < code.size() && (code[i + 1] == '+' || code[i + 1] == '-')) {
+                    scientific = true;
+                    ++i;
+                }
+                break;
+            case ';':
+                resolvePending(false);
+                previous = 0;
+                break;
+            case '%': percent = true; break;
+            case '$': currency = true; break;
+            case '/': fraction = true; break;
+            case '@': text = true; break;
+            case '.': decimal = true; break;
+            case '0':
+            case '#':
+            case '?':
+                digit = true;
+                break;
+            case '\xC2':
+                if (i + 1 < code.size() && code[i + 1] == '\xA4') { // UTF-8 for the currency sign
+                    currency = true;
+                    ++i;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    resolvePending(false);
+    
+    if (date && time) return NumberFormatType::DateTime;
+    if (date) return NumberFormatType::Date;
+    if (time) return NumberFormatType::Time;
+    if (percent) return NumberFormatType::Percentage;
+    if (currency) return NumberFormatType::Currency;
+    if (scientific) return NumberFormatType::Scientific;
+    if (fraction) return NumberFormatType::Fraction;
+    if (text) return NumberFormatType::Text;
+    if (decimal) return NumberFormatType::Decimal;
+    if (digit) return NumberFormatType::Integer;
+    return NumberFormatType::Custom;
+}
+
+} // namespace
+
 class StylesRegistry::Impl {
 public:
     Impl() = default;
@@ -15,13 +232,14 @@ public:
         close();
     }
     
-    void parse(const OpcPackage& package) {
+    void parse(const OpcPackage& package, StylesParseMode mode) {
         if (m_isOpen) {
             close();
         }
+        m_mode = mode;
         
         // Find styles.xml path through relationships
-        std::string stylesPath = "xl/styles.xml";
+        const std::string stylesPath = package.findWorkbookPartPath("styles");
         
         if (!package.getZipReader().hasEntry(stylesPath)) {
             throw XlsxError("Missing styles.xml in XLSX package");
@@ -40,7 +258,8 @@ public:
         m_fills.clear();
         m_borders.clear();
         m_cellStyles.clear();
-        m_dateTimeStyleMask.clear();
+        m_styleFormats.clear();
+        m_dateTimeKinds.clear();
     }
     
     bool isOpen() const {
@@ -48,9 +267,15 @@ public:
     }
     
     std::optional<CellStyle> getCellStyle(int styleIndex) const {
-        if (!m_isOpen || styleIndex < 0 || static_cast<size_t>(styleIndex) >= m_cellStyles.size()) {
+        if (!m_isOpen || styleIndex < 0 || static_cast<size_t>(styleIndex) >= m_styleFormats.size()) {
             return std::nullopt;
         }
+        if (m_mode == StylesParseMode::NumberFormatsOnly) {
+            CellStyle style;
+            style.styleIndex = styleIndex;
+            style.numberFormat = resolveNumberFormat(m_styleFormats[static_cast<size_t>(styleIndex)]);
+            return style;
+        }
         return m_cellStyles[styleIndex];
     }
     
@@ -69,71 +294,7 @@ public:
     }
     
     NumberFormatType detectNumberFormatType(const std::string& formatCode) const {
-        if (formatCode.empty() || formatCode == "General") {
-            return NumberFormatType::General;
-        }
-        
-        // Date/time patterns - be more specific about date patterns
-        bool hasDatePattern = std::regex_search(formatCode, std::regex(R"([yY])")); // Year
-        hasDatePattern = hasDatePattern || std::regex_search(formatCode, std::regex(R"(d+)")); // Day (dd, ddd, etc)
-        // Month pattern (MM, MMM) but not AM/PM 
-        hasDatePattern = hasDatePattern || (std::regex_search(formatCode, std::regex(R"(M+)")) && 
-                                           formatCode.find("AM/PM") == std::string::npos);
-        
-        bool hasTimePattern = std::regex_search(formatCode, std::regex(R"([hHsS])")); // Hour, second
-        hasTimePattern = hasTimePattern || (std::regex_search(formatCode, std::regex(R"(m+)")) && 
-                                           std::regex_search(formatCode, std::regex(R"([hHsS])"))); // Minutes with hours/seconds
-        
-        if (hasDatePattern && hasTimePattern) {
-            return NumberFormatType::DateTime;
-        }
-        
-        if (hasDatePattern) {
-            return NumberFormatType::Date;
-        }
-        
-        if (hasTimePattern) {
-            return NumberFormatType::Time;
-        }
-        
-        // Percentage
-        if (formatCode.find('%') != std::string::npos) {
-            return NumberFormatType::Percentage;
-        }
-        
-        // Currency/accounting
-        if (formatCode.find('$') != std::string::npos || 
-            formatCode.find("\xC2\xA4") != std::string::npos ||  // UTF-8 for ¤
-            std::regex_search(formatCode, std::regex(R"(\[Currency\])"))) {
-            return NumberFormatType::Currency;
-        }
-        
-        // Scientific notation
-        if (std::regex_search(formatCode, std::regex(R"([eE][+-])"))) {
-            return NumberFormatType::Scientific;
-        }
-        
-        // Fraction
-        if (formatCode.find('/') != std::string::npos) {
-            return NumberFormatType::Fraction;
-        }
-        
-        // Text format
-        if (formatCode.find('@') != std::string::npos) {
-            return NumberFormatType::Text;
-        }
-        
-        // Decimal numbers (has decimal point)
-        if (formatCode.find('.') != std::string::npos) {
-            return NumberFormatType::Decimal;
-        }
-        
-        // Integer (contains digits, zeros, formatting, but no decimal point)
-        if (std::regex_search(formatCode, std::regex(R"([0#])"))) {
-            return NumberFormatType::Integer;
-        }
-        
-        return NumberFormatType::Custom;
+        return classifyFormatCode(formatCode);
     }
     
     bool isDateTimeFormat(int formatId) const {
@@ -156,14 +317,18 @@ public:
     }
 
     bool isDateTimeStyle(int styleIndex) const {
-        if (!m_isOpen || styleIndex < 0 || static_cast<size_t>(styleIndex) >= m_dateTimeStyleMask.size()) {
-            return false;
+        return getDateTimeKind(styleIndex) != DateTimeKind::None;
+    }
+    
+    DateTimeKind getDateTimeKind(int styleIndex) const {
+        if (!m_isOpen || styleIndex < 0 || static_cast<size_t>(styleIndex) >= m_dateTimeKinds.size()) {
+            return DateTimeKind::None;
         }
-        return m_dateTimeStyleMask[static_cast<size_t>(styleIndex)] != 0;
+        return m_dateTimeKinds[static_cast<size_t>(styleIndex)];
     }
     
     size_t getStyleCount() const {
-        return m_cellStyles.size();
+        return m_styleFormats.size();
     }
     
     size_t getNumberFormatCount() const {
@@ -186,8 +351,10 @@ private:
         }
         
         // Parse the XML
+        const bool full = m_mode == StylesParseMode::Full;
         int result = xmlTextReaderRead(reader);
         while (result == 1) {
+            bool skipSubtree = false;
             if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
                 xmlChar* name = xmlTextReaderName(reader);
                 
@@ -195,18 +362,22 @@ private:
                     if (xmlStrcmp(name, BAD_CAST "numFmts") == 0) {
                         parseNumberFormats(reader);
                     } else if (xmlStrcmp(name, BAD_CAST "fonts") == 0) {
-                        parseFonts(reader);
+                        full ? parseFonts(reader) : void(skipSubtree = true);
                     } else if (xmlStrcmp(name, BAD_CAST "fills") == 0) {
-                        parseFills(reader);
+                        full ? parseFills(reader) : void(skipSubtree = true);
                     } else if (xmlStrcmp(name, BAD_CAST "borders") == 0) {
-                        parseBorders(reader);
+                        full ? parseBorders(reader) : void(skipSubtree = true);
                     } else if (xmlStrcmp(name, BAD_CAST "cellXfs") == 0) {
                         parseCellXfs(reader);
+                    } else if (!full && (xmlStrcmp(name, BAD_CAST "cellStyleXfs") == 0 ||
+                                         xmlStrcmp(name, BAD_CAST "dxfs") == 0)) {
+                        skipSubtree = true;
                     }
                     xmlFree(name);
                 }
             }
-            result = xmlTextReaderRead(reader);
+            // Next lands on the following sibling, which is examined without another Read
+            result = skipSubtree ? xmlTextReaderNext(reader) : xmlTextReaderRead(reader);
         }
         
         xmlFreeTextReader(reader);
@@ -438,68 +609,20 @@ private:
                 xmlChar* name = xmlTextReaderName(reader);
                 
                 if (name && xmlStrcmp(name, BAD_CAST "xf") == 0) {
-                    CellStyle style;
-                    style.styleIndex = static_cast<int>(m_cellStyles.size());
-                    
+                    int formatId = 0;
                     xmlChar* numFmtId = xmlTextReaderGetAttribute(reader, BAD_CAST "numFmtId");
-                    xmlChar* fontId = xmlTextReaderGetAttribute(reader, BAD_CAST "fontId");
-                    xmlChar* fillId = xmlTextReaderGetAttribute(reader, BAD_CAST "fillId");
-                    xmlChar* borderId = xmlTextReaderGetAttribute(reader, BAD_CAST "borderId");
-                    
                     if (numFmtId) {
-                        int formatId = std::atoi(reinterpret_cast<const char*>(numFmtId));
-                        
-                        // Look up the format directly from our parsed formats or built-in formats
-                        auto it = m_numberFormats.find(formatId);
-                        if (it != m_numberFormats.end()) {
-                            style.numberFormat = it->second;
-                        } else {
-                            // Try built-in formats
-                            auto builtIn = getBuiltInNumberFormat(formatId);
-                            if (builtIn.has_value()) {
-                                style.numberFormat = *builtIn;
-                            } else {
-                                // Default format
-                                style.numberFormat.formatId = formatId;
-                                style.numberFormat.formatCode = "General";
-                                style.numberFormat.type = NumberFormatType::General;
-                                style.numberFormat.isBuiltIn = true;
-                            }
-                        }
-                        
+                        formatId = std::atoi(reinterpret_cast<const char*>(numFmtId));
                         xmlFree(numFmtId);
                     }
                     
-                    if (fontId) {
-                        int fid = std::atoi(reinterpret_cast<const char*>(fontId));
-                        if (fid >= 0 && static_cast<size_t>(fid) < m_fonts.size()) {
-                            style.font = m_fonts[fid];
-                        }
-                        xmlFree(fontId);
+                    if (m_mode == StylesParseMode::Full) {
+                        m_cellStyles.push_back(parseFullCellStyle(reader, formatId));
+                        m_dateTimeKinds.push_back(dateTimeKindFor(m_cellStyles.back().numberFormat.type));
+                    } else {
+                        m_dateTimeKinds.push_back(dateTimeKindFor(numberFormatType(formatId)));
                     }
-                    
-                    if (fillId) {
-                        int fid = std::atoi(reinterpret_cast<const char*>(fillId));
-                        if (fid >= 0 && static_cast<size_t>(fid) < m_fills.size()) {
-                            style.fill = m_fills[fid];
-                        }
-                        xmlFree(fillId);
-                    }
-                    
-                    if (borderId) {
-                        int bid = std::atoi(reinterpret_cast<const char*>(borderId));
-                        if (bid >= 0 && static_cast<size_t>(bid) < m_borders.size()) {
-                            style.border = m_borders[bid];
-                        }
-                        xmlFree(borderId);
-                    }
-                    
-                    const NumberFormatType type = style.numberFormat.type;
-                    const bool isDateTime = (type == NumberFormatType::Date) ||
-                                            (type == NumberFormatType::Time) ||
-                                            (type == NumberFormatType::DateTime);
-                    m_dateTimeStyleMask.push_back(isDateTime ? 1 : 0);
-                    m_cellStyles.push_back(style);
+                    m_styleFormats.push_back(formatId);
                 }
                 
                 if (name) xmlFree(name);
@@ -507,41 +630,87 @@ private:
         }
     }
     
-    std::optional<NumberFormat> getBuiltInNumberFormat(int formatId) const {
-        // Excel built-in number formats
-        static const std::map<int, std::pair<std::string, NumberFormatType>> builtInFormats = {
-            {0, {"General", NumberFormatType::General}},
-            {1, {"0", NumberFormatType::Integer}},
-            {2, {"0.00", NumberFormatType::Decimal}},
-            {3, {"#,##0", NumberFormatType::Integer}},
-            {4, {"#,##0.00", NumberFormatType::Decimal}},
-            {9, {"0%", NumberFormatType::Percentage}},
-            {10, {"0.00%", NumberFormatType::Percentage}},
-            {11, {"0.00E+00", NumberFormatType::Scientific}},
-            {12, {"# ?/?", NumberFormatType::Fraction}},
-            {13, {"# ?\x3f/?\x3f", NumberFormatType::Fraction}},
-            {14, {"mm-dd-yy", NumberFormatType::Date}},
-            {15, {"d-mmm-yy", NumberFormatType::Date}},
-            {16, {"d-mmm", NumberFormatType::Date}},
-            {17, {"mmm-yy", NumberFormatType::Date}},
-            {18, {"h:mm AM/PM", NumberFormatType::Time}},
-            {19, {"h:mm:ss AM/PM", NumberFormatType::Time}},
-            {20, {"h:mm", NumberFormatType::Time}},
-            {21, {"h:mm:ss", NumberFormatType::Time}},
-            {22, {"m/d/yy h:mm", NumberFormatType::DateTime}},
-            {37, {"#,##0 ;(#,##0)", NumberFormatType::Currency}},
-            {38, {"#,##0 ;[Red](#,##0)", NumberFormatType::Currency}},
-            {39, {"#,##0.00;(#,##0.00)", NumberFormatType::Currency}},
-            {40, {"#,##0.00;[Red](#,##0.00)", NumberFormatType::Currency}},
-            {49, {"@", NumberFormatType::Text}}
-        };
+    CellStyle parseFullCellStyle(xmlTextReaderPtr reader, int formatId) const {
+        CellStyle style;
+        style.styleIndex = static_cast<int>(m_cellStyles.size());
+        style.numberFormat = resolveNumberFormat(formatId);
+        
+        xmlChar* fontId = xmlTextReaderGetAttribute(reader, BAD_CAST "fontId");
+        xmlChar* fillId = xmlTextReaderGetAttribute(reader, BAD_CAST "fillId");
+        xmlChar* borderId = xmlTextReaderGetAttribute(reader, BAD_CAST "borderId");
+        
+        if (fontId) {
+            int fid = std::atoi(reinterpret_cast<const char*>(fontId));
+            if (fid >= 0 && static_cast<size_t>(fid) < m_fonts.size()) {
+                style.font = m_fonts[fid];
+            }
+            xmlFree(fontId);
+        }
+        
+        if (fillId) {
+            int fid = std::atoi(reinterpret_cast<const char*>(fillId));
+            if (fid >= 0 && static_cast<size_t>(fid) < m_fills.size()) {
+                style.fill = m_fills[fid];
+            }
+            xmlFree(fillId);
+        }
+        
+        if (borderId) {
+            int bid = std::atoi(reinterpret_cast<const char*>(borderId));
+            if (bid >= 0 && static_cast<size_t>(bid) < m_borders.size()) {
+                style.border = m_borders[bid];
+            }
+            xmlFree(borderId);
+        }
         
-        auto it = builtInFormats.find(formatId);
-        if (it != builtInFormats.end()) {
+        return style;
+    }
+    
+    // Custom formats first, then built-ins; unknown ids fall back to General
+    NumberFormat resolveNumberFormat(int formatId) const {
+        auto it = m_numberFormats.find(formatId);
+        if (it != m_numberFormats.end()) {
+            return it->second;
+        }
+        auto builtIn = getBuiltInNumberFormat(formatId);
+        if (builtIn.has_value()) {
+            return *builtIn;
+        }
+        NumberFormat format;
+        format.formatId = formatId;
+        format.formatCode = "General";
+        format.type = NumberFormatType::General;
+        format.isBuiltIn = true;
+        return format;
+    }
+    
+    // Type of resolveNumberFormat(formatId) without copying its format code
+    NumberFormatType numberFormatType(int formatId) const {
+        auto it = m_numberFormats.find(formatId);
+        if (it != m_numberFormats.end()) {
+            return it->second.type;
+        }
+        if (const BuiltInNumberFormat* builtIn = findBuiltInNumberFormat(formatId)) {
+            return builtIn->type;
+        }
+        return NumberFormatType::General;
+    }
+    
+    static DateTimeKind dateTimeKindFor(NumberFormatType type) {
+        switch (type) {
+            case NumberFormatType::Date: return DateTimeKind::Date;
+            case NumberFormatType::Time: return DateTimeKind::Time;
+            case NumberFormatType::DateTime: return DateTimeKind::DateTime;
+            default: return DateTimeKind::None;
+        }
+    }
+    
+    std::optional<NumberFormat> getBuiltInNumberFormat(int formatId) const {
+        if (const BuiltInNumberFormat* builtIn = findBuiltInNumberFormat(formatId)) {
             NumberFormat format;
             format.formatId = formatId;
-            format.formatCode = it->second.first;
-            format.type = it->second.second;
+            format.formatCode = std::string(builtIn->formatCode);
+            format.type = builtIn->type;
             format.isBuiltIn = true;
             return format;
         }
@@ -550,12 +719,14 @@ private:
     }
     
     bool m_isOpen = false;
+    StylesParseMode m_mode = StylesParseMode::Full;
     std::map<int, NumberFormat> m_numberFormats;
     std::vector<FontInfo> m_fonts;
     std::vector<FillInfo> m_fills;
     std::vector<BorderInfo> m_borders;
-    std::vector<CellStyle> m_cellStyles;
-    std::vector<uint8_t> m_dateTimeStyleMask;
+    std::vector<CellStyle> m_cellStyles;      // Full mode only
+    std::vector<int> m_styleFormats;          // numFmtId per style index
+    std::vector<DateTimeKind> m_dateTimeKinds; // Per style index, for the per-cell hot path
 };
 
 // StylesRegistry implementation
@@ -566,8 +737,8 @@ StylesRegistry::~StylesRegistry() = default;
 StylesRegistry::StylesRegistry(StylesRegistry&&) noexcept = default;
 StylesRegistry& StylesRegistry::operator=(StylesRegistry&&) noexcept = default;
 
-void StylesRegistry::parse(const OpcPackage& package) {
-    m_impl->parse(package);
+void StylesRegistry::parse(const OpcPackage& package, StylesParseMode mode) {
+    m_impl->parse(package, mode);
 }
 
 bool StylesRegistry::isOpen() const {
@@ -602,6 +773,10 @@ bool StylesRegistry::isDateTimeStyle(int styleIndex) const {
     return m_impl->isDateTimeStyle(styleIndex);
 }
 
+DateTimeKind StylesRegistry::getDateTimeKind(int styleIndex) const {
+    return m_impl->getDateTimeKind(styleIndex);
+}
+
 size_t StylesRegistry::getStyleCount() const {
     return m_impl->getStyleCount();
 }
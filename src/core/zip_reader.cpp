@@ -1,270 +1,1004 @@
 #include "xlsxcsv/core.hpp"
-#if __has_include(<minizip-ng/unzip.h>)
-#  include <minizip-ng/unzip.h>
-#elif __has_include(<minizip/unzip.h>)
-#  include <minizip/unzip.h>
-#else
-#  error "minizip unzip.h header not found"
-#endif
+#include <zlib.h>
 #include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
 #include <filesystem>
-#include <regex>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
 
 namespace fs = std::filesystem;
 
 namespace xlsxcsv::core {
 
+namespace {
+
+// ZIP record signatures and fixed sizes (APPNOTE.TXT 4.3)
+constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr uint32_t EOCD_SIGNATURE = 0x06054b50;
+constexpr uint32_t ZIP64_EOCD_SIGNATURE = 0x06064b50;
+constexpr uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+constexpr uint16_t ZIP64_EXTRA_FIELD_ID = 0x0001;
+
+constexpr size_t LOCAL_HEADER_SIZE = 30;
+constexpr size_t CENTRAL_HEADER_SIZE = 46;
+constexpr size_t EOCD_SIZE = 22;
+constexpr size_t ZIP64_LOCATOR_SIZE = 20;
+constexpr size_t ZIP64_EOCD_SIZE = 56;
+constexpr size_t MAX_EOCD_SEARCH = EOCD_SIZE + 0xFFFF; // Record plus maximum comment
+
+constexpr uint16_t METHOD_STORED = 0;
+constexpr uint16_t METHOD_DEFLATED = 8;
+constexpr uint16_t FLAG_ENCRYPTED = 1;
+
+constexpr size_t INPUT_CHUNK_SIZE = 256 * 1024; // Compressed bytes fetched per positional read
+constexpr size_t MAX_OUTPUT_CHUNK = 1U << 30;   // zlib and crc32 take 32-bit lengths
+
+uint16_t readLe16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readLe32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t readLe64(const uint8_t* p) {
+    return static_cast<uint64_t>(readLe32(p)) | (static_cast<uint64_t>(readLe32(p + 4)) << 32);
+}
+
+// Read-only archive bytes with positional reads, so any number of threads can
+// read at once without sharing a cursor. Backed by a file handle, a read-only
+// mapping of the file, or a caller-owned buffer; the latter two expose the
+// bytes directly so entries inflate without an intermediate copy.
+class RandomAccessFile {
+public:
+    RandomAccessFile() = default;
+    ~RandomAccessFile() {
+        close();
+    }
+
+    RandomAccessFile(const RandomAccessFile&) = delete;
+    RandomAccessFile& operator=(const RandomAccessFile&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        m_handle = CreateFileW(fs::path(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (m_handle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_handle, &size)) {
+            close();
+            return false;
+        }
+        m_size = static_cast<uint64_t>(size.QuadPart);
+#else
+        m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (m_fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (::fstat(m_fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            close();
+            return false;
+        }
+        m_size = static_cast<uint64_t>(st.st_size);
+#endif
+        return true;
+    }
+
+    // Maps the whole file read-only; false if it cannot be opened or mapped
+    bool openMapped(const std::string& path) {
+        if (!open(path)) {
+            return false;
+        }
+        if (m_size == 0) {
+            return true; // Nothing to map; reads fail like those of an empty file
+        }
+        if (m_size > std::numeric_limits<size_t>::max()) {
+            close();
+            return false;
+        }
+#ifdef _WIN32
+        m_mapping = CreateFileMappingW(m_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            close();
+            return false;
+        }
+#else
+        void* view = ::mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (view == MAP_FAILED) {
+            close();
+            return false;
+        }
+        // Entries are inflated front to back
+        ::madvise(view, static_cast<size_t>(m_size), MADV_SEQUENTIAL);
+#endif
+        m_data = static_cast<const uint8_t*>(view);
+        m_mapped = true;
+        return true;
+    }
+
+    // Reads from caller-owned bytes, which must outlive the reader
+    void openMemory(const uint8_t* data, size_t size) {
+        close();
+        m_data = data;
+        m_size = size;
+    }
+
+    void close() {
+        if (m_mapped) {
+#ifdef _WIN32
+            UnmapViewOfFile(m_data);
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+#else
+            ::munmap(const_cast<uint8_t*>(m_data), static_cast<size_t>(m_size));
+#endif
+            m_mapped = false;
+        }
+        m_data = nullptr;
+#ifdef _WIN32
+        if (m_handle != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_handle);
+            m_handle = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+#endif
+        m_size = 0;
+    }
+
+    uint64_t size() const {
+        return m_size;
+    }
+
+    // The archive bytes when they are addressable (mapped or in memory), else null
+    const uint8_t* data() const {
+        return m_data;
+    }
+
+    // Read exactly size bytes starting at offset
+    void readAt(uint64_t offset, void* buffer, size_t size) const {
+        if (offset > m_size || size > m_size - offset) {
+            throw XlsxError("ZIP read beyond end of file");
+        }
+        if (m_data) {
+            std::memcpy(buffer, m_data + offset, size);
+            return;
+        }
+        auto* out = static_cast<uint8_t*>(buffer);
+        while (size > 0) {
+            const size_t chunk = std::min(size, MAX_OUTPUT_CHUNK);
+#ifdef _WIN32
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFu);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            DWORD got = 0;
+            if (!ReadFile(m_handle, out, static_cast<DWORD>(chunk), &got, &overlapped)) {
+                throw XlsxError("Failed to read ZIP file");
+            }
+#else
+            const ssize_t got = ::pread(m_fd, out, chunk, static_cast<off_t>(offset));
+            if (got < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw XlsxError("Failed to read ZIP file");
+            }
+#endif
+            if (got == 0) {
+                throw XlsxError("Unexpected end of ZIP file");
+            }
+            out += got;
+            offset += static_cast<uint64_t>(got);
+            size -= static_cast<size_t>(got);
+        }
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE m_handle = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+    uint64_t m_size = 0;
+    const uint8_t* m_data = nullptr;
+    bool m_mapped = false;
+};
+
+// Central directory record for one entry
+struct EntryRecord {
+    ZipEntry entry;
+    uint64_t localHeaderOffset = 0;
+};
+
+// Independent decoder for one entry: its own zlib stream and input buffer,
+// reading compressed bytes with positional I/O. Verifies size and CRC-32
+// once the end of the entry is reached.
+class EntryDecoder {
+public:
+    EntryDecoder(const RandomAccessFile& file, const EntryRecord& record)
+        : m_file(file), m_record(record) {
+        const ZipEntry& entry = m_record.entry;
+
+        uint8_t header[LOCAL_HEADER_SIZE];
+        m_file.readAt(m_record.localHeaderOffset, header, sizeof(header));
+        if (readLe32(header) != LOCAL_HEADER_SIGNATURE) {
+            throw XlsxError("Invalid local header for ZIP entry: " + entry.path);
+        }
+
+        // Name and extra lengths may differ from the central directory copy
+        m_dataOffset = m_record.localHeaderOffset + LOCAL_HEADER_SIZE +
+                       readLe16(header + 26) + readLe16(header + 28);
+        if (m_dataOffset > m_file.size() || entry.compressedSize > m_file.size() - m_dataOffset) {
+            throw XlsxError("ZIP entry data extends past end of file: " + entry.path);
+        }
+        m_compressedRemaining = entry.compressedSize;
+
+        if (entry.compressionMethod == METHOD_STORED) {
+            if (entry.compressedSize != entry.uncompressedSize) {
+                throw XlsxError("Corrupt stored ZIP entry: " + entry.path);
+            }
+        } else if (entry.compressionMethod == METHOD_DEFLATED) {
+            if (!m_file.data()) {
+                m_input.resize(std::min<size_t>(INPUT_CHUNK_SIZE, std::max<size_t>(entry.compressedSize, 1)));
+            }
+            m_zstream = z_stream{};
+            if (inflateInit2(&m_zstream, -MAX_WBITS) != Z_OK) { // Raw deflate, no zlib header
+                throw XlsxError("Failed to initialize inflate for ZIP entry: " + entry.path);
+            }
+            m_zstreamActive = true;
+        } else {
+            throw XlsxError("Unsupported ZIP compression method " +
+                            std::to_string(entry.compressionMethod) + ": " + entry.path);
+        }
+    }
+
+    ~EntryDecoder() {
+        if (m_zstreamActive) {
+            inflateEnd(&m_zstream);
+        }
+    }
+
+    EntryDecoder(const EntryDecoder&) = delete;
+    EntryDecoder& operator=(const EntryDecoder&) = delete;
+
+    // Decompress up to size bytes; returns 0 once the entry is complete
+    size_t read(uint8_t* buffer, size_t size) {
+        if (m_finished || size == 0) {
+            return 0;
+        }
+        size = std::min(size, MAX_OUTPUT_CHUNK);
+
+        size_t produced = m_record.entry.compressionMethod == METHOD_STORED
+            ? readStored(buffer, size)
+            : readDeflated(buffer, size);
+
+        if (produced == 0) {
+            verifyComplete();
+            m_finished = true;
+            return 0;
+        }
+
+        m_crc = crc32(m_crc, buffer, static_cast<uInt>(produced));
+        m_produced += produced;
+        if (m_produced > m_record.entry.uncompressedSize) {
+            throw XlsxError("ZIP entry is larger than its declared size: " + m_record.entry.path);
+        }
+        return produced;
+    }
+
+    uint64_t bytesProduced() const {
+        return m_produced;
+    }
+
+private:
+    size_t readStored(uint8_t* buffer, size_t size) {
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(size, m_compressedRemaining));
+        if (count > 0) {
+            m_file.readAt(m_dataOffset + (m_record.entry.compressedSize - m_compressedRemaining), buffer, count);
+            m_compressedRemaining -= count;
+        }
+        return count;
+    }
+
+    size_t readDeflated(uint8_t* buffer, size_t size) {
+        if (m_streamEnded) {
+            return 0;
+        }
+
+        m_zstream.next_out = buffer;
+        m_zstream.avail_out = static_cast<uInt>(size);
+
+        while (m_zstream.avail_out == size) {
+            if (m_zstream.avail_in == 0 && m_compressedRemaining > 0) {
+                const uint64_t offset = m_dataOffset + (m_record.entry.compressedSize - m_compressedRemaining);
+                if (const uint8_t* bytes = m_file.data()) {
+                    // Addressable archives are inflated in place
+                    const size_t count = static_cast<size_t>(std::min<uint64_t>(MAX_OUTPUT_CHUNK, m_compressedRemaining));
+                    m_zstream.next_in = const_cast<Bytef*>(bytes + offset);
+                    m_zstream.avail_in = static_cast<uInt>(count);
+                    m_compressedRemaining -= count;
+                } else {
+                    const size_t count = static_cast<size_t>(std::min<uint64_t>(m_input.size(), m_compressedRemaining));
+                    m_file.readAt(offset, m_input.data(), count);
+                    m_compressedRemaining -= count;
+                    m_zstream.next_in = m_input.data();
+                    m_zstream.avail_in = static_cast<uInt>(count);
+                }
+            }
+
+            int result = inflate(&m_zstream, Z_NO_FLUSH);
+            if (result == Z_STREAM_END) {
+                m_streamEnded = true;
+                break;
+            }
+            if (result == Z_BUF_ERROR && m_zstream.avail_in == 0 && m_compressedRemaining == 0) {
+                throw XlsxError("Truncated compressed data in ZIP entry: " + m_record.entry.path);
+            }
+            if (result != Z_OK && result != Z_BUF_ERROR) {
+                throw XlsxError("Corrupt compressed data in ZIP entry: " + m_record.entry.path);
+            }
+        }
+
+        return size - m_zstream.avail_out;
+    }
+
+    void verifyComplete() const {
+        if (m_produced != m_record.entry.uncompressedSize) {
+            throw XlsxError("ZIP entry size does not match its directory record: " + m_record.entry.path);
+        }
+        if (m_crc != m_record.entry.crc32) {
+            throw XlsxError("CRC-32 mismatch in ZIP entry: " + m_record.entry.path);
+        }
+    }
+
+    const RandomAccessFile& m_file;
+    EntryRecord m_record;
+    uint64_t m_dataOffset = 0;
+    uint64_t m_compressedRemaining = 0;
+    uint64_t m_produced = 0;
+    uLong m_crc = crc32(0L, Z_NULL, 0);
+    std::vector<uint8_t> m_input;
+    z_stream m_zstream{};
+    bool m_zstreamActive = false;
+    bool m_streamEnded = false;
+    bool m_finished = false;
+};
+
+// Inflates an entry on a background thread into a bounded ring of reusable
+// chunks while a single consumer reads them. Buffers are allocated once; the
+// producer fills a free slot outside the lock and only the handoff of a whole
+// chunk is synchronized. An empty chunk marks the end of the entry, and a
+// decoder error is rethrown to the consumer once the chunks before it are read.
+class InflatePipeline {
+public:
+    InflatePipeline(std::unique_ptr<EntryDecoder> decoder, size_t uncompressedSize,
+                    size_t chunkSize, size_t chunkCount)
+        : m_decoder(std::move(decoder)), m_chunks(std::max<size_t>(chunkCount, 1)) {
+        // Small entries do not need full-size buffers
+        const size_t bufferSize = std::max<size_t>(std::min(chunkSize, uncompressedSize), 1);
+        for (auto& chunk : m_chunks) {
+            chunk.data.resize(bufferSize);
+        }
+        m_worker = std::thread([this] { produce(); });
+    }
+
+    ~InflatePipeline() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_cv.notify_all();
+        m_worker.join();
+    }
+
+    InflatePipeline(const InflatePipeline&) = delete;
+    InflatePipeline& operator=(const InflatePipeline&) = delete;
+
+    size_t read(uint8_t* buffer, size_t size) {
+        if (size == 0) {
+            return 0;
+        }
+        if (!m_current) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [&] { return m_filled > m_released || m_error; });
+            if (m_filled == m_released) {
+                std::rethrow_exception(m_error);
+            }
+            m_current = &m_chunks[m_released % m_chunks.size()];
+        }
+        if (m_current->size == 0) {
+            return 0; // End of entry; the slot is kept so later reads also end
+        }
+
+        const size_t count = std::min(size, m_current->size - m_offset);
+        std::memcpy(buffer, m_current->data.data() + m_offset, count);
+        m_offset += count;
+        m_delivered += count;
+        if (m_offset == m_current->size) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_released;
+            }
+            m_cv.notify_all();
+            m_current = nullptr;
+            m_offset = 0;
+        }
+        return count;
+    }
+
+    uint64_t bytesDelivered() const {
+        return m_delivered;
+    }
+
+private:
+    struct Chunk {
+        std::vector<uint8_t> data;
+        size_t size = 0;
+    };
+
+    void produce() {
+        try {
+            for (;;) {
+                Chunk* chunk = nullptr;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_cv.wait(lock, [&] { return m_stopping || m_filled - m_released < m_chunks.size(); });
+                    if (m_stopping) {
+                        return;
+                    }
+                    chunk = &m_chunks[m_filled % m_chunks.size()];
+                }
+
+                // The consumer does not touch a slot until it is published
+                size_t size = 0;
+                while (size < chunk->data.size()) {
+                    const size_t produced = m_decoder->read(chunk->data.data() + size, chunk->data.size() - size);
+                    if (produced == 0) {
+                        break;
+                    }
+                    size += produced;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    chunk->size = size;
+                    ++m_filled;
+                }
+                m_cv.notify_all();
+                if (size == 0) {
+                    return;
+                }
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_error = std::current_exception();
+            }
+            m_cv.notify_all();
+        }
+    }
+
+    std::unique_ptr<EntryDecoder> m_decoder; // Only used by the worker
+    std::vector<Chunk> m_chunks;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    uint64_t m_filled = 0;    // Chunks published by the worker
+    uint64_t m_released = 0;  // Chunks the consumer has finished with
+    std::exception_ptr m_error;
+    bool m_stopping = false;
+
+    // Consumer state
+    Chunk* m_current = nullptr;
+    size_t m_offset = 0;
+    uint64_t m_delivered = 0;
+
+    std::thread m_worker;
+};
+
+} // namespace
+
+// The central directory is parsed once at open() into an immutable index;
+// reads never touch shared mutable state, so const methods are safe to call
+// from many threads at once.
 class ZipReader::Impl {
 public:
-    explicit Impl(const ZipSecurityLimits& limits) 
-        : m_limits(limits), m_unzFile(nullptr) {}
-    
+    explicit Impl(const ZipSecurityLimits& limits)
+        : m_limits(limits) {}
+
     ~Impl() {
         close();
     }
-    
+
     void open(const std::string& path) {
-        if (m_unzFile) {
+        if (m_isOpen) {
             close();
         }
-        
+
         if (!fs::exists(path)) {
             throw XlsxError("ZIP file does not exist: " + path);
         }
-        
-        m_unzFile = unzOpen64(path.c_str());
-        if (!m_unzFile) {
+
+        if (!m_file.open(path)) {
             throw XlsxError("Failed to open ZIP file: " + path);
         }
-        
-        validateZipSecurity();
-        m_isOpen = true;
+
+        indexCentralDirectory(path);
     }
-    
-    void close() {
-        if (m_unzFile) {
-            unzClose(m_unzFile);
-            m_unzFile = nullptr;
+
+    void openMapped(const std::string& path) {
+        if (m_isOpen) {
+            close();
+        }
+
+        if (!fs::exists(path)) {
+            throw XlsxError("ZIP file does not exist: " + path);
+        }
+
+        if (!m_file.openMapped(path)) {
+            throw XlsxError("Failed to map ZIP file: " + path);
         }
+        indexCentralDirectory(path);
+    }
+
+    void open(std::span<const std::byte> data) {
+        if (m_isOpen) {
+            close();
+        }
+
+        m_file.openMemory(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        indexCentralDirectory("<memory buffer>");
+    }
+
+    void close() {
+        m_file.close();
         m_isOpen = false;
-        m_entries.clear();
+        m_records.clear();
+        m_index.clear();
     }
-    
+
     bool isOpen() const {
         return m_isOpen;
     }
-    
-    std::vector<ZipEntry> listEntries() {
+
+    std::vector<ZipEntry> listEntries() const {
         if (!m_isOpen) {
             throw XlsxError("ZIP file is not open");
         }
-        
-        if (!m_entries.empty()) {
-            return m_entries; // Return cached entries
-        }
-        
-        int result = unzGoToFirstFile(m_unzFile);
-        if (result != UNZ_OK && result != UNZ_END_OF_LIST_OF_FILE) {
-            throw XlsxError("Failed to navigate to first ZIP entry");
-        }
-        
-        while (result == UNZ_OK) {
-            unz_file_info64 fileInfo;
-            char filename[1024] = {0};
-            
-            result = unzGetCurrentFileInfo64(m_unzFile, &fileInfo, filename, sizeof(filename), nullptr, 0, nullptr, 0);
-            if (result != UNZ_OK) {
-                break;
-            }
-            
-            ZipEntry entry;
-            entry.path = sanitizePath(filename);
-            entry.compressedSize = fileInfo.compressed_size;
-            entry.uncompressedSize = fileInfo.uncompressed_size;
-            entry.isEncrypted = (fileInfo.flag & 1) != 0; // UNZ_FLAG_ENCRYPTED
-            
-            // Skip entries with suspicious paths
-            if (entry.path.empty() || isPathSuspicious(entry.path)) {
-                result = unzGoToNextFile(m_unzFile);
-                continue;
-            }
-            
+
+        std::vector<ZipEntry> entries;
+        entries.reserve(m_records.size());
+        for (const auto& record : m_records) {
+            const ZipEntry& entry = record.entry;
+
             // Check security limits
             if (entry.uncompressedSize > m_limits.maxEntrySize) {
                 throw XlsxError("ZIP entry exceeds size limit: " + entry.path);
             }
-            
+
             if (entry.isEncrypted) {
                 throw XlsxError("Encrypted ZIP entries are not supported: " + entry.path);
             }
-            
-            m_entries.push_back(entry);
-            result = unzGoToNextFile(m_unzFile);
-        }
-        
-        if (m_entries.size() > m_limits.maxEntries) {
-            throw XlsxError("ZIP file contains too many entries: " + 
-                          std::to_string(m_entries.size()) + " > " + 
-                          std::to_string(m_limits.maxEntries));
+
+            entries.push_back(entry);
         }
-        
-        return m_entries;
+        return entries;
     }
-    
-    bool hasEntry(const std::string& path) {
+
+    bool hasEntry(const std::string& path) const {
         if (!m_isOpen) {
             throw XlsxError("ZIP file is not open");
         }
-        
-        auto entries = listEntries();
-        return std::find_if(entries.begin(), entries.end(),
-                           [&path](const ZipEntry& entry) {
-                               return entry.path == path;
-                           }) != entries.end();
+
+        return m_index.find(path) != m_index.end();
     }
-    
-    ByteVector readEntry(const std::string& path) {
+
+    const ZipEntry* findEntry(const std::string& path) const {
         if (!m_isOpen) {
             throw XlsxError("ZIP file is not open");
         }
-        
-        if (isPathSuspicious(path)) {
-            throw XlsxError("Suspicious path rejected: " + path);
-        }
-        
-        int result = unzLocateFile(m_unzFile, path.c_str(), 0);
-        if (result != UNZ_OK) {
-            throw XlsxError("ZIP entry not found: " + path);
-        }
-        
-        unz_file_info64 fileInfo;
-        result = unzGetCurrentFileInfo64(m_unzFile, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0);
-        if (result != UNZ_OK) {
-            throw XlsxError("Failed to get ZIP entry info: " + path);
-        }
-        
-        if (fileInfo.uncompressed_size > m_limits.maxEntrySize) {
-            throw XlsxError("ZIP entry exceeds size limit: " + path);
-        }
-        
-        if (fileInfo.flag & 1) { // UNZ_FLAG_ENCRYPTED
-            throw XlsxError("Encrypted ZIP entries are not supported: " + path);
-        }
-        
-        result = unzOpenCurrentFile(m_unzFile);
-        if (result != UNZ_OK) {
-            throw XlsxError("Failed to open ZIP entry: " + path);
-        }
-        
-        // Use chunked reading with 512 KiB buffers for better I/O efficiency
-        static constexpr size_t BUFFER_SIZE = 512 * 1024; // 512 KiB chunks
-        ByteVector data;
-        data.reserve(fileInfo.uncompressed_size);
-        
-        ByteVector buffer(BUFFER_SIZE);
-        
-        while (true) {
-            int bytesRead = unzReadCurrentFile(m_unzFile, buffer.data(), buffer.size());
-            if (bytesRead < 0) {
-                unzCloseCurrentFile(m_unzFile);
-                throw XlsxError("Failed to read ZIP entry: " + path);
-            }
-            
+
+        auto it = m_index.find(path);
+        return it == m_index.end() ? nullptr : &m_records[it->second].entry;
+    }
+
+    ByteVector readEntry(const std::string& path) const {
+        std::unique_ptr<EntryDecoder> decoder = openDecoder(path);
+        const size_t uncompressedSize = findRecord(path).entry.uncompressedSize;
+
+        // The declared size is validated against the limits, so inflate straight
+        // into a buffer of that size
+        ByteVector data(uncompressedSize);
+        size_t filled = 0;
+        while (filled < data.size()) {
+            size_t bytesRead = decoder->read(data.data() + filled, data.size() - filled);
             if (bytesRead == 0) {
-                break; // End of file
+                break; // Size mismatch is reported by the decoder
             }
-            
-            // Append the chunk to our data
-            data.insert(data.end(), buffer.begin(), buffer.begin() + bytesRead);
+            filled += bytesRead;
         }
-        
-        unzCloseCurrentFile(m_unzFile);
+
+        // Drive the decoder to end of entry so size and CRC are verified
+        uint8_t probe;
+        decoder->read(&probe, 1);
         return data;
     }
-    
-    std::string readEntryAsString(const std::string& path) {
+
+    std::string readEntryAsString(const std::string& path) const {
         auto data = readEntry(path);
         return std::string(data.begin(), data.end());
     }
-    
+
+    std::unique_ptr<EntryDecoder> openDecoder(const std::string& path) const {
+        const EntryRecord& record = findRecord(path);
+
+        if (record.entry.uncompressedSize > m_limits.maxEntrySize) {
+            throw XlsxError("ZIP entry exceeds size limit: " + path);
+        }
+
+        if (record.entry.isEncrypted) {
+            throw XlsxError("Encrypted ZIP entries are not supported: " + path);
+        }
+
+        return std::make_unique<EntryDecoder>(m_file, record);
+    }
+
+    const EntryRecord& findRecord(const std::string& path) const {
+        if (!m_isOpen) {
+            throw XlsxError("ZIP file is not open");
+        }
+
+        if (isPathSuspicious(path)) {
+            throw XlsxError("Suspicious path rejected: " + path);
+        }
+
+        auto it = m_index.find(path);
+        if (it == m_index.end()) {
+            throw XlsxError("ZIP entry not found: " + path);
+        }
+        return m_records[it->second];
+    }
+
     const ZipSecurityLimits& getSecurityLimits() const {
         return m_limits;
     }
 
 private:
-    void validateZipSecurity() {
-        // Get total uncompressed size to check against limit
-        size_t totalUncompressed = 0;
-        size_t entryCount = 0;
-        
-        int result = unzGoToFirstFile(m_unzFile);
-        while (result == UNZ_OK) {
-            unz_file_info64 fileInfo;
-            result = unzGetCurrentFileInfo64(m_unzFile, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0);
-            if (result != UNZ_OK) {
+    // The name only labels error messages
+    void indexCentralDirectory(const std::string& name) {
+        try {
+            readCentralDirectory(name);
+        } catch (...) {
+            close();
+            throw;
+        }
+        m_isOpen = true;
+    }
+
+    void readCentralDirectory(const std::string& path) {
+        const uint64_t fileSize = m_file.size();
+        if (fileSize < EOCD_SIZE) {
+            throw XlsxError("Failed to open ZIP file: " + path);
+        }
+
+        // The end of central directory record sits at the end, before an optional comment
+        const size_t tailSize = static_cast<size_t>(std::min<uint64_t>(fileSize, MAX_EOCD_SEARCH));
+        const uint64_t tailOffset = fileSize - tailSize;
+        ByteVector tail(tailSize);
+        m_file.readAt(tailOffset, tail.data(), tail.size());
+
+        size_t eocdPos = std::numeric_limits<size_t>::max();
+        for (size_t pos = tailSize - EOCD_SIZE + 1; pos-- > 0;) {
+            if (readLe32(&tail[pos]) == EOCD_SIGNATURE &&
+                pos + EOCD_SIZE + readLe16(&tail[pos + 20]) <= tailSize) {
+                eocdPos = pos;
                 break;
             }
-            
-            totalUncompressed += fileInfo.uncompressed_size;
-            entryCount++;
-            
-            if (entryCount > m_limits.maxEntries) {
-                throw XlsxError("ZIP file contains too many entries");
+        }
+        if (eocdPos == std::numeric_limits<size_t>::max()) {
+            throw XlsxError("Failed to open ZIP file: " + path);
+        }
+
+        const uint8_t* eocd = &tail[eocdPos];
+        const uint64_t eocdOffset = tailOffset + eocdPos;
+        uint32_t diskNumber = readLe16(eocd + 4);
+        uint32_t cdDisk = readLe16(eocd + 6);
+        uint64_t entryCount = readLe16(eocd + 10);
+        uint64_t cdSize = readLe32(eocd + 12);
+        uint64_t cdOffset = readLe32(eocd + 16);
+
+        if (entryCount == 0xFFFF || cdSize == 0xFFFFFFFF || cdOffset == 0xFFFFFFFF) {
+            // ZIP64: the locator immediately precedes the classic record
+            if (eocdOffset < ZIP64_LOCATOR_SIZE) {
+                throw XlsxError("Missing ZIP64 end of central directory locator: " + path);
+            }
+            uint8_t locator[ZIP64_LOCATOR_SIZE];
+            m_file.readAt(eocdOffset - ZIP64_LOCATOR_SIZE, locator, sizeof(locator));
+            if (readLe32(locator) != ZIP64_LOCATOR_SIGNATURE) {
+                throw XlsxError("Missing ZIP64 end of central directory locator: " + path);
             }
-            
-            if (totalUncompressed > m_limits.maxTotalUncompressed) {
+
+            uint8_t zip64Eocd[ZIP64_EOCD_SIZE];
+            m_file.readAt(readLe64(locator + 8), zip64Eocd, sizeof(zip64Eocd));
+            if (readLe32(zip64Eocd) != ZIP64_EOCD_SIGNATURE) {
+                throw XlsxError("Invalid ZIP64 end of central directory record: " + path);
+            }
+            diskNumber = readLe32(zip64Eocd + 16);
+            cdDisk = readLe32(zip64Eocd + 20);
+            entryCount = readLe64(zip64Eocd + 32);
+            cdSize = readLe64(zip64Eocd + 40);
+            cdOffset = readLe64(zip64Eocd + 48);
+        }
+
+        if (diskNumber != 0 || cdDisk != 0) {
+            throw XlsxError("Multi-disk ZIP archives are not supported: " + path);
+        }
+
+        if (entryCount > m_limits.maxEntries) {
+            throw XlsxError("ZIP file contains too many entries");
+        }
+
+        if (cdOffset > fileSize || cdSize > fileSize - cdOffset) {
+            throw XlsxError("Corrupt ZIP central directory: " + path);
+        }
+
+        ByteVector directory(static_cast<size_t>(cdSize));
+        m_file.readAt(cdOffset, directory.data(), directory.size());
+
+        m_records.reserve(static_cast<size_t>(entryCount));
+        m_index.reserve(static_cast<size_t>(entryCount));
+
+        uint64_t totalUncompressed = 0;
+        size_t pos = 0;
+        for (uint64_t i = 0; i < entryCount; ++i) {
+            if (directory.size() - pos < CENTRAL_HEADER_SIZE ||
+                readLe32(&directory[pos]) != CENTRAL_HEADER_SIGNATURE) {
+                throw XlsxError("Corrupt ZIP central directory: " + path);
+            }
+
+            const uint8_t* header = &directory[pos];
+            const uint16_t flags = readLe16(header + 8);
+            const uint16_t method = readLe16(header + 10);
+            const uint32_t crc = readLe32(header + 16);
+            uint64_t compressedSize = readLe32(header + 20);
+            uint64_t uncompressedSize = readLe32(header + 24);
+            const size_t nameLength = readLe16(header + 28);
+            const size_t extraLength = readLe16(header + 30);
+            const size_t commentLength = readLe16(header + 32);
+            uint64_t localHeaderOffset = readLe32(header + 42);
+
+            const size_t recordSize = CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength;
+            if (directory.size() - pos < recordSize) {
+                throw XlsxError("Corrupt ZIP central directory: " + path);
+            }
+
+            std::string name(reinterpret_cast<const char*>(header + CENTRAL_HEADER_SIZE), nameLength);
+
+            // ZIP64 extended information holds only the fields saturated above
+            const uint8_t* extra = header + CENTRAL_HEADER_SIZE + nameLength;
+            for (size_t e = 0; e + 4 <= extraLength;) {
+                const uint16_t id = readLe16(extra + e);
+                const size_t size = readLe16(extra + e + 2);
+                if (e + 4 + size > extraLength) {
+                    break;
+                }
+                if (id == ZIP64_EXTRA_FIELD_ID) {
+                    const uint8_t* field = extra + e + 4;
+                    const uint8_t* fieldEnd = field + size;
+                    auto take = [&](uint64_t& value) {
+                        if (value == 0xFFFFFFFF && fieldEnd - field >= 8) {
+                            value = readLe64(field);
+                            field += 8;
+                        }
+                    };
+                    take(uncompressedSize);
+                    take(compressedSize);
+                    take(localHeaderOffset);
+                    break;
+                }
+                e += 4 + size;
+            }
+            pos += recordSize;
+
+            if (uncompressedSize > m_limits.maxTotalUncompressed - totalUncompressed) {
                 throw XlsxError("ZIP file total uncompressed size exceeds limit");
             }
-            
-            result = unzGoToNextFile(m_unzFile);
+            totalUncompressed += uncompressedSize;
+
+            // Skip entries with suspicious paths
+            std::string sanitized = sanitizePath(name);
+            if (sanitized.empty() || isPathSuspicious(sanitized)) {
+                continue;
+            }
+
+            EntryRecord record;
+            record.entry.path = std::move(sanitized);
+            record.entry.compressedSize = static_cast<size_t>(compressedSize);
+            record.entry.uncompressedSize = static_cast<size_t>(uncompressedSize);
+            record.entry.isEncrypted = (flags & FLAG_ENCRYPTED) != 0;
+            record.entry.compressionMethod = method;
+            record.entry.crc32 = crc;
+            record.localHeaderOffset = localHeaderOffset;
+
+            // First occurrence wins for duplicate names
+            if (m_index.emplace(record.entry.path, m_records.size()).second) {
+                m_records.push_back(std::move(record));
+            }
         }
     }
-    
-    std::string sanitizePath(const std::string& path) {
+
+    static std::string sanitizePath(const std::string& path) {
         // Normalize path separators and remove dangerous sequences
         std::string sanitized = path;
-        
+
         // Replace backslashes with forward slashes
         std::replace(sanitized.begin(), sanitized.end(), '\\', '/');
-        
+
         // Remove leading slashes
         while (!sanitized.empty() && sanitized[0] == '/') {
             sanitized.erase(0, 1);
         }
-        
+
         return sanitized;
     }
-    
-    bool isPathSuspicious(const std::string& path) {
+
+    static bool isPathSuspicious(const std::string& path) {
         // Check for path traversal attempts
         if (path.find("..") != std::string::npos) {
             return true;
         }
-        
+
         // Check for absolute paths
         if (!path.empty() && path[0] == '/') {
             return true;
         }
-        
+
         // Check for null bytes
         if (path.find('\0') != std::string::npos) {
             return true;
         }
-        
+
         // Check for extremely long paths
         if (path.length() > 1024) {
             return true;
         }
-        
+
         return false;
     }
-    
+
     ZipSecurityLimits m_limits;
-    unzFile m_unzFile;
+    RandomAccessFile m_file;
     bool m_isOpen = false;
-    std::vector<ZipEntry> m_entries; // Cache entries after first list
+    std::vector<EntryRecord> m_records;                 // Central directory order
+    std::unordered_map<std::string, size_t> m_index;    // Path -> index into m_records
 };
 
+// ZipEntryStream implementation
+class ZipEntryStream::Impl {
+public:
+    Impl(std::unique_ptr<EntryDecoder> decoder, std::string path, size_t uncompressedSize)
+        : m_decoder(std::move(decoder)), m_path(std::move(path)), m_uncompressedSize(uncompressedSize) {}
+
+    Impl(std::unique_ptr<InflatePipeline> pipeline, std::string path, size_t uncompressedSize)
+        : m_pipeline(std::move(pipeline)), m_path(std::move(path)), m_uncompressedSize(uncompressedSize) {}
+
+    size_t read(uint8_t* buffer, size_t size) {
+        if (m_pipeline) {
+            return m_pipeline->read(buffer, size);
+        }
+        if (!m_decoder) {
+            return 0;
+        }
+        return m_decoder->read(buffer, size);
+    }
+
+    void close() {
+        if (m_decoder) {
+            m_bytesRead = static_cast<size_t>(m_decoder->bytesProduced());
+            m_decoder.reset();
+        }
+        if (m_pipeline) {
+            m_bytesRead = static_cast<size_t>(m_pipeline->bytesDelivered());
+            m_pipeline.reset(); // Stops and joins the inflate thread
+        }
+    }
+
+    bool isOpen() const {
+        return m_decoder != nullptr || m_pipeline != nullptr;
+    }
+
+    const std::string& path() const {
+        return m_path;
+    }
+
+    size_t uncompressedSize() const {
+        return m_uncompressedSize;
+    }
+
+    size_t bytesRead() const {
+        if (m_pipeline) {
+            return static_cast<size_t>(m_pipeline->bytesDelivered());
+        }
+        return m_decoder ? static_cast<size_t>(m_decoder->bytesProduced()) : m_bytesRead;
+    }
+
+private:
+    std::unique_ptr<EntryDecoder> m_decoder;
+    std::unique_ptr<InflatePipeline> m_pipeline;
+    std::string m_path;
+    size_t m_uncompressedSize;
+    size_t m_bytesRead = 0;
+};
+
+ZipEntryStream::ZipEntryStream() = default;
+
+ZipEntryStream::ZipEntryStream(std::unique_ptr<Impl> impl) : m_impl(std::move(impl)) {}
+
+ZipEntryStream::~ZipEntryStream() = default;
+
+ZipEntryStream::ZipEntryStream(ZipEntryStream&&) noexcept = default;
+ZipEntryStream& ZipEntryStream::operator=(ZipEntryStream&&) noexcept = default;
+
+size_t ZipEntryStream::read(uint8_t* buffer, size_t size) {
+    if (!m_impl) {
+        throw XlsxError("ZIP entry stream is not open");
+    }
+    return m_impl->read(buffer, size);
+}
+
+void ZipEntryStream::close() {
+    if (m_impl) {
+        m_impl->close();
+    }
+}
+
+bool ZipEntryStream::isOpen() const {
+    return m_impl && m_impl->isOpen();
+}
+
+const std::string& ZipEntryStream::path() const {
+    static const std::string empty;
+    return m_impl ? m_impl->path() : empty;
+}
+
+size_t ZipEntryStream::uncompressedSize() const {
+    return m_impl ? m_impl->uncompressedSize() : 0;
+}
+
+size_t ZipEntryStream::bytesRead() const {
+    return m_impl ? m_impl->bytesRead() : 0;
+}
+
 // ZipReader implementation
 ZipReader::ZipReader(const ZipSecurityLimits& limits) 
     : m_impl(std::make_unique<Impl>(limits)) {}
@@ -278,6 +1012,14 @@ void ZipReader::open(const std::string& path) {
     m_impl->open(path);
 }
 
+void ZipReader::openMapped(const std::string& path) {
+    m_impl->openMapped(path);
+}
+
+void ZipReader::open(std::span<const std::byte> data) {
+    m_impl->open(data);
+}
+
 void ZipReader::close() {
     m_impl->close();
 }
@@ -294,6 +1036,10 @@ bool ZipReader::hasEntry(const std::string& path) const {
     return m_impl->hasEntry(path);
 }
 
+const ZipEntry* ZipReader::findEntry(const std::string& path) const {
+    return m_impl->findEntry(path);
+}
+
 ByteVector ZipReader::readEntry(const std::string& path) const {
     return m_impl->readEntry(path);
 }
@@ -302,6 +1048,21 @@ std::string ZipReader::readEntryAsString(const std::string& path) const {
     return m_impl->readEntryAsString(path);
 }
 
+ZipEntryStream ZipReader::openEntryStream(const std::string& path) const {
+    auto decoder = m_impl->openDecoder(path);
+    const size_t uncompressedSize = m_impl->findRecord(path).entry.uncompressedSize;
+    return ZipEntryStream(std::make_unique<ZipEntryStream::Impl>(std::move(decoder), path, uncompressedSize));
+}
+
+ZipEntryStream ZipReader::openPipelinedEntryStream(const std::string& path,
+                                                   size_t chunkSize,
+                                                   size_t chunkCount) const {
+    auto decoder = m_impl->openDecoder(path);
+    const size_t uncompressedSize = m_impl->findRecord(path).entry.uncompressedSize;
+    auto pipeline = std::make_unique<InflatePipeline>(std::move(decoder), uncompressedSize, chunkSize, chunkCount);
+    return ZipEntryStream(std::make_unique<ZipEntryStream::Impl>(std::move(pipeline), path, uncompressedSize));
+}
+
 const ZipSecurityLimits& ZipReader::getSecurityLimits() const {
     return m_impl->getSecurityLimits();
 }
@@ -0,0 +1,492 @@
+#include "xlsxcsv.hpp"
+#include <zlib.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#ifdef TURBOXL_HAVE_ZSTD
+#  include <zstd.h>
+#endif
+
+namespace xlsxcsv {
+
+namespace {
+
+// Compressed bytes are handed to the target in blocks of this size
+constexpr size_t OUTPUT_BLOCK_BYTES = 256 * 1024;
+// Input per concurrently deflated block, as in pigz
+constexpr size_t PARALLEL_BLOCK_BYTES = 128 * 1024;
+// Blocks queued or compressing per worker thread
+constexpr size_t BLOCKS_PER_THREAD = 2;
+// Deflate's window; each parallel block is primed with this much preceding input
+constexpr size_t DICTIONARY_BYTES = 32 * 1024;
+// Largest piece handed to zlib at once, whose lengths are 32-bit
+constexpr size_t MAX_ZLIB_PIECE = 1u << 30;
+
+// Hands compressed bytes to the target, counting them
+class CompressedWriter {
+public:
+    explicit CompressedWriter(OutputSink& target) : m_target(target) {}
+
+    void write(const char* data, size_t size) {
+        if (size > 0) {
+            m_target.write(data, size);
+            m_bytes += size;
+        }
+    }
+    void flush() { m_target.flush(); }
+    uint64_t bytes() const { return m_bytes; }
+
+private:
+    OutputSink& m_target;
+    uint64_t m_bytes = 0;
+};
+
+class Codec {
+public:
+    virtual ~Codec() = default;
+    virtual void write(const char* data, size_t size) = 0;
+    virtual void flush() = 0;  // Passes on the bytes compressed so far
+    virtual void finish() = 0; // Ends the stream
+};
+
+class PassThroughCodec : public Codec {
+public:
+    explicit PassThroughCodec(CompressedWriter& out) : m_out(out) {}
+    void write(const char* data, size_t size) override { m_out.write(data, size); }
+    void flush() override { m_out.flush(); }
+    void finish() override { m_out.flush(); }
+
+private:
+    CompressedWriter& m_out;
+};
+
+// One gzip member from a single deflate stream
+class GzipCodec : public Codec {
+public:
+    GzipCodec(CompressedWriter& out, int level) : m_out(out), m_buffer(OUTPUT_BLOCK_BYTES) {
+        // 16 added to the window bits selects the gzip wrapper
+        if (deflateInit2(&m_stream, level, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("Failed to initialize gzip compression");
+        }
+    }
+
+    ~GzipCodec() override {
+        deflateEnd(&m_stream);
+    }
+
+    void write(const char* data, size_t size) override {
+        while (size > 0) {
+            const size_t piece = std::min(size, MAX_ZLIB_PIECE);
+            deflateInput(data, piece, Z_NO_FLUSH);
+            data += piece;
+            size -= piece;
+        }
+    }
+
+    void flush() override {
+        emit();
+        m_out.flush();
+    }
+
+    void finish() override {
+        deflateInput(nullptr, 0, Z_FINISH);
+        emit();
+        m_out.flush();
+    }
+
+private:
+    void deflateInput(const char* data, size_t size, int mode) {
+        m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        m_stream.avail_in = static_cast<uInt>(size);
+        for (;;) {
+            m_stream.next_out = reinterpret_cast<Bytef*>(m_buffer.data() + m_used);
+            m_stream.avail_out = static_cast<uInt>(m_buffer.size() - m_used);
+            const int result = deflate(&m_stream, mode);
+            if (result == Z_STREAM_ERROR) {
+                throw std::runtime_error("gzip compression failed");
+            }
+            m_used = m_buffer.size() - m_stream.avail_out;
+            if (m_used == m_buffer.size()) {
+                emit();
+                continue;
+            }
+            if (mode == Z_FINISH ? result == Z_STREAM_END : m_stream.avail_in == 0) {
+                return;
+            }
+        }
+    }
+
+    void emit() {
+        m_out.write(m_buffer.data(), m_used);
+        m_used = 0;
+    }
+
+    CompressedWriter& m_out;
+    z_stream m_stream{};
+    std::vector<char> m_buffer;
+    size_t m_used = 0;
+};
+
+// One gzip member whose deflate stream is built from independently deflated
+// blocks. Each block is primed with the input preceding it and ends on a
+// byte boundary (a sync flush), so the blocks concatenate into a stream any
+// gunzip reads; the CRC is computed here as the input arrives. Blocks are
+// written out in order on the caller's thread.
+class ParallelGzipCodec : public Codec {
+public:
+    ParallelGzipCodec(CompressedWriter& out, int level, unsigned threads)
+        : m_out(out), m_level(level), m_maxInFlight(threads * BLOCKS_PER_THREAD) {
+        // Test deflate parameters up front rather than in a worker
+        z_stream probe{};
+        if (deflateInit2(&probe, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("Failed to initialize gzip compression");
+        }
+        deflateEnd(&probe);
+        m_pending.reserve(PARALLEL_BLOCK_BYTES);
+        m_workers.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            m_workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ~ParallelGzipCodec() override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_changed.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void write(const char* data, size_t size) override {
+        if (!m_headerWritten) {
+            // Fixed header: no name or timestamp, unknown OS
+            static constexpr char HEADER[10] = {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, '\xff'};
+            m_out.write(HEADER, sizeof(HEADER));
+            m_headerWritten = true;
+        }
+        while (size > 0) {
+            const size_t piece = std::min(size, PARALLEL_BLOCK_BYTES - m_pending.size());
+            m_crc = crc32(m_crc, reinterpret_cast<const Bytef*>(data), static_cast<uInt>(piece));
+            m_inputBytes += piece;
+            m_pending.append(data, piece);
+            data += piece;
+            size -= piece;
+            if (m_pending.size() == PARALLEL_BLOCK_BYTES) {
+                submit(false);
+            }
+        }
+    }
+
+    void flush() override {
+        drain(false);
+        m_out.flush();
+    }
+
+    void finish() override {
+        write(nullptr, 0); // Header of an empty stream
+        submit(true);
+        drain(true);
+        // Trailer: CRC32 and input size modulo 2^32, little-endian
+        char trailer[8];
+        const uint32_t crc = static_cast<uint32_t>(m_crc);
+        const uint32_t size = static_cast<uint32_t>(m_inputBytes);
+        for (int i = 0; i < 4; ++i) {
+            trailer[i] = static_cast<char>((crc >> (8 * i)) & 0xFF);
+            trailer[4 + i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+        }
+        m_out.write(trailer, sizeof(trailer));
+        m_out.flush();
+    }
+
+private:
+    struct Block {
+        std::string input;
+        std::string dictionary;
+        bool last = false;
+        std::string output; // Set by a worker, with done
+        std::string error;
+        bool done = false;
+    };
+
+    void submit(bool last) {
+        auto block = std::make_shared<Block>();
+        block->dictionary = m_window;
+        block->last = last;
+        if (m_pending.size() >= DICTIONARY_BYTES) {
+            m_window.assign(m_pending, m_pending.size() - DICTIONARY_BYTES, DICTIONARY_BYTES);
+        } else {
+            m_window.append(m_pending);
+            if (m_window.size() > DICTIONARY_BYTES) {
+                m_window.erase(0, m_window.size() - DICTIONARY_BYTES);
+            }
+        }
+        block->input = std::move(m_pending);
+        m_pending = std::string();
+        m_pending.reserve(PARALLEL_BLOCK_BYTES);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_inFlight.push_back(block);
+            m_queue.push_back(std::move(block));
+        }
+        m_changed.notify_all();
+        drain(false);
+    }
+
+    // Writes out finished blocks in order. Without waitAll it only waits
+    // while too many blocks are in flight.
+    void drain(bool waitAll) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_inFlight.empty()) {
+            std::shared_ptr<Block> block = m_inFlight.front();
+            if (!block->done) {
+                if (!waitAll && m_inFlight.size() <= m_maxInFlight) {
+                    return;
+                }
+                m_changed.wait(lock, [&] { return block->done; });
+            }
+            m_inFlight.pop_front();
+            lock.unlock();
+            if (!block->error.empty()) {
+                throw std::runtime_error(block->error);
+            }
+            m_out.write(block->output.data(), block->output.size());
+            lock.lock();
+        }
+    }
+
+    void work() {
+        for (;;) {
+            std::shared_ptr<Block> block;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_changed.wait(lock, [&] { return m_stopping || !m_queue.empty(); });
+                if (m_stopping) {
+                    return;
+                }
+                block = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            compress(*block);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                block->done = true;
+            }
+            m_changed.notify_all();
+        }
+    }
+
+    void compress(Block& block) const {
+        z_stream stream{};
+        if (deflateInit2(&stream, m_level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            block.error = "Failed to initialize gzip compression";
+            return;
+        }
+        if (!block.dictionary.empty()) {
+            deflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(block.dictionary.data()),
+                                 static_cast<uInt>(block.dictionary.size()));
+        }
+        // The bound does not cover the sync flush marker, hence the margin
+        block.output.resize(deflateBound(&stream, static_cast<uLong>(block.input.size())) + 64);
+        stream.next_in = reinterpret_cast<Bytef*>(block.input.data());
+        stream.avail_in = static_cast<uInt>(block.input.size());
+        const int mode = block.last ? Z_FINISH : Z_SYNC_FLUSH;
+        for (;;) {
+            stream.next_out = reinterpret_cast<Bytef*>(block.output.data() + stream.total_out);
+            stream.avail_out = static_cast<uInt>(block.output.size() - stream.total_out);
+            const int result = deflate(&stream, mode);
+            if (result == Z_STREAM_ERROR) {
+                block.error = "gzip compression failed";
+                break;
+            }
+            if (stream.avail_out > 0 && (block.last ? result == Z_STREAM_END : stream.avail_in == 0)) {
+                break;
+            }
+            block.output.resize(block.output.size() * 2);
+        }
+        block.output.resize(stream.total_out);
+        block.input = std::string(); // Released early; the window copy lives on
+        deflateEnd(&stream);
+    }
+
+    CompressedWriter& m_out;
+    const int m_level;
+    const size_t m_maxInFlight;
+    bool m_headerWritten = false;
+    uLong m_crc = crc32(0L, Z_NULL, 0);
+    uint64_t m_inputBytes = 0;
+    std::string m_pending; // Input of the block being filled
+    std::string m_window;  // Last DICTIONARY_BYTES of input submitted
+
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::deque<std::shared_ptr<Block>> m_inFlight; // Submitted, in output order
+    std::deque<std::shared_ptr<Block>> m_queue;    // Not yet claimed by a worker
+    bool m_stopping = false;
+    std::vector<std::thread> m_workers;
+};
+
+#ifdef TURBOXL_HAVE_ZSTD
+// One zstd frame; with several threads libzstd compresses jobs concurrently
+class ZstdCodec : public Codec {
+public:
+    ZstdCodec(CompressedWriter& out, int level, unsigned threads)
+        : m_out(out), m_context(ZSTD_createCCtx()), m_buffer(OUTPUT_BLOCK_BYTES) {
+        if (!m_context || ZSTD_isError(ZSTD_CCtx_setParameter(m_context, ZSTD_c_compressionLevel, level))) {
+            ZSTD_freeCCtx(m_context);
+            throw std::runtime_error("Failed to initialize zstd compression");
+        }
+        if (threads > 1) {
+            // Fails harmlessly with a single-threaded libzstd
+            ZSTD_CCtx_setParameter(m_context, ZSTD_c_nbWorkers, static_cast<int>(threads));
+        }
+    }
+
+    ~ZstdCodec() override {
+        ZSTD_freeCCtx(m_context);
+    }
+
+    void write(const char* data, size_t size) override {
+        ZSTD_inBuffer input{data, size, 0};
+        while (input.pos < input.size) {
+            compress(input, ZSTD_e_continue);
+        }
+    }
+
+    void flush() override {
+        emit();
+        m_out.flush();
+    }
+
+    void finish() override {
+        ZSTD_inBuffer input{nullptr, 0, 0};
+        while (compress(input, ZSTD_e_end) != 0) {
+        }
+        emit();
+        m_out.flush();
+    }
+
+private:
+    // Returns what libzstd still has to flush
+    size_t compress(ZSTD_inBuffer& input, ZSTD_EndDirective mode) {
+        ZSTD_outBuffer output{m_buffer.data() + m_used, m_buffer.size() - m_used, 0};
+        const size_t remaining = ZSTD_compressStream2(m_context, &output, &input, mode);
+        if (ZSTD_isError(remaining)) {
+            throw std::runtime_error(std::string("zstd compression failed: ") + ZSTD_getErrorName(remaining));
+        }
+        m_used += output.pos;
+        if (m_used == m_buffer.size()) {
+            emit();
+        }
+        return remaining;
+    }
+
+    void emit() {
+        m_out.write(m_buffer.data(), m_used);
+        m_used = 0;
+    }
+
+    CompressedWriter& m_out;
+    ZSTD_CCtx* m_context;
+    std::vector<char> m_buffer;
+    size_t m_used = 0;
+};
+#endif
+
+} // namespace
+
+class CompressedOutputSink::Impl {
+public:
+    Impl(OutputSink& target, CsvOptions::OutputCompression codec, int level, unsigned threads)
+        : m_out(target) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        switch (codec) {
+            case CsvOptions::OutputCompression::NONE:
+                m_codec = std::make_unique<PassThroughCodec>(m_out);
+                break;
+            case CsvOptions::OutputCompression::GZIP:
+                if (level == -1) {
+                    level = Z_DEFAULT_COMPRESSION;
+                } else if (level < 0 || level > 9) {
+                    throw std::invalid_argument("gzip compression level must be 0-9, got " + std::to_string(level));
+                }
+                if (threads > 1) {
+                    m_codec = std::make_unique<ParallelGzipCodec>(m_out, level, threads);
+                } else {
+                    m_codec = std::make_unique<GzipCodec>(m_out, level);
+                }
+                break;
+            case CsvOptions::OutputCompression::ZSTD:
+#ifdef TURBOXL_HAVE_ZSTD
+                if (level == -1) {
+                    level = ZSTD_CLEVEL_DEFAULT;
+                } else if (level < ZSTD_minCLevel() || level > ZSTD_maxCLevel()) {
+                    throw std::invalid_argument("zstd compression level out of range: " + std::to_string(level));
+                }
+                m_codec = std::make_unique<ZstdCodec>(m_out, level, threads);
+                break;
+#else
+                throw std::invalid_argument("zstd output compression is not available in this build");
+#endif
+            default:
+                throw std::invalid_argument("Unknown output compression");
+        }
+    }
+
+    CompressedWriter m_out;
+    std::unique_ptr<Codec> m_codec;
+    bool m_finished = false;
+};
+
+CompressedOutputSink::CompressedOutputSink(OutputSink& target,
+                                           CsvOptions::OutputCompression codec,
+                                           int level,
+                                           unsigned threads)
+    : m_impl(std::make_unique<Impl>(target, codec, level, threads)) {}
+
+CompressedOutputSink::~CompressedOutputSink() = default;
+
+void CompressedOutputSink::write(const char* data, size_t size) {
+    if (m_impl->m_finished) {
+        throw std::runtime_error("Compressed output was already finished");
+    }
+    m_impl->m_codec->write(data, size);
+}
+
+void CompressedOutputSink::flush() {
+    if (!m_impl->m_finished) {
+        m_impl->m_codec->flush();
+    }
+}
+
+void CompressedOutputSink::finish() {
+    if (m_impl->m_finished) {
+        return;
+    }
+    m_impl->m_codec->finish();
+    m_impl->m_finished = true;
+}
+
+uint64_t CompressedOutputSink::compressedBytes() const {
+    return m_impl->m_out.bytes();
+}
+
+bool CompressedOutputSink::supports(CsvOptions::OutputCompression codec) {
+#ifdef TURBOXL_HAVE_ZSTD
+    (void)codec;
+    return true;
+#else
+    return codec != CsvOptions::OutputCompression::ZSTD;
+#endif
+}
+
+} // namespace xlsxcsv
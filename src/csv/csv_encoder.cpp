@@ -1,17 +1,145 @@
 #include "xlsxcsv/core.hpp"
-#include <stdexcept>
+#include "xlsxcsv.hpp"  // For CsvOptions
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define TURBOXL_CSV_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define TURBOXL_CSV_NEON 1
+#endif
 
 namespace xlsxcsv::core {
 
-class CsvEncoder {
-public:
-    CsvEncoder() = default;
-    ~CsvEncoder() = default;
-    
-    // TODO: Implement in Phase 6
-    std::string encode(const std::vector<std::vector<std::string>>& data) {
-        throw std::runtime_error("CsvEncoder not implemented yet - coming in Phase 6");
+namespace {
+
+inline bool isSpecial(char ch, char delimiter) {
+    return ch == delimiter || ch == '"' || ch == '\n' || ch == '\r';
+}
+
+// First byte in [p, end) that forces quoting, or end. Most cell text has
+// none, so 16 bytes are tested per step against all four specials at once.
+const char* findSpecial(const char* p, const char* end, char delimiter) {
+#if defined(TURBOXL_CSV_SSE2)
+    const __m128i vdelim = _mm_set1_epi8(delimiter);
+    const __m128i vquote = _mm_set1_epi8('"');
+    const __m128i vlf = _mm_set1_epi8('\n');
+    const __m128i vcr = _mm_set1_epi8('\r');
+    while (end - p >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, vdelim), _mm_cmpeq_epi8(chunk, vquote)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, vlf), _mm_cmpeq_epi8(chunk, vcr)));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return p + std::countr_zero(mask);
+        }
+        p += 16;
+    }
+#elif defined(TURBOXL_CSV_NEON)
+    const uint8x16_t vdelim = vdupq_n_u8(static_cast<uint8_t>(delimiter));
+    const uint8x16_t vquote = vdupq_n_u8('"');
+    const uint8x16_t vlf = vdupq_n_u8('\n');
+    const uint8x16_t vcr = vdupq_n_u8('\r');
+    while (end - p >= 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        const uint8x16_t hits = vorrq_u8(vorrq_u8(vceqq_u8(chunk, vdelim), vceqq_u8(chunk, vquote)),
+                                         vorrq_u8(vceqq_u8(chunk, vlf), vceqq_u8(chunk, vcr)));
+        // Narrow each byte lane to a nibble so the first hit is a trailing-zero count
+        const uint64_t mask = vget_lane_u64(
+            vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+        if (mask != 0) {
+            return p + (std::countr_zero(mask) >> 2);
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && !isSpecial(*p, delimiter)) {
+        ++p;
+    }
+    return p;
+}
+
+// Appends field[from, size) with each quote doubled, copying the runs
+// between quotes in bulk
+void appendDoubledQuotes(std::string& out, std::string_view field, size_t from) {
+    const char* p = field.data() + from;
+    const char* end = field.data() + field.size();
+    while (p < end) {
+        const auto* quote = static_cast<const char*>(std::memchr(p, '"', static_cast<size_t>(end - p)));
+        if (!quote) {
+            out.append(p, static_cast<size_t>(end - p));
+            return;
+        }
+        out.append(p, static_cast<size_t>(quote - p + 1));
+        out.push_back('"');
+        p = quote + 1;
+    }
+}
+
+} // namespace
+
+CsvEncoder::CsvEncoder(const void* csvOptions) {
+    const auto* options = static_cast<const ::xlsxcsv::CsvOptions*>(csvOptions);
+    if (!options) {
+        return;
+    }
+    if (options->delimiter != '\0') {
+        m_delimiter = options->delimiter;
+    }
+    m_quoteAll = options->quoteAll;
+    m_includeBom = options->includeBom;
+    m_newline = options->newline == ::xlsxcsv::CsvOptions::Newline::CRLF ? "\r\n" : "\n";
+}
+
+bool CsvEncoder::needsQuoting(std::string_view field) const {
+    const char* end = field.data() + field.size();
+    return findSpecial(field.data(), end, m_delimiter) != end;
+}
+
+void CsvEncoder::appendField(std::string& out, std::string_view field) const {
+    const char* end = field.data() + field.size();
+    const char* special = findSpecial(field.data(), end, m_delimiter);
+    if (special == end) {
+        appendPlainField(out, field);
+        return;
+    }
+    // Everything before the first special character is clean, so the scan
+    // for quotes resumes from there
+    const size_t clean = static_cast<size_t>(special - field.data());
+    out.push_back('"');
+    out.append(field.data(), clean);
+    appendDoubledQuotes(out, field, clean);
+    out.push_back('"');
+}
+
+void CsvEncoder::appendQuoted(std::string& out, std::string_view field) {
+    out.push_back('"');
+    appendDoubledQuotes(out, field, 0);
+    out.push_back('"');
+}
+
+void CsvEncoder::appendBom(std::string& out) const {
+    if (m_includeBom) {
+        out.append("\xEF\xBB\xBF");
+    }
+}
+
+std::string CsvEncoder::encode(const std::vector<std::vector<std::string>>& rows) const {
+    std::string out;
+    appendBom(out);
+    for (const auto& row : rows) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            if (i > 0) {
+                appendDelimiter(out);
+            }
+            appendField(out, row[i]);
+        }
+        appendRowEnd(out);
     }
-};
+    return out;
+}
 
 } // namespace xlsxcsv::core
@@ -0,0 +1,136 @@
+#include "xlsxcsv.hpp"
+#include <cerrno>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#ifdef _WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace xlsxcsv {
+
+// FileOutputSink implementation
+FileOutputSink::FileOutputSink(const std::string& path) : m_path(path) {
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        throw std::runtime_error("Failed to open output file: " + path);
+    }
+}
+
+FileOutputSink::~FileOutputSink() {
+    if (m_file) {
+        std::fclose(m_file);
+    }
+}
+
+void FileOutputSink::write(const char* data, size_t size) {
+    if (!m_file) {
+        throw std::runtime_error("Output file is closed: " + m_path);
+    }
+    if (size > 0 && std::fwrite(data, 1, size, m_file) != size) {
+        throw std::runtime_error("Failed to write output file: " + m_path);
+    }
+}
+
+void FileOutputSink::flush() {
+    if (m_file && std::fflush(m_file) != 0) {
+        throw std::runtime_error("Failed to flush output file: " + m_path);
+    }
+}
+
+void FileOutputSink::close() {
+    if (!m_file) {
+        return;
+    }
+    // fclose reports deferred write errors, so surface them instead of dropping them
+    int result = std::fclose(m_file);
+    m_file = nullptr;
+    if (result != 0) {
+        throw std::runtime_error("Failed to close output file: " + m_path);
+    }
+}
+
+// StdioOutputSink implementation
+StdioOutputSink::StdioOutputSink(std::FILE* file) : m_file(file) {
+    if (!m_file) {
+        throw std::invalid_argument("StdioOutputSink requires a valid FILE*");
+    }
+}
+
+void StdioOutputSink::write(const char* data, size_t size) {
+    if (size > 0 && std::fwrite(data, 1, size, m_file) != size) {
+        throw std::runtime_error("Failed to write CSV output stream");
+    }
+}
+
+void StdioOutputSink::flush() {
+    if (std::fflush(m_file) != 0) {
+        throw std::runtime_error("Failed to flush CSV output stream");
+    }
+}
+
+// FdOutputSink implementation
+FdOutputSink::FdOutputSink(int fd) : m_fd(fd) {
+    if (m_fd < 0) {
+        throw std::invalid_argument("FdOutputSink requires a valid file descriptor");
+    }
+}
+
+void FdOutputSink::write(const char* data, size_t size) {
+    // write() may accept fewer bytes than requested (pipes, sockets), so loop
+    while (size > 0) {
+#ifdef _WIN32
+        const unsigned int chunk = static_cast<unsigned int>(size > 0x40000000 ? 0x40000000 : size);
+        const int written = ::_write(m_fd, data, chunk);
+#else
+        const ssize_t written = ::write(m_fd, data, size);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write CSV output to file descriptor");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+// StreamOutputSink implementation
+StreamOutputSink::StreamOutputSink(std::ostream& stream) : m_stream(stream) {}
+
+void StreamOutputSink::write(const char* data, size_t size) {
+    m_stream.write(data, static_cast<std::streamsize>(size));
+    if (!m_stream) {
+        throw std::runtime_error("Failed to write CSV output stream");
+    }
+}
+
+void StreamOutputSink::flush() {
+    m_stream.flush();
+    if (!m_stream) {
+        throw std::runtime_error("Failed to flush CSV output stream");
+    }
+}
+
+// CallbackOutputSink implementation
+CallbackOutputSink::CallbackOutputSink(Callback callback) : m_callback(std::move(callback)) {
+    if (!m_callback) {
+        throw std::invalid_argument("CallbackOutputSink requires a callback");
+    }
+}
+
+void CallbackOutputSink::write(const char* data, size_t size) {
+    m_callback(data, size);
+}
+
+// StringOutputSink implementation
+StringOutputSink::StringOutputSink(std::string& target) : m_target(target) {}
+
+void StringOutputSink::write(const char* data, size_t size) {
+    m_target.append(data, size);
+}
+
+} // namespace xlsxcsv
@@ -0,0 +1,392 @@
+#include "xlsxcsv.hpp"
+#include "xlsxcsv/core.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace xlsxcsv {
+
+namespace {
+
+// Fixed allowance per conversion for ZIP, XML and output buffers
+constexpr uint64_t BASE_CONVERSION_BYTES = 8ULL * 1024 * 1024;
+
+// Times a waiting job may be overtaken by smaller ones, per worker thread
+constexpr unsigned OVERTAKES_PER_THREAD = 2;
+
+// State of one batch; lives on the caller's stack until every task has been
+// called
+struct Batch {
+    const std::function<bool(size_t, bool)>* task = nullptr;
+
+    std::atomic<bool> stopped{false};    // A task returned false or threw
+    std::atomic<bool> failed{false};     // A task threw
+    std::mutex errorMutex;
+    std::exception_ptr error;            // Guarded by errorMutex
+    size_t remaining = 0;                // Guarded by the scheduler mutex
+};
+
+struct QueuedJob {
+    Batch* batch = nullptr;
+    size_t index = 0;
+    uint64_t estimate = 0;
+    unsigned overtaken = 0;
+};
+
+core::ZipSecurityLimits zipLimits(const CsvOptions& options) {
+    core::ZipSecurityLimits limits;
+    limits.maxEntries = options.maxEntries;
+    limits.maxEntrySize = options.maxEntrySize;
+    limits.maxTotalUncompressed = options.maxTotalUncompressed;
+    return limits;
+}
+
+// The shared string table and styles, plus the worksheet when parallel row
+// parsing inflates it whole and again when the CSV comes back as a string
+uint64_t estimateFromParts(const core::ZipReader& zip,
+                           uint64_t worksheetBytes,
+                           bool returnsString,
+                           const CsvOptions& options) {
+    uint64_t estimate = BASE_CONVERSION_BYTES;
+    if (const core::ZipEntry* entry = zip.findEntry(core::findWorkbookPartPath(zip, "sharedStrings"))) {
+        estimate += 2 * static_cast<uint64_t>(entry->uncompressedSize);
+    }
+    if (const core::ZipEntry* entry = zip.findEntry(core::findWorkbookPartPath(zip, "styles"))) {
+        estimate += entry->uncompressedSize;
+    }
+    if (options.sheetParseThreads != 1) {
+        estimate += worksheetBytes;
+    }
+    if (returnsString) {
+        estimate += worksheetBytes;
+    }
+    return estimate;
+}
+
+} // namespace
+
+uint64_t estimateConversionMemory(const std::string& xlsxPath, const CsvOptions& options) {
+    try {
+        core::ZipReader zip(zipLimits(options));
+        zip.open(xlsxPath);
+
+        uint64_t largestWorksheet = 0;
+        for (const auto& entry : zip.listEntries()) {
+            if (entry.path.rfind("xl/worksheets/", 0) == 0) {
+                largestWorksheet = std::max<uint64_t>(largestWorksheet, entry.uncompressedSize);
+            }
+        }
+        return estimateFromParts(zip, largestWorksheet, false, options);
+    } catch (const std::exception&) {
+        return BASE_CONVERSION_BYTES; // The conversion reports the real error
+    }
+}
+
+uint64_t estimateConversionMemory(const FileConversionJob& job, const CsvOptions& options) {
+    try {
+        core::OpcPackage package;
+        package.open(job.xlsxPath);
+        core::Workbook workbook;
+        workbook.open(package);
+
+        std::optional<core::SheetInfo> sheet;
+        if (const auto* name = std::get_if<std::string>(&job.sheet)) {
+            sheet = workbook.findSheet(*name);
+        } else {
+            const int index = std::get<int>(job.sheet);
+            sheet = workbook.findSheet(index == -1 ? 0 : index);
+        }
+        uint64_t worksheetBytes = 0;
+        if (sheet) {
+            // Same resolution the conversion applies to relationship targets
+            const std::string path = sheet->target.rfind("xl/", 0) == 0 ? sheet->target : "xl/" + sheet->target;
+            if (const core::ZipEntry* entry = package.getZipReader().findEntry(path)) {
+                worksheetBytes = entry->uncompressedSize;
+            }
+        }
+        return estimateFromParts(package.getZipReader(), worksheetBytes, job.outputPath.empty(), options);
+    } catch (const std::exception&) {
+        return BASE_CONVERSION_BYTES;
+    }
+}
+
+// Workers take the first queued job whose estimate fits in the budget. A job
+// that does not fit lets later ones pass until it has been overtaken
+// maxOvertakes times; from then on nothing starts until it does.
+class ConversionScheduler::Impl {
+public:
+    Impl(unsigned threads, uint64_t memoryBudget)
+        : m_limit(memoryBudget) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        m_maxOvertakes = threads * OVERTAKES_PER_THREAD;
+        m_workers.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            m_workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_workAvailable.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void run(const std::vector<uint64_t>& estimates, const std::function<bool(size_t, bool)>& task) {
+        if (estimates.empty()) {
+            return;
+        }
+
+        Batch batch;
+        batch.task = &task;
+        batch.remaining = estimates.size();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t i = 0; i < estimates.size(); ++i) {
+                m_queue.push_back({&batch, i, estimates[i], 0});
+            }
+        }
+        m_workAvailable.notify_all();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_batchDone.wait(lock, [&] { return batch.remaining == 0; });
+        lock.unlock();
+
+        if (batch.error) {
+            std::rethrow_exception(batch.error);
+        }
+    }
+
+    unsigned threadCount() const {
+        return static_cast<unsigned>(m_workers.size());
+    }
+
+    void setMemoryBudget(uint64_t bytes) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_limit = bytes;
+        }
+        m_workAvailable.notify_all();
+    }
+
+    uint64_t getMemoryBudget() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_limit;
+    }
+
+    uint64_t getReservedMemory() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_reserved;
+    }
+
+    uint64_t getPeakReservedMemory() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_peakReserved;
+    }
+
+private:
+    bool fits(uint64_t estimate) const {
+        return m_limit == 0 || m_reserved == 0 || m_reserved + estimate <= m_limit;
+    }
+
+    // Removes the next job allowed to start from the queue; caller holds m_mutex
+    bool takeJob(QueuedJob& job) {
+        for (size_t i = 0; i < m_queue.size(); ++i) {
+            QueuedJob& candidate = m_queue[i];
+            // Skipped jobs only need reporting, so they reserve nothing
+            if (candidate.batch->stopped.load(std::memory_order_relaxed)) {
+                candidate.estimate = 0;
+            }
+            if (fits(candidate.estimate)) {
+                if (i > 0) {
+                    ++m_queue.front().overtaken;
+                }
+                job = candidate;
+                m_queue.erase(m_queue.begin() + static_cast<std::ptrdiff_t>(i));
+                m_reserved += job.estimate;
+                m_peakReserved = std::max(m_peakReserved, m_reserved);
+                return true;
+            }
+            if (i == 0 && candidate.overtaken >= m_maxOvertakes) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    void work() {
+        for (;;) {
+            QueuedJob job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                bool taken = false;
+                m_workAvailable.wait(lock, [&] {
+                    return m_stopping || (taken = takeJob(job));
+                });
+                if (!taken) {
+                    return; // Stopping
+                }
+            }
+
+            execute(job);
+
+            bool batchDone = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_reserved -= job.estimate;
+                batchDone = --job.batch->remaining == 0;
+            }
+            // Freed budget may let a waiting job start
+            m_workAvailable.notify_all();
+            if (batchDone) {
+                m_batchDone.notify_all();
+            }
+        }
+    }
+
+    static void execute(const QueuedJob& job) {
+        Batch& batch = *job.batch;
+        if (batch.failed.load(std::memory_order_relaxed)) {
+            return;
+        }
+        try {
+            if (!(*batch.task)(job.index, batch.stopped.load(std::memory_order_relaxed))) {
+                batch.stopped = true;
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(batch.errorMutex);
+            if (!batch.error) {
+                batch.error = std::current_exception();
+            }
+            batch.failed = true;
+            batch.stopped = true;
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_batchDone;
+    std::deque<QueuedJob> m_queue;
+    uint64_t m_limit;
+    uint64_t m_reserved = 0;
+    uint64_t m_peakReserved = 0;
+    unsigned m_maxOvertakes = 0;
+    bool m_stopping = false;
+    std::vector<std::thread> m_workers;
+};
+
+ConversionScheduler::ConversionScheduler(unsigned threads, uint64_t memoryBudget)
+    : m_impl(std::make_unique<Impl>(threads, memoryBudget)) {}
+
+ConversionScheduler::~ConversionScheduler() = default;
+
+unsigned ConversionScheduler::threadCount() const {
+    return m_impl->threadCount();
+}
+
+void ConversionScheduler::setMemoryBudget(uint64_t bytes) {
+    m_impl->setMemoryBudget(bytes);
+}
+
+uint64_t ConversionScheduler::getMemoryBudget() const {
+    return m_impl->getMemoryBudget();
+}
+
+uint64_t ConversionScheduler::getReservedMemory() const {
+    return m_impl->getReservedMemory();
+}
+
+uint64_t ConversionScheduler::getPeakReservedMemory() const {
+    return m_impl->getPeakReservedMemory();
+}
+
+ConversionScheduler& ConversionScheduler::shared() {
+    static ConversionScheduler scheduler;
+    return scheduler;
+}
+
+void ConversionScheduler::run(const std::vector<uint64_t>& estimates,
+                              const std::function<bool(size_t, bool)>& task) {
+    m_impl->run(estimates, task);
+}
+
+void convertFiles(
+    const std::vector<FileConversionJob>& jobs,
+    const std::function<void(FileConversionResult&)>& onResult,
+    const CsvOptions& options,
+    const BatchOptions& batch) {
+
+    ConversionScheduler& scheduler = batch.scheduler ? *batch.scheduler : ConversionScheduler::shared();
+
+    // Estimates read each central directory, so they are only taken when a
+    // budget needs them
+    std::vector<uint64_t> estimates(jobs.size(), 0);
+    if (scheduler.getMemoryBudget() > 0) {
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            estimates[i] = estimateConversionMemory(jobs[i], options);
+        }
+    }
+
+    std::mutex callbackMutex; // Serializes onResult
+    bool callbackFailed = false;
+    scheduler.run(estimates, [&](size_t index, bool skipped) {
+        const FileConversionJob& spec = jobs[index];
+        FileConversionResult result;
+        result.index = index;
+        result.xlsxPath = spec.xlsxPath;
+        if (skipped) {
+            result.error = "Skipped after an earlier failure";
+        } else {
+            result.estimatedMemory = estimates[index];
+            try {
+                if (spec.outputPath.empty()) {
+                    result.csv = readSheetToCsv(spec.xlsxPath, spec.sheet, options, &result.stats);
+                } else {
+                    convertSheetToFile(spec.xlsxPath, spec.sheet, spec.outputPath, options, &result.stats);
+                }
+                result.ok = true;
+            } catch (const std::exception& e) {
+                result.error = e.what();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        if (callbackFailed) {
+            return false;
+        }
+        try {
+            onResult(result);
+        } catch (...) {
+            callbackFailed = true;
+            throw;
+        }
+        return result.ok || skipped || !batch.failFast;
+    });
+}
+
+std::vector<FileConversionResult> convertFiles(
+    const std::vector<FileConversionJob>& jobs,
+    const CsvOptions& options,
+    const BatchOptions& batch) {
+
+    std::vector<FileConversionResult> results(jobs.size());
+    convertFiles(jobs, [&](FileConversionResult& result) {
+        results[result.index] = std::move(result);
+    }, options, batch);
+    return results;
+}
+
+} // namespace xlsxcsv
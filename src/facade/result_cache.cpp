@@ -0,0 +1,315 @@
+#include "result_cache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace xlsxcsv::facade {
+
+namespace {
+
+// Bump whenever the converter's output for unchanged input and options changes
+constexpr int RESULT_FORMAT_VERSION = 1;
+
+constexpr char MAGIC[] = "TURBOXL-RESULT\n";
+constexpr char RESULT_EXTENSION[] = ".csv";
+constexpr char TEMP_MARKER[] = ".tmp";
+constexpr size_t ROWS_FIELD_WIDTH = 20;
+constexpr size_t COPY_BLOCK_BYTES = 1024 * 1024;
+
+// Temporary files this old were left by a process that died while recording
+constexpr auto STALE_TEMP_AGE = std::chrono::hours(24);
+
+uint64_t fnv1a(const std::string& text) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool endsWith(const std::string& text, const char* suffix) {
+    const size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+void appendEntry(std::ostringstream& key, const core::ZipEntry& entry) {
+    key << entry.path << ' ' << entry.crc32 << ' ' << entry.compressedSize << ' '
+        << entry.uncompressedSize << '\n';
+}
+
+bool readLine(std::FILE* file, std::string& line) {
+    line.clear();
+    int c;
+    while ((c = std::fgetc(file)) != EOF) {
+        if (c == '\n') {
+            return true;
+        }
+        line.push_back(static_cast<char>(c));
+    }
+    return false;
+}
+
+std::string header(const std::string& key, uint64_t rows) {
+    char rowsField[ROWS_FIELD_WIDTH + 2];
+    std::snprintf(rowsField, sizeof(rowsField), "%0*" PRIu64 "\n", static_cast<int>(ROWS_FIELD_WIDTH), rows);
+    return std::string(MAGIC) + std::to_string(key.size()) + "\n" + key + rowsField;
+}
+
+} // namespace
+
+ResultCache::ResultCache(const CsvOptions& options)
+    : m_directory(options.resultCacheDir), m_limit(options.resultCacheLimit) {}
+
+std::string ResultCache::makeKey(const core::OpcPackage& package,
+                                 const std::string& worksheetPath,
+                                 core::DateSystem dateSystem,
+                                 const CsvOptions& options) {
+    std::ostringstream key;
+    key << "v" << RESULT_FORMAT_VERSION << '\n';
+
+    // Parts read by the conversion, by their central directory records
+    const core::ZipReader& zip = package.getZipReader();
+    const core::ZipEntry* worksheet = zip.findEntry(worksheetPath);
+    if (!worksheet) {
+        return {}; // Not cacheable; the conversion reports the missing part
+    }
+    appendEntry(key, *worksheet);
+    for (const char* part : {"sharedStrings", "styles"}) {
+        if (const core::ZipEntry* entry = zip.findEntry(package.findWorkbookPartPath(part))) {
+            appendEntry(key, *entry);
+        }
+    }
+    key << "date1904 " << (dateSystem == core::DateSystem::Date1904) << '\n';
+
+    // Options that change the CSV produced. Selection, parallelism and input
+    // options only change how the same output is reached.
+    key << "delimiter " << static_cast<int>(options.delimiter)
+        << " newline " << static_cast<int>(options.newline)
+        << " bom " << options.includeBom
+        << " dates " << static_cast<int>(options.dateMode)
+        << " quoteAll " << options.quoteAll
+        << " numbers " << static_cast<int>(options.numberFormat)
+        << " merged " << static_cast<int>(options.mergedHandling)
+        << " hiddenRows " << options.includeHiddenRows
+        << " hiddenColumns " << options.includeHiddenColumns
+        << " offset " << options.rowOffset
+        << " limit " << options.rowLimit << '\n';
+    key << "columns";
+    for (const auto& column : options.columns) {
+        if (const auto* name = std::get_if<std::string>(&column)) {
+            key << " s" << name->size() << ':' << *name;
+        } else {
+            key << " i" << std::get<int>(column);
+        }
+    }
+    key << '\n';
+    return key.str();
+}
+
+std::string ResultCache::pathFor(const std::string& key) const {
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016" PRIx64, fnv1a(key));
+    return (fs::path(m_directory) / (std::string(name) + RESULT_EXTENSION)).string();
+}
+
+std::optional<ResultCache::Stored> ResultCache::load(const std::string& key, OutputSink& sink) const {
+    if (!enabled() || key.empty()) {
+        return std::nullopt;
+    }
+    const std::string path = pathFor(key);
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return std::nullopt;
+    }
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> guard(file, &std::fclose);
+
+    // Anything unexpected, including a hash collision, is a miss
+    std::string line;
+    if (!readLine(file, line) || line + "\n" != MAGIC || !readLine(file, line)) {
+        return std::nullopt;
+    }
+    size_t keySize = 0;
+    try {
+        keySize = std::stoull(line);
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+    if (keySize != key.size()) {
+        return std::nullopt;
+    }
+    std::string storedKey(keySize, '\0');
+    if (std::fread(storedKey.data(), 1, keySize, file) != keySize || storedKey != key) {
+        return std::nullopt;
+    }
+    if (!readLine(file, line) || line.size() != ROWS_FIELD_WIDTH) {
+        return std::nullopt;
+    }
+    Stored stored;
+    stored.rows = std::strtoull(line.c_str(), nullptr, 10);
+
+    // Touched on every hit so eviction drops the least recently used
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+    std::vector<char> block(COPY_BLOCK_BYTES);
+    size_t read;
+    while ((read = std::fread(block.data(), 1, block.size(), file)) > 0) {
+        sink.write(block.data(), read);
+        stored.bytes += read;
+    }
+    if (std::ferror(file)) {
+        throw std::runtime_error("Failed to read cached result: " + path);
+    }
+    sink.flush();
+    return stored;
+}
+
+void ResultCache::evict() const {
+    // Eviction scans are serialized within the process; other processes may
+    // remove the same files, so every filesystem error is ignored
+    static std::mutex evictMutex;
+    std::lock_guard<std::mutex> lock(evictMutex);
+
+    struct Result {
+        fs::file_time_type used;
+        uint64_t bytes;
+        fs::path path;
+    };
+    std::vector<Result> results;
+    uint64_t total = 0;
+    const auto staleBefore = fs::file_time_type::clock::now() - STALE_TEMP_AGE;
+
+    std::error_code ec;
+    for (fs::directory_iterator it(m_directory, ec), end; !ec && it != end; it.increment(ec)) {
+        const fs::path path = it->path();
+        const std::string name = path.filename().string();
+        std::error_code entryEc;
+        const auto used = fs::last_write_time(path, entryEc);
+        if (entryEc) {
+            continue;
+        }
+        if (name.find(std::string(RESULT_EXTENSION) + TEMP_MARKER) != std::string::npos) {
+            if (used < staleBefore) {
+                fs::remove(path, entryEc);
+            }
+            continue;
+        }
+        if (!endsWith(name, RESULT_EXTENSION)) {
+            continue;
+        }
+        const uint64_t bytes = fs::file_size(path, entryEc);
+        if (entryEc) {
+            continue;
+        }
+        results.push_back({used, bytes, path});
+        total += bytes;
+    }
+    if (total <= m_limit) {
+        return;
+    }
+
+    std::sort(results.begin(), results.end(),
+              [](const Result& a, const Result& b) { return a.used < b.used; });
+    for (const auto& result : results) {
+        if (total <= m_limit) {
+            break;
+        }
+        std::error_code removeEc;
+        fs::remove(result.path, removeEc);
+        total -= result.bytes;
+    }
+}
+
+ResultCache::Recorder::Recorder(const ResultCache& cache, std::string key, OutputSink* forward)
+    : m_cache(cache), m_key(std::move(key)), m_forward(forward) {
+    if (!m_cache.enabled() || m_key.empty()) {
+        return;
+    }
+    std::error_code ec;
+    fs::create_directories(m_cache.m_directory, ec);
+
+    // Unique per recording so concurrent conversions of one sheet don't collide
+    std::random_device random;
+    const uint64_t suffix = (static_cast<uint64_t>(random()) << 32) ^ random();
+    char tag[17];
+    std::snprintf(tag, sizeof(tag), "%016" PRIx64, suffix);
+    m_tempPath = m_cache.pathFor(m_key) + TEMP_MARKER + tag;
+
+    m_file = std::fopen(m_tempPath.c_str(), "wb");
+    if (!m_file) {
+        return; // Caching is best effort; the conversion itself goes ahead
+    }
+    const std::string head = header(m_key, 0);
+    if (std::fwrite(head.data(), 1, head.size(), m_file) != head.size()) {
+        abandon();
+        return;
+    }
+    m_bytes = head.size();
+}
+
+ResultCache::Recorder::~Recorder() {
+    abandon();
+}
+
+void ResultCache::Recorder::write(const char* data, size_t size) {
+    if (m_forward) {
+        m_forward->write(data, size);
+    }
+    if (!m_file) {
+        return;
+    }
+    m_bytes += size;
+    // A result larger than the whole cache would only evict everything else
+    if (m_bytes > m_cache.m_limit || std::fwrite(data, 1, size, m_file) != size) {
+        abandon();
+    }
+}
+
+void ResultCache::Recorder::flush() {
+    if (m_forward) {
+        m_forward->flush();
+    }
+}
+
+void ResultCache::Recorder::commit(uint64_t rows) {
+    if (!m_file) {
+        return;
+    }
+    const std::string head = header(m_key, rows);
+    const bool written = std::fseek(m_file, 0, SEEK_SET) == 0 &&
+                         std::fwrite(head.data(), 1, head.size(), m_file) == head.size();
+    const bool closed = std::fclose(m_file) == 0;
+    m_file = nullptr;
+
+    std::error_code ec;
+    if (written && closed) {
+        fs::rename(m_tempPath, m_cache.pathFor(m_key), ec);
+    }
+    if (!written || !closed || ec) {
+        fs::remove(m_tempPath, ec);
+        return;
+    }
+    m_cache.evict();
+}
+
+void ResultCache::Recorder::abandon() {
+    if (!m_file) {
+        return;
+    }
+    std::fclose(m_file);
+    m_file = nullptr;
+    std::error_code ec;
+    fs::remove(m_tempPath, ec);
+}
+
+} // namespace xlsxcsv::facade
@@ -0,0 +1,75 @@
+#pragma once
+
+// On-disk cache of converted worksheets, enabled by CsvOptions::resultCacheDir.
+// A result is keyed by the CRC32 and sizes the ZIP central directory records
+// for every part its conversion reads (the worksheet, shared strings and
+// styles) plus the options that shape the CSV, so a workbook re-uploaded with
+// only other parts changed is served without inflating or parsing anything.
+// Results are written to a temporary file and renamed into place, and the
+// least recently used are removed once the directory exceeds
+// CsvOptions::resultCacheLimit. Several processes may share a directory.
+
+#include "xlsxcsv.hpp"
+#include "xlsxcsv/core.hpp"
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace xlsxcsv::facade {
+
+class ResultCache {
+public:
+    // Disabled when options.resultCacheDir is empty
+    explicit ResultCache(const CsvOptions& options);
+
+    bool enabled() const { return !m_directory.empty(); }
+
+    // Identifies the CSV of one worksheet of an open package
+    static std::string makeKey(const core::OpcPackage& package,
+                               const std::string& worksheetPath,
+                               core::DateSystem dateSystem,
+                               const CsvOptions& options);
+
+    struct Stored {
+        uint64_t rows = 0;  // CSV rows
+        uint64_t bytes = 0; // CSV bytes, BOM included
+    };
+
+    // Copies the result stored under key to sink; nullopt on a miss
+    std::optional<Stored> load(const std::string& key, OutputSink& sink) const;
+
+    // Forwards output to a sink (if any) while recording it; commit() stores
+    // the recording under its key, otherwise it is discarded
+    class Recorder : public OutputSink {
+    public:
+        Recorder(const ResultCache& cache, std::string key, OutputSink* forward);
+        ~Recorder() override;
+
+        Recorder(const Recorder&) = delete;
+        Recorder& operator=(const Recorder&) = delete;
+
+        void write(const char* data, size_t size) override;
+        void flush() override;
+        void commit(uint64_t rows);
+
+    private:
+        void abandon();
+
+        const ResultCache& m_cache;
+        const std::string m_key;
+        OutputSink* m_forward;
+        std::string m_tempPath;
+        std::FILE* m_file = nullptr;
+        uint64_t m_bytes = 0;
+    };
+
+private:
+    std::string pathFor(const std::string& key) const;
+    void evict() const;
+
+    std::string m_directory;
+    uint64_t m_limit;
+};
+
+} // namespace xlsxcsv::facade
@@ -1,186 +1,698 @@
 #include "xlsxcsv.hpp"
 #include "xlsxcsv/core.hpp"
+#include "result_cache.hpp"
 #include <stdexcept>
 #include <sstream>
 #include <algorithm>
 #include <chrono>
-#include <cstdlib>
-#include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 
 namespace xlsxcsv {
 
-std::string readSheetToCsv(
-    const std::string& xlsxPath,
-    const std::variant<std::string, int>& sheetSelector,
-    const CsvOptions& options) {
+namespace {
+
+xlsxcsv::core::SharedStringsMode toCoreSharedStringsMode(CsvOptions::SharedStringsMode mode) {
+    switch (mode) {
+        case CsvOptions::SharedStringsMode::IN_MEMORY:
+            return xlsxcsv::core::SharedStringsMode::InMemory;
+        case CsvOptions::SharedStringsMode::EXTERNAL:
+            return xlsxcsv::core::SharedStringsMode::External;
+        case CsvOptions::SharedStringsMode::LAZY:
+            return xlsxcsv::core::SharedStringsMode::Lazy;
+        case CsvOptions::SharedStringsMode::AUTO:
+        default:
+            return xlsxcsv::core::SharedStringsMode::Auto;
+    }
+}
+
+xlsxcsv::core::SheetParserBackend toCoreParserBackend(CsvOptions::ParserBackend backend) {
+    switch (backend) {
+        case CsvOptions::ParserBackend::FAST:
+            return xlsxcsv::core::SheetParserBackend::Fast;
+        case CsvOptions::ParserBackend::LIBXML:
+            return xlsxcsv::core::SheetParserBackend::LibXml;
+        case CsvOptions::ParserBackend::AUTO:
+        default:
+            return xlsxcsv::core::SheetParserBackend::Auto;
+    }
+}
+
+// Resolves a sheet selector (name, index or -1 for the first sheet)
+xlsxcsv::core::SheetInfo selectSheet(const xlsxcsv::core::Workbook& workbook,
+                                     const std::variant<std::string, int>& sheetSelector) {
+    std::optional<xlsxcsv::core::SheetInfo> targetSheet;
+    auto sheets = workbook.getSheets();
     
-    try {
-        const bool profileTimings = []() {
-            const char* v = std::getenv("TURBOXL_PROFILE_TIMINGS");
-            return v && (v[0] == '1' || v[0] == 't' || v[0] == 'T' || v[0] == 'y' || v[0] == 'Y');
-        }();
-        const auto t0 = std::chrono::steady_clock::now();
-        auto msSince = [&](const std::chrono::steady_clock::time_point& start) -> double {
-            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
-        };
-        double t_open = 0.0;
-        double t_workbook = 0.0;
-        double t_styles = 0.0;
-        double t_shared = 0.0;
-        double t_sheet = 0.0;
-        double t_csv = 0.0;
-        double t_post = 0.0;
-
-        // Create security limits from options
-        xlsxcsv::core::ZipSecurityLimits limits;
-        limits.maxEntries = options.maxEntries;
-        limits.maxEntrySize = options.maxEntrySize;
-        limits.maxTotalUncompressed = options.maxTotalUncompressed;
-        
-        // Phase 4 implementation: Shared strings + all previous phases
-        xlsxcsv::core::OpcPackage package;
-        auto t = std::chrono::steady_clock::now();
-        package.open(xlsxPath);
-        t_open = msSince(t);
-        
-        // Parse workbook structure
-        xlsxcsv::core::Workbook workbook;
-        t = std::chrono::steady_clock::now();
-        workbook.open(package);
-        t_workbook = msSince(t);
-        
-        // Parse styles registry
-        xlsxcsv::core::StylesRegistry styles;
-        t = std::chrono::steady_clock::now();
-        try {
-            styles.parse(package);
-        } catch (const xlsxcsv::core::XlsxError& e) {
-            // Some XLSX files might not have styles.xml, continue without styles
-        }
-        t_styles = msSince(t);
-        
-        // Parse shared strings (Phase 4)
-        xlsxcsv::core::SharedStringsConfig sharedConfig;
-        sharedConfig.mode = options.sharedStringsMode == CsvOptions::SharedStringsMode::AUTO ? 
-            xlsxcsv::core::SharedStringsMode::Auto :
-            options.sharedStringsMode == CsvOptions::SharedStringsMode::IN_MEMORY ?
-            xlsxcsv::core::SharedStringsMode::InMemory :
-            xlsxcsv::core::SharedStringsMode::External;
-        
-        xlsxcsv::core::SharedStringsProvider sharedStrings(sharedConfig);
-        t = std::chrono::steady_clock::now();
-        try {
-            sharedStrings.parse(package);
-        } catch (const xlsxcsv::core::XlsxError& e) {
-            // Some XLSX files might not have sharedStrings.xml, continue without shared strings
+    if (std::holds_alternative<std::string>(sheetSelector)) {
+        // Find sheet by name
+        std::string sheetName = std::get<std::string>(sheetSelector);
+        targetSheet = workbook.findSheet(sheetName);
+        if (!targetSheet.has_value()) {
+            throw std::runtime_error("Sheet not found: " + sheetName);
         }
-        t_shared = msSince(t);
-        
-        // Determine which sheet to parse
-        std::optional<xlsxcsv::core::SheetInfo> targetSheet;
-        auto sheets = workbook.getSheets();
-        
-        if (std::holds_alternative<std::string>(sheetSelector)) {
-            // Find sheet by name
-            std::string sheetName = std::get<std::string>(sheetSelector);
-            targetSheet = workbook.findSheet(sheetName);
-            if (!targetSheet.has_value()) {
-                throw std::runtime_error("Sheet not found: " + sheetName);
-            }
-        } else {
-            // Find sheet by index
-            int sheetIndex = std::get<int>(sheetSelector);
-            if (sheetIndex == -1) {
-                // Use first sheet
-                if (!sheets.empty()) {
-                    targetSheet = sheets[0];
-                }
-            } else if (sheetIndex >= 0 && static_cast<size_t>(sheetIndex) < sheets.size()) {
-                targetSheet = sheets[static_cast<size_t>(sheetIndex)];
-            }
-            
-            if (!targetSheet.has_value()) {
-                throw std::runtime_error("Sheet index out of range: " + std::to_string(sheetIndex));
+    } else {
+        // Find sheet by index
+        int sheetIndex = std::get<int>(sheetSelector);
+        if (sheetIndex == -1) {
+            // Use first sheet
+            if (!sheets.empty()) {
+                targetSheet = sheets[0];
             }
+        } else if (sheetIndex >= 0 && static_cast<size_t>(sheetIndex) < sheets.size()) {
+            targetSheet = sheets[static_cast<size_t>(sheetIndex)];
         }
         
         if (!targetSheet.has_value()) {
-            throw std::runtime_error("No sheets found in workbook");
+            throw std::runtime_error("Sheet index out of range: " + std::to_string(sheetIndex));
+        }
+    }
+    
+    if (!targetSheet.has_value()) {
+        throw std::runtime_error("No sheets found in workbook");
+    }
+    return *targetSheet;
+}
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Stamps the total time when a conversion returns or throws
+class TotalTimer {
+public:
+    explicit TotalTimer(ConversionStats& stats) : m_stats(stats), m_start(Clock::now()) {}
+    ~TotalTimer() { m_stats.totalMs = msSince(m_start); }
+    TotalTimer(const TotalTimer&) = delete;
+    TotalTimer& operator=(const TotalTimer&) = delete;
+
+private:
+    ConversionStats& m_stats;
+    Clock::time_point m_start;
+};
+
+// Same resolution SheetStreamReader applies to workbook relationship targets
+std::string worksheetEntryPath(const std::string& target) {
+    return target.find("xl/") == 0 ? target : "xl/" + target;
+}
+
+void recordPartSizes(const xlsxcsv::core::OpcPackage& package,
+                     const std::vector<xlsxcsv::core::SheetInfo>& sheets,
+                     ConversionStats& stats) {
+    const auto& zip = package.getZipReader();
+    if (const auto* entry = zip.findEntry(package.findWorkbookPartPath("sharedStrings"))) {
+        stats.sharedStringsCompressedBytes = entry->compressedSize;
+        stats.sharedStringsUncompressedBytes = entry->uncompressedSize;
+    }
+    // A sheet listed twice is read twice
+    for (const auto& sheet : sheets) {
+        if (const auto* entry = zip.findEntry(worksheetEntryPath(sheet.target))) {
+            stats.worksheetCompressedBytes += entry->compressedSize;
+            stats.worksheetUncompressedBytes += entry->uncompressedSize;
+        }
+    }
+}
+
+void recordCollector(const xlsxcsv::core::CsvRowCollector& collector, ConversionStats& stats) {
+    using xlsxcsv::core::CellType;
+    const auto& counters = collector.getCounters();
+    auto cellsOf = [&](CellType type) { return counters.cellsByType[static_cast<size_t>(type)]; };
+    
+    stats.sheets += 1;
+    stats.rows += collector.getRowCount();
+    for (uint64_t count : counters.cellsByType) {
+        stats.cells += count;
+    }
+    stats.numberCells += cellsOf(CellType::Number);
+    stats.sharedStringCells += cellsOf(CellType::SharedString);
+    stats.inlineStringCells += cellsOf(CellType::InlineString);
+    stats.formulaStringCells += cellsOf(CellType::String);
+    stats.booleanCells += cellsOf(CellType::Boolean);
+    stats.errorCells += cellsOf(CellType::Error);
+    stats.sharedStringLookups += counters.sharedStringLookups;
+    stats.outputBytes += collector.getBytesWritten();
+}
+
+void addSheetStats(const ConversionStats& sheet, ConversionStats& total) {
+    total.parseSheetMs += sheet.parseSheetMs;
+    total.sheets += sheet.sheets;
+    total.rows += sheet.rows;
+    total.cells += sheet.cells;
+    total.numberCells += sheet.numberCells;
+    total.sharedStringCells += sheet.sharedStringCells;
+    total.inlineStringCells += sheet.inlineStringCells;
+    total.formulaStringCells += sheet.formulaStringCells;
+    total.booleanCells += sheet.booleanCells;
+    total.errorCells += sheet.errorCells;
+    total.sharedStringLookups += sheet.sharedStringLookups;
+    total.outputBytes += sheet.outputBytes;
+    total.resultCacheHits += sheet.resultCacheHits;
+}
+
+// Called once every sheet has been recorded. The provider counts spill reads
+// for its whole lifetime, so a conversion reports the reads since it started
+// (which includes those of concurrent conversions of the same Document).
+void recordSharedStrings(const xlsxcsv::core::SharedStringsProvider& sharedStrings,
+                         uint64_t spillReadsAtStart,
+                         ConversionStats& stats) {
+    if (!sharedStrings.isOpen()) {
+        return;
+    }
+    stats.sharedStringCount = sharedStrings.getStringCount();
+    stats.sharedStringsMemoryBytes = sharedStrings.getPeakMemoryUsage();
+    stats.spillReads = sharedStrings.getSpillReadCount() - spillReadsAtStart;
+}
+
+// Package, workbook structure, styles and shared strings of one file. Once
+// opened they are only read, so any number of conversions may use them
+// concurrently: ZipReader reads are thread-safe and every sheet gets its own
+// entry stream.
+struct OpenWorkbook {
+    explicit OpenWorkbook(const CsvOptions& options)
+        : memoryMap(options.memoryMap)
+        , memoryTracker(makeMemoryTracker(options))
+        , sharedStrings(sharedStringsConfig(options, memoryTracker.get())) {}
+    
+    static std::unique_ptr<xlsxcsv::core::MemoryTracker> makeMemoryTracker(const CsvOptions& options) {
+        if (!options.trackMemory && options.memoryLimit == 0) {
+            return nullptr;
+        }
+        return std::make_unique<xlsxcsv::core::MemoryTracker>(options.memoryLimit);
+    }
+    
+    static xlsxcsv::core::SharedStringsConfig sharedStringsConfig(const CsvOptions& options,
+                                                                  xlsxcsv::core::MemoryTracker* tracker) {
+        xlsxcsv::core::SharedStringsConfig config;
+        config.mode = toCoreSharedStringsMode(options.sharedStringsMode);
+        config.pipelinedInflate = options.pipelinedInflate;
+        config.memoryTracker = tracker;
+        return config;
+    }
+    
+    const xlsxcsv::core::SharedStringsProvider* sharedStringsPtr() const {
+        return sharedStrings.isOpen() ? &sharedStrings : nullptr;
+    }
+    const xlsxcsv::core::StylesRegistry* stylesPtr() const {
+        return styles.isOpen() ? &styles : nullptr;
+    }
+    
+    const bool memoryMap;
+    // Outlives the parts charged to it, so it is declared first
+    const std::unique_ptr<xlsxcsv::core::MemoryTracker> memoryTracker;
+    xlsxcsv::core::OpcPackage package;
+    xlsxcsv::core::Workbook workbook;
+    xlsxcsv::core::StylesRegistry styles;
+    xlsxcsv::core::SharedStringsProvider sharedStrings;
+};
+
+// A workbook path, or the bytes of a whole workbook owned by the caller
+using WorkbookInput = std::variant<std::string, std::span<const std::byte>>;
+
+// Opens the package and parses the workbook structure
+void openPackage(OpenWorkbook& parts, const WorkbookInput& input, ConversionStats& stats) {
+    auto t = Clock::now();
+    if (const auto* data = std::get_if<std::span<const std::byte>>(&input)) {
+        parts.package.open(*data);
+    } else if (parts.memoryMap) {
+        parts.package.openMapped(std::get<std::string>(input));
+    } else {
+        parts.package.open(std::get<std::string>(input));
+    }
+    stats.openMs = msSince(t);
+    
+    // Parse workbook structure
+    t = Clock::now();
+    parts.workbook.open(parts.package);
+    stats.workbookMs = msSince(t);
+}
+
+// Parses styles and shared strings, the parts every sheet conversion shares
+void openSharedParts(OpenWorkbook& parts, ConversionStats& stats) {
+    // Parse styles registry
+    auto t = Clock::now();
+    try {
+        parts.styles.parse(parts.package, xlsxcsv::core::StylesParseMode::NumberFormatsOnly);
+    } catch (const xlsxcsv::core::XlsxError& e) {
+        // Some XLSX files might not have styles.xml, continue without styles
+    }
+    stats.stylesMs = msSince(t);
+    
+    // Parse shared strings
+    t = Clock::now();
+    try {
+        parts.sharedStrings.parse(parts.package);
+    } catch (const xlsxcsv::core::MemoryLimitError&) {
+        throw;
+    } catch (const xlsxcsv::core::XlsxError& e) {
+        // Some XLSX files might not have sharedStrings.xml, continue without shared strings
+    }
+    stats.sharedStringsMs = msSince(t);
+}
+
+void openWorkbook(OpenWorkbook& parts, const WorkbookInput& input, ConversionStats& stats) {
+    openPackage(parts, input, stats);
+    openSharedParts(parts, stats);
+}
+
+// Result cache key of one sheet; empty when caching is off
+std::string resultCacheKey(const OpenWorkbook& parts, const xlsxcsv::core::SheetInfo& sheet, const CsvOptions& options) {
+    if (options.resultCacheDir.empty()) {
+        return {};
+    }
+    return facade::ResultCache::makeKey(parts.package, worksheetEntryPath(sheet.target),
+                                        parts.workbook.getDateSystem(), options);
+}
+
+// Serves a sheet from the result cache into the sink, or into csv without one
+bool loadCachedSheet(const std::string& cacheKey,
+                     const CsvOptions& options,
+                     OutputSink* sink,
+                     std::string& csv,
+                     ConversionStats& stats) {
+    if (cacheKey.empty()) {
+        return false;
+    }
+    const auto t = Clock::now();
+    StringOutputSink stringSink(csv);
+    const auto stored = facade::ResultCache(options).load(cacheKey, sink ? *sink : stringSink);
+    if (!stored) {
+        return false;
+    }
+    stats.assembleCsvMs = msSince(t);
+    stats.sheets += 1;
+    stats.rows += stored->rows;
+    stats.outputBytes += stored->bytes;
+    stats.resultCacheHits += 1;
+    return true;
+}
+
+// Charges a conversion's reader and handler to its tracker, if any
+void trackMemory(xlsxcsv::core::MemoryTracker* tracker,
+                 xlsxcsv::core::SheetStreamReader& sheetReader,
+                 xlsxcsv::core::CsvRowCollector* csvCollector) {
+    if (!tracker) {
+        return;
+    }
+    sheetReader.setMemoryTracker(tracker);
+    if (csvCollector) {
+        csvCollector->setMemoryTracker(tracker);
+    }
+}
+
+std::string describeErrors(const std::string& prefix, const std::vector<std::string>& errors) {
+    std::ostringstream errorMsg;
+    errorMsg << prefix;
+    for (size_t i = 0; i < errors.size(); ++i) {
+        if (i > 0) errorMsg << "; ";
+        errorMsg << errors[i];
+    }
+    return errorMsg.str();
+}
+
+// A refused memory charge surfaces as a parse error, so once the limit has
+// been hit the errors are reported as that
+void throwParseErrors(const xlsxcsv::core::MemoryTracker* tracker,
+                      const std::string& prefix,
+                      const std::vector<std::string>& errors) {
+    if (tracker) {
+        tracker->throwIfLimitExceeded();
+    }
+    throw std::runtime_error(describeErrors(prefix, errors));
+}
+
+// Peak tracked memory, recorded once a conversion has finished
+void recordMemory(const xlsxcsv::core::MemoryTracker* tracker, ConversionStats& stats) {
+    if (tracker) {
+        stats.peakMemoryBytes = tracker->peak();
+    }
+}
+
+// Converts one sheet of an open workbook. With a sink the CSV is streamed out
+// while parsing and the returned string is empty. With a cache key the CSV is
+// also stored in the result cache.
+std::string convertOpenSheet(
+    const OpenWorkbook& parts,
+    xlsxcsv::core::MemoryTracker* tracker,
+    const xlsxcsv::core::SheetInfo& targetSheet,
+    const CsvOptions& options,
+    OutputSink* sink,
+    ConversionStats& stats,
+    const std::string& cacheKey) {
+    
+    recordPartSizes(parts.package, {targetSheet}, stats);
+    const uint64_t spillReadsAtStart = parts.sharedStrings.getSpillReadCount();
+    
+    const facade::ResultCache cache(options);
+    std::optional<facade::ResultCache::Recorder> recorder;
+    if (!cacheKey.empty()) {
+        recorder.emplace(cache, cacheKey, sink);
+    }
+    
+    xlsxcsv::core::SheetStreamReader sheetReader;
+    sheetReader.setParserBackend(toCoreParserBackend(options.parserBackend));
+    sheetReader.setPipelinedInflate(options.pipelinedInflate);
+    sheetReader.setReadFilter(xlsxcsv::core::makeSheetReadFilter(&options));
+    
+    // Create CSV collector with proper configuration
+    xlsxcsv::core::CsvRowCollector csvCollector(
+        parts.sharedStringsPtr(),
+        parts.stylesPtr(),
+        parts.workbook.getDateSystem(),
+        &options,
+        sink && recorder ? &*recorder : sink
+    );
+    trackMemory(tracker, sheetReader, &csvCollector);
+    
+    // Parse the worksheet, optionally splitting its rows across workers
+    auto t = Clock::now();
+    if (options.sheetParseThreads != 1) {
+        sheetReader.parseSheetParallel(parts.package, targetSheet.target, csvCollector, options.sheetParseThreads,
+                                       parts.sharedStringsPtr(), parts.stylesPtr());
+    } else {
+        sheetReader.parseSheet(parts.package, targetSheet.target, csvCollector,
+                              parts.sharedStringsPtr(), parts.stylesPtr());
+    }
+    stats.parseSheetMs = msSince(t);
+    
+    // Check for parsing errors
+    const auto& errors = csvCollector.getErrors();
+    if (!errors.empty()) {
+        throwParseErrors(tracker, "Sheet parsing errors: ", errors);
+    }
+    
+    // BOM and newline style are applied by the collector, so assembling
+    // the result is a move (string API) or a final flush (sink API)
+    t = Clock::now();
+    csvCollector.finish();
+    std::string csvResult = sink ? std::string() : csvCollector.takeCsvString();
+    if (recorder) {
+        if (!sink) {
+            recorder->write(csvResult.data(), csvResult.size());
+        }
+        recorder->commit(csvCollector.getRowCount());
+    }
+    stats.assembleCsvMs = msSince(t);
+    
+    recordCollector(csvCollector, stats);
+    recordSharedStrings(parts.sharedStrings, spillReadsAtStart, stats);
+    recordMemory(tracker, stats);
+    return csvResult;
+}
+
+// Runs convert with the sink wrapped in options.outputCompression. The
+// wrapper is outermost, so the result cache still records plain CSV.
+template <typename Function>
+std::string compressedOutput(OutputSink* sink, const CsvOptions& options, ConversionStats& stats, Function&& convert) {
+    if (options.outputCompression == CsvOptions::OutputCompression::NONE) {
+        return convert(sink);
+    }
+    if (!sink) {
+        throw std::invalid_argument("outputCompression applies to sink and file output only");
+    }
+    CompressedOutputSink compressed(*sink, options.outputCompression, options.compressionLevel,
+                                    options.compressionThreads);
+    std::string csv = convert(&compressed);
+    compressed.finish();
+    stats.compressedBytes = compressed.compressedBytes();
+    return csv;
+}
+
+// Converts one sheet of an open workbook, served from the result cache when
+// it holds the sheet
+std::string convertOrLoadSheet(
+    const OpenWorkbook& parts,
+    xlsxcsv::core::MemoryTracker* tracker,
+    const std::variant<std::string, int>& sheetSelector,
+    const CsvOptions& options,
+    OutputSink* sink,
+    ConversionStats& stats) {
+    
+    const xlsxcsv::core::SheetInfo targetSheet = selectSheet(parts.workbook, sheetSelector);
+    const std::string cacheKey = resultCacheKey(parts, targetSheet, options);
+    return compressedOutput(sink, options, stats, [&](OutputSink* output) {
+        std::string csv;
+        if (loadCachedSheet(cacheKey, options, output, csv, stats)) {
+            return csv;
+        }
+        return convertOpenSheet(parts, tracker, targetSheet, options, output, stats, cacheKey);
+    });
+}
+
+// Converts several sheets of an open workbook, concurrently with
+// options.maxThreads > 1; the first failure is rethrown
+std::map<std::string, std::string> convertOpenSheets(
+    const OpenWorkbook& parts,
+    xlsxcsv::core::MemoryTracker* tracker,
+    const std::vector<std::string>& sheetNames,
+    const CsvOptions& options,
+    ConversionStats& stats) {
+    
+    if (options.outputCompression != CsvOptions::OutputCompression::NONE) {
+        throw std::invalid_argument("outputCompression applies to sink and file output only");
+    }
+    
+    // Resolve every requested sheet up front so a bad name fails before any work starts
+    std::vector<xlsxcsv::core::SheetInfo> targets;
+    targets.reserve(sheetNames.size());
+    for (const std::string& sheetName : sheetNames) {
+        auto sheetInfo = parts.workbook.findSheet(sheetName);
+        if (!sheetInfo.has_value()) {
+            throw std::runtime_error("Sheet not found: " + sheetName);
+        }
+        targets.push_back(*sheetInfo);
+    }
+    recordPartSizes(parts.package, targets, stats);
+    const uint64_t spillReadsAtStart = parts.sharedStrings.getSpillReadCount();
+    
+    const auto* sharedStringsPtr = parts.sharedStringsPtr();
+    const auto* stylesPtr = parts.stylesPtr();
+    const auto dateSystem = parts.workbook.getDateSystem();
+    const auto readFilter = xlsxcsv::core::makeSheetReadFilter(&options);
+    const facade::ResultCache cache(options);
+    
+    // Converts one sheet; styles and shared strings are only read here.
+    // Each sheet records into its own stats, summed once all are done.
+    std::vector<ConversionStats> sheetStats(targets.size());
+    auto convertOne = [&](size_t i) -> std::string {
+        const auto sheetStart = Clock::now();
+        const std::string cacheKey = resultCacheKey(parts, targets[i], options);
+        std::string cached;
+        if (loadCachedSheet(cacheKey, options, nullptr, cached, sheetStats[i])) {
+            sheetStats[i].parseSheetMs = msSince(sheetStart);
+            return cached;
         }
         
-        // Phase 5: Parse sheet content to CSV
         xlsxcsv::core::SheetStreamReader sheetReader;
-        
-        // Create CSV collector with proper configuration
-        xlsxcsv::core::CsvRowCollector csvCollector(
-            sharedStrings.isOpen() ? &sharedStrings : nullptr,
-            styles.isOpen() ? &styles : nullptr, 
-            workbook.getDateSystem(),
-            &options
-        );
+        sheetReader.setParserBackend(toCoreParserBackend(options.parserBackend));
+        sheetReader.setPipelinedInflate(options.pipelinedInflate);
+        sheetReader.setReadFilter(readFilter);
+        xlsxcsv::core::CsvRowCollector csvCollector(sharedStringsPtr, stylesPtr, dateSystem, &options);
+        trackMemory(tracker, sheetReader, &csvCollector);
         
         // Parse the worksheet
-        t = std::chrono::steady_clock::now();
-        sheetReader.parseSheet(package, targetSheet->target, csvCollector,
-                              sharedStrings.isOpen() ? &sharedStrings : nullptr,
-                              styles.isOpen() ? &styles : nullptr);
-        t_sheet = msSince(t);
+        sheetReader.parseSheet(parts.package, targets[i].target, csvCollector,
+                              sharedStringsPtr, stylesPtr);
         
         // Check for parsing errors
         const auto& errors = csvCollector.getErrors();
         if (!errors.empty()) {
-            std::ostringstream errorMsg;
-            errorMsg << "Sheet parsing errors: ";
-            for (size_t i = 0; i < errors.size(); ++i) {
-                if (i > 0) errorMsg << "; ";
-                errorMsg << errors[i];
-            }
-            throw std::runtime_error(errorMsg.str());
+            throwParseErrors(tracker, "Sheet parsing errors for '" + sheetNames[i] + "': ", errors);
         }
         
-        // Return CSV string
-        t = std::chrono::steady_clock::now();
-        std::string csvResult = csvCollector.getCsvString();
-        t_csv = msSince(t);
-        
-        // Handle BOM if requested
-        if (options.includeBom) {
-            csvResult = "\xEF\xBB\xBF" + csvResult;
+        // Get CSV result (BOM and newline style already applied)
+        std::string csv = csvCollector.takeCsvString();
+        if (!cacheKey.empty()) {
+            facade::ResultCache::Recorder recorder(cache, cacheKey, nullptr);
+            recorder.write(csv.data(), csv.size());
+            recorder.commit(csvCollector.getRowCount());
         }
+        sheetStats[i].parseSheetMs = msSince(sheetStart);
+        recordCollector(csvCollector, sheetStats[i]);
+        return csv;
+    };
+    
+    std::vector<std::string> csvResults(targets.size());
+    
+    size_t threadCount = options.maxThreads;
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = std::min(threadCount, targets.size());
+    
+    if (threadCount <= 1) {
+        for (size_t i = 0; i < targets.size(); ++i) {
+            csvResults[i] = convertOne(i);
+        }
+    } else {
+        // Worker pool over the shared package. Sheets are claimed from a
+        // shared counter so long sheets don't hold up a pre-assigned batch.
+        std::atomic<size_t> nextSheet{0};
+        std::atomic<bool> failed{false};
+        std::mutex errorMutex;
+        std::exception_ptr firstError;
         
-        // Handle newline conversion if needed
-        if (options.newline == CsvOptions::Newline::CRLF) {
-            // Convert LF to CRLF
-            std::string result;
-            result.reserve(csvResult.size() * 1.1); // Reserve some extra space
-            for (char c : csvResult) {
-                if (c == '\n') {
-                    result += "\r\n";
-                } else {
-                    result += c;
+        auto worker = [&]() {
+            try {
+                while (!failed.load(std::memory_order_relaxed)) {
+                    const size_t i = nextSheet.fetch_add(1, std::memory_order_relaxed);
+                    if (i >= targets.size()) {
+                        break;
+                    }
+                    csvResults[i] = convertOne(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
                 }
+                failed.store(true, std::memory_order_relaxed);
             }
-            csvResult = std::move(result);
+        };
+        
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount);
+        for (size_t t = 0; t < threadCount; ++t) {
+            workers.emplace_back(worker);
+        }
+        for (auto& w : workers) {
+            w.join();
         }
-        t_post = msSince(t);
-
-        if (profileTimings) {
-            const double totalMs = msSince(t0);
-            std::cerr
-                << "turboxl_timing_ms"
-                << " open=" << t_open
-                << " workbook=" << t_workbook
-                << " styles=" << t_styles
-                << " shared_strings=" << t_shared
-                << " parse_sheet=" << t_sheet
-                << " assemble_csv=" << t_csv
-                << " postprocess=" << t_post
-                << " total=" << totalMs
-                << " rows=" << csvCollector.getRowCount()
-                << "\n";
+        
+        if (firstError) {
+            std::rethrow_exception(firstError);
+        }
+    }
+    
+    std::map<std::string, std::string> results;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        results[sheetNames[i]] = std::move(csvResults[i]);
+        addSheetStats(sheetStats[i], stats);
+    }
+    recordSharedStrings(parts.sharedStrings, spillReadsAtStart, stats);
+    recordMemory(tracker, stats);
+    return results;
+}
+
+void exportOpenSheet(
+    const OpenWorkbook& parts,
+    xlsxcsv::core::MemoryTracker* tracker,
+    const std::variant<std::string, int>& sheetSelector,
+    ArrowArrayStream* out,
+    const CsvOptions& options,
+    const ColumnarOptions& columnar) {
+    
+    const xlsxcsv::core::SheetInfo targetSheet = selectSheet(parts.workbook, sheetSelector);
+    
+    xlsxcsv::core::SheetStreamReader sheetReader;
+    sheetReader.setParserBackend(toCoreParserBackend(options.parserBackend));
+    sheetReader.setPipelinedInflate(options.pipelinedInflate);
+    sheetReader.setReadFilter(xlsxcsv::core::makeSheetReadFilter(&options));
+    trackMemory(tracker, sheetReader, nullptr);
+    xlsxcsv::core::ColumnarBatchBuilder builder(parts.sharedStringsPtr(), parts.stylesPtr(),
+                                                parts.workbook.getDateSystem(),
+                                                &options, columnar.batchSize, columnar.headerRow);
+    sheetReader.parseSheet(parts.package, targetSheet.target, builder, parts.sharedStringsPtr(), parts.stylesPtr());
+    
+    const auto& errors = builder.getErrors();
+    if (!errors.empty()) {
+        throwParseErrors(tracker, "Sheet parsing errors: ", errors);
+    }
+    
+    // All strings are copied into the stream, so the package may close afterwards
+    builder.exportStream(out);
+}
+
+std::vector<SheetMetadata> sheetMetadata(const xlsxcsv::core::Workbook& workbook) {
+    auto sheets = workbook.getSheets();
+    std::vector<SheetMetadata> result;
+    result.reserve(sheets.size());
+    
+    for (const auto& sheet : sheets) {
+        SheetMetadata metadata;
+        metadata.name = sheet.name;
+        metadata.sheetId = sheet.sheetId;
+        metadata.visible = sheet.visible;
+        metadata.target = sheet.target;
+        result.push_back(metadata);
+    }
+    return result;
+}
+
+std::vector<SheetMetadata> visibleOnly(std::vector<SheetMetadata> sheets) {
+    sheets.erase(std::remove_if(sheets.begin(), sheets.end(),
+                                [](const SheetMetadata& sheet) { return !sheet.visible; }),
+                 sheets.end());
+    return sheets;
+}
+
+// Shared conversion path for the string and sink APIs
+std::string convertSheetImpl(
+    const WorkbookInput& input,
+    const std::variant<std::string, int>& sheetSelector,
+    const CsvOptions& options,
+    OutputSink* sink,
+    ConversionStats* statsOut) {
+    
+    ConversionStats localStats;
+    ConversionStats& stats = statsOut ? *statsOut : localStats;
+    stats = ConversionStats{};
+    TotalTimer totalTimer(stats);
+    
+    OpenWorkbook parts(options);
+    openPackage(parts, input, stats);
+    
+    const xlsxcsv::core::SheetInfo targetSheet = selectSheet(parts.workbook, sheetSelector);
+    const std::string cacheKey = resultCacheKey(parts, targetSheet, options);
+    return compressedOutput(sink, options, stats, [&](OutputSink* output) {
+        std::string csv;
+        if (loadCachedSheet(cacheKey, options, output, csv, stats)) {
+            return csv;
         }
         
-        return csvResult;
+        // Styles and shared strings are only read once the cache has missed
+        openSharedParts(parts, stats);
+        return convertOpenSheet(parts, parts.memoryTracker.get(), targetSheet, options, output, stats, cacheKey);
+    });
+}
+
+// Writes a file under a temporary name in its directory and renames it into
+// place once write succeeds, so a failed conversion never leaves a truncated
+// file that looks complete (or clobbers an earlier good one)
+template <typename Function>
+void writeFileAtomically(const std::string& outPath, Function&& write) {
+    static const uint64_t processTag = std::random_device{}();
+    static std::atomic<uint64_t> sequence{0};
+    std::filesystem::path partial(outPath);
+    partial += ".partial-" + std::to_string(processTag) + "-" + std::to_string(sequence++);
+    try {
+        FileOutputSink sink(partial.string());
+        write(sink);
+        sink.close();
+        std::filesystem::rename(partial, outPath);
+    } catch (...) {
+        std::error_code ignored;
+        std::filesystem::remove(partial, ignored);
+        throw;
+    }
+}
+
+// Rethrows core and conversion errors the way every public entry point reports them
+template <typename Function>
+auto translateErrors(Function&& function) {
+    try {
+        return function();
     }
     catch (const xlsxcsv::core::XlsxError& e) {
         throw std::runtime_error("XLSX parsing error: " + std::string(e.what()));
@@ -190,15 +702,218 @@ std::string readSheetToCsv(
     }
 }
 
+} // namespace
+
+bool installMemoryHooks() {
+    return xlsxcsv::core::MemoryTracker::installLibxmlHooks();
+}
+
+std::string readSheetToCsv(
+    const std::string& xlsxPath,
+    const std::variant<std::string, int>& sheetSelector,
+    const CsvOptions& options,
+    ConversionStats* stats) {
+    
+    return translateErrors([&]() {
+        return convertSheetImpl(xlsxPath, sheetSelector, options, nullptr, stats);
+    });
+}
+
+void convertSheet(
+    const std::string& xlsxPath,
+    const std::variant<std::string, int>& sheetSelector,
+    OutputSink& sink,
+    const CsvOptions& options,
+    ConversionStats* stats) {
+    
+    translateErrors([&]() {
+        convertSheetImpl(xlsxPath, sheetSelector, options, &sink, stats);
+    });
+}
+
+std::string readSheetToCsv(
+    std::span<const std::byte> data,
+    const std::variant<std::string, int>& sheetSelector,
+    const CsvOptions& options,
+    ConversionStats* stats) {
+    
+    return translateErrors([&]() {
+        return convertSheetImpl(data, sheetSelector, options, nullptr, stats);
+    });
+}
+
+void convertSheet(
+    std::span<const std::byte> data,
+    const std::variant<std::string, int>& sheetSelector,
+    OutputSink& sink,
+    const CsvOptions& options,
+    ConversionStats* stats) {
+    
+    translateErrors([&]() {
+        convertSheetImpl(data, sheetSelector, options, &sink, stats);
+    });
+}
+
+void convertSheetToFile(
+    const std::string& xlsxPath,
+    const std::variant<std::string, int>& sheetSelector,
+    const std::string& outPath,
+    const CsvOptions& options,
+    ConversionStats* stats) {
+    
+    translateErrors([&]() {
+        writeFileAtomically(outPath, [&](OutputSink& sink) {
+            convertSheetImpl(xlsxPath, sheetSelector, options, &sink, stats);
+        });
+    });
+}
+
+// Chunks are queued by a sink on the conversion thread and handed out by next()
+class CsvChunkReader::Impl {
+public:
+    Impl(const std::string& xlsxPath,
+         const std::variant<std::string, int>& sheetSelector,
+         const CsvOptions& options,
+         size_t chunkBytes,
+         size_t maxQueuedChunks)
+        : m_chunkBytes(std::max<size_t>(chunkBytes, 1))
+        , m_maxQueuedChunks(std::max<size_t>(maxQueuedChunks, 1)) {
+        m_worker = std::thread([this, xlsxPath, sheetSelector, options]() {
+            run(xlsxPath, sheetSelector, options);
+        });
+    }
+    
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cancelled = true;
+        }
+        m_changed.notify_all();
+        m_worker.join();
+    }
+    
+    bool next(std::string& chunk) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this]() { return !m_queue.empty() || m_done; });
+        if (!m_queue.empty()) {
+            chunk = std::move(m_queue.front());
+            m_queue.pop_front();
+            lock.unlock();
+            m_changed.notify_all();
+            return true;
+        }
+        if (m_error) {
+            std::rethrow_exception(std::exchange(m_error, nullptr));
+        }
+        return false;
+    }
+
+private:
+    class QueueSink : public OutputSink {
+    public:
+        explicit QueueSink(Impl& owner) : m_owner(owner) {}
+        void write(const char* data, size_t size) override { m_owner.append(data, size); }
+        
+    private:
+        Impl& m_owner;
+    };
+    
+    void run(const std::string& xlsxPath,
+             const std::variant<std::string, int>& sheetSelector,
+             const CsvOptions& options) {
+        try {
+            QueueSink sink(*this);
+            convertSheet(xlsxPath, sheetSelector, sink, options);
+            if (!m_pending.empty()) {
+                push();
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_cancelled) {
+                m_error = std::current_exception();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_done = true;
+        }
+        m_changed.notify_all();
+    }
+    
+    // Sink blocks end at row boundaries, so cutting between them keeps rows whole
+    void append(const char* data, size_t size) {
+        m_pending.append(data, size);
+        if (m_pending.size() >= m_chunkBytes) {
+            push();
+        }
+    }
+    
+    void push() {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_changed.wait(lock, [this]() { return m_cancelled || m_queue.size() < m_maxQueuedChunks; });
+            if (m_cancelled) {
+                throw std::runtime_error("CSV chunk reader was closed");
+            }
+            m_queue.push_back(std::move(m_pending));
+        }
+        m_changed.notify_all();
+        m_pending = std::string();
+    }
+    
+    const size_t m_chunkBytes;
+    const size_t m_maxQueuedChunks;
+    std::string m_pending; // Only touched by the conversion thread
+    
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::deque<std::string> m_queue;
+    std::exception_ptr m_error;
+    bool m_done = false;
+    bool m_cancelled = false;
+    std::thread m_worker; // Started in the constructor body, once every other member exists
+};
+
+CsvChunkReader::CsvChunkReader(const std::string& xlsxPath,
+                               const std::variant<std::string, int>& sheetSelector,
+                               const CsvOptions& options,
+                               size_t chunkBytes,
+                               size_t maxQueuedChunks)
+    : m_impl(std::make_unique<Impl>(xlsxPath, sheetSelector, options, chunkBytes, maxQueuedChunks)) {
+}
+
+CsvChunkReader::~CsvChunkReader() = default;
+
+bool CsvChunkReader::next(std::string& chunk) {
+    return m_impl->next(chunk);
+}
+
+void readSheetToArrow(
+    const std::string& xlsxPath,
+    const std::variant<std::string, int>& sheetSelector,
+    ArrowArrayStream* out,
+    const CsvOptions& options,
+    const ColumnarOptions& columnar) {
+    
+    if (!out) {
+        throw std::invalid_argument("readSheetToArrow requires an output stream");
+    }
+    out->release = nullptr;
+    
+    translateErrors([&]() {
+        ConversionStats stats;
+        OpenWorkbook parts(options);
+        openWorkbook(parts, xlsxPath, stats);
+        exportOpenSheet(parts, parts.memoryTracker.get(), sheetSelector, out, options, columnar);
+    });
+}
+
 std::string readSheetToCsv(const std::string& xlsxPath) {
     return readSheetToCsv(xlsxPath, -1, CsvOptions{});
 }
 
 std::vector<SheetMetadata> getSheetList(const std::string& xlsxPath) {
-    try {
-        // Create security limits with defaults
-        xlsxcsv::core::ZipSecurityLimits limits;
-        
+    return translateErrors([&]() {
         // Open package and workbook (lightweight operations)
         xlsxcsv::core::OpcPackage package;
         package.open(xlsxPath);
@@ -206,166 +921,287 @@ std::vector<SheetMetadata> getSheetList(const std::string& xlsxPath) {
         xlsxcsv::core::Workbook workbook;
         workbook.open(package);
         
-        // Get all sheets and convert to public metadata format
-        auto sheets = workbook.getSheets();
-        std::vector<SheetMetadata> result;
-        result.reserve(sheets.size());
-        
-        for (const auto& sheet : sheets) {
-            SheetMetadata metadata;
-            metadata.name = sheet.name;
-            metadata.sheetId = sheet.sheetId;
-            metadata.visible = sheet.visible;
-            metadata.target = sheet.target;
-            result.push_back(metadata);
-        }
-        
-        return result;
-    }
-    catch (const xlsxcsv::core::XlsxError& e) {
-        throw std::runtime_error("XLSX parsing error: " + std::string(e.what()));
-    }
-    catch (const std::exception& e) {
-        throw std::runtime_error("Error reading XLSX file: " + std::string(e.what()));
-    }
+        return sheetMetadata(workbook);
+    });
 }
 
 std::vector<SheetMetadata> getVisibleSheets(const std::string& xlsxPath) {
-    auto allSheets = getSheetList(xlsxPath);
-    
-    std::vector<SheetMetadata> visibleSheets;
-    for (const auto& sheet : allSheets) {
-        if (sheet.visible) {
-            visibleSheets.push_back(sheet);
-        }
-    }
-    
-    return visibleSheets;
+    return visibleOnly(getSheetList(xlsxPath));
 }
 
 std::string readSpecificSheet(
     const std::string& xlsxPath,
     const std::string& sheetName,
-    const CsvOptions& options) {
+    const CsvOptions& options,
+    ConversionStats* stats) {
     
     // Use the existing function but with the specific sheet name
     CsvOptions modifiedOptions = options;
     modifiedOptions.sheetByName = sheetName;
     modifiedOptions.sheetByIndex = -1; // Clear index to ensure name takes precedence
     
-    return readSheetToCsv(xlsxPath, sheetName, modifiedOptions);
+    return readSheetToCsv(xlsxPath, sheetName, modifiedOptions, stats);
 }
 
 std::map<std::string, std::string> readMultipleSheets(
     const std::string& xlsxPath,
     const std::vector<std::string>& sheetNames,
-    const CsvOptions& options) {
+    const CsvOptions& options,
+    ConversionStats* statsOut) {
     
-    try {
-        // Create security limits from options
-        xlsxcsv::core::ZipSecurityLimits limits;
-        limits.maxEntries = options.maxEntries;
-        limits.maxEntrySize = options.maxEntrySize;
-        limits.maxTotalUncompressed = options.maxTotalUncompressed;
-        
+    ConversionStats localStats;
+    ConversionStats& stats = statsOut ? *statsOut : localStats;
+    stats = ConversionStats{};
+    TotalTimer totalTimer(stats);
+    
+    return translateErrors([&]() {
         // Open package, workbook, styles, and shared strings once (efficient reuse)
-        xlsxcsv::core::OpcPackage package;
-        package.open(xlsxPath);
-        
-        xlsxcsv::core::Workbook workbook;
-        workbook.open(package);
-        
-        xlsxcsv::core::StylesRegistry styles;
-        try {
-            styles.parse(package);
-        } catch (const xlsxcsv::core::XlsxError& e) {
-            // Some XLSX files might not have styles.xml, continue without styles
+        OpenWorkbook parts(options);
+        openWorkbook(parts, xlsxPath, stats);
+        return convertOpenSheets(parts, parts.memoryTracker.get(), sheetNames, options, stats);
+    });
+}
+
+class Document::Impl {
+public:
+    Impl(const std::string& xlsxPath, const CsvOptions& options)
+        : m_path(xlsxPath), m_parts(options) {
+        ConversionStats openStats;
+        openWorkbook(m_parts, xlsxPath, openStats);
+    }
+    
+    // Each conversion charges its own tracker, made from that call's options
+    // and starting from the shared string table the document keeps resident
+    std::unique_ptr<xlsxcsv::core::MemoryTracker> conversionTracker(const CsvOptions& options) const {
+        auto tracker = OpenWorkbook::makeMemoryTracker(options);
+        if (tracker && m_parts.sharedStrings.isOpen()) {
+            tracker->charge(m_parts.sharedStrings.getMemoryUsage());
         }
-        
-        xlsxcsv::core::SharedStringsConfig sharedConfig;
-        sharedConfig.mode = options.sharedStringsMode == CsvOptions::SharedStringsMode::AUTO ? 
-            xlsxcsv::core::SharedStringsMode::Auto :
-            options.sharedStringsMode == CsvOptions::SharedStringsMode::IN_MEMORY ?
-            xlsxcsv::core::SharedStringsMode::InMemory :
-            xlsxcsv::core::SharedStringsMode::External;
-        
-        xlsxcsv::core::SharedStringsProvider sharedStrings(sharedConfig);
-        try {
-            sharedStrings.parse(package);
-        } catch (const xlsxcsv::core::XlsxError& e) {
-            // Some XLSX files might not have sharedStrings.xml, continue without shared strings
+        return tracker;
+    }
+    
+    // Runs one conversion with stats reset up front and the total filled on exit
+    template <typename Convert>
+    auto measured(ConversionStats* statsOut, const CsvOptions& options, Convert&& convert) const {
+        ConversionStats localStats;
+        ConversionStats& stats = statsOut ? *statsOut : localStats;
+        stats = ConversionStats{};
+        TotalTimer totalTimer(stats);
+        return translateErrors([&]() {
+            const auto tracker = conversionTracker(options);
+            return convert(stats, tracker.get());
+        });
+    }
+    
+    const std::string m_path;
+    OpenWorkbook m_parts;
+};
+
+Document::Document(const std::string& xlsxPath, const CsvOptions& options)
+    : m_impl(translateErrors([&]() { return std::make_unique<Impl>(xlsxPath, options); })) {
+}
+
+Document::~Document() = default;
+Document::Document(Document&&) noexcept = default;
+Document& Document::operator=(Document&&) noexcept = default;
+
+const std::string& Document::path() const {
+    return m_impl->m_path;
+}
+
+std::vector<SheetMetadata> Document::getSheetList() const {
+    return sheetMetadata(m_impl->m_parts.workbook);
+}
+
+std::vector<SheetMetadata> Document::getVisibleSheets() const {
+    return visibleOnly(getSheetList());
+}
+
+std::string Document::readSheetToCsv(
+    const std::variant<std::string, int>& sheetSelector,
+    const CsvOptions& options,
+    ConversionStats* stats) const {
+    
+    return m_impl->measured(stats, options, [&](ConversionStats& s, xlsxcsv::core::MemoryTracker* tracker) {
+        return convertOrLoadSheet(m_impl->m_parts, tracker, sheetSelector, options, nullptr, s);
+    });
+}
+
+void Document::convertSheet(
+    const std::variant<std::string, int>& sheetSelector,
+    OutputSink& sink,
+    const CsvOptions& options,
+    ConversionStats* stats) const {
+    
+    m_impl->measured(stats, options, [&](ConversionStats& s, xlsxcsv::core::MemoryTracker* tracker) {
+        convertOrLoadSheet(m_impl->m_parts, tracker, sheetSelector, options, &sink, s);
+    });
+}
+
+void Document::convertSheetToFile(
+    const std::variant<std::string, int>& sheetSelector,
+    const std::string& outPath,
+    const CsvOptions& options,
+    ConversionStats* stats) const {
+    
+    m_impl->measured(stats, options, [&](ConversionStats& s, xlsxcsv::core::MemoryTracker* tracker) {
+        writeFileAtomically(outPath, [&](OutputSink& sink) {
+            convertOrLoadSheet(m_impl->m_parts, tracker, sheetSelector, options, &sink, s);
+        });
+    });
+}
+
+std::map<std::string, std::string> Document::readMultipleSheets(
+    const std::vector<std::string>& sheetNames,
+    const CsvOptions& options,
+    ConversionStats* stats) const {
+    
+    return m_impl->measured(stats, options, [&](ConversionStats& s, xlsxcsv::core::MemoryTracker* tracker) {
+        return convertOpenSheets(m_impl->m_parts, tracker, sheetNames, options, s);
+    });
+}
+
+void Document::readSheetToArrow(
+    const std::variant<std::string, int>& sheetSelector,
+    ArrowArrayStream* out,
+    const CsvOptions& options,
+    const ColumnarOptions& columnar) const {
+    
+    if (!out) {
+        throw std::invalid_argument("readSheetToArrow requires an output stream");
+    }
+    out->release = nullptr;
+    translateErrors([&]() {
+        const auto tracker = m_impl->conversionTracker(options);
+        exportOpenSheet(m_impl->m_parts, tracker.get(), sheetSelector, out, options, columnar);
+    });
+}
+
+size_t Document::getMemoryUsage() const {
+    // Central directory, relationships and number formats are small next to
+    // the shared strings, so a fixed allowance covers them
+    constexpr size_t BASELINE_BYTES = 64 * 1024;
+    const auto& sharedStrings = m_impl->m_parts.sharedStrings;
+    return BASELINE_BYTES + (sharedStrings.isOpen() ? sharedStrings.getMemoryUsage() : 0);
+}
+
+namespace {
+
+// Process-wide LRU of opened documents, most recently used first
+class DocumentCache {
+public:
+    static DocumentCache& instance() {
+        static DocumentCache cache;
+        return cache;
+    }
+    
+    std::shared_ptr<const Document> open(const std::string& xlsxPath, const CsvOptions& options) {
+        const std::optional<std::string> key = cacheKey(xlsxPath, options);
+        if (!key) {
+            // Let the Document report why the file can't be read
+            return std::make_shared<const Document>(xlsxPath, options);
         }
         
-        std::map<std::string, std::string> results;
-        
-        // Process each requested sheet
-        xlsxcsv::core::SheetStreamReader sheetReader;
-        
-        for (const std::string& sheetName : sheetNames) {
-            auto sheetInfo = workbook.findSheet(sheetName);
-            if (!sheetInfo.has_value()) {
-                throw std::runtime_error("Sheet not found: " + sheetName);
-            }
-            
-            // Parse sheet content to CSV
-            xlsxcsv::core::CsvRowCollector csvCollector(
-                sharedStrings.isOpen() ? &sharedStrings : nullptr,
-                styles.isOpen() ? &styles : nullptr, 
-                workbook.getDateSystem(),
-                &options
-            );
-            
-            // Parse the worksheet
-            sheetReader.parseSheet(package, sheetInfo->target, csvCollector,
-                                  sharedStrings.isOpen() ? &sharedStrings : nullptr,
-                                  styles.isOpen() ? &styles : nullptr);
-            
-            // Check for parsing errors
-            const auto& errors = csvCollector.getErrors();
-            if (!errors.empty()) {
-                std::ostringstream errorMsg;
-                errorMsg << "Sheet parsing errors for '" << sheetName << "': ";
-                for (size_t i = 0; i < errors.size(); ++i) {
-                    if (i > 0) errorMsg << "; ";
-                    errorMsg << errors[i];
-                }
-                throw std::runtime_error(errorMsg.str());
-            }
-            
-            // Get CSV result
-            std::string csvResult = csvCollector.getCsvString();
-            
-            // Handle BOM if requested
-            if (options.includeBom) {
-                csvResult = "\xEF\xBB\xBF" + csvResult;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto found = m_index.find(*key);
+            if (found != m_index.end()) {
+                m_entries.splice(m_entries.begin(), m_entries, found->second);
+                auto document = found->second->document;
+                evict();
+                return document;
             }
-            
-            // Handle newline conversion if needed
-            if (options.newline == CsvOptions::Newline::CRLF) {
-                // Convert LF to CRLF
-                std::string result;
-                result.reserve(csvResult.size() * 1.1);
-                for (char c : csvResult) {
-                    if (c == '\n') {
-                        result += "\r\n";
-                    } else {
-                        result += c;
-                    }
-                }
-                csvResult = std::move(result);
-            }
-            
-            results[sheetName] = csvResult;
         }
         
-        return results;
+        // Opened without the lock so other files stay available meanwhile; if
+        // the same file was opened concurrently the first entry wins
+        auto document = std::make_shared<const Document>(xlsxPath, options);
+        const size_t bytes = document->getMemoryUsage();
+        
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto found = m_index.find(*key);
+        if (found != m_index.end()) {
+            m_entries.splice(m_entries.begin(), m_entries, found->second);
+            return found->second->document;
+        }
+        if (bytes <= m_limit) {
+            m_entries.push_front(Entry{*key, document});
+            m_index.emplace(*key, m_entries.begin());
+            evict();
+        }
+        return document;
     }
-    catch (const xlsxcsv::core::XlsxError& e) {
-        throw std::runtime_error("XLSX parsing error: " + std::string(e.what()));
+    
+    void setLimit(size_t bytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_limit = bytes;
+        evict();
     }
-    catch (const std::exception& e) {
-        throw std::runtime_error("Error reading XLSX file: " + std::string(e.what()));
+    
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_index.clear();
+        m_entries.clear();
     }
+
+private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const Document> document;
+    };
+    
+    // Path, size and modification time identify one version of a file; the
+    // open options that shape what is kept resident are part of the key too
+    static std::optional<std::string> cacheKey(const std::string& xlsxPath, const CsvOptions& options) {
+        std::error_code ec;
+        const auto canonical = std::filesystem::weakly_canonical(xlsxPath, ec);
+        if (ec) return std::nullopt;
+        const auto size = std::filesystem::file_size(canonical, ec);
+        if (ec) return std::nullopt;
+        const auto modified = std::filesystem::last_write_time(canonical, ec);
+        if (ec) return std::nullopt;
+        
+        std::ostringstream key;
+        key << canonical.string() << '\n' << size << '\n'
+            << modified.time_since_epoch().count() << '\n'
+            << static_cast<int>(options.sharedStringsMode) << '\n'
+            << (options.trackMemory || options.memoryLimit > 0) << '\n'
+            << options.memoryLimit;
+        return key.str();
+    }
+    
+    // Sizes are re-read rather than recorded at insertion, since Lazy
+    // documents grow as conversions decode their strings
+    void evict() {
+        size_t bytes = 0;
+        for (const auto& entry : m_entries) {
+            bytes += entry.document->getMemoryUsage();
+        }
+        while (bytes > m_limit && !m_entries.empty()) {
+            bytes -= std::min(bytes, m_entries.back().document->getMemoryUsage());
+            m_index.erase(m_entries.back().key);
+            m_entries.pop_back();
+        }
+    }
+    
+    std::mutex m_mutex;
+    std::list<Entry> m_entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    size_t m_limit = 512 * 1024 * 1024;
+};
+
+} // namespace
+
+std::shared_ptr<const Document> Document::openCached(const std::string& xlsxPath, const CsvOptions& options) {
+    return DocumentCache::instance().open(xlsxPath, options);
+}
+
+void Document::setCacheLimit(size_t bytes) {
+    DocumentCache::instance().setLimit(bytes);
+}
+
+void Document::clearCache() {
+    DocumentCache::instance().clear();
 }
 
 } // namespace xlsxcsv
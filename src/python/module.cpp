@@ -2,8 +2,204 @@
 #include <pybind11/stl.h>
 #include "xlsxcsv.hpp"
 
+#include <optional>
+
 namespace py = pybind11;
 
+namespace {
+
+// A converted sheet waiting to be imported through the Arrow PyCapsule
+// interface (pyarrow.table(obj), polars.DataFrame(obj), ...). The record
+// batches are handed over without copying and can be consumed once.
+class ArrowSheetStream {
+public:
+    explicit ArrowSheetStream(const ArrowArrayStream& stream) : m_stream(stream) {}
+    ArrowSheetStream(const ArrowSheetStream&) = delete;
+    ArrowSheetStream& operator=(const ArrowSheetStream&) = delete;
+    
+    ~ArrowSheetStream() {
+        if (m_stream.release) {
+            m_stream.release(&m_stream);
+        }
+    }
+    
+    py::object exportStream(const py::object& requestedSchema) {
+        if (!requestedSchema.is_none()) {
+            throw py::type_error("turboxl Arrow streams do not support schema requests");
+        }
+        if (!m_stream.release) {
+            throw std::runtime_error("Arrow stream has already been consumed");
+        }
+        auto* exported = new ArrowArrayStream(m_stream);
+        m_stream.release = nullptr; // Ownership moves to the capsule
+        PyObject* capsule = PyCapsule_New(exported, "arrow_array_stream", [](PyObject* object) {
+            auto* stream = static_cast<ArrowArrayStream*>(PyCapsule_GetPointer(object, "arrow_array_stream"));
+            if (stream->release) {
+                stream->release(stream);
+            }
+            delete stream;
+        });
+        if (!capsule) {
+            exported->release(exported);
+            delete exported;
+            throw py::error_already_set();
+        }
+        return py::reinterpret_steal<py::object>(capsule);
+    }
+
+private:
+    ArrowArrayStream m_stream;
+};
+
+// CSV bytes owned by C++. Exposes the buffer protocol, so memoryview(chunk),
+// bytes(chunk) and file.write(chunk) work without a str conversion.
+class CsvChunk {
+public:
+    explicit CsvChunk(std::string data) : m_data(std::move(data)) {}
+    
+    py::buffer_info buffer() {
+        return py::buffer_info(m_data.data(), 1, py::format_descriptor<uint8_t>::format(), 1,
+                               {static_cast<py::ssize_t>(m_data.size())}, {1}, true);
+    }
+    size_t size() const { return m_data.size(); }
+
+private:
+    std::string m_data;
+};
+
+// Iterator over the chunks of a background conversion; the GIL is only held
+// while a finished chunk is handed to Python
+class CsvChunkIterator {
+public:
+    CsvChunkIterator(const std::string& xlsxPath,
+                     const std::variant<std::string, int>& sheet,
+                     const xlsxcsv::CsvOptions& options,
+                     size_t batchSize)
+        : m_reader(std::make_unique<xlsxcsv::CsvChunkReader>(xlsxPath, sheet, options, batchSize)) {}
+    
+    ~CsvChunkIterator() {
+        // Stopping the conversion waits for the worker's current block
+        if (m_reader) {
+            py::gil_scoped_release gil;
+            m_reader.reset();
+        }
+    }
+    
+    std::unique_ptr<CsvChunk> next() {
+        if (!m_reader) {
+            throw py::stop_iteration();
+        }
+        std::string chunk;
+        bool more = false;
+        {
+            py::gil_scoped_release gil;
+            try {
+                more = m_reader->next(chunk);
+            } catch (...) {
+                m_reader.reset();
+                throw;
+            }
+            if (!more) {
+                m_reader.reset(); // Joins the finished worker now rather than when collected
+            }
+        }
+        if (!more) {
+            throw py::stop_iteration();
+        }
+        return std::make_unique<CsvChunk>(std::move(chunk));
+    }
+
+private:
+    std::unique_ptr<xlsxcsv::CsvChunkReader> m_reader;
+};
+
+// Read-only view of a Python object's bytes (bytes, bytearray, memoryview,
+// mmap, NumPy arrays...). The exporter keeps the memory alive and unchanged
+// until the view is released, so it can be read with the GIL dropped.
+class ContiguousBytes {
+public:
+    explicit ContiguousBytes(const py::object& object) {
+        if (PyObject_GetBuffer(object.ptr(), &m_view, PyBUF_SIMPLE) != 0) {
+            throw py::error_already_set();
+        }
+    }
+    ~ContiguousBytes() {
+        PyBuffer_Release(&m_view);
+    }
+    ContiguousBytes(const ContiguousBytes&) = delete;
+    ContiguousBytes& operator=(const ContiguousBytes&) = delete;
+
+    std::span<const std::byte> span() const {
+        return {static_cast<const std::byte*>(m_view.buf), static_cast<size_t>(m_view.len)};
+    }
+
+private:
+    Py_buffer m_view{};
+};
+
+void fillStatsDict(const xlsxcsv::ConversionStats& stats, py::dict& out) {
+    out["open_ms"] = stats.openMs;
+    out["workbook_ms"] = stats.workbookMs;
+    out["styles_ms"] = stats.stylesMs;
+    out["shared_strings_ms"] = stats.sharedStringsMs;
+    out["parse_sheet_ms"] = stats.parseSheetMs;
+    out["assemble_csv_ms"] = stats.assembleCsvMs;
+    out["total_ms"] = stats.totalMs;
+    out["worksheet_compressed_bytes"] = stats.worksheetCompressedBytes;
+    out["worksheet_uncompressed_bytes"] = stats.worksheetUncompressedBytes;
+    out["shared_strings_compressed_bytes"] = stats.sharedStringsCompressedBytes;
+    out["shared_strings_uncompressed_bytes"] = stats.sharedStringsUncompressedBytes;
+    out["sheets"] = stats.sheets;
+    out["rows"] = stats.rows;
+    out["cells"] = stats.cells;
+    out["number_cells"] = stats.numberCells;
+    out["shared_string_cells"] = stats.sharedStringCells;
+    out["inline_string_cells"] = stats.inlineStringCells;
+    out["formula_string_cells"] = stats.formulaStringCells;
+    out["boolean_cells"] = stats.booleanCells;
+    out["error_cells"] = stats.errorCells;
+    out["shared_string_count"] = stats.sharedStringCount;
+    out["shared_string_lookups"] = stats.sharedStringLookups;
+    out["spill_reads"] = stats.spillReads;
+    out["shared_strings_memory_bytes"] = stats.sharedStringsMemoryBytes;
+    out["output_bytes"] = stats.outputBytes;
+    out["compressed_bytes"] = stats.compressedBytes;
+    out["result_cache_hits"] = stats.resultCacheHits;
+    out["peak_memory_bytes"] = stats.peakMemoryBytes;
+}
+
+// Runs a conversion without the GIL. When the caller passed a dict as stats=,
+// it is filled with the conversion's stats, also when the conversion fails.
+template <typename Convert>
+auto convertWithStats(const py::object& statsOut, Convert&& convert) {
+    std::optional<py::dict> dict;
+    if (!statsOut.is_none()) {
+        if (!py::isinstance<py::dict>(statsOut)) {
+            throw py::type_error("stats must be a dict");
+        }
+        dict = py::reinterpret_borrow<py::dict>(statsOut);
+    }
+    xlsxcsv::ConversionStats stats;
+    try {
+        decltype(convert(&stats)) result;
+        {
+            py::gil_scoped_release gil;  // Release GIL during C++ execution
+            result = convert(dict ? &stats : nullptr);
+        }
+        if (dict) {
+            fillStatsDict(stats, *dict);
+        }
+        return result;
+    } catch (...) {
+        if (dict) {
+            fillStatsDict(stats, *dict);
+        }
+        throw;
+    }
+}
+
+} // namespace
+
 PYBIND11_MODULE(turboxl, m) {
     m.doc() = "Fast XLSX to CSV converter (C++ core with Python bindings)";
     
@@ -16,15 +212,30 @@ PYBIND11_MODULE(turboxl, m) {
         .value("ISO", xlsxcsv::CsvOptions::DateMode::ISO)
         .value("RAW", xlsxcsv::CsvOptions::DateMode::RAW);
     
+    py::enum_<xlsxcsv::CsvOptions::NumberFormat>(m, "NumberFormat")
+        .value("FIXED6", xlsxcsv::CsvOptions::NumberFormat::FIXED6)
+        .value("SHORTEST", xlsxcsv::CsvOptions::NumberFormat::SHORTEST);
+    
     py::enum_<xlsxcsv::CsvOptions::SharedStringsMode>(m, "SharedStringsMode")
         .value("AUTO", xlsxcsv::CsvOptions::SharedStringsMode::AUTO)
         .value("IN_MEMORY", xlsxcsv::CsvOptions::SharedStringsMode::IN_MEMORY)
-        .value("EXTERNAL", xlsxcsv::CsvOptions::SharedStringsMode::EXTERNAL);
+        .value("EXTERNAL", xlsxcsv::CsvOptions::SharedStringsMode::EXTERNAL)
+        .value("LAZY", xlsxcsv::CsvOptions::SharedStringsMode::LAZY);
+    
+    py::enum_<xlsxcsv::CsvOptions::ParserBackend>(m, "ParserBackend")
+        .value("AUTO", xlsxcsv::CsvOptions::ParserBackend::AUTO)
+        .value("FAST", xlsxcsv::CsvOptions::ParserBackend::FAST)
+        .value("LIBXML", xlsxcsv::CsvOptions::ParserBackend::LIBXML);
     
     py::enum_<xlsxcsv::CsvOptions::MergedHandling>(m, "MergedHandling")
         .value("NONE", xlsxcsv::CsvOptions::MergedHandling::NONE)
         .value("PROPAGATE", xlsxcsv::CsvOptions::MergedHandling::PROPAGATE);
     
+    py::enum_<xlsxcsv::CsvOptions::OutputCompression>(m, "OutputCompression")
+        .value("NONE", xlsxcsv::CsvOptions::OutputCompression::NONE)
+        .value("GZIP", xlsxcsv::CsvOptions::OutputCompression::GZIP)
+        .value("ZSTD", xlsxcsv::CsvOptions::OutputCompression::ZSTD);
+    
     // SheetMetadata struct
     py::class_<xlsxcsv::SheetMetadata>(m, "SheetMetadata")
         .def(py::init<>())
@@ -47,26 +258,138 @@ PYBIND11_MODULE(turboxl, m) {
         .def_readwrite("include_bom", &xlsxcsv::CsvOptions::includeBom)
         .def_readwrite("date_mode", &xlsxcsv::CsvOptions::dateMode)
         .def_readwrite("quote_all", &xlsxcsv::CsvOptions::quoteAll)
+        .def_readwrite("number_format", &xlsxcsv::CsvOptions::numberFormat)
         .def_readwrite("shared_strings_mode", &xlsxcsv::CsvOptions::sharedStringsMode)
         .def_readwrite("merged_handling", &xlsxcsv::CsvOptions::mergedHandling)
         .def_readwrite("include_hidden_rows", &xlsxcsv::CsvOptions::includeHiddenRows)
         .def_readwrite("include_hidden_columns", &xlsxcsv::CsvOptions::includeHiddenColumns)
+        .def_readwrite("row_offset", &xlsxcsv::CsvOptions::rowOffset)
+        .def_readwrite("row_limit", &xlsxcsv::CsvOptions::rowLimit)
+        .def_readwrite("columns", &xlsxcsv::CsvOptions::columns)
+        .def_readwrite("memory_map", &xlsxcsv::CsvOptions::memoryMap)
+        .def_readwrite("pipelined_inflate", &xlsxcsv::CsvOptions::pipelinedInflate)
+        .def_readwrite("result_cache_dir", &xlsxcsv::CsvOptions::resultCacheDir)
+        .def_readwrite("result_cache_limit", &xlsxcsv::CsvOptions::resultCacheLimit)
+        .def_readwrite("output_compression", &xlsxcsv::CsvOptions::outputCompression)
+        .def_readwrite("compression_level", &xlsxcsv::CsvOptions::compressionLevel)
+        .def_readwrite("compression_threads", &xlsxcsv::CsvOptions::compressionThreads)
+        .def_readwrite("track_memory", &xlsxcsv::CsvOptions::trackMemory)
+        .def_readwrite("memory_limit", &xlsxcsv::CsvOptions::memoryLimit)
+        .def_readwrite("parser_backend", &xlsxcsv::CsvOptions::parserBackend)
+        .def_readwrite("max_threads", &xlsxcsv::CsvOptions::maxThreads)
+        .def_readwrite("sheet_parse_threads", &xlsxcsv::CsvOptions::sheetParseThreads)
         .def_readwrite("max_entries", &xlsxcsv::CsvOptions::maxEntries)
         .def_readwrite("max_entry_size", &xlsxcsv::CsvOptions::maxEntrySize)
         .def_readwrite("max_total_uncompressed", &xlsxcsv::CsvOptions::maxTotalUncompressed);
     
+    py::class_<ArrowSheetStream>(m, "ArrowSheetStream")
+        .def("__arrow_c_stream__", &ArrowSheetStream::exportStream,
+             py::arg("requested_schema") = py::none(),
+             "Export the record batches as an Arrow C stream PyCapsule");
+    
+    py::class_<CsvChunk>(m, "CsvChunk", py::buffer_protocol())
+        .def_buffer(&CsvChunk::buffer)
+        .def("__len__", &CsvChunk::size);
+    
+    py::class_<CsvChunkIterator>(m, "CsvChunkIterator")
+        .def("__iter__", [](CsvChunkIterator& it) -> CsvChunkIterator& { return it; },
+             py::return_value_policy::reference_internal)
+        .def("__next__", &CsvChunkIterator::next);
+    
     // Main function
     m.def("read_sheet_to_csv", 
         [](const std::string& xlsx_path, 
            const std::variant<std::string, int>& sheet,
-           const xlsxcsv::CsvOptions& options) -> std::string {
-            py::gil_scoped_release gil;  // Release GIL during C++ execution
-            return xlsxcsv::readSheetToCsv(xlsx_path, sheet, options);
+           const xlsxcsv::CsvOptions& options,
+           const py::object& stats) -> std::string {
+            return convertWithStats(stats, [&](xlsxcsv::ConversionStats* out) {
+                return xlsxcsv::readSheetToCsv(xlsx_path, sheet, options, out);
+            });
         },
         py::arg("xlsx_path"),
         py::arg("sheet") = -1,
         py::arg("options") = xlsxcsv::CsvOptions{},
-        "Convert a worksheet from XLSX to CSV string"
+        py::arg("stats") = py::none(),
+        "Convert a worksheet from XLSX to CSV string. Pass a dict as stats to receive "
+        "per-stage timings (ms) and counters"
+    );
+    
+    m.def("read_sheet_to_csv",
+        [](const py::object& data,
+           const std::variant<std::string, int>& sheet,
+           const xlsxcsv::CsvOptions& options,
+           const py::object& stats) -> std::string {
+            const ContiguousBytes bytes(data);
+            return convertWithStats(stats, [&](xlsxcsv::ConversionStats* out) {
+                return xlsxcsv::readSheetToCsv(bytes.span(), sheet, options, out);
+            });
+        },
+        py::kw_only(),
+        py::arg("data"),
+        py::arg("sheet") = -1,
+        py::arg("options") = xlsxcsv::CsvOptions{},
+        py::arg("stats") = py::none(),
+        "Convert a worksheet of an XLSX file held in memory, given as any contiguous buffer "
+        "(bytes, bytearray, memoryview, mmap). The buffer is read in place without copying"
+    );
+    
+    m.def("read_sheet_to_arrow",
+        [](const std::string& xlsx_path,
+           const std::variant<std::string, int>& sheet,
+           const xlsxcsv::CsvOptions& options,
+           size_t batch_size,
+           bool header) {
+            ArrowArrayStream stream;
+            {
+                py::gil_scoped_release gil;  // Release GIL during C++ execution
+                xlsxcsv::ColumnarOptions columnar;
+                columnar.batchSize = batch_size;
+                columnar.headerRow = header;
+                xlsxcsv::readSheetToArrow(xlsx_path, sheet, &stream, options, columnar);
+            }
+            return std::make_unique<ArrowSheetStream>(stream);
+        },
+        py::arg("xlsx_path"),
+        py::arg("sheet") = -1,
+        py::arg("options") = xlsxcsv::CsvOptions{},
+        py::arg("batch_size") = 65536,
+        py::arg("header") = false,
+        "Convert a worksheet to typed Arrow record batches (e.g. pyarrow.table(result))"
+    );
+    
+    m.def("iter_rows",
+        [](const std::string& xlsx_path,
+           const std::variant<std::string, int>& sheet,
+           const xlsxcsv::CsvOptions& options,
+           size_t batch_size) {
+            return std::make_unique<CsvChunkIterator>(xlsx_path, sheet, options, batch_size);
+        },
+        py::arg("xlsx_path"),
+        py::arg("sheet") = -1,
+        py::arg("options") = xlsxcsv::CsvOptions{},
+        py::arg("batch_size") = 1024 * 1024,
+        "Iterate over a worksheet's CSV in chunks of whole rows, at least batch_size bytes each "
+        "(except the last), converted on a background thread. Chunks support the buffer protocol."
+    );
+    
+    m.def("convert_to_file",
+        [](const std::string& xlsx_path,
+           const std::variant<std::string, int>& sheet,
+           const std::string& out_path,
+           const xlsxcsv::CsvOptions& options,
+           const py::object& stats) {
+            convertWithStats(stats, [&](xlsxcsv::ConversionStats* out) {
+                xlsxcsv::convertSheetToFile(xlsx_path, sheet, out_path, options, out);
+                return true;
+            });
+        },
+        py::arg("xlsx_path"),
+        py::arg("sheet"),
+        py::arg("out_path"),
+        py::arg("options") = xlsxcsv::CsvOptions{},
+        py::arg("stats") = py::none(),
+        "Convert a worksheet straight into a CSV file without building a Python string. "
+        "Pass a dict as stats to receive per-stage timings (ms) and counters"
     );
     
     // Convenience function
@@ -102,26 +425,216 @@ PYBIND11_MODULE(turboxl, m) {
     m.def("read_specific_sheet", 
         [](const std::string& xlsx_path, 
            const std::string& sheet_name,
-           const xlsxcsv::CsvOptions& options) -> std::string {
-            py::gil_scoped_release gil;  // Release GIL during C++ execution
-            return xlsxcsv::readSpecificSheet(xlsx_path, sheet_name, options);
+           const xlsxcsv::CsvOptions& options,
+           const py::object& stats) -> std::string {
+            return convertWithStats(stats, [&](xlsxcsv::ConversionStats* out) {
+                return xlsxcsv::readSpecificSheet(xlsx_path, sheet_name, options, out);
+            });
         },
         py::arg("xlsx_path"),
         py::arg("sheet_name"),
         py::arg("options") = xlsxcsv::CsvOptions{},
+        py::arg("stats") = py::none(),
         "Convert a specific worksheet to CSV by name"
     );
     
     m.def("read_multiple_sheets", 
         [](const std::string& xlsx_path, 
            const std::vector<std::string>& sheet_names,
-           const xlsxcsv::CsvOptions& options) -> std::map<std::string, std::string> {
-            py::gil_scoped_release gil;  // Release GIL during C++ execution
-            return xlsxcsv::readMultipleSheets(xlsx_path, sheet_names, options);
+           const xlsxcsv::CsvOptions& options,
+           const py::object& stats) -> std::map<std::string, std::string> {
+            return convertWithStats(stats, [&](xlsxcsv::ConversionStats* out) {
+                return xlsxcsv::readMultipleSheets(xlsx_path, sheet_names, options, out);
+            });
         },
         py::arg("xlsx_path"),
         py::arg("sheet_names"),
         py::arg("options") = xlsxcsv::CsvOptions{},
-        "Convert multiple worksheets to CSV by name"
+        py::arg("stats") = py::none(),
+        "Convert multiple worksheets to CSV by name; stats receives totals over all sheets"
+    );
+    
+    // Workbook sessions: the package, styles and shared strings are parsed once
+    // and reused by every conversion; methods release the GIL and may be
+    // called from several Python threads at once
+    py::class_<xlsxcsv::Document, std::shared_ptr<xlsxcsv::Document>>(m, "Document")
+        .def(py::init([](const std::string& xlsx_path, const xlsxcsv::CsvOptions& options) {
+                 py::gil_scoped_release gil;  // Release GIL during C++ execution
+                 return std::make_shared<xlsxcsv::Document>(xlsx_path, options);
+             }),
+             py::arg("xlsx_path"),
+             py::arg("options") = xlsxcsv::CsvOptions{},
+             "Open a workbook; options.shared_strings_mode, track_memory and memory_limit apply when opening")
+        .def_static("open_cached",
+            [](const std::string& xlsx_path, const xlsxcsv::CsvOptions& options) {
+                py::gil_scoped_release gil;  // Release GIL during C++ execution
+                // pybind11 holders can't be const; every method below is const anyway
+                return std::const_pointer_cast<xlsxcsv::Document>(
+                    xlsxcsv::Document::openCached(xlsx_path, options));
+            },
+            py::arg("xlsx_path"),
+            py::arg("options") = xlsxcsv::CsvOptions{},
+            "Open a workbook through the process-wide cache, keyed by path, size and modification time")
+        .def_static("set_cache_limit", &xlsxcsv::Document::setCacheLimit, py::arg("bytes"),
+                    "Bytes of parsed workbooks the cache may retain; 0 disables caching")
+        .def_static("clear_cache", &xlsxcsv::Document::clearCache)
+        .def_property_readonly("path", &xlsxcsv::Document::path)
+        .def("memory_usage", &xlsxcsv::Document::getMemoryUsage,
+             "Approximate bytes held by the parsed parts")
+        .def("get_sheet_list", &xlsxcsv::Document::getSheetList,
+             py::call_guard<py::gil_scoped_release>())
+        .def("get_visible_sheets", &xlsxcsv::Document::getVisibleSheets,
+             py::call_guard<py::gil_scoped_release>())
+        .def("read_sheet_to_csv",
+            [](const xlsxcsv::Document& document,
+               const std::variant<std::string, int>& sheet,
+               const xlsxcsv::CsvOptions& options,
+               const py::object& stats) -> std::string {
+                return convertWithStats(stats, [&](xlsxcsv::ConversionStats* out) {
+                    return document.readSheetToCsv(sheet, options, out);
+                });
+            },
+            py::arg("sheet") = -1,
+            py::arg("options") = xlsxcsv::CsvOptions{},
+            py::arg("stats") = py::none())
+        .def("convert_to_file",
+            [](const xlsxcsv::Document& document,
+               const std::variant<std::string, int>& sheet,
+               const std::string& out_path,
+               const xlsxcsv::CsvOptions& options,
+               const py::object& stats) {
+                convertWithStats(stats, [&](xlsxcsv::ConversionStats* out) {
+                    document.convertSheetToFile(sheet, out_path, options, out);
+                    return true;
+                });
+            },
+            py::arg("sheet"),
+            py::arg("out_path"),
+            py::arg("options") = xlsxcsv::CsvOptions{},
+            py::arg("stats") = py::none())
+        .def("read_multiple_sheets",
+            [](const xlsxcsv::Document& document,
+               const std::vector<std::string>& sheet_names,
+               const xlsxcsv::CsvOptions& options,
+               const py::object& stats) -> std::map<std::string, std::string> {
+                return convertWithStats(stats, [&](xlsxcsv::ConversionStats* out) {
+                    return document.readMultipleSheets(sheet_names, options, out);
+                });
+            },
+            py::arg("sheet_names"),
+            py::arg("options") = xlsxcsv::CsvOptions{},
+            py::arg("stats") = py::none())
+        .def("read_sheet_to_arrow",
+            [](const xlsxcsv::Document& document,
+               const std::variant<std::string, int>& sheet,
+               const xlsxcsv::CsvOptions& options,
+               size_t batch_size,
+               bool header) {
+                ArrowArrayStream stream;
+                {
+                    py::gil_scoped_release gil;  // Release GIL during C++ execution
+                    xlsxcsv::ColumnarOptions columnar;
+                    columnar.batchSize = batch_size;
+                    columnar.headerRow = header;
+                    document.readSheetToArrow(sheet, &stream, options, columnar);
+                }
+                return std::make_unique<ArrowSheetStream>(stream);
+            },
+            py::arg("sheet") = -1,
+            py::arg("options") = xlsxcsv::CsvOptions{},
+            py::arg("batch_size") = 65536,
+            py::arg("header") = false);
+    
+    // Batch conversion on a shared, memory-budgeted worker pool
+    py::class_<xlsxcsv::FileConversionJob>(m, "FileConversionJob")
+        .def(py::init([](const std::string& xlsx_path,
+                         const std::variant<std::string, int>& sheet,
+                         const std::string& output_path) {
+                 return xlsxcsv::FileConversionJob{xlsx_path, sheet, output_path};
+             }),
+             py::arg("xlsx_path"),
+             py::arg("sheet") = -1,
+             py::arg("output_path") = "")
+        .def_readwrite("xlsx_path", &xlsxcsv::FileConversionJob::xlsxPath)
+        .def_readwrite("sheet", &xlsxcsv::FileConversionJob::sheet)
+        .def_readwrite("output_path", &xlsxcsv::FileConversionJob::outputPath);
+    py::implicitly_convertible<std::string, xlsxcsv::FileConversionJob>();
+    
+    py::class_<xlsxcsv::FileConversionResult>(m, "FileConversionResult")
+        .def_readonly("index", &xlsxcsv::FileConversionResult::index)
+        .def_readonly("xlsx_path", &xlsxcsv::FileConversionResult::xlsxPath)
+        .def_readonly("ok", &xlsxcsv::FileConversionResult::ok)
+        .def_readonly("error", &xlsxcsv::FileConversionResult::error)
+        .def_readonly("csv", &xlsxcsv::FileConversionResult::csv)
+        .def_readonly("estimated_memory", &xlsxcsv::FileConversionResult::estimatedMemory)
+        .def_property_readonly("stats", [](const xlsxcsv::FileConversionResult& result) {
+            py::dict dict;
+            fillStatsDict(result.stats, dict);
+            return dict;
+        })
+        .def("__repr__", [](const xlsxcsv::FileConversionResult& r) {
+            return "FileConversionResult(index=" + std::to_string(r.index) + ", xlsx_path='" + r.xlsxPath +
+                   "', ok=" + (r.ok ? "True" : "False") + ")";
+        });
+    
+    py::class_<xlsxcsv::ConversionScheduler>(m, "ConversionScheduler")
+        .def(py::init<unsigned, uint64_t>(),
+             py::arg("threads") = 0,
+             py::arg("memory_budget") = 0,
+             "Worker pool shared by convert_files batches (threads=0: one per core, memory_budget=0: unlimited)")
+        .def_static("shared", &xlsxcsv::ConversionScheduler::shared, py::return_value_policy::reference,
+                    "The process-wide scheduler convert_files uses by default")
+        .def_property_readonly("thread_count", &xlsxcsv::ConversionScheduler::threadCount)
+        .def_property("memory_budget",
+                      &xlsxcsv::ConversionScheduler::getMemoryBudget,
+                      &xlsxcsv::ConversionScheduler::setMemoryBudget)
+        .def_property_readonly("reserved_memory", &xlsxcsv::ConversionScheduler::getReservedMemory)
+        .def_property_readonly("peak_reserved_memory", &xlsxcsv::ConversionScheduler::getPeakReservedMemory);
+    
+    m.def("install_memory_hooks", &xlsxcsv::installMemoryHooks,
+          "Charge libxml2's allocations to track_memory/memory_limit trackers; "
+          "call once before any conversion starts");
+    
+    m.def("estimate_conversion_memory",
+          py::overload_cast<const xlsxcsv::FileConversionJob&, const xlsxcsv::CsvOptions&>(
+              &xlsxcsv::estimateConversionMemory),
+          py::arg("job"),
+          py::arg("options") = xlsxcsv::CsvOptions{},
+          py::call_guard<py::gil_scoped_release>(),
+          "Estimated peak bytes of a convert_files job (a path selects the first sheet, returned as a string), "
+          "read from its ZIP central directory");
+    
+    m.def("convert_files",
+        [](const std::vector<xlsxcsv::FileConversionJob>& jobs,
+           const xlsxcsv::CsvOptions& options,
+           const py::object& on_result,
+           xlsxcsv::ConversionScheduler* scheduler,
+           bool fail_fast) -> py::object {
+            const xlsxcsv::BatchOptions batch{scheduler, fail_fast};
+            if (on_result.is_none()) {
+                std::vector<xlsxcsv::FileConversionResult> results;
+                {
+                    py::gil_scoped_release gil;  // Release GIL during C++ execution
+                    results = xlsxcsv::convertFiles(jobs, options, batch);
+                }
+                return py::cast(std::move(results));
+            }
+            {
+                py::gil_scoped_release gil;  // Release GIL during C++ execution
+                xlsxcsv::convertFiles(jobs, [&](xlsxcsv::FileConversionResult& result) {
+                    py::gil_scoped_acquire acquire;
+                    on_result(std::move(result));
+                }, options, batch);
+            }
+            return py::none();
+        },
+        py::arg("jobs"),
+        py::arg("options") = xlsxcsv::CsvOptions{},
+        py::arg("on_result") = py::none(),
+        py::arg("scheduler") = nullptr,
+        py::arg("fail_fast") = false,
+        "Convert many workbooks on a shared worker pool. Jobs are FileConversionJob or paths. "
+        "Without on_result, returns the results in job order; otherwise calls on_result(result) "
+        "as each job completes and returns None. Failed conversions are reported in their result"
     );
 }
@@ -1,6 +1,63 @@
 #include <gtest/gtest.h>
+#include "xlsxcsv.hpp"
+#include "xlsxcsv/core.hpp"
 
-TEST(CsvEncoderTest, BasicFunctionality) {
-    // TODO: Implement actual tests in Phase 6
-    EXPECT_TRUE(true); // Placeholder test
+using xlsxcsv::core::CsvEncoder;
+
+namespace {
+
+std::string encodeField(const CsvEncoder& encoder, std::string_view field) {
+    std::string out;
+    encoder.appendField(out, field);
+    return out;
+}
+
+} // namespace
+
+TEST(CsvEncoderTest, PlainFieldsAreCopied) {
+    CsvEncoder encoder;
+    EXPECT_EQ(encodeField(encoder, ""), "");
+    EXPECT_EQ(encodeField(encoder, "hello"), "hello");
+    EXPECT_EQ(encodeField(encoder, "naïve café 日本"), "naïve café 日本");
+    EXPECT_FALSE(encoder.needsQuoting("a field well past sixteen bytes without specials"));
+}
+
+TEST(CsvEncoderTest, SpecialCharactersForceQuoting) {
+    CsvEncoder encoder;
+    EXPECT_EQ(encodeField(encoder, "a,b"), "\"a,b\"");
+    EXPECT_EQ(encodeField(encoder, "line\nbreak"), "\"line\nbreak\"");
+    EXPECT_EQ(encodeField(encoder, "cr\r"), "\"cr\r\"");
+    EXPECT_EQ(encodeField(encoder, "say \"hi\""), "\"say \"\"hi\"\"\"");
+    EXPECT_EQ(encodeField(encoder, "\"\""), "\"\"\"\"\"\"");
+
+    // Specials at every offset of the vector block and the scalar tail
+    const std::string padding(40, 'x');
+    for (size_t offset = 0; offset <= padding.size(); ++offset) {
+        std::string field = padding;
+        field.insert(offset, "\"");
+        std::string expected = padding;
+        expected.insert(offset, "\"\"");
+        EXPECT_EQ(encodeField(encoder, field), "\"" + expected + "\"") << "offset " << offset;
+    }
+}
+
+TEST(CsvEncoderTest, HonoursOptions) {
+    xlsxcsv::CsvOptions options;
+    options.delimiter = ';';
+    options.quoteAll = true;
+    options.newline = xlsxcsv::CsvOptions::Newline::CRLF;
+    options.includeBom = true;
+    CsvEncoder encoder(&options);
+
+    EXPECT_FALSE(encoder.needsQuoting("a,b"));
+    EXPECT_TRUE(encoder.needsQuoting("a;b"));
+    EXPECT_EQ(encoder.encode({{"a,b", "c;d", ""}, {"1"}}),
+              "\xEF\xBB\xBF\"a,b\";\"c;d\";\"\"\r\n\"1\"\r\n");
+}
+
+TEST(CsvEncoderTest, EncodesRows) {
+    CsvEncoder encoder;
+    EXPECT_EQ(encoder.encode({}), "");
+    EXPECT_EQ(encoder.encode({{"Name", "Note"}, {"Bob", "said \"no\""}, {}}),
+              "Name,Note\nBob,\"said \"\"no\"\"\"\n\n");
 }
@@ -1,6 +1,1391 @@
 #include <gtest/gtest.h>
+#include "xlsxcsv.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <zlib.h>
+#ifdef TURBOXL_HAVE_ZSTD
+#  include <zstd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Inflates a gzip stream, failing the test on a corrupt or truncated one
+std::string gunzip(const std::string& compressed) {
+    z_stream stream{};
+    EXPECT_EQ(inflateInit2(&stream, MAX_WBITS + 16), Z_OK);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    std::string out;
+    char buffer[64 * 1024];
+    int result = Z_OK;
+    while (result == Z_OK) {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+        result = inflate(&stream, Z_NO_FLUSH);
+        out.append(buffer, sizeof(buffer) - stream.avail_out);
+    }
+    EXPECT_EQ(result, Z_STREAM_END);
+    EXPECT_EQ(stream.avail_in, 0u);
+    inflateEnd(&stream);
+    return out;
+}
+
+#ifdef TURBOXL_HAVE_ZSTD
+// Streamed frames don't record their content size, so the caller bounds it
+std::string unzstd(const std::string& compressed, size_t maxSize) {
+    std::string out(maxSize + 1, '\0');
+    const size_t size = ZSTD_decompress(out.data(), out.size(), compressed.data(), compressed.size());
+    EXPECT_FALSE(ZSTD_isError(size)) << ZSTD_getErrorName(size);
+    out.resize(ZSTD_isError(size) ? 0 : size);
+    return out;
+}
+#endif
+
+} // namespace
 
 TEST(IntegrationTest, EndToEndConversion) {
     // TODO: Implement actual integration tests in Phase 6+
     EXPECT_TRUE(true); // Placeholder test
 }
+
+class SinkConversionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "turboxl_sink_conversion_test";
+        fs::create_directories(testDir / "content" / "_rels");
+        fs::create_directories(testDir / "content" / "xl" / "_rels");
+        fs::create_directories(testDir / "content" / "xl" / "worksheets");
+
+        auto root = testDir / "content";
+        std::ofstream(root / "[Content_Types].xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">
+    <Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>
+    <Default Extension="xml" ContentType="application/xml"/>
+    <Override PartName="/xl/workbook.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml"/>
+    <Override PartName="/xl/worksheets/sheet1.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml"/>
+</Types>)";
+        std::ofstream(root / "_rels" / ".rels") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+    <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument" Target="xl/workbook.xml"/>
+</Relationships>)";
+        std::ofstream(root / "xl" / "workbook.xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<workbook xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" xmlns:r="http://schemas.openxmlformats.org/officeDocument/2006/relationships">
+    <sheets>
+        <sheet name="Data" sheetId="1" r:id="rId1"/>
+    </sheets>
+</workbook>)";
+        std::ofstream(root / "xl" / "_rels" / "workbook.xml.rels") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+    <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet" Target="worksheets/sheet1.xml"/>
+</Relationships>)";
+
+        // Enough rows that the collector hands the sink several blocks
+        std::ofstream sheet(root / "xl" / "worksheets" / "sheet1.xml");
+        sheet << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<worksheet xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main"><sheetData>)";
+        for (int r = 1; r <= rowCount; ++r) {
+            sheet << "<row r=\"" << r << "\"><c r=\"A" << r << "\"><v>" << r
+                  << "</v></c><c r=\"B" << r << "\" t=\"inlineStr\"><is><t>value, " << r
+                  << "</t></is></c></row>";
+        }
+        sheet << "</sheetData></worksheet>";
+        sheet.close();
+
+        std::string cmd = "cd \"" + root.string() + "\" && zip -q -r ../book.xlsx . > /dev/null 2>&1";
+        std::system(cmd.c_str());
+        xlsxPath = (testDir / "book.xlsx").string();
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    static constexpr int rowCount = 15000;
+    fs::path testDir;
+    std::string xlsxPath;
+};
+
+TEST_F(SinkConversionTest, SinkOutputMatchesStringOutput) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::CsvOptions options;
+    options.includeBom = true;
+    options.newline = xlsxcsv::CsvOptions::Newline::CRLF;
+    const std::string expected = xlsxcsv::readSheetToCsv(xlsxPath, "Data", options);
+    EXPECT_EQ(expected.rfind("\xEF\xBB\xBF" "1,\"value, 1\"\r\n2,", 0), 0u);
+
+    size_t blocks = 0;
+    std::string streamed;
+    xlsxcsv::CallbackOutputSink sink([&](const char* data, size_t size) {
+        ++blocks;
+        streamed.append(data, size);
+    });
+    xlsxcsv::convertSheet(xlsxPath, "Data", sink, options);
+
+    EXPECT_EQ(streamed, expected);
+    EXPECT_GT(blocks, 1u);
+
+    std::ostringstream stream;
+    xlsxcsv::StreamOutputSink streamSink(stream);
+    xlsxcsv::convertSheet(xlsxPath, 0, streamSink, options);
+    EXPECT_EQ(stream.str(), expected);
+}
+
+TEST_F(SinkConversionTest, InMemoryAndMappedInputsMatchPath) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    const std::string expected = xlsxcsv::readSheetToCsv(xlsxPath, "Data");
+    std::ifstream file(xlsxPath, std::ios::binary);
+    const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const std::span<const std::byte> data(reinterpret_cast<const std::byte*>(bytes.data()), bytes.size());
+
+    xlsxcsv::ConversionStats stats;
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(data, "Data", {}, &stats), expected);
+    EXPECT_GT(stats.rows, 0u);
+
+    std::ostringstream stream;
+    xlsxcsv::StreamOutputSink sink(stream);
+    xlsxcsv::convertSheet(data, 0, sink);
+    EXPECT_EQ(stream.str(), expected);
+
+    xlsxcsv::CsvOptions mapped;
+    mapped.memoryMap = true;
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, "Data", mapped), expected);
+
+    const std::string garbage = "PK not really a workbook";
+    EXPECT_THROW(xlsxcsv::readSheetToCsv(std::as_bytes(std::span(garbage)), 0), std::runtime_error);
+}
+
+TEST_F(SinkConversionTest, ConvertSheetToFile) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    const fs::path outPath = testDir / "out.csv";
+    xlsxcsv::convertSheetToFile(xlsxPath, -1, outPath.string());
+
+    std::ifstream in(outPath, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    EXPECT_EQ(contents.str(), xlsxcsv::readSheetToCsv(xlsxPath));
+
+    EXPECT_THROW(xlsxcsv::convertSheetToFile(xlsxPath, "Missing", outPath.string()), std::runtime_error);
+    EXPECT_THROW(xlsxcsv::convertSheetToFile(xlsxPath, -1, (testDir / "no_dir" / "out.csv").string()),
+                 std::runtime_error);
+}
+
+TEST_F(SinkConversionTest, FailedFileConversionLeavesNoPartialOutput) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    // A memory limit hit mid-sheet fails after some CSV has been written
+    xlsxcsv::CsvOptions limited;
+    limited.memoryLimit = 64 * 1024;
+    const fs::path outPath = testDir / "limited.csv";
+    EXPECT_THROW(xlsxcsv::convertSheetToFile(xlsxPath, "Data", outPath.string(), limited), std::runtime_error);
+    EXPECT_FALSE(fs::exists(outPath));
+
+    // An earlier good file survives a failed overwrite
+    xlsxcsv::convertSheetToFile(xlsxPath, "Data", outPath.string());
+    const auto goodSize = fs::file_size(outPath);
+    EXPECT_THROW(xlsxcsv::convertSheetToFile(xlsxPath, "Data", outPath.string(), limited), std::runtime_error);
+    EXPECT_EQ(fs::file_size(outPath), goodSize);
+
+    xlsxcsv::Document document(xlsxPath);
+    EXPECT_THROW(document.convertSheetToFile("Missing", outPath.string()), std::runtime_error);
+    EXPECT_EQ(fs::file_size(outPath), goodSize);
+
+    for (const auto& entry : fs::directory_iterator(testDir)) {
+        EXPECT_EQ(entry.path().filename().string().find(".partial"), std::string::npos) << entry.path();
+    }
+}
+
+TEST_F(SinkConversionTest, QuoteAllWithCrlfAndBom) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::CsvOptions options;
+    options.quoteAll = true;
+    options.newline = xlsxcsv::CsvOptions::Newline::CRLF;
+    options.includeBom = true;
+    options.rowLimit = 2;
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, "Data", options),
+              "\xEF\xBB\xBF\"1\",\"value, 1\"\r\n\"2\",\"value, 2\"\r\n");
+}
+
+TEST_F(SinkConversionTest, GzipOutputRoundTrips) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    const std::string expected = xlsxcsv::readSheetToCsv(xlsxPath, "Data");
+    ASSERT_GT(expected.size(), 2 * 128 * 1024u); // Several blocks for the threaded path
+
+    xlsxcsv::CsvOptions options;
+    options.outputCompression = xlsxcsv::CsvOptions::OutputCompression::GZIP;
+    for (unsigned threads : {1u, 3u}) {
+        options.compressionThreads = threads;
+        std::string compressed;
+        xlsxcsv::StringOutputSink sink(compressed);
+        xlsxcsv::ConversionStats stats;
+        xlsxcsv::convertSheet(xlsxPath, "Data", sink, options, &stats);
+        EXPECT_EQ(gunzip(compressed), expected) << threads << " thread(s)";
+        EXPECT_EQ(stats.outputBytes, expected.size());
+        EXPECT_EQ(stats.compressedBytes, compressed.size());
+        EXPECT_LT(compressed.size(), expected.size() / 2);
+    }
+
+    const fs::path outPath = testDir / "out.csv.gz";
+    xlsxcsv::convertSheetToFile(xlsxPath, "Data", outPath.string(), options);
+    std::ifstream in(outPath, std::ios::binary);
+    const std::string file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(gunzip(file), expected);
+
+    // The string APIs have nowhere to put compressed bytes
+    EXPECT_THROW(xlsxcsv::readSheetToCsv(xlsxPath, "Data", options), std::runtime_error);
+    EXPECT_THROW(xlsxcsv::readMultipleSheets(xlsxPath, {"Data"}, options), std::runtime_error);
+}
+
+TEST_F(SinkConversionTest, ZstdOutputRoundTrips) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+    if (!xlsxcsv::CompressedOutputSink::supports(xlsxcsv::CsvOptions::OutputCompression::ZSTD)) {
+        GTEST_SKIP() << "Built without zstd";
+    }
+#ifdef TURBOXL_HAVE_ZSTD
+    const std::string expected = xlsxcsv::readSheetToCsv(xlsxPath, "Data");
+
+    xlsxcsv::CsvOptions options;
+    options.outputCompression = xlsxcsv::CsvOptions::OutputCompression::ZSTD;
+    for (unsigned threads : {1u, 3u}) {
+        options.compressionThreads = threads;
+        std::string compressed;
+        xlsxcsv::StringOutputSink sink(compressed);
+        xlsxcsv::ConversionStats stats;
+        xlsxcsv::convertSheet(xlsxPath, "Data", sink, options, &stats);
+        EXPECT_EQ(unzstd(compressed, expected.size()), expected) << threads << " thread(s)";
+        EXPECT_EQ(stats.outputBytes, expected.size());
+        EXPECT_EQ(stats.compressedBytes, compressed.size());
+        EXPECT_LT(compressed.size(), expected.size() / 2);
+    }
+
+    const fs::path outPath = testDir / "out.csv.zst";
+    xlsxcsv::convertSheetToFile(xlsxPath, "Data", outPath.string(), options);
+    std::ifstream in(outPath, std::ios::binary);
+    const std::string file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(unzstd(file, expected.size()), expected);
+#endif
+}
+
+TEST(CompressedOutputSinkTest, FlushFinishAndCodecChecks) {
+    using Compression = xlsxcsv::CsvOptions::OutputCompression;
+    std::string input;
+    for (int i = 0; i < 60000; ++i) {
+        input += std::to_string(i * 7919 % 100003) + ",row " + std::to_string(i) + "\n";
+    }
+
+    for (unsigned threads : {1u, 4u}) {
+        std::string compressed;
+        xlsxcsv::StringOutputSink target(compressed);
+        xlsxcsv::CompressedOutputSink sink(target, Compression::GZIP, 9, threads);
+        const size_t half = input.size() / 2;
+        sink.write(input.data(), half);
+        sink.flush();
+        EXPECT_GT(compressed.size(), 0u);
+        sink.write(input.data() + half, input.size() - half);
+        sink.finish();
+        sink.finish();
+        EXPECT_EQ(sink.compressedBytes(), compressed.size());
+        EXPECT_EQ(gunzip(compressed), input) << threads << " thread(s)";
+        EXPECT_THROW(sink.write("x", 1), std::runtime_error);
+    }
+
+    std::string empty;
+    xlsxcsv::StringOutputSink emptyTarget(empty);
+    xlsxcsv::CompressedOutputSink emptySink(emptyTarget, Compression::GZIP, -1, 2);
+    emptySink.finish();
+    EXPECT_EQ(gunzip(empty), "");
+
+    std::string plain;
+    xlsxcsv::StringOutputSink plainTarget(plain);
+    xlsxcsv::CompressedOutputSink passThrough(plainTarget, Compression::NONE);
+    passThrough.write("a,b\n", 4);
+    passThrough.finish();
+    EXPECT_EQ(plain, "a,b\n");
+
+    EXPECT_THROW(xlsxcsv::CompressedOutputSink(plainTarget, Compression::GZIP, 10), std::invalid_argument);
+    EXPECT_TRUE(xlsxcsv::CompressedOutputSink::supports(Compression::GZIP));
+    if (!xlsxcsv::CompressedOutputSink::supports(Compression::ZSTD)) {
+        EXPECT_THROW(xlsxcsv::CompressedOutputSink(plainTarget, Compression::ZSTD), std::invalid_argument);
+    }
+}
+
+class ParallelMultiSheetTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "turboxl_parallel_multi_sheet_test";
+        fs::create_directories(testDir / "content" / "_rels");
+        fs::create_directories(testDir / "content" / "xl" / "_rels");
+        fs::create_directories(testDir / "content" / "xl" / "worksheets");
+
+        auto root = testDir / "content";
+        std::ofstream(root / "[Content_Types].xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">
+    <Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>
+    <Default Extension="xml" ContentType="application/xml"/>
+</Types>)";
+        std::ofstream(root / "_rels" / ".rels") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+    <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument" Target="xl/workbook.xml"/>
+</Relationships>)";
+
+        std::ofstream workbook(root / "xl" / "workbook.xml");
+        std::ofstream rels(root / "xl" / "_rels" / "workbook.xml.rels");
+        workbook << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<workbook xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" xmlns:r="http://schemas.openxmlformats.org/officeDocument/2006/relationships"><sheets>)";
+        rels << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">)";
+        for (int s = 1; s <= sheetCount; ++s) {
+            const std::string name = "Sheet" + std::to_string(s);
+            sheetNames.push_back(name);
+            workbook << "<sheet name=\"" << name << "\" sheetId=\"" << s << "\" r:id=\"rId" << s << "\"/>";
+            rels << "<Relationship Id=\"rId" << s
+                 << "\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet\""
+                 << " Target=\"worksheets/sheet" << s << ".xml\"/>";
+
+            // Every sheet references the shared string table so workers read it concurrently
+            std::ofstream sheet(root / "xl" / "worksheets" / ("sheet" + std::to_string(s) + ".xml"));
+            sheet << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<worksheet xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main"><sheetData>)";
+            for (int r = 1; r <= 500 * s; ++r) {
+                sheet << "<row r=\"" << r << "\"><c r=\"A" << r << "\"><v>" << (r * s)
+                      << "</v></c><c r=\"B" << r << "\" t=\"s\"><v>" << ((r + s) % stringCount)
+                      << "</v></c></row>";
+            }
+            sheet << "</sheetData></worksheet>";
+        }
+        workbook << "</sheets></workbook>";
+        rels << "</Relationships>";
+        workbook.close();
+        rels.close();
+
+        std::ofstream shared(root / "xl" / "sharedStrings.xml");
+        shared << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<sst xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main">)";
+        for (int i = 0; i < stringCount; ++i) {
+            shared << "<si><t>shared " << i << "</t></si>";
+        }
+        shared << "</sst>";
+        shared.close();
+
+        std::string cmd = "cd \"" + root.string() + "\" && zip -q -r ../book.xlsx . > /dev/null 2>&1";
+        std::system(cmd.c_str());
+        xlsxPath = (testDir / "book.xlsx").string();
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    static constexpr int sheetCount = 6;
+    static constexpr int stringCount = 37;
+    fs::path testDir;
+    std::string xlsxPath;
+    std::vector<std::string> sheetNames;
+};
+
+TEST_F(ParallelMultiSheetTest, ParallelMatchesSequential) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    for (auto mode : {xlsxcsv::CsvOptions::SharedStringsMode::IN_MEMORY,
+                      xlsxcsv::CsvOptions::SharedStringsMode::EXTERNAL,
+                      xlsxcsv::CsvOptions::SharedStringsMode::LAZY}) {
+        xlsxcsv::CsvOptions options;
+        options.sharedStringsMode = mode;
+        const auto sequential = xlsxcsv::readMultipleSheets(xlsxPath, sheetNames, options);
+        ASSERT_EQ(sequential.size(), static_cast<size_t>(sheetCount));
+        EXPECT_EQ(sequential.at("Sheet2").rfind("2,shared 3\n4,shared 4\n", 0), 0u);
+
+        options.maxThreads = 4;
+        const auto parallel = xlsxcsv::readMultipleSheets(xlsxPath, sheetNames, options);
+        EXPECT_EQ(parallel, sequential);
+
+        options.maxThreads = 0; // All cores
+        EXPECT_EQ(xlsxcsv::readMultipleSheets(xlsxPath, sheetNames, options), sequential);
+    }
+}
+
+TEST_F(ParallelMultiSheetTest, SheetParseThreadsMatchSerial) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::CsvOptions serial;
+    xlsxcsv::CsvOptions parallel;
+    parallel.sheetParseThreads = 4;
+    for (const auto& name : sheetNames) {
+        EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, name, parallel),
+                  xlsxcsv::readSheetToCsv(xlsxPath, name, serial)) << name;
+    }
+}
+
+TEST_F(ParallelMultiSheetTest, PipelinedInflateMatchesSerial) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::CsvOptions pipelined;
+    pipelined.pipelinedInflate = true;
+    for (const auto& name : sheetNames) {
+        EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, name, pipelined),
+                  xlsxcsv::readSheetToCsv(xlsxPath, name)) << name;
+    }
+
+    // Stopping at a row limit abandons the entry while it is still inflating
+    pipelined.rowLimit = 3;
+    xlsxcsv::CsvOptions limited;
+    limited.rowLimit = 3;
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, sheetNames[0], pipelined),
+              xlsxcsv::readSheetToCsv(xlsxPath, sheetNames[0], limited));
+}
+
+TEST_F(ParallelMultiSheetTest, ChunkReaderYieldsWholeRows) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    const std::string expected = xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6");
+    // Sink blocks are far larger than this, so every block completes a chunk
+    xlsxcsv::CsvChunkReader reader(xlsxPath, "Sheet6", {}, 1, 1);
+    std::string joined;
+    std::string chunk;
+    int chunks = 0;
+    while (reader.next(chunk)) {
+        ASSERT_FALSE(chunk.empty());
+        EXPECT_EQ(chunk.back(), '\n');
+        joined += chunk;
+        ++chunks;
+    }
+    EXPECT_GE(chunks, 1);
+    EXPECT_EQ(joined, expected);
+    EXPECT_FALSE(reader.next(chunk));
+}
+
+TEST_F(ParallelMultiSheetTest, ChunkReaderReportsErrorsAndStopsEarly) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::CsvChunkReader missing(xlsxPath, "Missing");
+    std::string chunk;
+    EXPECT_THROW(missing.next(chunk), std::runtime_error);
+
+    // Destroying a reader whose queue is full stops the conversion thread
+    for (const auto& name : sheetNames) {
+        xlsxcsv::CsvChunkReader reader(xlsxPath, name, {}, 1, 1);
+    }
+    xlsxcsv::CsvChunkReader reader(xlsxPath, "Sheet6", {}, 1, 1);
+    ASSERT_TRUE(reader.next(chunk));
+    EXPECT_EQ(chunk.rfind("6,shared 7\n", 0), 0u);
+}
+
+TEST_F(ParallelMultiSheetTest, ParallelReportsMissingSheet) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::CsvOptions options;
+    options.maxThreads = 4;
+    auto names = sheetNames;
+    names.push_back("Missing");
+    EXPECT_THROW(xlsxcsv::readMultipleSheets(xlsxPath, names, options), std::runtime_error);
+}
+
+TEST_F(ParallelMultiSheetTest, StatsReportStagesAndCounters) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::ConversionStats stats;
+    const std::string csv = xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2", {}, &stats);
+    EXPECT_EQ(stats.sheets, 1u);
+    EXPECT_EQ(stats.rows, 1000u);
+    EXPECT_EQ(stats.cells, 2000u);
+    EXPECT_EQ(stats.numberCells, 1000u);
+    EXPECT_EQ(stats.sharedStringCells, 1000u);
+    EXPECT_EQ(stats.sharedStringLookups, 1000u);
+    EXPECT_EQ(stats.sharedStringCount, static_cast<uint64_t>(stringCount));
+    EXPECT_GT(stats.sharedStringsMemoryBytes, 0u);
+    EXPECT_EQ(stats.spillReads, 0u);
+    EXPECT_EQ(stats.outputBytes, csv.size());
+    EXPECT_GT(stats.worksheetCompressedBytes, 0u);
+    EXPECT_GT(stats.worksheetUncompressedBytes, stats.worksheetCompressedBytes);
+    EXPECT_GT(stats.sharedStringsUncompressedBytes, 0u);
+    EXPECT_GE(stats.totalMs, stats.parseSheetMs + stats.sharedStringsMs);
+
+    // The sink path and parallel row parsing report the same counters
+    xlsxcsv::CsvOptions options;
+    options.sharedStringsMode = xlsxcsv::CsvOptions::SharedStringsMode::EXTERNAL;
+    options.sheetParseThreads = 4;
+    std::string streamed;
+    xlsxcsv::StringOutputSink sink(streamed);
+    xlsxcsv::ConversionStats sinkStats;
+    xlsxcsv::convertSheet(xlsxPath, "Sheet2", sink, options, &sinkStats);
+    EXPECT_EQ(streamed, csv);
+    EXPECT_EQ(sinkStats.rows, stats.rows);
+    EXPECT_EQ(sinkStats.cells, stats.cells);
+    EXPECT_EQ(sinkStats.outputBytes, stats.outputBytes);
+    EXPECT_EQ(sinkStats.spillReads, 1000u);
+
+    // A Document's provider outlives each conversion; every one reports its own reads
+    xlsxcsv::Document document(xlsxPath, options);
+    for (int pass = 0; pass < 2; ++pass) {
+        xlsxcsv::ConversionStats documentStats;
+        document.readSheetToCsv("Sheet2", options, &documentStats);
+        EXPECT_EQ(documentStats.spillReads, 1000u);
+    }
+}
+
+TEST_F(ParallelMultiSheetTest, StatsSumOverMultipleSheets) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::ConversionStats serial;
+    const auto results = xlsxcsv::readMultipleSheets(xlsxPath, sheetNames, {}, &serial);
+    uint64_t bytes = 0;
+    for (const auto& [name, csv] : results) {
+        bytes += csv.size();
+    }
+    EXPECT_EQ(serial.sheets, static_cast<size_t>(sheetCount));
+    EXPECT_EQ(serial.rows, 500u * (1 + 2 + 3 + 4 + 5 + 6));
+    EXPECT_EQ(serial.cells, 2 * serial.rows);
+    EXPECT_EQ(serial.outputBytes, bytes);
+
+    xlsxcsv::CsvOptions options;
+    options.maxThreads = 4;
+    xlsxcsv::ConversionStats parallel;
+    xlsxcsv::readMultipleSheets(xlsxPath, sheetNames, options, &parallel);
+    EXPECT_EQ(parallel.rows, serial.rows);
+    EXPECT_EQ(parallel.sharedStringLookups, serial.sharedStringLookups);
+    EXPECT_EQ(parallel.worksheetUncompressedBytes, serial.worksheetUncompressedBytes);
+
+    // A failed conversion still reports the stages it completed
+    xlsxcsv::ConversionStats failed;
+    EXPECT_THROW(xlsxcsv::readSheetToCsv(xlsxPath, "Missing", {}, &failed), std::runtime_error);
+    EXPECT_EQ(failed.rows, 0u);
+    EXPECT_GT(failed.totalMs, 0.0);
+    EXPECT_GE(failed.totalMs, failed.openMs + failed.sharedStringsMs);
+}
+
+TEST_F(ParallelMultiSheetTest, DocumentMatchesFreeFunctions) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    const xlsxcsv::Document document(xlsxPath);
+    EXPECT_EQ(document.getSheetList().size(), static_cast<size_t>(sheetCount));
+    EXPECT_GT(document.getMemoryUsage(), 0u);
+
+    // Sheets converted concurrently from one document share its parsed parts
+    std::vector<std::string> fromDocument(sheetNames.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < sheetNames.size(); ++i) {
+        threads.emplace_back([&, i]() { fromDocument[i] = document.readSheetToCsv(sheetNames[i]); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < sheetNames.size(); ++i) {
+        EXPECT_EQ(fromDocument[i], xlsxcsv::readSheetToCsv(xlsxPath, sheetNames[i])) << sheetNames[i];
+    }
+
+    xlsxcsv::CsvOptions options;
+    options.maxThreads = 3;
+    xlsxcsv::ConversionStats stats;
+    EXPECT_EQ(document.readMultipleSheets(sheetNames, options, &stats),
+              xlsxcsv::readMultipleSheets(xlsxPath, sheetNames));
+    EXPECT_EQ(stats.openMs, 0.0);
+    EXPECT_EQ(stats.sheets, static_cast<size_t>(sheetCount));
+
+    EXPECT_THROW(document.readSheetToCsv("Missing"), std::runtime_error);
+    EXPECT_THROW(xlsxcsv::Document((testDir / "missing.xlsx").string()), std::runtime_error);
+}
+
+TEST_F(ParallelMultiSheetTest, OpenCachedReusesUntilFileChanges) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::Document::clearCache();
+    const auto first = xlsxcsv::Document::openCached(xlsxPath);
+    EXPECT_EQ(xlsxcsv::Document::openCached(xlsxPath), first);
+
+    // A different shared strings mode is a different document
+    xlsxcsv::CsvOptions lazy;
+    lazy.sharedStringsMode = xlsxcsv::CsvOptions::SharedStringsMode::LAZY;
+    EXPECT_NE(xlsxcsv::Document::openCached(xlsxPath, lazy), first);
+
+    // So is one opened with memory tracking or a different limit
+    xlsxcsv::CsvOptions tracked;
+    tracked.trackMemory = true;
+    const auto trackedDocument = xlsxcsv::Document::openCached(xlsxPath, tracked);
+    EXPECT_NE(trackedDocument, first);
+    tracked.memoryLimit = 1ULL << 30;
+    EXPECT_NE(xlsxcsv::Document::openCached(xlsxPath, tracked), trackedDocument);
+
+    // Touching the file invalidates its entry
+    fs::last_write_time(xlsxPath, fs::last_write_time(xlsxPath) + std::chrono::seconds(5));
+    const auto touched = xlsxcsv::Document::openCached(xlsxPath);
+    EXPECT_NE(touched, first);
+    EXPECT_EQ(touched->readSheetToCsv(0), first->readSheetToCsv(0));
+
+    xlsxcsv::Document::clearCache();
+    EXPECT_NE(xlsxcsv::Document::openCached(xlsxPath), touched);
+
+    // Documents over the limit are handed out but not retained
+    xlsxcsv::Document::setCacheLimit(1);
+    EXPECT_NE(xlsxcsv::Document::openCached(xlsxPath), xlsxcsv::Document::openCached(xlsxPath));
+
+    // Lazy documents are re-measured as conversions decode their strings
+    xlsxcsv::Document::setCacheLimit(512 * 1024 * 1024);
+    const auto lazyDocument = xlsxcsv::Document::openCached(xlsxPath, lazy);
+    const size_t openedBytes = lazyDocument->getMemoryUsage();
+    xlsxcsv::Document::setCacheLimit(openedBytes + 1024);
+    EXPECT_EQ(xlsxcsv::Document::openCached(xlsxPath, lazy), lazyDocument);
+    lazyDocument->readSheetToCsv("Sheet6");
+    EXPECT_GT(lazyDocument->getMemoryUsage(), openedBytes + 1024);
+    // The next hit still returns it but finds it over the limit
+    EXPECT_EQ(xlsxcsv::Document::openCached(xlsxPath, lazy), lazyDocument);
+    EXPECT_NE(xlsxcsv::Document::openCached(xlsxPath, lazy), lazyDocument);
+
+    xlsxcsv::Document::setCacheLimit(512 * 1024 * 1024);
+    xlsxcsv::Document::clearCache();
+}
+
+TEST_F(ParallelMultiSheetTest, RowRangeAndColumnsSelectLines) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    std::vector<std::string> lines;
+    std::istringstream full(xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2"));
+    for (std::string line; std::getline(full, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 1000u);
+
+    xlsxcsv::CsvOptions options;
+    options.rowOffset = 10;
+    options.rowLimit = 5;
+    options.columns = {std::string("B")};
+    std::string expected;
+    for (size_t i = 10; i < 15; ++i) {
+        expected += lines[i].substr(lines[i].find(',') + 1) + "\n";
+    }
+
+    xlsxcsv::ConversionStats stats;
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2", options, &stats), expected);
+    EXPECT_EQ(stats.rows, 5u);
+    EXPECT_EQ(stats.cells, 5u); // Column A is skipped before it becomes a cell
+    EXPECT_EQ(stats.sharedStringLookups, 5u);
+
+    // A row range makes split parsing serial; the output is the same
+    options.sheetParseThreads = 4;
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2", options), expected);
+
+    // Offsets past the end give no rows; an index selects like a letter
+    options.rowOffset = 5000;
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2", options), "");
+    options.rowOffset = 0;
+    options.rowLimit = 1;
+    options.columns = {0};
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2", options), lines[0].substr(0, lines[0].find(',')) + "\n");
+
+    options.columns = {std::string("B2")};
+    EXPECT_THROW(xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2", options), std::runtime_error);
+}
+
+TEST_F(ParallelMultiSheetTest, ResultCacheServesUnchangedSheets) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::CsvOptions options;
+    options.resultCacheDir = (testDir / "cache").string();
+    const std::string expected = xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2");
+
+    xlsxcsv::ConversionStats stats;
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2", options, &stats), expected);
+    EXPECT_EQ(stats.resultCacheHits, 0u);
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2", options, &stats), expected);
+    EXPECT_EQ(stats.resultCacheHits, 1u);
+    EXPECT_EQ(stats.rows, 1000u);
+    EXPECT_EQ(stats.outputBytes, expected.size());
+    EXPECT_EQ(stats.cells, 0u); // Nothing was parsed
+    EXPECT_EQ(stats.sharedStringsMs, 0.0);
+
+    // Sinks, files and open documents are served from the same entry
+    std::string streamed;
+    xlsxcsv::StringOutputSink sink(streamed);
+    xlsxcsv::convertSheet(xlsxPath, 1, sink, options, &stats);
+    EXPECT_EQ(streamed, expected);
+    EXPECT_EQ(stats.resultCacheHits, 1u);
+    xlsxcsv::Document document(xlsxPath);
+    EXPECT_EQ(document.readSheetToCsv("Sheet2", options, &stats), expected);
+    EXPECT_EQ(stats.resultCacheHits, 1u);
+    const auto sheets = xlsxcsv::readMultipleSheets(xlsxPath, {"Sheet1", "Sheet2"}, options, &stats);
+    EXPECT_EQ(sheets.at("Sheet2"), expected);
+    EXPECT_EQ(stats.resultCacheHits, 1u);
+    EXPECT_EQ(xlsxcsv::readMultipleSheets(xlsxPath, {"Sheet1", "Sheet2"}, options, &stats), sheets);
+    EXPECT_EQ(stats.resultCacheHits, 2u);
+
+    // Options that change the output are part of the key
+    xlsxcsv::CsvOptions semicolons = options;
+    semicolons.delimiter = ';';
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2", semicolons, &stats).find(','), std::string::npos);
+    EXPECT_EQ(stats.resultCacheHits, 0u);
+
+    // A re-packed workbook with only another sheet changed still hits;
+    // changing the sheet itself misses
+    const auto root = testDir / "content";
+    std::ofstream(root / "xl" / "worksheets" / "sheet5.xml", std::ios::app) << "\n";
+    const std::string repacked = (testDir / "repacked.xlsx").string();
+    std::system(("cd \"" + root.string() + "\" && zip -q -r ../repacked.xlsx . > /dev/null 2>&1").c_str());
+    ASSERT_TRUE(fs::exists(repacked));
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(repacked, "Sheet2", options, &stats), expected);
+    EXPECT_EQ(stats.resultCacheHits, 1u);
+
+    std::ofstream(root / "xl" / "worksheets" / "sheet2.xml", std::ios::app) << "\n";
+    fs::remove(repacked);
+    std::system(("cd \"" + root.string() + "\" && zip -q -r ../repacked.xlsx . > /dev/null 2>&1").c_str());
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(repacked, "Sheet2", options, &stats), expected);
+    EXPECT_EQ(stats.resultCacheHits, 0u);
+}
+
+TEST_F(ParallelMultiSheetTest, ResultCacheEvictsLeastRecentlyUsed) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    const fs::path cacheDir = testDir / "cache";
+    auto cachedBytes = [&] {
+        uint64_t total = 0;
+        for (const auto& entry : fs::directory_iterator(cacheDir)) {
+            total += entry.file_size();
+        }
+        return total;
+    };
+
+    // Room for one of the larger sheets at a time
+    xlsxcsv::CsvOptions options;
+    options.resultCacheDir = cacheDir.string();
+    options.resultCacheLimit = xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6").size() + 4096;
+
+    xlsxcsv::ConversionStats stats;
+    xlsxcsv::readSheetToCsv(xlsxPath, "Sheet5", options);
+    xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6", options);
+    EXPECT_LE(cachedBytes(), options.resultCacheLimit);
+    xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6", options, &stats);
+    EXPECT_EQ(stats.resultCacheHits, 1u);
+    xlsxcsv::readSheetToCsv(xlsxPath, "Sheet5", options, &stats);
+    EXPECT_EQ(stats.resultCacheHits, 0u);
+
+    // A result larger than the whole cache is not stored
+    options.resultCacheLimit = 1024;
+    fs::remove_all(cacheDir);
+    xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6", options);
+    xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6", options, &stats);
+    EXPECT_EQ(stats.resultCacheHits, 0u);
+    EXPECT_EQ(cachedBytes(), 0u);
+}
+
+TEST_F(ParallelMultiSheetTest, ConvertFilesMatchesSingleConversions) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    std::vector<xlsxcsv::FileConversionJob> jobs;
+    for (const auto& name : sheetNames) {
+        jobs.push_back({xlsxPath, name, ""});
+    }
+    jobs.push_back({(testDir / "missing.xlsx").string(), -1, ""});
+    const std::string outPath = (testDir / "sheet3.csv").string();
+    jobs.push_back({xlsxPath, 2, outPath});
+
+    xlsxcsv::ConversionScheduler scheduler(3);
+    const auto results = xlsxcsv::convertFiles(jobs, {}, {&scheduler, false});
+    ASSERT_EQ(results.size(), jobs.size());
+    for (size_t i = 0; i < sheetNames.size(); ++i) {
+        EXPECT_EQ(results[i].index, i);
+        EXPECT_TRUE(results[i].ok) << results[i].error;
+        EXPECT_EQ(results[i].csv, xlsxcsv::readSheetToCsv(xlsxPath, sheetNames[i])) << sheetNames[i];
+        EXPECT_EQ(results[i].stats.rows, 500u * (i + 1));
+    }
+
+    const auto& missing = results[sheetNames.size()];
+    EXPECT_FALSE(missing.ok);
+    EXPECT_FALSE(missing.error.empty());
+
+    const auto& written = results.back();
+    EXPECT_TRUE(written.ok) << written.error;
+    EXPECT_TRUE(written.csv.empty());
+    std::ifstream in(outPath, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    EXPECT_EQ(contents.str(), xlsxcsv::readSheetToCsv(xlsxPath, 2));
+}
+
+TEST_F(ParallelMultiSheetTest, SharedPartsAreFoundThroughRelationships) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    // The same workbook with its string table stored under another name
+    const fs::path root = testDir / "relocated";
+    fs::copy(testDir / "content", root, fs::copy_options::recursive);
+    fs::create_directories(root / "xl" / "strings");
+    fs::rename(root / "xl" / "sharedStrings.xml", root / "xl" / "strings" / "table.xml");
+    const fs::path relsPath = root / "xl" / "_rels" / "workbook.xml.rels";
+    std::string rels;
+    {
+        std::ifstream in(relsPath);
+        rels.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    rels.replace(rels.find("</Relationships>"), 0,
+                 "<Relationship Id=\"rIdStrings\" Type=\"http://schemas.openxmlformats.org/officeDocument/"
+                 "2006/relationships/sharedStrings\" Target=\"strings/table.xml\"/>");
+    std::ofstream(relsPath) << rels;
+    auto zipTo = [&](const fs::path& archive) {
+        fs::remove(archive);
+        std::string cmd = "cd \"" + root.string() + "\" && zip -q -r \"" + archive.string() + "\" . > /dev/null 2>&1";
+        std::system(cmd.c_str());
+    };
+    const fs::path relocated = testDir / "relocated.xlsx";
+    zipTo(relocated);
+
+    const std::string expected = xlsxcsv::readSheetToCsv(xlsxPath, "Sheet2");
+    xlsxcsv::ConversionStats stats;
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(relocated.string(), "Sheet2", {}, &stats), expected);
+    EXPECT_EQ(stats.sharedStringCount, static_cast<uint64_t>(stringCount));
+    EXPECT_GT(stats.sharedStringsUncompressedBytes, 0u);
+
+    // Estimates count the table wherever it is stored
+    EXPECT_EQ(xlsxcsv::estimateConversionMemory(relocated.string()), xlsxcsv::estimateConversionMemory(xlsxPath));
+    EXPECT_EQ(xlsxcsv::estimateConversionMemory(xlsxcsv::FileConversionJob{relocated.string(), "Sheet2", ""}),
+              xlsxcsv::estimateConversionMemory(xlsxcsv::FileConversionJob{xlsxPath, "Sheet2", ""}));
+
+    // And a changed table invalidates cached results
+    xlsxcsv::CsvOptions options;
+    options.resultCacheDir = (testDir / "cache").string();
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(relocated.string(), "Sheet2", options), expected);
+    std::string table;
+    {
+        std::ifstream in(root / "xl" / "strings" / "table.xml");
+        table.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    table.replace(table.find("shared 0<"), 8, "changed!");
+    std::ofstream(root / "xl" / "strings" / "table.xml") << table;
+    zipTo(relocated);
+    const std::string changed = xlsxcsv::readSheetToCsv(relocated.string(), "Sheet2", options, &stats);
+    EXPECT_EQ(stats.resultCacheHits, 0u);
+    EXPECT_NE(changed, expected);
+    EXPECT_NE(changed.find("changed!"), std::string::npos);
+}
+
+TEST_F(ParallelMultiSheetTest, ConvertFilesRespectsMemoryBudget) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    const uint64_t estimate = xlsxcsv::estimateConversionMemory(xlsxcsv::FileConversionJob{xlsxPath, -1, ""});
+    EXPECT_GT(estimate, xlsxcsv::estimateConversionMemory((testDir / "missing.xlsx").string()));
+
+    // Jobs are sized by the sheet they select, and returning the CSV as a
+    // string costs more than writing it out
+    const uint64_t largest = xlsxcsv::estimateConversionMemory(xlsxcsv::FileConversionJob{xlsxPath, "Sheet6", ""});
+    EXPECT_GT(largest, estimate);
+    const uint64_t toFile = xlsxcsv::estimateConversionMemory(
+        xlsxcsv::FileConversionJob{xlsxPath, "Sheet6", (testDir / "out.csv").string()});
+    EXPECT_LT(toFile, largest);
+    EXPECT_GE(largest - toFile, xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6").size() / 2);
+    EXPECT_EQ(xlsxcsv::estimateConversionMemory(xlsxPath), toFile);
+
+    // Room for two conversions at a time on four threads
+    xlsxcsv::ConversionScheduler scheduler(4, 2 * estimate);
+    std::vector<xlsxcsv::FileConversionJob> jobs(12, {xlsxPath, -1, ""});
+    size_t reported = 0;
+    xlsxcsv::convertFiles(jobs, [&](xlsxcsv::FileConversionResult& result) {
+        EXPECT_TRUE(result.ok) << result.error;
+        EXPECT_EQ(result.estimatedMemory, estimate);
+        EXPECT_LE(scheduler.getReservedMemory(), 2 * estimate);
+        ++reported;
+    }, {}, {&scheduler, false});
+    EXPECT_EQ(reported, jobs.size());
+    EXPECT_LE(scheduler.getPeakReservedMemory(), 2 * estimate);
+    EXPECT_EQ(scheduler.getReservedMemory(), 0u);
+
+    // A job larger than the whole budget still runs, alone
+    scheduler.setMemoryBudget(estimate / 2);
+    const auto results = xlsxcsv::convertFiles(jobs, {}, {&scheduler, false});
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.ok) << result.error;
+    }
+}
+
+TEST_F(ParallelMultiSheetTest, ConvertFilesFailFastAndCallbackErrors) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    // One thread runs the jobs in order, so everything after the failure is skipped
+    xlsxcsv::ConversionScheduler scheduler(1);
+    std::vector<xlsxcsv::FileConversionJob> jobs = {
+        {xlsxPath, -1, ""}, {xlsxPath, "NoSuchSheet", ""}, {xlsxPath, -1, ""}, {xlsxPath, 1, ""}};
+    auto results = xlsxcsv::convertFiles(jobs, {}, {&scheduler, true});
+    EXPECT_TRUE(results[0].ok);
+    EXPECT_FALSE(results[1].ok);
+    EXPECT_NE(results[1].error.find("NoSuchSheet"), std::string::npos);
+    EXPECT_FALSE(results[2].ok);
+    EXPECT_FALSE(results[3].ok);
+
+    results = xlsxcsv::convertFiles(jobs, {}, {&scheduler, false});
+    EXPECT_TRUE(results[2].ok);
+    EXPECT_TRUE(results[3].ok);
+
+    size_t calls = 0;
+    EXPECT_THROW(xlsxcsv::convertFiles(jobs, [&](xlsxcsv::FileConversionResult&) {
+        ++calls;
+        throw std::runtime_error("consumer failed");
+    }, {}, {&scheduler, false}), std::runtime_error);
+    EXPECT_EQ(calls, 1u);
+
+    // The scheduler stays usable after a failed batch
+    EXPECT_EQ(xlsxcsv::convertFiles(jobs).size(), jobs.size());
+}
+
+TEST(ConversionSchedulerTest, RunsCallerTasksUnderTheBudget) {
+    xlsxcsv::ConversionScheduler scheduler(4, 100);
+    std::mutex mutex;
+    std::vector<size_t> ran;
+    std::vector<size_t> skipped;
+    const std::vector<uint64_t> estimates(8, 40);
+    scheduler.run(estimates, [&](size_t index, bool skip) {
+        EXPECT_LE(scheduler.getReservedMemory(), 80u);
+        std::lock_guard<std::mutex> lock(mutex);
+        (skip ? skipped : ran).push_back(index);
+        return true;
+    });
+    EXPECT_EQ(ran.size(), estimates.size());
+    EXPECT_TRUE(skipped.empty());
+    EXPECT_LE(scheduler.getPeakReservedMemory(), 80u);
+    EXPECT_EQ(scheduler.getReservedMemory(), 0u);
+
+    // One thread runs tasks in order: a false return skips the rest, a
+    // throw drops them
+    xlsxcsv::ConversionScheduler serial(1);
+    ran.clear();
+    serial.run(estimates, [&](size_t index, bool skip) {
+        (skip ? skipped : ran).push_back(index);
+        return index != 2;
+    });
+    EXPECT_EQ(ran, (std::vector<size_t>{0, 1, 2}));
+    EXPECT_EQ(skipped, (std::vector<size_t>{3, 4, 5, 6, 7}));
+
+    size_t calls = 0;
+    EXPECT_THROW(serial.run(estimates, [&](size_t, bool) -> bool {
+        ++calls;
+        throw std::runtime_error("task failed");
+    }), std::runtime_error);
+    EXPECT_EQ(calls, 1u);
+}
+
+TEST_F(ParallelMultiSheetTest, MemoryTrackingReportsPeakAndEnforcesLimit) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::CsvOptions options;
+    options.trackMemory = true;
+    xlsxcsv::ConversionStats stats;
+    const std::string csv = xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6", options, &stats);
+    EXPECT_EQ(csv, xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6"));
+    EXPECT_GE(stats.peakMemoryBytes, csv.size());
+
+    // Splitting rows inflates the whole worksheet first
+    options.sheetParseThreads = 2;
+    xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6", options, &stats);
+    EXPECT_GE(stats.peakMemoryBytes, stats.worksheetUncompressedBytes);
+
+    options.maxThreads = 3;
+    xlsxcsv::readMultipleSheets(xlsxPath, sheetNames, options, &stats);
+    EXPECT_GT(stats.peakMemoryBytes, 0u);
+
+    xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6", {}, &stats);
+    EXPECT_EQ(stats.peakMemoryBytes, 0u);
+
+    // A limit aborts the conversion with an error naming it
+    options.memoryLimit = 16 * 1024;
+    for (unsigned threads : {1u, 2u}) {
+        options.sheetParseThreads = threads;
+        try {
+            xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6", options);
+            ADD_FAILURE() << "Expected the memory limit to be hit";
+        } catch (const std::runtime_error& e) {
+            EXPECT_NE(std::string(e.what()).find("memory limit"), std::string::npos) << e.what();
+        }
+    }
+    EXPECT_THROW(xlsxcsv::readMultipleSheets(xlsxPath, sheetNames, options), std::runtime_error);
+
+    options.memoryLimit = 1ULL << 30;
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6", options, &stats), csv);
+    EXPECT_LE(stats.peakMemoryBytes, options.memoryLimit);
+
+    // Installing the libxml2 hooks is explicit and idempotent
+    const bool hooked = xlsxcsv::installMemoryHooks();
+    EXPECT_EQ(xlsxcsv::installMemoryHooks(), hooked);
+    options.parserBackend = xlsxcsv::CsvOptions::ParserBackend::LIBXML;
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6", options, &stats), csv);
+    EXPECT_GT(stats.peakMemoryBytes, 0u);
+}
+
+TEST_F(ParallelMultiSheetTest, DocumentTracksEachConversionFromItsOptions) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    // Opened untracked, the per-call options still decide tracking and limits
+    xlsxcsv::Document document(xlsxPath);
+    xlsxcsv::CsvOptions options;
+    options.trackMemory = true;
+    xlsxcsv::ConversionStats small;
+    document.readSheetToCsv("Sheet1", options, &small);
+    EXPECT_GT(small.peakMemoryBytes, 0u);
+
+    // Each conversion has its own peak rather than the document's running one
+    xlsxcsv::ConversionStats large;
+    document.readSheetToCsv("Sheet6", options, &large);
+    xlsxcsv::ConversionStats again;
+    document.readSheetToCsv("Sheet1", options, &again);
+    EXPECT_LT(again.peakMemoryBytes, large.peakMemoryBytes);
+
+    xlsxcsv::ConversionStats untracked;
+    document.readSheetToCsv("Sheet6", {}, &untracked);
+    EXPECT_EQ(untracked.peakMemoryBytes, 0u);
+
+    options.memoryLimit = 16 * 1024;
+    EXPECT_THROW(document.readSheetToCsv("Sheet6", options), std::runtime_error);
+    const std::string expected = xlsxcsv::readSheetToCsv(xlsxPath, "Sheet6");
+    EXPECT_EQ(document.readSheetToCsv("Sheet6"), expected);
+
+    // Lazy decodes are charged to the call making them, so the open-time
+    // limit no longer applies and the call's own peak includes them
+    xlsxcsv::CsvOptions lazy;
+    lazy.sharedStringsMode = xlsxcsv::CsvOptions::SharedStringsMode::LAZY;
+    lazy.memoryLimit = 32 * 1024;
+    xlsxcsv::Document limitedAtOpen(xlsxPath, lazy);
+    EXPECT_EQ(limitedAtOpen.readSheetToCsv("Sheet6"), expected);
+
+    lazy.memoryLimit = 0;
+    xlsxcsv::Document openedUntracked(xlsxPath, lazy);
+    options.memoryLimit = 0;
+    xlsxcsv::ConversionStats decoding;
+    EXPECT_EQ(openedUntracked.readSheetToCsv("Sheet6", options, &decoding), expected);
+    EXPECT_GE(decoding.peakMemoryBytes, 64u * 1024);
+}
+
+class ArrowExportTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "turboxl_arrow_export_test";
+        fs::create_directories(testDir / "content" / "_rels");
+        fs::create_directories(testDir / "content" / "xl" / "_rels");
+        fs::create_directories(testDir / "content" / "xl" / "worksheets");
+
+        auto root = testDir / "content";
+        std::ofstream(root / "[Content_Types].xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">
+    <Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>
+    <Default Extension="xml" ContentType="application/xml"/>
+</Types>)";
+        std::ofstream(root / "_rels" / ".rels") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+    <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument" Target="xl/workbook.xml"/>
+</Relationships>)";
+        std::ofstream(root / "xl" / "workbook.xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<workbook xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" xmlns:r="http://schemas.openxmlformats.org/officeDocument/2006/relationships">
+    <sheets>
+        <sheet name="Typed" sheetId="1" r:id="rId1"/>
+    </sheets>
+</workbook>)";
+        std::ofstream(root / "xl" / "_rels" / "workbook.xml.rels") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+    <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet" Target="worksheets/sheet1.xml"/>
+</Relationships>)";
+        std::ofstream(root / "xl" / "styles.xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<styleSheet xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main">
+    <cellXfs count="2"><xf numFmtId="0"/><xf numFmtId="14"/></cellXfs>
+</styleSheet>)";
+        std::ofstream(root / "xl" / "sharedStrings.xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<sst xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main"><si><t>label</t></si><si><t>red</t></si><si><t>green</t></si><si><t>blue</t></si></sst>)";
+
+        // Columns: number, shared-string category, date, boolean, mixed, errors only
+        std::ofstream sheet(root / "xl" / "worksheets" / "sheet1.xml");
+        sheet << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<worksheet xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main"><sheetData>)"
+              << R"(<row r="1"><c r="A1" t="inlineStr"><is><t>id</t></is></c><c r="B1" t="s"><v>0</v></c>)"
+              << R"(<c r="C1" t="inlineStr"><is><t>when</t></is></c><c r="D1" t="inlineStr"><is><t>flag</t></is></c>)"
+              << R"(<c r="E1" t="inlineStr"><is><t>mixed</t></is></c></row>)";
+        for (int r = 2; r <= rowCount + 1; ++r) {
+            sheet << "<row r=\"" << r << "\"><c r=\"A" << r << "\"><v>" << r << ".5</v></c>"
+                  << "<c r=\"B" << r << "\" t=\"s\"><v>" << (1 + r % 3) << "</v></c>"
+                  << "<c r=\"C" << r << "\" s=\"1\"><v>" << (44998 + r) << "</v></c>"
+                  << "<c r=\"D" << r << "\" t=\"b\"><v>" << (r % 2) << "</v></c>";
+            if (r % 2 == 0) {
+                sheet << "<c r=\"E" << r << "\"><v>" << r << "</v></c>";
+            } else {
+                sheet << "<c r=\"E" << r << "\" t=\"inlineStr\"><is><t>odd " << r << "</t></is></c>";
+            }
+            sheet << "<c r=\"F" << r << "\" t=\"e\"><v>#N/A</v></c></row>";
+        }
+        sheet << "</sheetData></worksheet>";
+        sheet.close();
+
+        std::string cmd = "cd \"" + root.string() + "\" && zip -q -r ../typed.xlsx . > /dev/null 2>&1";
+        std::system(cmd.c_str());
+        xlsxPath = (testDir / "typed.xlsx").string();
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    static constexpr int rowCount = 9;
+    fs::path testDir;
+    std::string xlsxPath;
+};
+
+TEST_F(ArrowExportTest, TypedColumnsInFixedSizeBatches) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::ColumnarOptions columnar;
+    columnar.batchSize = 4;
+    columnar.headerRow = true;
+    ArrowArrayStream stream;
+    xlsxcsv::readSheetToArrow(xlsxPath, "Typed", &stream, {}, columnar);
+    ASSERT_NE(stream.release, nullptr);
+
+    ArrowSchema schema;
+    ASSERT_EQ(stream.get_schema(&stream, &schema), 0);
+    EXPECT_STREQ(schema.format, "+s");
+    ASSERT_EQ(schema.n_children, 6);
+    const char* names[] = {"id", "label", "when", "flag", "mixed", "F"};
+    const char* formats[] = {"g", "i", "tsm:", "b", "u", "n"};
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_STREQ(schema.children[i]->name, names[i]);
+        EXPECT_STREQ(schema.children[i]->format, formats[i]);
+    }
+    ASSERT_NE(schema.children[1]->dictionary, nullptr);
+    EXPECT_STREQ(schema.children[1]->dictionary->format, "u");
+    schema.release(&schema);
+    EXPECT_EQ(schema.release, nullptr);
+
+    std::vector<int64_t> lengths;
+    int64_t row = 2;
+    for (;;) {
+        ArrowArray batch;
+        ASSERT_EQ(stream.get_next(&stream, &batch), 0);
+        if (!batch.release) {
+            break;
+        }
+        lengths.push_back(batch.length);
+        ASSERT_EQ(batch.n_children, 6);
+        const ArrowArray* number = batch.children[0];
+        const ArrowArray* label = batch.children[1];
+        const ArrowArray* when = batch.children[2];
+        const ArrowArray* flag = batch.children[3];
+        const ArrowArray* mixed = batch.children[4];
+        EXPECT_EQ(batch.children[5]->null_count, batch.length);
+        EXPECT_EQ(number->null_count, 0);
+
+        for (int64_t i = 0; i < batch.length; ++i, ++row) {
+            const auto* values = static_cast<const double*>(number->buffers[1]);
+            EXPECT_DOUBLE_EQ(values[number->offset + i], static_cast<double>(row) + 0.5);
+
+            const auto* codes = static_cast<const int32_t*>(label->buffers[1]);
+            const auto* dictOffsets = static_cast<const int32_t*>(label->dictionary->buffers[1]);
+            const auto* dictData = static_cast<const char*>(label->dictionary->buffers[2]);
+            const int32_t code = codes[label->offset + i];
+            const std::string category(dictData + dictOffsets[code], dictData + dictOffsets[code + 1]);
+            const char* expected[] = {"red", "green", "blue"};
+            EXPECT_EQ(category, expected[row % 3]);
+
+            const auto* millis = static_cast<const int64_t*>(when->buffers[1]);
+            // Serial 45000 is 2023-03-15, i.e. 19431 days after the Unix epoch
+            EXPECT_EQ(millis[when->offset + i], (19431 + (row - 2)) * 86400000LL);
+
+            const auto* bits = static_cast<const uint8_t*>(flag->buffers[1]);
+            const int64_t bit = flag->offset + i;
+            EXPECT_EQ(((bits[bit >> 3] >> (bit & 7)) & 1) != 0, row % 2 == 1);
+
+            const auto* textOffsets = static_cast<const int32_t*>(mixed->buffers[1]);
+            const auto* text = static_cast<const char*>(mixed->buffers[2]);
+            const int64_t slot = mixed->offset + i;
+            const std::string value(text + textOffsets[slot], text + textOffsets[slot + 1]);
+            EXPECT_EQ(value, row % 2 == 0 ? std::to_string(row) : "odd " + std::to_string(row));
+        }
+        batch.release(&batch);
+    }
+    EXPECT_EQ(lengths, (std::vector<int64_t>{4, 4, 1}));
+    stream.release(&stream);
+    EXPECT_EQ(stream.release, nullptr);
+}
+
+TEST_F(ArrowExportTest, BatchOutlivesStreamAndMovedChildren) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    ArrowArrayStream stream;
+    xlsxcsv::readSheetToArrow(xlsxPath, 0, &stream);
+    ArrowArray batch;
+    ASSERT_EQ(stream.get_next(&stream, &batch), 0);
+    stream.release(&stream);
+
+    // Without a header row the first row is data and columns are named by letter
+    ASSERT_NE(batch.release, nullptr);
+    EXPECT_EQ(batch.length, rowCount + 1);
+    ArrowArray moved = *batch.children[0];
+    batch.children[0]->release = nullptr;
+    batch.release(&batch);
+
+    EXPECT_EQ(moved.null_count, 0);
+    const auto* text = static_cast<const char*>(moved.buffers[2]);
+    const auto* offsets = static_cast<const int32_t*>(moved.buffers[1]);
+    EXPECT_EQ(std::string(text + offsets[0], text + offsets[1]), "id");
+    moved.release(&moved);
+
+    EXPECT_THROW(xlsxcsv::readSheetToArrow(xlsxPath, "Missing", &stream), std::runtime_error);
+}
+
+class DateRenderingTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    // Single-sheet workbook whose styles are: 0 General, 1 date, 2 time, 3 date-time
+    std::string buildWorkbook(const std::string& workbookPr, const std::string& rowXml) {
+        auto root = testDir / "content";
+        fs::remove_all(testDir);
+        fs::create_directories(root / "_rels");
+        fs::create_directories(root / "xl" / "_rels");
+        fs::create_directories(root / "xl" / "worksheets");
+
+        std::ofstream(root / "[Content_Types].xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">
+    <Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>
+    <Default Extension="xml" ContentType="application/xml"/>
+</Types>)";
+        std::ofstream(root / "_rels" / ".rels") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+    <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument" Target="xl/workbook.xml"/>
+</Relationships>)";
+        std::ofstream(root / "xl" / "workbook.xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<workbook xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" xmlns:r="http://schemas.openxmlformats.org/officeDocument/2006/relationships">)"
+            << workbookPr << R"(
+    <sheets>
+        <sheet name="Dates" sheetId="1" r:id="rId1"/>
+    </sheets>
+</workbook>)";
+        std::ofstream(root / "xl" / "_rels" / "workbook.xml.rels") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+    <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet" Target="worksheets/sheet1.xml"/>
+</Relationships>)";
+        std::ofstream(root / "xl" / "styles.xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<styleSheet xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main">
+    <cellXfs count="4"><xf numFmtId="0"/><xf numFmtId="14"/><xf numFmtId="21"/><xf numFmtId="22"/></cellXfs>
+</styleSheet>)";
+        std::ofstream(root / "xl" / "worksheets" / "sheet1.xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<worksheet xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main"><sheetData><row r="1">)"
+            << rowXml << "</row></sheetData></worksheet>";
+
+        std::string cmd = "cd \"" + root.string() + "\" && zip -q -r ../dates.xlsx . > /dev/null 2>&1";
+        std::system(cmd.c_str());
+        return (testDir / "dates.xlsx").string();
+    }
+
+    static std::string cells(const std::vector<std::pair<int, std::string>>& styledValues) {
+        std::string xml;
+        char column = 'A';
+        for (const auto& [style, value] : styledValues) {
+            xml += std::string("<c r=\"") + column++ + "1\" s=\"" + std::to_string(style) + "\"><v>" + value + "</v></c>";
+        }
+        return xml;
+    }
+
+    fs::path testDir = fs::temp_directory_path() / "turboxl_date_rendering_test";
+};
+
+TEST_F(DateRenderingTest, Date1900SystemAndStyleKinds) {
+    const std::string path = buildWorkbook("", cells({
+        {1, "45000"}, {1, "45000.75"}, {2, "0.5"}, {3, "45000.5"}, {3, "45000"},
+        {1, "1"}, {1, "59"}, {1, "60"}, {1, "61"}, {2, "0.999994"}, {2, "1.25"},
+        {1, "2958465"}, {1, "-1"}, {0, "45000"}}));
+    if (!fs::exists(path)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    // The style decides which parts are shown; serial 60 is Excel's phantom
+    // 1900-02-29 and out-of-range serials fall back to the number
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(path),
+              "2023-03-15,2023-03-15,12:00:00,2023-03-15T12:00:00,2023-03-15T00:00:00,"
+              "1900-01-01,1900-02-28,1900-02-29,1900-03-01,23:59:59,1900-01-01T06:00:00,"
+              "9999-12-31,-1,45000\n");
+}
+
+TEST_F(DateRenderingTest, Date1904System) {
+    const std::string path = buildWorkbook(R"(<workbookPr date1904="1"/>)",
+                                           cells({{1, "0"}, {1, "45000"}, {3, "1.5"}}));
+    if (!fs::exists(path)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    EXPECT_EQ(xlsxcsv::readSheetToCsv(path), "1904-01-01,2027-03-16,1904-01-02T12:00:00\n");
+}
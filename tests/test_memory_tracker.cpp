@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "xlsxcsv/core.hpp"
+
+using xlsxcsv::core::MemoryCharge;
+using xlsxcsv::core::MemoryLimitError;
+using xlsxcsv::core::MemoryTracker;
+
+TEST(MemoryTrackerTest, ChargesReleasesAndKeepsPeak) {
+    MemoryTracker tracker;
+    tracker.charge(1000);
+    tracker.charge(500);
+    tracker.release(1200);
+    EXPECT_EQ(tracker.current(), 300u);
+    EXPECT_EQ(tracker.peak(), 1500u);
+    EXPECT_EQ(tracker.limit(), 0u);
+    EXPECT_FALSE(tracker.limitExceeded());
+}
+
+TEST(MemoryTrackerTest, LimitRefusesWithoutRecording) {
+    MemoryTracker tracker(100);
+    tracker.charge(60);
+    EXPECT_THROW(tracker.charge(50), MemoryLimitError);
+    EXPECT_FALSE(tracker.tryCharge(41));
+    EXPECT_EQ(tracker.current(), 60u);
+    EXPECT_EQ(tracker.peak(), 60u);
+
+    // The refusal is remembered for the parsers that cannot throw
+    EXPECT_TRUE(tracker.limitExceeded());
+    EXPECT_THROW(tracker.throwIfLimitExceeded(), MemoryLimitError);
+    EXPECT_TRUE(tracker.tryCharge(40));
+}
+
+TEST(MemoryTrackerTest, ChargeFollowsBufferSize) {
+    MemoryTracker tracker(1000);
+    {
+        MemoryCharge charge(&tracker, 100);
+        charge.resize(700);
+        EXPECT_EQ(tracker.current(), 700u);
+        charge.resize(200);
+        EXPECT_EQ(tracker.current(), 200u);
+        EXPECT_THROW(charge.resize(2000), MemoryLimitError);
+        EXPECT_EQ(charge.size(), 200u);
+    }
+    EXPECT_EQ(tracker.current(), 0u);
+    EXPECT_EQ(tracker.peak(), 700u);
+
+    MemoryCharge untracked(nullptr, 1 << 20);
+    untracked.resize(1 << 30);
+    EXPECT_EQ(untracked.size(), 0u);
+}
@@ -114,6 +114,36 @@ TEST_F(OpcPackageTest, FindWorkbookPath) {
     EXPECT_EQ(workbookPath, "xl/workbook.xml");
 }
 
+TEST_F(OpcPackageTest, FindWorkbookPartPath) {
+    if (!fs::exists(testXlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+    
+    // Without workbook relationships parts are looked for where they usually live
+    xlsxcsv::core::OpcPackage package;
+    package.open(testXlsxPath.string());
+    EXPECT_EQ(package.findWorkbookPartPath("sharedStrings"), "xl/sharedStrings.xml");
+    EXPECT_EQ(package.findWorkbookPartPath("styles"), "xl/styles.xml");
+    
+    // Targets are relative to xl/ unless absolute
+    auto content = testDir / "xlsx_content";
+    std::ofstream(content / "xl" / "_rels" / "workbook.xml.rels") << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+    <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet" Target="worksheets/sheet1.xml"/>
+    <Relationship Id="rId2" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/sharedStrings" Target="strings/table.xml"/>
+    <Relationship Id="rId3" Type="http://purl.oclc.org/ooxml/officeDocument/relationships/styles" Target="/xl/theme/styles.xml"/>
+</Relationships>)";
+    auto relatedPath = testDir / "related.xlsx";
+    std::string cmd = "cd " + content.string() + " && zip -r ../related.xlsx . > /dev/null 2>&1";
+    system(cmd.c_str());
+    
+    xlsxcsv::core::OpcPackage related;
+    related.open(relatedPath.string());
+    EXPECT_EQ(related.findWorkbookPartPath("sharedStrings"), "xl/strings/table.xml");
+    EXPECT_EQ(related.findWorkbookPartPath("styles"), "xl/theme/styles.xml");
+    EXPECT_EQ(xlsxcsv::core::findWorkbookPartPath(related.getZipReader(), "styles"), "xl/theme/styles.xml");
+}
+
 TEST_F(OpcPackageTest, GetContentTypes) {
     if (!fs::exists(testXlsxPath)) {
         GTEST_SKIP() << "Test XLSX file could not be created";
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include "xlsxcsv/core.hpp"
+#include "xlsxcsv.hpp"
+#include <limits>
+#include <string>
 
 using namespace xlsxcsv::core;
 
@@ -234,4 +237,184 @@ TEST_F(Phase5FunctionalityTest, CsvRowCollectorErrorHandling) {
     collector.handleError("Second error");
     EXPECT_EQ(collector.getErrors().size(), 2);
     EXPECT_EQ(collector.getErrors()[1], "Second error");
-}
\ No newline at end of file
+}
+TEST_F(Phase5FunctionalityTest, CsvRowCollectorSinkOutput) {
+    xlsxcsv::CsvOptions options;
+    options.includeBom = true;
+    options.newline = xlsxcsv::CsvOptions::Newline::CRLF;
+    
+    std::string sinkOutput;
+    xlsxcsv::StringOutputSink sink(sinkOutput);
+    CsvRowCollector collector(nullptr, nullptr, DateSystem::Date1900, &options, &sink);
+    
+    RowData row;
+    row.rowNumber = 1;
+    CellData cell;
+    cell.coordinate.row = 1;
+    cell.coordinate.column = 1;
+    cell.value = std::string("line1\nline2");
+    cell.type = CellType::String;
+    row.cells.push_back(cell);
+    
+    collector.handleRow(row);
+    collector.handleRow(RowData{});
+    collector.finish();
+    
+    // BOM and CRLF row terminators are applied inline; embedded newlines are kept as-is
+    EXPECT_EQ(sinkOutput, "\xEF\xBB\xBF\"line1\nline2\"\r\n\r\n");
+    EXPECT_EQ(collector.getBytesWritten(), sinkOutput.size());
+    EXPECT_EQ(collector.getCsvString(), "");
+}
+
+TEST_F(Phase5FunctionalityTest, NumberFormatModes) {
+    auto numberCell = [](double value) {
+        CellData cell;
+        cell.value = value;
+        cell.type = CellType::Number;
+        return cell;
+    };
+    auto fixed6 = [&](double value) { return formatCellText(numberCell(value)); };
+    auto shortest = [&](double value) {
+        return formatCellText(numberCell(value), nullptr, nullptr, DateSystem::Date1900,
+                              NumberFormatMode::Shortest);
+    };
+    
+    // Fixed6 keeps the historical "%.6f with trailing zeros trimmed" output
+    EXPECT_EQ(fixed6(42.0), "42");
+    EXPECT_EQ(fixed6(-3.0), "-3");
+    EXPECT_EQ(fixed6(1.5), "1.5");
+    EXPECT_EQ(fixed6(0.1234567), "0.123457");
+    EXPECT_EQ(fixed6(1e20), "100000000000000000000");
+    EXPECT_EQ(fixed6(-0.0000001), "-0");
+    EXPECT_EQ(fixed6(std::numeric_limits<double>::quiet_NaN()), "#NUM!");
+    EXPECT_EQ(fixed6(-std::numeric_limits<double>::infinity()), "-#DIV/0!");
+    EXPECT_EQ(fixed6(std::numeric_limits<double>::max()).size(), 309u);
+    
+    // Shortest round-trips, integers are unchanged
+    EXPECT_EQ(shortest(42.0), "42");
+    EXPECT_EQ(shortest(0.1), "0.1");
+    EXPECT_EQ(shortest(0.1234567), "0.1234567");
+    EXPECT_EQ(shortest(1e-7), "1e-07");
+    for (double value : {0.1 + 0.2, 1.0 / 3.0, 123456.789e-12, 2.5e300}) {
+        EXPECT_EQ(std::stod(shortest(value)), value);
+    }
+    
+    // The collector applies the option; a delimiter that can occur in a
+    // number still gets the field quoted
+    xlsxcsv::CsvOptions options;
+    options.numberFormat = xlsxcsv::CsvOptions::NumberFormat::SHORTEST;
+    options.delimiter = '.';
+    CsvRowCollector collector(nullptr, nullptr, DateSystem::Date1900, &options);
+    RowData row;
+    row.rowNumber = 1;
+    row.cells.push_back(numberCell(0.1234567));
+    row.cells.back().coordinate = {1, 1};
+    row.cells.push_back(numberCell(7.0));
+    row.cells.back().coordinate = {1, 2};
+    collector.handleRow(row);
+    EXPECT_EQ(collector.getCsvString(), "\"0.1234567\".7\n");
+}
+
+TEST_F(Phase5FunctionalityTest, WorksheetMetadataIndexMatchesLinearScan) {
+    WorksheetMetadata linear;
+    // Disjoint ranges of varied shape, including a tall one that starts early
+    for (const char* ref : {"B2:C3", "A10:A400", "D1:F1", "E5:H9", "B20:I20", "C4:C4", "J2:J30", "K12:M14"}) {
+        linear.mergedCells.push_back(*MergedCellRange::fromReference(ref));
+    }
+    ColumnInfo wide;
+    wide.columnIndex = 20;
+    wide.lastColumn = 16384;
+    wide.hidden = true;
+    ColumnInfo visible;
+    visible.columnIndex = 2;
+    visible.lastColumn = 4;
+    ColumnInfo single;
+    single.columnIndex = 7;
+    single.hidden = true;
+    linear.columnInfo = {visible, single, wide};
+    
+    WorksheetMetadata indexed = linear;
+    indexed.buildIndex();
+    
+    for (int row = 1; row <= 410; ++row) {
+        for (int col = 1; col <= 30; ++col) {
+            const CellCoordinate coord{row, col};
+            EXPECT_EQ(indexed.findMergedCellRange(coord) ? indexed.findMergedCellRange(coord)->toReference() : "",
+                      linear.findMergedCellRange(coord) ? linear.findMergedCellRange(coord)->toReference() : "")
+                << row << "," << col;
+        }
+    }
+    for (int col = 0; col <= 16385; ++col) {
+        EXPECT_EQ(indexed.isColumnHidden(col), linear.isColumnHidden(col)) << col;
+    }
+    EXPECT_TRUE(indexed.isColumnHidden(16384));
+    EXPECT_FALSE(indexed.isColumnHidden(19));
+    
+    const MergedCellRange* tall = indexed.findMergedCellRange({250, 1});
+    ASSERT_NE(tall, nullptr);
+    EXPECT_EQ(indexed.mergedRangeId(*tall), 1u);
+}
+
+TEST_F(Phase5FunctionalityTest, CsvRowCollectorPropagatesIndexedMerges) {
+    xlsxcsv::CsvOptions options;
+    options.mergedHandling = xlsxcsv::CsvOptions::MergedHandling::PROPAGATE;
+    options.includeHiddenColumns = false;
+    CsvRowCollector collector(nullptr, nullptr, DateSystem::Date1900, &options);
+    
+    WorksheetMetadata metadata;
+    metadata.mergedCells.push_back(*MergedCellRange::fromReference("A1:B2"));
+    ColumnInfo hidden;
+    hidden.columnIndex = 3;
+    hidden.lastColumn = 3;
+    hidden.hidden = true;
+    metadata.columnInfo.push_back(hidden);
+    metadata.buildIndex();
+    collector.handleWorksheetMetadata(metadata);
+    
+    auto textCell = [](int row, int column, const char* text) {
+        CellData cell;
+        cell.coordinate = {row, column};
+        cell.value = std::string(text);
+        cell.type = CellType::String;
+        return cell;
+    };
+    RowData first;
+    first.rowNumber = 1;
+    first.cells = {textCell(1, 1, "merged"), textCell(1, 3, "hidden"), textCell(1, 4, "d1")};
+    RowData second;
+    second.rowNumber = 2;
+    second.cells = {textCell(2, 4, "d2")};
+    collector.handleRow(first);
+    collector.handleRow(second);
+    
+    EXPECT_EQ(collector.getCsvString(), "merged,merged,d1\nmerged,merged,d2\n");
+}
+
+TEST_F(Phase5FunctionalityTest, RowDataTextArenaViews) {
+    RowData row;
+    row.rowNumber = 3;
+    // Enough appends to force the arena to reallocate several times
+    for (int i = 0; i < 64; ++i) {
+        CellData& cell = row.cells.emplace_back();
+        cell.coordinate = {3, i + 1};
+        cell.type = CellType::InlineString;
+        cell.value = row.appendText("text value number " + std::to_string(i));
+    }
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_TRUE(row.cells[i].isString());
+        EXPECT_EQ(row.cells[i].getText(), "text value number " + std::to_string(i));
+    }
+    
+    // Copies own their text; moves keep the existing arena
+    RowData copy = row;
+    RowData moved = std::move(row);
+    CellData kept = copy.cells[5];
+    kept.makeOwned();
+    copy.clear();
+    copy.appendText(std::string(4096, '#'));
+    EXPECT_EQ(moved.cells[63].getString(), "text value number 63");
+    EXPECT_EQ(kept.getText(), "text value number 5");
+    EXPECT_TRUE(std::holds_alternative<std::string>(kept.value));
+    EXPECT_TRUE(copy.cells.empty());
+    EXPECT_EQ(copy.rowNumber, 0);
+}
@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 #include "xlsxcsv/core.hpp"
+#include "xlsxcsv.hpp"
+#include <filesystem>
+#include <fstream>
+#include <cstdlib>
+
+namespace fs = std::filesystem;
 
 class SharedStringsProviderTest : public ::testing::Test {
 protected:
@@ -70,3 +76,459 @@ TEST_F(SharedStringsProviderTest, ConfigurationPersistence) {
     EXPECT_EQ(storedConfig.maxStringLength, 500);
     EXPECT_FALSE(storedConfig.flattenRichText);
 }
+
+class SharedStringsFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "turboxl_shared_strings_test";
+        fs::create_directories(testDir / "content" / "_rels");
+        fs::create_directories(testDir / "content" / "xl");
+
+        auto root = testDir / "content";
+        std::ofstream(root / "[Content_Types].xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">
+    <Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>
+    <Default Extension="xml" ContentType="application/xml"/>
+</Types>)";
+        std::ofstream(root / "_rels" / ".rels") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+    <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument" Target="xl/workbook.xml"/>
+</Relationships>)";
+        std::ofstream(root / "xl" / "sharedStrings.xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<sst xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" count="4" uniqueCount="4">
+    <si><t>plain</t></si>
+    <si><t>say "hi", please</t></si>
+    <si><t></t></si>
+    <si><r><t>rich </t></r><r><t>text</t></r></si>
+</sst>)";
+
+        std::string cmd = "cd \"" + root.string() + "\" && zip -q -r ../strings.xlsx . > /dev/null 2>&1";
+        std::system(cmd.c_str());
+        xlsxPath = testDir / "strings.xlsx";
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    fs::path testDir;
+    fs::path xlsxPath;
+};
+
+TEST_F(SharedStringsFileTest, StringViewsReferenceArena) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::core::OpcPackage package;
+    package.open(xlsxPath.string());
+
+    xlsxcsv::core::SharedStringsConfig config;
+    config.mode = xlsxcsv::core::SharedStringsMode::InMemory;
+    xlsxcsv::core::SharedStringsProvider provider(config);
+    provider.parse(package);
+    ASSERT_EQ(provider.getStringCount(), 4u);
+
+    EXPECT_EQ(provider.getStringView(0), "plain");
+    EXPECT_EQ(provider.getStringView(1), "say \"hi\", please");
+    EXPECT_EQ(provider.getStringView(2), "");
+    EXPECT_EQ(provider.getStringView(3), "rich text");
+
+    // Repeated lookups return the same arena bytes, not fresh copies
+    EXPECT_EQ(provider.getStringView(1).data(), provider.tryGetStringView(1)->data());
+    EXPECT_EQ(provider.tryGetString(1).value(), provider.getStringView(1));
+
+    EXPECT_FALSE(provider.tryGetStringView(4).has_value());
+    EXPECT_THROW(provider.getStringView(4), xlsxcsv::core::XlsxError);
+    EXPECT_EQ(provider.getSpillReadCount(), 0u);
+    // The inflated XML was held next to the arena while parsing
+    EXPECT_GT(provider.getPeakMemoryUsage(), provider.getMemoryUsage());
+
+    // The CSV collector escapes straight from the views
+    xlsxcsv::core::CsvRowCollector collector(&provider);
+    xlsxcsv::core::RowData row;
+    row.rowNumber = 1;
+    for (int i = 0; i < 4; ++i) {
+        xlsxcsv::core::CellData cell;
+        cell.coordinate = {1, i + 1};
+        cell.type = xlsxcsv::core::CellType::SharedString;
+        cell.value = i;
+        row.cells.push_back(cell);
+    }
+    collector.handleRow(row);
+    EXPECT_EQ(collector.getCsvString(), "plain,\"say \"\"hi\"\", please\",,rich text\n");
+}
+
+TEST_F(SharedStringsFileTest, CollectorReusesEscapedSharedStrings) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::core::OpcPackage package;
+    package.open(xlsxPath.string());
+    xlsxcsv::core::SharedStringsProvider provider;
+    provider.parse(package);
+
+    auto sharedRow = [](int rowNumber, std::initializer_list<int> indices) {
+        xlsxcsv::core::RowData row;
+        row.rowNumber = rowNumber;
+        int column = 1;
+        for (int index : indices) {
+            xlsxcsv::core::CellData cell;
+            cell.coordinate = {rowNumber, column++};
+            cell.type = xlsxcsv::core::CellType::SharedString;
+            cell.value = index;
+            row.cells.push_back(cell);
+        }
+        return row;
+    };
+
+    // Repeated strings come from the per-index cache; a delimiter change
+    // changes which strings need quoting
+    xlsxcsv::CsvOptions options;
+    options.delimiter = ';';
+    xlsxcsv::core::CsvRowCollector collector(&provider, nullptr, xlsxcsv::core::DateSystem::Date1900, &options);
+    std::string expected;
+    for (int r = 1; r <= 3; ++r) {
+        collector.handleRow(sharedRow(r, {1, 0, 1, 2, 3}));
+        expected += "\"say \"\"hi\"\", please\";plain;\"say \"\"hi\"\", please\";;rich text\n";
+    }
+
+    // Chunk collectors keep caches of their own
+    auto chunk = collector.createChunkHandler();
+    chunk->handleRow(sharedRow(4, {3, 1}));
+    chunk->handleRow(sharedRow(5, {1, 3}));
+    collector.completeChunk(*chunk);
+    expected += "rich text;\"say \"\"hi\"\", please\"\n\"say \"\"hi\"\", please\";rich text\n";
+    EXPECT_EQ(collector.getCsvString(), expected);
+
+    xlsxcsv::CsvOptions spaces;
+    spaces.delimiter = ' ';
+    xlsxcsv::core::CsvRowCollector spaced(&provider, nullptr, xlsxcsv::core::DateSystem::Date1900, &spaces);
+    spaced.handleRow(sharedRow(1, {3, 0, 3}));
+    EXPECT_EQ(spaced.getCsvString(), "\"rich text\" plain \"rich text\"\n");
+}
+
+TEST_F(SharedStringsFileTest, PipelinedInflateParsesSameStrings) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::core::OpcPackage package;
+    package.open(xlsxPath.string());
+
+    for (auto mode : {xlsxcsv::core::SharedStringsMode::InMemory, xlsxcsv::core::SharedStringsMode::External}) {
+        xlsxcsv::core::SharedStringsConfig config;
+        config.mode = mode;
+        config.tempDirectory = testDir.string();
+        config.pipelinedInflate = true;
+        xlsxcsv::core::SharedStringsProvider provider(config);
+        provider.parse(package);
+        ASSERT_EQ(provider.getStringCount(), 4u);
+        EXPECT_EQ(provider.getStringView(0), "plain");
+        EXPECT_EQ(provider.getStringView(1), "say \"hi\", please");
+        EXPECT_EQ(provider.getStringView(2), "");
+        EXPECT_EQ(provider.getStringView(3), "rich text");
+    }
+}
+
+TEST_F(SharedStringsFileTest, ExternalStorageIsMapped) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::core::OpcPackage package;
+    package.open(xlsxPath.string());
+
+    const fs::path spillDir = testDir / "spill";
+    fs::create_directories(spillDir);
+
+    xlsxcsv::core::SharedStringsConfig config;
+    config.mode = xlsxcsv::core::SharedStringsMode::External;
+    config.tempDirectory = spillDir.string();
+    xlsxcsv::core::SharedStringsProvider provider(config);
+    provider.parse(package);
+    ASSERT_TRUE(provider.isUsingDisk());
+    ASSERT_EQ(provider.getStringCount(), 4u);
+
+    EXPECT_EQ(provider.getStringView(0), "plain");
+    EXPECT_EQ(provider.getStringView(2), "");
+    EXPECT_EQ(provider.getStringView(3), "rich text");
+    EXPECT_EQ(provider.tryGetString(1).value(), "say \"hi\", please");
+    EXPECT_FALSE(provider.tryGetStringView(4).has_value());
+    EXPECT_EQ(provider.getSpillReadCount(), 4u);
+
+    // Two providers spilling into the same directory never collide
+    xlsxcsv::core::SharedStringsProvider second(config);
+    second.parse(package);
+    EXPECT_EQ(second.getStringView(1), provider.getStringView(1));
+
+    provider.close();
+    second.close();
+    EXPECT_TRUE(fs::is_empty(spillDir));
+
+    config.tempDirectory = (testDir / "missing_dir").string();
+    xlsxcsv::core::SharedStringsProvider unwritable(config);
+    EXPECT_THROW(unwritable.parse(package), xlsxcsv::core::XlsxError);
+}
+
+TEST_F(SharedStringsFileTest, LazyModeDecodesOnFirstReference) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    // Richer table than the shared fixture: entities, CRLF, rich runs, empty items
+    auto root = testDir / "content";
+    std::ofstream(root / "xl" / "sharedStrings.xml", std::ios::binary) <<
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\r\n"
+        "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" count=\"6\">"
+        "<si><t>plain</t></si>"
+        "<si><t xml:space=\"preserve\"> a &amp; b &lt;c&gt; &#233;&#x4E2D; </t></si>"
+        "<si/>"
+        "<si><r><rPr><rFont val=\"a>b\"/></rPr><t>rich </t></r><r><t>text</t></r></si>"
+        "<si><t>line1\r\nline2</t></si>"
+        "<si><t/></si>"
+        "</sst>";
+    fs::remove(xlsxPath);
+    std::string cmd = "cd \"" + root.string() + "\" && zip -q -r ../strings.xlsx . > /dev/null 2>&1";
+    std::system(cmd.c_str());
+
+    xlsxcsv::core::OpcPackage package;
+    package.open(xlsxPath.string());
+
+    xlsxcsv::core::SharedStringsConfig eagerConfig;
+    eagerConfig.mode = xlsxcsv::core::SharedStringsMode::InMemory;
+    xlsxcsv::core::SharedStringsProvider eager(eagerConfig);
+    eager.parse(package);
+
+    xlsxcsv::core::SharedStringsConfig lazyConfig;
+    lazyConfig.mode = xlsxcsv::core::SharedStringsMode::Lazy;
+    xlsxcsv::core::SharedStringsProvider lazy(lazyConfig);
+    lazy.parse(package);
+
+    EXPECT_EQ(lazy.getActiveMode(), xlsxcsv::core::SharedStringsMode::Lazy);
+    ASSERT_EQ(lazy.getStringCount(), 6u);
+    ASSERT_EQ(lazy.getStringCount(), eager.getStringCount());
+    EXPECT_EQ(lazy.getMaterializedCount(), 0u);
+
+    EXPECT_EQ(lazy.getStringView(1), " a & b <c> \xC3\xA9\xE4\xB8\xAD ");
+    EXPECT_EQ(lazy.getMaterializedCount(), 1u);
+
+    // Repeat lookups reuse the decoded bytes
+    const char* first = lazy.getStringView(1).data();
+    EXPECT_EQ(lazy.getStringView(1).data(), first);
+    EXPECT_EQ(lazy.getMaterializedCount(), 1u);
+
+    for (size_t i = 0; i < eager.getStringCount(); ++i) {
+        EXPECT_EQ(lazy.getString(i), eager.getString(i)) << "index " << i;
+    }
+    EXPECT_EQ(lazy.getMaterializedCount(), 6u);
+    EXPECT_FALSE(lazy.tryGetStringView(6).has_value());
+}
+
+TEST_F(SharedStringsFileTest, LazyModeCountsDecodedStringsAndSpillsPastThreshold) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    // 20000 strings of 80 bytes, of which only two are read
+    constexpr int stringCount = 20000;
+    auto stringAt = [](int i) {
+        std::string text = "s" + std::to_string(100000 + i);
+        text.resize(80, 'x');
+        return text;
+    };
+    auto root = testDir / "content";
+    {
+        std::ofstream xml(root / "xl" / "sharedStrings.xml");
+        xml << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+               "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">";
+        for (int i = 0; i < stringCount; ++i) {
+            xml << "<si><t>" << stringAt(i) << "</t></si>";
+        }
+        xml << "</sst>";
+    }
+    fs::remove(xlsxPath);
+    std::string cmd = "cd \"" + root.string() + "\" && zip -q -r ../strings.xlsx . > /dev/null 2>&1";
+    std::system(cmd.c_str());
+
+    xlsxcsv::core::OpcPackage package;
+    package.open(xlsxPath.string());
+
+    xlsxcsv::core::SharedStringsConfig config;
+    config.mode = xlsxcsv::core::SharedStringsMode::InMemory;
+    xlsxcsv::core::SharedStringsProvider eager(config);
+    eager.parse(package);
+
+    // Below the threshold the raw XML is kept, and decoded strings add to it
+    xlsxcsv::core::MemoryTracker tracker;
+    config.mode = xlsxcsv::core::SharedStringsMode::Lazy;
+    config.memoryTracker = &tracker;
+    xlsxcsv::core::SharedStringsProvider pinned(config);
+    pinned.parse(package);
+    EXPECT_FALSE(pinned.isUsingDisk());
+    const size_t indexed = pinned.getMemoryUsage();
+    {
+        // Decodes are charged to the tracker scoped around the lookups
+        xlsxcsv::core::MemoryTracker::Scope scope(&tracker);
+        EXPECT_EQ(pinned.getString(7), stringAt(7));
+        EXPECT_EQ(pinned.getString(19000), stringAt(19000));
+    }
+    EXPECT_GT(pinned.getMemoryUsage(), indexed);
+    EXPECT_EQ(tracker.current(), pinned.getMemoryUsage());
+
+    // Past it the items are spilled, leaving only the index and decoded strings
+    const fs::path spillDir = testDir / "spill";
+    fs::create_directories(spillDir);
+    config.memoryThreshold = 1024;
+    config.tempDirectory = spillDir.string();
+    config.memoryTracker = nullptr;
+    xlsxcsv::core::SharedStringsProvider spilled(config);
+    spilled.parse(package);
+    EXPECT_EQ(spilled.getActiveMode(), xlsxcsv::core::SharedStringsMode::Lazy);
+    EXPECT_TRUE(spilled.isUsingDisk());
+    EXPECT_EQ(spilled.getString(7), stringAt(7));
+    EXPECT_EQ(spilled.getString(19000), stringAt(19000));
+    EXPECT_EQ(spilled.getString(7), stringAt(7));
+    EXPECT_EQ(spilled.getSpillReadCount(), 2u);
+    EXPECT_EQ(spilled.getMaterializedCount(), 2u);
+    EXPECT_LT(spilled.getMemoryUsage(), eager.getMemoryUsage());
+    EXPECT_LT(spilled.getMemoryUsage(), pinned.getMemoryUsage());
+
+    spilled.close();
+    EXPECT_TRUE(fs::is_empty(spillDir));
+}
+
+TEST(SharedStringDictionaryTest, WideSheetCostsDistinctValuesOnly) {
+    // 256 columns, each cycling through three indexes of a table with
+    // millions of strings; no provider, so indexes aren't range-checked
+    constexpr int columns = 256;
+    xlsxcsv::core::SharedStringDictionaryCollector collector(nullptr, nullptr, true);
+    for (int r = 1; r <= 300; ++r) {
+        xlsxcsv::core::RowData row;
+        row.rowNumber = r;
+        for (int c = 1; c <= columns; ++c) {
+            xlsxcsv::core::CellData cell;
+            cell.coordinate = {r, c};
+            cell.type = xlsxcsv::core::CellType::SharedString;
+            cell.value = 4000000 + c * 3 + r % 3;
+            row.cells.push_back(cell);
+        }
+        collector.handleRow(row);
+    }
+
+    // Row codes dominate; the index lookups stay a few entries per column
+    EXPECT_LT(collector.getMemoryUsage(), columns * (300 * sizeof(int32_t) * 2 + 1024));
+    const auto dictionaries = collector.takeDictionaries();
+    ASSERT_EQ(dictionaries.size(), static_cast<size_t>(columns));
+    for (const auto& dictionary : dictionaries) {
+        EXPECT_EQ(dictionary.indexes.size(), 3u);
+        EXPECT_EQ(dictionary.counts, (std::vector<uint64_t>{100, 100, 100}));
+    }
+}
+
+TEST_F(SharedStringsFileTest, DictionariesResolveOncePerDistinctString) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    xlsxcsv::core::OpcPackage package;
+    package.open(xlsxPath.string());
+    xlsxcsv::core::SharedStringsConfig config;
+    config.mode = xlsxcsv::core::SharedStringsMode::Lazy;
+    xlsxcsv::core::SharedStringsProvider provider(config);
+    provider.parse(package);
+
+    // Column A cycles through shared strings 1 and 3; column B holds an
+    // inline string, a number, a shared string and an out-of-range index
+    auto makeRow = [](int rowNumber) {
+        xlsxcsv::core::RowData row;
+        row.rowNumber = rowNumber;
+        xlsxcsv::core::CellData category;
+        category.coordinate = {rowNumber, 1};
+        category.type = xlsxcsv::core::CellType::SharedString;
+        category.value = rowNumber % 2 == 0 ? 1 : 3;
+        row.cells.push_back(category);
+        xlsxcsv::core::CellData other;
+        other.coordinate = {rowNumber, 2};
+        if (rowNumber == 1) {
+            other.type = xlsxcsv::core::CellType::InlineString;
+            other.value = std::string("plain");
+        } else if (rowNumber == 2) {
+            other.type = xlsxcsv::core::CellType::Number;
+            other.value = 2.5;
+        } else {
+            other.type = xlsxcsv::core::CellType::SharedString;
+            other.value = rowNumber == 3 ? 0 : 99;
+        }
+        row.cells.push_back(other);
+        return row;
+    };
+
+    xlsxcsv::core::SharedStringDictionaryCollector collector(&provider, nullptr, true);
+    for (int r = 1; r <= 5; ++r) {
+        collector.handleRow(makeRow(r));
+    }
+    EXPECT_EQ(collector.getRowCount(), 5u);
+    EXPECT_EQ(provider.getMaterializedCount(), 0u);
+
+    auto dictionaries = collector.takeDictionaries();
+    ASSERT_EQ(dictionaries.size(), 2u);
+    const auto& a = dictionaries[0];
+    EXPECT_EQ(a.column, 1);
+    EXPECT_EQ(a.indexes, (std::vector<uint32_t>{3, 1}));
+    EXPECT_EQ(a.counts, (std::vector<uint64_t>{3, 2}));
+    EXPECT_EQ(a.codes, (std::vector<int32_t>{0, 1, 0, 1, 0}));
+    EXPECT_EQ(a.otherCells, 0u);
+    const auto& b = dictionaries[1];
+    EXPECT_EQ(b.indexes, (std::vector<uint32_t>{0}));
+    EXPECT_EQ(b.codes, (std::vector<int32_t>{-1, -1, 0, -1, -1}));
+    EXPECT_EQ(b.otherCells, 2u);
+
+    const auto values = collector.resolveValues(a);
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_EQ(values[0], "rich text");
+    EXPECT_EQ(values[1], "say \"hi\", please");
+    EXPECT_EQ(provider.getMaterializedCount(), 2u);
+
+    // The Arrow builder also defers shared strings to export, and merges
+    // an inline string equal to a shared one into the same dictionary value
+    xlsxcsv::core::SharedStringsProvider columnarStrings(config);
+    columnarStrings.parse(package);
+    xlsxcsv::core::ColumnarBatchBuilder builder(&columnarStrings);
+    for (int r = 1; r <= 4; ++r) {
+        xlsxcsv::core::RowData row;
+        row.rowNumber = r;
+        xlsxcsv::core::CellData cell;
+        cell.coordinate = {r, 1};
+        if (r == 3) {
+            cell.type = xlsxcsv::core::CellType::InlineString;
+            cell.value = std::string("plain");
+        } else {
+            cell.type = xlsxcsv::core::CellType::SharedString;
+            cell.value = r == 2 ? 1 : 0;
+        }
+        row.cells.push_back(cell);
+        builder.handleRow(row);
+    }
+    EXPECT_EQ(columnarStrings.getMaterializedCount(), 0u);
+
+    ArrowArrayStream stream;
+    builder.exportStream(&stream);
+    EXPECT_EQ(columnarStrings.getMaterializedCount(), 2u);
+    ArrowArray batch;
+    ASSERT_EQ(stream.get_next(&stream, &batch), 0);
+    ASSERT_NE(batch.release, nullptr);
+    const ArrowArray* column = batch.children[0];
+    ASSERT_NE(column->dictionary, nullptr);
+    EXPECT_EQ(column->dictionary->length, 2);
+    const auto* codes = static_cast<const int32_t*>(column->buffers[1]);
+    EXPECT_EQ(codes[0], codes[2]);
+    EXPECT_EQ(codes[0], codes[3]);
+    EXPECT_NE(codes[0], codes[1]);
+    batch.release(&batch);
+    stream.release(&stream);
+}
@@ -1,6 +1,533 @@
 #include <gtest/gtest.h>
+#include "xlsxcsv/core.hpp"
+#include "xlsxcsv.hpp"
+#include <filesystem>
+#include <fstream>
+#include <cstdlib>
+#include <utility>
+
+namespace fs = std::filesystem;
+using namespace xlsxcsv::core;
+
+namespace {
+
+// Records every row so tests can assert on parsed content
+class RecordingHandler : public SheetRowHandler {
+public:
+    void handleRow(const RowData& row) override {
+        rows.push_back(row);
+    }
+    void handleError(const std::string& message) override {
+        errors.push_back(message);
+    }
+
+    std::vector<RowData> rows;
+    std::vector<std::string> errors;
+};
+
+} // namespace
 
 TEST(SheetStreamReaderTest, BasicFunctionality) {
     // TODO: Implement actual tests in Phase 5
     EXPECT_TRUE(true); // Placeholder test
 }
+
+class SheetStreamReaderFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "turboxl_sheet_stream_test";
+        fs::create_directories(testDir / "content" / "_rels");
+        fs::create_directories(testDir / "content" / "xl" / "_rels");
+        fs::create_directories(testDir / "content" / "xl" / "worksheets");
+
+        auto root = testDir / "content";
+        std::ofstream(root / "[Content_Types].xml") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">
+    <Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>
+    <Default Extension="xml" ContentType="application/xml"/>
+</Types>)";
+        std::ofstream(root / "_rels" / ".rels") <<
+R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+    <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument" Target="xl/workbook.xml"/>
+</Relationships>)";
+
+        // Large enough that libxml2 pulls it through several read callbacks
+        std::ofstream sheet(root / "xl" / "worksheets" / "sheet1.xml");
+        sheet << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<worksheet xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main"><sheetData>)";
+        for (int r = 1; r <= rowCount; ++r) {
+            sheet << "<row r=\"" << r << "\"><c r=\"A" << r << "\"><v>" << r
+                  << "</v></c><c r=\"B" << r << "\" t=\"inlineStr\"><is><t>row " << r
+                  << "</t></is></c></row>";
+        }
+        sheet << "</sheetData></worksheet>";
+        sheet.close();
+
+        std::string cmd = "cd \"" + root.string() + "\" && zip -q -r ../sheet.xlsx . > /dev/null 2>&1";
+        std::system(cmd.c_str());
+        xlsxPath = testDir / "sheet.xlsx";
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    static constexpr int rowCount = 2000;
+    fs::path testDir;
+    fs::path xlsxPath;
+};
+
+TEST_F(SheetStreamReaderFileTest, StreamedParseMatchesInMemoryParse) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    OpcPackage package;
+    package.open(xlsxPath.string());
+
+    SheetStreamReader reader;
+    RecordingHandler streamed;
+    reader.parseSheet(package, "worksheets/sheet1.xml", streamed);
+
+    RecordingHandler buffered;
+    auto xmlData = package.getZipReader().readEntry("xl/worksheets/sheet1.xml");
+    reader.parseSheetData(xmlData, buffered);
+
+    EXPECT_TRUE(streamed.errors.empty());
+    ASSERT_EQ(streamed.rows.size(), static_cast<size_t>(rowCount));
+    ASSERT_EQ(streamed.rows.size(), buffered.rows.size());
+
+    const auto& last = streamed.rows.back();
+    EXPECT_EQ(last.rowNumber, rowCount);
+    ASSERT_EQ(last.cells.size(), 2u);
+    EXPECT_DOUBLE_EQ(last.cells[0].getNumber(), rowCount);
+    EXPECT_EQ(last.cells[1].getString(), "row " + std::to_string(rowCount));
+
+    for (size_t i = 0; i < streamed.rows.size(); ++i) {
+        EXPECT_EQ(streamed.rows[i].cells[1].getString(), buffered.rows[i].cells[1].getString());
+    }
+}
+
+TEST_F(SheetStreamReaderFileTest, MissingWorksheetThrows) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    OpcPackage package;
+    package.open(xlsxPath.string());
+
+    SheetStreamReader reader;
+    RecordingHandler handler;
+    EXPECT_THROW(reader.parseSheet(package, "worksheets/missing.xml", handler), XlsxError);
+}
+
+namespace {
+
+void expectSameRows(const RecordingHandler& expected, const RecordingHandler& actual) {
+    ASSERT_EQ(expected.rows.size(), actual.rows.size());
+    for (size_t r = 0; r < expected.rows.size(); ++r) {
+        const RowData& a = expected.rows[r];
+        const RowData& b = actual.rows[r];
+        EXPECT_EQ(a.rowNumber, b.rowNumber);
+        EXPECT_EQ(a.hidden, b.hidden);
+        ASSERT_EQ(a.cells.size(), b.cells.size()) << "row " << a.rowNumber;
+        for (size_t c = 0; c < a.cells.size(); ++c) {
+            EXPECT_EQ(a.cells[c].coordinate.row, b.cells[c].coordinate.row);
+            EXPECT_EQ(a.cells[c].coordinate.column, b.cells[c].coordinate.column);
+            EXPECT_EQ(a.cells[c].type, b.cells[c].type);
+            EXPECT_EQ(a.cells[c].styleIndex, b.cells[c].styleIndex);
+            EXPECT_EQ(a.cells[c].value, b.cells[c].value) << "row " << a.rowNumber << " cell " << c;
+        }
+    }
+}
+
+// Also records metadata so hidden columns and merges can be compared
+class MetadataRecordingHandler : public RecordingHandler {
+public:
+    void handleWorksheetMetadata(const WorksheetMetadata& metadata) override {
+        ++metadataCalls;
+        last = metadata;
+    }
+
+    int metadataCalls = 0;
+    WorksheetMetadata last;
+};
+
+std::vector<uint8_t> toBytes(const std::string& xml) {
+    return std::vector<uint8_t>(xml.begin(), xml.end());
+}
+
+} // namespace
+
+TEST(SheetParserBackendTest, FastScannerMatchesLibXml) {
+    const std::string xml =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\r\n"
+        "<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+        "<!-- generated --><cols><col min=\"2\" max=\"3\" width=\"9.5\" hidden=\"1\"/></cols>"
+        "<sheetData>"
+        "<row r=\"1\" spans=\"1:4\"><c r=\"A1\" s=\"3\"><v>42.5</v></c><c r=\"B1\" t=\"s\"><v>7</v></c>"
+        "<c r=\"C1\" t=\"b\"><v>1</v></c><c r=\"D1\" t=\"e\"><v>#DIV/0!</v></c></row>"
+        "<row r=\"2\" hidden=\"true\"><c r=\"A2\" t=\"inlineStr\"><is><t xml:space=\"preserve\">a &amp; b &lt;c&gt; &#x41;&#66;\r\nline</t></is></c>"
+        "<c r=\"B2\" t=\"str\"><f>A1*2</f><v><![CDATA[x<y]]> &quot;q&apos;</v></c><c r=\"C2\"/>"
+        "<c r=\"D2\" t=\"inlineStr\"><is>\n  <t>spaced</t>\n</is></c><c r=\"E2\"><v> </v></c></row>"
+        "<row r=\"4\"/>"
+        "<row><c r=\"AB5\" t=\"n\"><v>1e3</v></c><c r=\"AC5\"><v>12x</v></c><c t=\"weird\"><v>v</v></c></row>"
+        "</sheetData>"
+        "<mergeCells count=\"1\"><mergeCell ref=\"A1:B2\"/></mergeCells>"
+        "</worksheet>";
+
+    SheetStreamReader reader;
+    MetadataRecordingHandler libxml;
+    reader.setParserBackend(SheetParserBackend::LibXml);
+    reader.parseSheetData(toBytes(xml), libxml);
+
+    MetadataRecordingHandler fast;
+    reader.setParserBackend(SheetParserBackend::Fast);
+    reader.parseSheetData(toBytes(xml), fast);
+
+    EXPECT_TRUE(libxml.errors.empty());
+    EXPECT_TRUE(fast.errors.empty()) << (fast.errors.empty() ? "" : fast.errors[0]);
+    ASSERT_EQ(fast.rows.size(), 4u);
+    expectSameRows(libxml, fast);
+    EXPECT_EQ(fast.rows[1].cells[0].getString(), "a & b <c> AB\nline");
+    EXPECT_EQ(fast.rows[1].cells[1].getString(), "x<y \"q'");
+
+    EXPECT_EQ(libxml.metadataCalls, fast.metadataCalls);
+    ASSERT_EQ(fast.last.columnInfo.size(), 1u);
+    EXPECT_EQ(fast.last.columnInfo[0].lastColumn, 3);
+    EXPECT_TRUE(fast.last.isColumnHidden(3));
+    EXPECT_DOUBLE_EQ(fast.last.columnInfo[0].width, 9.5);
+    ASSERT_EQ(fast.last.mergedCells.size(), 1u);
+    EXPECT_EQ(fast.last.mergedCells[0].toReference(), "A1:B2");
+}
+
+TEST(SheetParserBackendTest, FastScannerRejectsMalformedXml) {
+    SheetStreamReader reader;
+    reader.setParserBackend(SheetParserBackend::Fast);
+
+    for (const std::string xml : {"<worksheet><sheetData><row r=\"1\"><c><v>1</c></row></sheetData></worksheet>",
+                                  "<worksheet><sheetData><row r=\"1\"><c><v>1</v></c>",
+                                  "<worksheet><sheetData><row r=\"1\"><c t=\"str\"><v>&bogus;</v></c></row></sheetData></worksheet>"}) {
+        RecordingHandler handler;
+        reader.parseSheetData(toBytes(xml), handler);
+        EXPECT_FALSE(handler.errors.empty()) << xml;
+    }
+}
+
+TEST(SheetParserBackendTest, AutoFallsBackForDoctype) {
+    const std::string xml =
+        "<?xml version=\"1.0\"?><!DOCTYPE worksheet [<!ENTITY who \"world\">]>"
+        "<worksheet><sheetData><row r=\"1\"><c t=\"str\"><v>hello &who;</v></c></row></sheetData></worksheet>";
+
+    SheetStreamReader reader;
+    RecordingHandler fastOnly;
+    reader.setParserBackend(SheetParserBackend::Fast);
+    reader.parseSheetData(toBytes(xml), fastOnly);
+    EXPECT_FALSE(fastOnly.errors.empty());
+    EXPECT_TRUE(fastOnly.rows.empty());
+
+    RecordingHandler automatic;
+    reader.setParserBackend(SheetParserBackend::Auto);
+    reader.parseSheetData(toBytes(xml), automatic);
+    EXPECT_TRUE(automatic.errors.empty());
+    ASSERT_EQ(automatic.rows.size(), 1u);
+    EXPECT_EQ(automatic.rows[0].cells[0].getString(), "hello world");
+}
+
+TEST(SheetReadFilterTest, BackendsSkipRowsAndCellsAndStopEarly) {
+    const std::string rows =
+        "<worksheet><sheetData>"
+        "<row r=\"1\"><c r=\"A1\"><v>1</v></c><c r=\"B1\"><v>2</v></c><c r=\"C1\"><v>3</v></c></row>"
+        "<row r=\"2\"><c r=\"A2\"><v>4</v></c><c r=\"B2\" t=\"s\"><v>0</v></c><c r=\"C2\" t=\"inlineStr\"><is><t>c2</t></is></c></row>"
+        "<row r=\"3\" hidden=\"1\"><c r=\"A3\"><v>7</v></c></row>"
+        "<row r=\"4\"><c r=\"B4\"><v>8</v></c><c r=\"C4\"/><c><v>9</v></c></row>"
+        "<row r=\"5\"><c r=\"A5\"><v>10</v></c></row>";
+
+    SheetReadFilter filter;
+    filter.skipRows = 1;
+    filter.maxRows = 2;
+    filter.skipHiddenRows = true;
+    filter.keepColumn(1);
+    filter.keepColumn(3);
+    EXPECT_TRUE(filter.keepsColumn(3));
+    EXPECT_FALSE(filter.keepsColumn(2));
+
+    // libxml2 reads ahead of the rows it reports, so only the fast scanner is
+    // shown to stop early by a malformed tail it never reaches
+    const std::pair<SheetParserBackend, std::string> cases[] = {
+        {SheetParserBackend::Fast, rows + "<row r=\"6\"><c r=\"A6\"><v>11</c>"},
+        {SheetParserBackend::LibXml, rows + "</sheetData></worksheet>"}};
+    for (const auto& [backend, xml] : cases) {
+        SheetStreamReader reader;
+        reader.setParserBackend(backend);
+        reader.setReadFilter(filter);
+        RecordingHandler handler;
+        reader.parseSheetData(toBytes(xml), handler);
+
+        EXPECT_TRUE(handler.errors.empty()) << (handler.errors.empty() ? "" : handler.errors[0]);
+        ASSERT_EQ(handler.rows.size(), 2u);
+        EXPECT_EQ(handler.rows[0].rowNumber, 2);
+        ASSERT_EQ(handler.rows[0].cells.size(), 2u);
+        EXPECT_EQ(handler.rows[0].cells[0].getNumber(), 4.0);
+        EXPECT_EQ(handler.rows[0].cells[1].getString(), "c2");
+        EXPECT_EQ(handler.rows[1].rowNumber, 4);
+        ASSERT_EQ(handler.rows[1].cells.size(), 1u);
+        EXPECT_EQ(handler.rows[1].cells[0].coordinate.column, 3);
+    }
+}
+
+TEST(SheetReadFilterTest, BuiltFromCsvOptions) {
+    xlsxcsv::CsvOptions options;
+    options.rowOffset = 3;
+    options.rowLimit = 10;
+    options.includeHiddenRows = false;
+    options.columns = {std::string("b"), std::string("D:F"), 0};
+    const SheetReadFilter filter = makeSheetReadFilter(&options);
+    EXPECT_EQ(filter.skipRows, 3u);
+    EXPECT_EQ(filter.maxRows, 10u);
+    EXPECT_TRUE(filter.skipHiddenRows);
+    for (int column = 1; column <= 7; ++column) {
+        EXPECT_EQ(filter.keepsColumn(column), column != 3 && column != 7) << column;
+    }
+
+    EXPECT_FALSE(makeSheetReadFilter(nullptr).isActive());
+    EXPECT_EQ(makeSheetReadFilter(&options).maxRows, 10u);
+    for (const auto& bad : std::vector<std::variant<std::string, int>>{std::string("A1"), std::string("C:A"),
+                                                                      std::string(""), -1, 16384}) {
+        options.columns = {bad};
+        EXPECT_THROW(makeSheetReadFilter(&options), std::invalid_argument);
+    }
+}
+
+TEST_F(SheetStreamReaderFileTest, StreamedBackendsAgree) {
+    if (!fs::exists(xlsxPath)) {
+        GTEST_SKIP() << "Test XLSX file could not be created";
+    }
+
+    OpcPackage package;
+    package.open(xlsxPath.string());
+
+    SheetStreamReader reader;
+    RecordingHandler libxml;
+    reader.setParserBackend(SheetParserBackend::LibXml);
+    reader.parseSheet(package, "worksheets/sheet1.xml", libxml);
+
+    RecordingHandler fast;
+    reader.setParserBackend(SheetParserBackend::Fast);
+    reader.parseSheet(package, "worksheets/sheet1.xml", fast);
+
+    EXPECT_TRUE(fast.errors.empty());
+    ASSERT_EQ(fast.rows.size(), static_cast<size_t>(rowCount));
+    expectSameRows(libxml, fast);
+}
+
+namespace {
+
+// Gives every chunk a RecordingHandler and concatenates them in completion order
+class RecordingChunks : public ChunkedRowHandler {
+public:
+    std::unique_ptr<SheetRowHandler> createChunkHandler() override {
+        return std::make_unique<MetadataRecordingHandler>();
+    }
+    void completeChunk(SheetRowHandler& chunk) override {
+        auto& recorded = static_cast<MetadataRecordingHandler&>(chunk);
+        for (const RowData& row : recorded.rows) {
+            rows.rows.push_back(row);
+        }
+        rows.errors.insert(rows.errors.end(), recorded.errors.begin(), recorded.errors.end());
+        lastMetadata = recorded.last;
+        ++chunks;
+    }
+
+    RecordingHandler rows;
+    WorksheetMetadata lastMetadata;
+    int chunks = 0;
+};
+
+// Several MiB of rows so the parallel reader splits them into chunks; filler
+// is inserted after every 1000th row
+std::string largeWorksheet(int rowCount, const std::string& filler = "") {
+    std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                      "<worksheet><cols><col min=\"2\" max=\"2\" hidden=\"1\"/></cols><sheetData>";
+    for (int r = 1; r <= rowCount; ++r) {
+        const std::string n = std::to_string(r);
+        xml += "<row r=\"" + n + "\"><c r=\"A" + n + "\"><v>" + n + "</v></c>"
+               "<c r=\"B" + n + "\" t=\"inlineStr\"><is><t>row, " + n + "</t></is></c>"
+               "<c r=\"C" + n + "\" t=\"str\"><v>x&amp;y</v></c></row>\n";
+        if (r % 1000 == 0) {
+            xml += filler;
+        }
+    }
+    xml += "</sheetData><mergeCells count=\"1\"><mergeCell ref=\"A1:B2\"/></mergeCells></worksheet>";
+    return xml;
+}
+
+} // namespace
+
+TEST(SheetStreamReaderParallelTest, ChunksMatchSerialParse) {
+    const auto xml = toBytes(largeWorksheet(60000));
+
+    SheetStreamReader reader;
+    MetadataRecordingHandler serial;
+    reader.parseSheetData(xml, serial);
+
+    RecordingChunks parallel;
+    reader.parseSheetDataParallel(xml, parallel, 4);
+
+    EXPECT_GT(parallel.chunks, 1);
+    EXPECT_TRUE(parallel.rows.errors.empty());
+    expectSameRows(serial, parallel.rows);
+    EXPECT_EQ(parallel.lastMetadata.columnInfo.size(), 1u);
+    EXPECT_EQ(parallel.lastMetadata.mergedCells.size(), 1u);
+}
+
+TEST(SheetStreamReaderParallelTest, SplitInsideCommentIsReparsed) {
+    // Comments full of row markup, so some split points land inside one
+    std::string filler = "<!-- ";
+    for (int i = 0; i < 2000; ++i) {
+        filler += "<row r=\"9\"><c><v>0</v></c></row>";
+    }
+    filler += " -->";
+    const auto xml = toBytes(largeWorksheet(20000, filler));
+
+    SheetStreamReader reader;
+    RecordingHandler serial;
+    reader.parseSheetData(xml, serial);
+
+    RecordingChunks parallel;
+    reader.parseSheetDataParallel(xml, parallel, 8);
+
+    EXPECT_TRUE(parallel.rows.errors.empty());
+    ASSERT_EQ(serial.rows.size(), 20000u);
+    expectSameRows(serial, parallel.rows);
+}
+
+TEST(SheetStreamReaderParallelTest, MalformedRowsReportLikeSerialParse) {
+    std::string text = largeWorksheet(60000);
+    // Break an end tag well past the first split point
+    const size_t broken = text.find("</row>", text.size() * 3 / 4);
+    text.replace(broken, 6, "</rox>");
+    const auto xml = toBytes(text);
+
+    SheetStreamReader reader;
+    RecordingHandler serial;
+    reader.parseSheetData(xml, serial);
+
+    RecordingChunks parallel;
+    reader.parseSheetDataParallel(xml, parallel, 4);
+
+    ASSERT_EQ(serial.errors.size(), 1u);
+    EXPECT_EQ(parallel.rows.errors, serial.errors);
+    expectSameRows(serial, parallel.rows);
+}
+
+TEST(SheetStreamReaderParallelTest, CsvCollectorChunksMatchSerialCsv) {
+    const auto xml = toBytes(largeWorksheet(60000));
+    xlsxcsv::CsvOptions options;
+    options.includeBom = true;
+    options.includeHiddenColumns = false;
+
+    SheetStreamReader reader;
+    CsvRowCollector serial(nullptr, nullptr, DateSystem::Date1900, &options);
+    reader.parseSheetData(xml, serial);
+
+    CsvRowCollector parallel(nullptr, nullptr, DateSystem::Date1900, &options);
+    reader.parseSheetDataParallel(xml, parallel, 4);
+
+    EXPECT_TRUE(parallel.getErrors().empty());
+    EXPECT_EQ(parallel.getRowCount(), serial.getRowCount());
+    const std::string expected = serial.takeCsvString();
+    const std::string actual = parallel.takeCsvString();
+    EXPECT_EQ(actual.rfind("\xEF\xBB\xBF", 0), 0u);
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(SheetStreamReaderParallelTest, SmallOrSingleThreadedSheetsUseOneChunk) {
+    const auto xml = toBytes(largeWorksheet(10));
+
+    SheetStreamReader reader;
+    RecordingChunks small;
+    reader.parseSheetDataParallel(xml, small, 4);
+    EXPECT_EQ(small.chunks, 1);
+    EXPECT_EQ(small.rows.rows.size(), 10u);
+
+    RecordingChunks libxml;
+    reader.setParserBackend(SheetParserBackend::LibXml);
+    reader.parseSheetDataParallel(xml, libxml, 4);
+    EXPECT_EQ(libxml.chunks, 1);
+    expectSameRows(small.rows, libxml.rows);
+}
+
+TEST(SheetStreamReaderMemoryTest, ChargesLibxmlAndOutputBuffers) {
+    const auto xml = toBytes(largeWorksheet(5000));
+
+    // Output buffers are charged while they are held and released on hand-off
+    MemoryTracker tracker;
+    SheetStreamReader reader;
+    reader.setMemoryTracker(&tracker);
+    CsvRowCollector collector;
+    collector.setMemoryTracker(&tracker);
+    reader.parseSheetDataParallel(xml, collector, 4);
+    EXPECT_TRUE(collector.getErrors().empty());
+    EXPECT_GT(tracker.current(), 0u);
+    const std::string csv = collector.takeCsvString();
+    EXPECT_GE(tracker.peak(), csv.size());
+    EXPECT_LT(tracker.current(), 1024u); // Empty buffers only
+
+    if (MemoryTracker::installLibxmlHooks()) {
+        MemoryTracker libxmlTracker;
+        reader.setMemoryTracker(&libxmlTracker);
+        reader.setParserBackend(SheetParserBackend::LibXml);
+        RecordingHandler rows;
+        reader.parseSheetData(xml, rows);
+        EXPECT_TRUE(rows.errors.empty());
+        EXPECT_EQ(rows.rows.size(), 5000u);
+        EXPECT_GT(libxmlTracker.peak(), 0u);
+    }
+}
+
+TEST(SheetStreamReaderMemoryTest, LimitTurnsIntoParseErrors) {
+    const auto xml = toBytes(largeWorksheet(20000));
+
+    MemoryTracker tracker(64 * 1024);
+    SheetStreamReader reader;
+    reader.setMemoryTracker(&tracker);
+    CsvRowCollector collector;
+    collector.setMemoryTracker(&tracker);
+    // Refusals inside a parse become errors; others, such as completing a
+    // chunk, throw
+    bool aborted = false;
+    try {
+        reader.parseSheetDataParallel(xml, collector, 4);
+        aborted = !collector.getErrors().empty();
+    } catch (const MemoryLimitError&) {
+        aborted = true;
+    }
+    EXPECT_TRUE(aborted);
+    EXPECT_TRUE(tracker.limitExceeded());
+    EXPECT_LE(tracker.peak(), 64u * 1024);
+}
+
+TEST(SheetStreamReaderMemoryTest, LibxmlRefusalsAreReportedNotPrinted) {
+    if (!MemoryTracker::installLibxmlHooks()) {
+        GTEST_SKIP() << "libxml2 allocations cannot be tracked here";
+    }
+    const auto xml = toBytes(largeWorksheet(5000));
+
+    for (uint64_t limit : {1024u, 4u * 1024, 16u * 1024}) {
+        MemoryTracker tracker(limit);
+        SheetStreamReader reader;
+        reader.setMemoryTracker(&tracker);
+        reader.setParserBackend(SheetParserBackend::LibXml);
+        RecordingHandler rows;
+        testing::internal::CaptureStderr();
+        reader.parseSheetData(xml, rows);
+        EXPECT_EQ(testing::internal::GetCapturedStderr(), "");
+        ASSERT_FALSE(rows.errors.empty()) << "limit " << limit;
+        // Creating the reader or reading can fail, each with its own wording
+        EXPECT_NE(rows.errors[0].find("alloc"), std::string::npos) << rows.errors[0];
+        EXPECT_TRUE(tracker.limitExceeded());
+    }
+}
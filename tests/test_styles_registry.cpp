@@ -27,7 +27,7 @@ protected:
     }
     
     void createBasicStylesXlsx() {
-        std::string zipCmd = "cd \"" + testDir.string() + "\" && zip -q \"" + 
+        std::string zipCmd = "cd \"" + testDir.string() + "\" && zip -q -r \"" + 
                             basicStylesXlsxPath.filename().string() + "\" ";
         
         // Create directory structure
@@ -126,7 +126,7 @@ R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
     }
     
     void createComplexStylesXlsx() {
-        std::string zipCmd = "cd \"" + testDir.string() + "\" && zip -q \"" + 
+        std::string zipCmd = "cd \"" + testDir.string() + "\" && zip -q -r \"" + 
                             complexStylesXlsxPath.filename().string() + "\" ";
         
         // Create directory structure  
@@ -261,7 +261,7 @@ R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
     }
     
     void createDateFormatsXlsx() {
-        std::string zipCmd = "cd \"" + testDir.string() + "\" && zip -q \"" + 
+        std::string zipCmd = "cd \"" + testDir.string() + "\" && zip -q -r \"" + 
                             dateFormatsXlsxPath.filename().string() + "\" ";
         
         // Create directory structure
@@ -579,6 +579,63 @@ TEST_F(StylesRegistryTest, ComplexStylesParsing) {
     EXPECT_TRUE(style2->font.underline);
 }
 
+TEST_F(StylesRegistryTest, FormatCodeLexerSkipsLiteralsAndBrackets) {
+    xlsxcsv::core::StylesRegistry registry;
+    using xlsxcsv::core::NumberFormatType;
+    
+    // Colours, conditions and quoted or escaped text are not date tokens
+    EXPECT_EQ(registry.detectNumberFormatType("0.00;[Red]-0.00"), NumberFormatType::Decimal);
+    EXPECT_EQ(registry.detectNumberFormatType("[<100]0;[Blue]0"), NumberFormatType::Integer);
+    EXPECT_EQ(registry.detectNumberFormatType("0 \"days\""), NumberFormatType::Integer);
+    EXPECT_EQ(registry.detectNumberFormatType("0\\d"), NumberFormatType::Integer);
+    EXPECT_EQ(registry.detectNumberFormatType("#,##0_);[Red](#,##0)"), NumberFormatType::Integer);
+    
+    // "m" is a minute after an hour or before a second, a month otherwise
+    EXPECT_EQ(registry.detectNumberFormatType("mm:ss"), NumberFormatType::Time);
+    EXPECT_EQ(registry.detectNumberFormatType("[h]:mm"), NumberFormatType::Time);
+    EXPECT_EQ(registry.detectNumberFormatType("[mm]:ss"), NumberFormatType::Time);
+    EXPECT_EQ(registry.detectNumberFormatType("mmm yy"), NumberFormatType::Date);
+    EXPECT_EQ(registry.detectNumberFormatType("mm"), NumberFormatType::Date);
+    EXPECT_EQ(registry.detectNumberFormatType("yyyy\"T\"hh:mm"), NumberFormatType::DateTime);
+    
+    // Locale tags only make a currency when they carry a symbol
+    EXPECT_EQ(registry.detectNumberFormatType("[$-409]#,##0"), NumberFormatType::Integer);
+    EXPECT_EQ(registry.detectNumberFormatType("[$EUR-407] #,##0.00"), NumberFormatType::Currency);
+    EXPECT_EQ(registry.detectNumberFormatType("[$-F800]dddd, mmmm dd, yyyy"), NumberFormatType::Date);
+}
+
+TEST_F(StylesRegistryTest, NumberFormatsOnlyMode) {
+    if (!fs::exists(complexStylesXlsxPath)) {
+        GTEST_SKIP() << "Complex styles test XLSX file could not be created";
+    }
+    
+    xlsxcsv::core::OpcPackage package;
+    package.open(complexStylesXlsxPath.string());
+    
+    xlsxcsv::core::StylesRegistry full;
+    full.parse(package);
+    xlsxcsv::core::StylesRegistry numFmtOnly;
+    numFmtOnly.parse(package, xlsxcsv::core::StylesParseMode::NumberFormatsOnly);
+    
+    ASSERT_EQ(numFmtOnly.getStyleCount(), full.getStyleCount());
+    EXPECT_EQ(numFmtOnly.getNumberFormatCount(), full.getNumberFormatCount());
+    for (int i = 0; i < static_cast<int>(full.getStyleCount()); ++i) {
+        EXPECT_EQ(numFmtOnly.getDateTimeKind(i), full.getDateTimeKind(i)) << "style " << i;
+        auto style = numFmtOnly.getCellStyle(i);
+        ASSERT_TRUE(style.has_value());
+        EXPECT_EQ(style->styleIndex, i);
+        EXPECT_EQ(style->numberFormat.formatCode, full.getCellStyle(i)->numberFormat.formatCode);
+    }
+    EXPECT_EQ(numFmtOnly.getDateTimeKind(1), xlsxcsv::core::DateTimeKind::Date);
+    EXPECT_EQ(numFmtOnly.getDateTimeKind(2), xlsxcsv::core::DateTimeKind::Time);
+    EXPECT_EQ(numFmtOnly.getDateTimeKind(3), xlsxcsv::core::DateTimeKind::DateTime);
+    EXPECT_EQ(numFmtOnly.getDateTimeKind(4), xlsxcsv::core::DateTimeKind::None);
+    
+    // Fonts, fills and borders are left at their defaults
+    EXPECT_EQ(numFmtOnly.getCellStyle(1)->font.name, "Calibri");
+    EXPECT_EQ(full.getCellStyle(1)->font.name, "Times New Roman");
+}
+
 TEST_F(StylesRegistryTest, CloseRegistry) {
     if (!fs::exists(basicStylesXlsxPath)) {
         GTEST_SKIP() << "Basic styles test XLSX file could not be created";
@@ -643,7 +700,7 @@ TEST_F(StylesRegistryTest, MissingStylesFile) {
     // Create a simple XLSX without styles.xml
     fs::path noStylesPath = testDir / "no_styles.xlsx";
     
-    std::string zipCmd = "cd \"" + testDir.string() + "\" && zip -q \"" + 
+    std::string zipCmd = "cd \"" + testDir.string() + "\" && zip -q -r \"" + 
                         noStylesPath.filename().string() + "\" ";
     
     // Create minimal XLSX structure without styles.xml
@@ -2,6 +2,10 @@
 #include "xlsxcsv/core.hpp"
 #include <fstream>
 #include <filesystem>
+#include <atomic>
+#include <span>
+#include <thread>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -127,6 +131,12 @@ TEST_F(ZipReaderTest, HasEntry) {
     
     EXPECT_TRUE(reader.hasEntry("test.txt"));
     EXPECT_FALSE(reader.hasEntry("nonexistent.txt"));
+
+    const auto* entry = reader.findEntry("test.txt");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->path, "test.txt");
+    EXPECT_EQ(entry->uncompressedSize, reader.readEntry("test.txt").size());
+    EXPECT_EQ(reader.findEntry("nonexistent.txt"), nullptr);
 }
 
 TEST_F(ZipReaderTest, ReadEntry) {
@@ -168,6 +178,232 @@ TEST_F(ZipReaderTest, ReadNonExistentEntry) {
     EXPECT_THROW(reader.readEntryAsString("nonexistent.txt"), xlsxcsv::core::XlsxError);
 }
 
+TEST_F(ZipReaderTest, StreamEntry) {
+    if (!fs::exists(testZipPath)) {
+        GTEST_SKIP() << "Test ZIP file could not be created";
+    }
+    
+    xlsxcsv::core::ZipReader reader;
+    reader.open(testZipPath.string());
+    
+    auto stream = reader.openEntryStream("test.txt");
+    EXPECT_TRUE(stream.isOpen());
+    EXPECT_EQ(stream.path(), "test.txt");
+    EXPECT_EQ(stream.uncompressedSize(), 34u);
+    
+    // Read in deliberately tiny chunks to exercise chunk boundaries
+    std::string content;
+    uint8_t buffer[5];
+    size_t bytesRead = 0;
+    while ((bytesRead = stream.read(buffer, sizeof(buffer))) > 0) {
+        content.append(reinterpret_cast<const char*>(buffer), bytesRead);
+    }
+    EXPECT_EQ(content, "Hello, World!\nThis is a test file.");
+    EXPECT_EQ(stream.bytesRead(), content.size());
+    EXPECT_EQ(stream.read(buffer, sizeof(buffer)), 0u);
+}
+
+TEST_F(ZipReaderTest, StreamEntryLifecycle) {
+    if (!fs::exists(testZipPath)) {
+        GTEST_SKIP() << "Test ZIP file could not be created";
+    }
+    
+    xlsxcsv::core::ZipReader reader;
+    reader.open(testZipPath.string());
+    
+    EXPECT_THROW(reader.openEntryStream("nonexistent.txt"), xlsxcsv::core::XlsxError);
+    
+    {
+        auto stream = reader.openEntryStream("test.txt");
+        // Streams have independent inflate state, so other reads can interleave
+        auto second = reader.openEntryStream("test.txt");
+        uint8_t buffer[8];
+        EXPECT_EQ(stream.read(buffer, sizeof(buffer)), sizeof(buffer));
+        EXPECT_EQ(reader.readEntryAsString("test.txt"), "Hello, World!\nThis is a test file.");
+        EXPECT_EQ(second.read(buffer, sizeof(buffer)), sizeof(buffer));
+        EXPECT_EQ(std::string(reinterpret_cast<const char*>(buffer), sizeof(buffer)), "Hello, W");
+        stream.close();
+        EXPECT_FALSE(stream.isOpen());
+        EXPECT_EQ(stream.bytesRead(), sizeof(buffer));
+        EXPECT_TRUE(second.isOpen());
+    }
+    
+    EXPECT_NO_THROW(reader.readEntry("test.txt"));
+}
+
+TEST_F(ZipReaderTest, ConcurrentReads) {
+    if (!fs::exists(testZipPath)) {
+        GTEST_SKIP() << "Test ZIP file could not be created";
+    }
+    
+    xlsxcsv::core::ZipReader reader;
+    reader.open(testZipPath.string());
+    
+    // One reader serves many threads without external locking
+    std::atomic<int> matches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 50; ++i) {
+                if (reader.hasEntry("test.txt") &&
+                    reader.readEntryAsString("test.txt") == "Hello, World!\nThis is a test file.") {
+                    ++matches;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(matches.load(), 8 * 50);
+}
+
+TEST_F(ZipReaderTest, StoredAndZip64Entries) {
+    // Stored (uncompressed) entry
+    std::string cmd = "cd " + testDir.string() + " && zip -q -0 stored.zip test.txt";
+    system(cmd.c_str());
+    // Archives written from a pipe use ZIP64 records
+    cmd = "cd " + testDir.string() + " && printf 'piped data' | zip -q zip64.zip -";
+    system(cmd.c_str());
+    if (!fs::exists(testDir / "stored.zip") || !fs::exists(testDir / "zip64.zip")) {
+        GTEST_SKIP() << "Test ZIP files could not be created";
+    }
+    
+    xlsxcsv::core::ZipReader stored;
+    stored.open((testDir / "stored.zip").string());
+    auto entries = stored.listEntries();
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].compressionMethod, 0);
+    EXPECT_EQ(stored.readEntryAsString("test.txt"), "Hello, World!\nThis is a test file.");
+    
+    xlsxcsv::core::ZipReader zip64;
+    zip64.open((testDir / "zip64.zip").string());
+    EXPECT_EQ(zip64.readEntryAsString("-"), "piped data");
+}
+
+TEST_F(ZipReaderTest, CrcMismatchDetected) {
+    std::string cmd = "cd " + testDir.string() + " && zip -q -0 stored.zip test.txt";
+    system(cmd.c_str());
+    auto zipPath = testDir / "stored.zip";
+    if (!fs::exists(zipPath)) {
+        GTEST_SKIP() << "Test ZIP file could not be created";
+    }
+    
+    // Flip one byte of the stored payload so only the CRC can catch it
+    {
+        std::fstream file(zipPath, std::ios::in | std::ios::out | std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto pos = bytes.find("Hello, World!");
+        ASSERT_NE(pos, std::string::npos);
+        file.seekp(static_cast<std::streamoff>(pos));
+        file.put('J');
+    }
+    
+    xlsxcsv::core::ZipReader reader;
+    reader.open(zipPath.string());
+    EXPECT_THROW(reader.readEntry("test.txt"), xlsxcsv::core::XlsxError);
+    
+    auto stream = reader.openEntryStream("test.txt");
+    uint8_t buffer[64];
+    EXPECT_THROW({
+        while (stream.read(buffer, sizeof(buffer)) > 0) {}
+    }, xlsxcsv::core::XlsxError);
+    
+    // The pipeline's inflate thread hands the error over to the reader
+    auto pipelined = reader.openPipelinedEntryStream("test.txt");
+    EXPECT_THROW({
+        while (pipelined.read(buffer, sizeof(buffer)) > 0) {}
+    }, xlsxcsv::core::XlsxError);
+}
+
+TEST_F(ZipReaderTest, PipelinedStreamMatchesEntry) {
+    std::string big;
+    for (int i = 0; i < 50000; ++i) {
+        big += "<row r=\"" + std::to_string(i) + "\"><v>" + std::to_string(i * 3) + "</v></row>";
+    }
+    std::ofstream(testDir / "big.txt", std::ios::binary) << big;
+    std::string cmd = "cd " + testDir.string() + " && zip -q pipe.zip test.txt big.txt";
+    system(cmd.c_str());
+    auto zipPath = testDir / "pipe.zip";
+    if (!fs::exists(zipPath)) {
+        GTEST_SKIP() << "Test ZIP file could not be created";
+    }
+    
+    xlsxcsv::core::ZipReader reader;
+    reader.open(zipPath.string());
+    
+    // Small chunks and an odd read size make every handoff path run many times
+    auto stream = reader.openPipelinedEntryStream("big.txt", 4096, 3);
+    EXPECT_TRUE(stream.isOpen());
+    EXPECT_EQ(stream.uncompressedSize(), big.size());
+    std::string streamed;
+    uint8_t buffer[1000];
+    while (size_t n = stream.read(buffer, sizeof(buffer))) {
+        streamed.append(reinterpret_cast<const char*>(buffer), n);
+    }
+    EXPECT_EQ(streamed, big);
+    EXPECT_EQ(stream.bytesRead(), big.size());
+    EXPECT_EQ(stream.read(buffer, sizeof(buffer)), 0u);
+    
+    auto small = reader.openPipelinedEntryStream("test.txt");
+    std::string text(64, '\0');
+    text.resize(small.read(reinterpret_cast<uint8_t*>(text.data()), text.size()));
+    EXPECT_EQ(text, "Hello, World!\nThis is a test file.");
+    
+    // Closing mid-entry stops the inflate thread while it waits for space
+    auto abandoned = reader.openPipelinedEntryStream("big.txt", 1024, 2);
+    EXPECT_GT(abandoned.read(buffer, sizeof(buffer)), 0u);
+    abandoned.close();
+    EXPECT_FALSE(abandoned.isOpen());
+    EXPECT_EQ(abandoned.bytesRead(), sizeof(buffer));
+}
+
+TEST_F(ZipReaderTest, MemoryAndMappedSources) {
+    // A deflated entry large enough to take several inflate rounds
+    std::string big;
+    for (int i = 0; i < 20000; ++i) {
+        big += "row " + std::to_string(i) + ",value " + std::to_string(i * 7) + "\n";
+    }
+    std::ofstream(testDir / "big.txt", std::ios::binary) << big;
+    std::string cmd = "cd " + testDir.string() + " && zip -q both.zip test.txt big.txt";
+    system(cmd.c_str());
+    auto zipPath = testDir / "both.zip";
+    if (!fs::exists(zipPath)) {
+        GTEST_SKIP() << "Test ZIP file could not be created";
+    }
+    
+    std::ifstream file(zipPath, std::ios::binary);
+    const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const std::span<const std::byte> data(reinterpret_cast<const std::byte*>(bytes.data()), bytes.size());
+    
+    xlsxcsv::core::ZipReader fromMemory;
+    fromMemory.open(data);
+    xlsxcsv::core::ZipReader mapped;
+    mapped.openMapped(zipPath.string());
+    
+    for (auto* reader : {&fromMemory, &mapped}) {
+        ASSERT_TRUE(reader->isOpen());
+        EXPECT_EQ(reader->listEntries().size(), 2u);
+        EXPECT_EQ(reader->readEntryAsString("test.txt"), "Hello, World!\nThis is a test file.");
+        EXPECT_EQ(reader->readEntryAsString("big.txt"), big);
+        
+        std::string streamed;
+        auto stream = reader->openEntryStream("big.txt");
+        uint8_t buffer[4096];
+        while (size_t n = stream.read(buffer, sizeof(buffer))) {
+            streamed.append(reinterpret_cast<const char*>(buffer), n);
+        }
+        EXPECT_EQ(streamed, big);
+    }
+    
+    // Truncated or garbage buffers fail like damaged files do
+    xlsxcsv::core::ZipReader truncated;
+    EXPECT_THROW(truncated.open(data.first(data.size() / 2)), xlsxcsv::core::XlsxError);
+    EXPECT_FALSE(truncated.isOpen());
+    EXPECT_THROW(truncated.open(std::span<const std::byte>()), xlsxcsv::core::XlsxError);
+    EXPECT_THROW(truncated.openMapped((testDir / "missing.zip").string()), xlsxcsv::core::XlsxError);
+}
+
 TEST_F(ZipReaderTest, CloseFile) {
     if (!fs::exists(testZipPath)) {
         GTEST_SKIP() << "Test ZIP file could not be created";
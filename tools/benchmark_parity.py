@@ -3,7 +3,7 @@ import argparse
 import csv
 import hashlib
 import io
-import os
+import json
 import statistics
 import subprocess
 import sys
@@ -61,29 +61,39 @@ def calamine_to_csv(path, sheet_index):
     return out.getvalue(), row_count
 
 
+TIMING_KEYS = [
+    ("open", "open_ms"),
+    ("workbook", "workbook_ms"),
+    ("styles", "styles_ms"),
+    ("shared_strings", "shared_strings_ms"),
+    ("parse_sheet", "parse_sheet_ms"),
+    ("assemble_csv", "assemble_csv_ms"),
+    ("total", "total_ms"),
+]
+
+
 def turboxl_to_csv(path, sheet_index, profile=False):
-    env = os.environ.copy()
-    if profile:
-        env["TURBOXL_PROFILE_TIMINGS"] = "1"
+    # Runs in a fresh interpreter so each round pays the same cold-start costs
     code = (
-        "import turboxl,sys\n"
+        "import json,turboxl,sys\n"
         "p=sys.argv[1]\n"
         "i=int(sys.argv[2])\n"
-        "print(turboxl.read_sheet_to_csv(p, i), end='')\n"
+        "stats={}\n"
+        "print(turboxl.read_sheet_to_csv(p, i, stats=stats), end='')\n"
+        "print(json.dumps(stats), file=sys.stderr)\n"
     )
     proc = subprocess.run(
         [sys.executable, "-c", code, path, str(sheet_index)],
         check=True,
         capture_output=True,
         text=True,
-        env=env,
     )
     csv_text = proc.stdout
     timing_line = ""
-    for line in proc.stderr.splitlines():
-        if line.startswith("turboxl_timing_ms"):
-            timing_line = line
-            break
+    if profile:
+        stats = json.loads(proc.stderr.strip().splitlines()[-1])
+        fields = " ".join(f"{name}={stats[key]:.3f}" for name, key in TIMING_KEYS)
+        timing_line = f"turboxl_timing_ms {fields} rows={stats['rows']}"
     return csv_text, timing_line
 
 
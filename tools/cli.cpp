@@ -0,0 +1,1003 @@
+// turboxl_cli - batch XLSX to CSV conversion
+//
+// Converts single workbooks, every sheet of a workbook, or whole directories
+// and glob patterns of workbooks in one process. Files are converted
+// concurrently on a ConversionScheduler, admitted against an optional memory
+// budget estimated from each archive's central directory, and every
+// CSV is streamed straight to disk (or stdout) as it is encoded.
+
+#include "xlsxcsv.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* PROGRAM = "turboxl_cli";
+
+void printUsage(std::FILE* out) {
+    std::fprintf(out,
+        "Usage: %s [options] <input>...\n"
+        "\n"
+        "Inputs are .xlsx/.xlsm files, directories, or glob patterns such as\n"
+        "'data/*.xlsx' (quote them to bypass the shell's argument limit).\n"
+        "\n"
+        "Selection:\n"
+        "  -s, --sheet NAME|INDEX   Sheet to convert (default: first sheet)\n"
+        "  -a, --all-sheets         Convert every visible sheet\n"
+        "      --hidden-sheets      With --all-sheets, include hidden sheets too\n"
+        "  -r, --recursive          Descend into subdirectories of directory inputs\n"
+        "      --files-from FILE    Read additional inputs, one per line ('-' = stdin)\n"
+        "      --skip-rows N        Leave out the first N rows of each sheet\n"
+        "      --max-rows N         Write at most N rows per sheet and stop parsing there\n"
+        "      --columns LIST       Keep only these columns: letters, ranges or 0-based\n"
+        "                           indexes separated by commas, e.g. A,C:E,7\n"
+        "\n"
+        "Output:\n"
+        "  -o, --output PATH        Output directory, a .csv file for a single\n"
+        "                           conversion, or '-' for stdout (default: next\n"
+        "                           to each input)\n"
+        "  -d, --delimiter CHAR     Field delimiter (default ','; 'tab' for TAB)\n"
+        "      --crlf               Use CRLF line endings\n"
+        "      --bom                Write a UTF-8 BOM\n"
+        "      --shortest-numbers   Shortest round-trip number formatting\n"
+        "      --merged-propagate   Repeat merged cell values across the range\n"
+        "      --skip-hidden-rows   Omit hidden rows\n"
+        "      --skip-hidden-columns Omit hidden columns\n"
+        "      --compress gzip|zstd Compress output files and stdout; output names\n"
+        "                           get a .gz or .zst suffix\n"
+        "      --compress-level N   Codec level (default: gzip 6, zstd 3)\n"
+        "      --compress-threads N Threads compressing each output (default 1,\n"
+        "                           0 = all cores)\n"
+        "\n"
+        "Execution:\n"
+        "  -j, --jobs N             Files converted concurrently (default: all cores)\n"
+        "  -m, --memory-budget SIZE Estimated memory shared by running conversions,\n"
+        "                           e.g. 512M or 4G (default: unlimited)\n"
+        "      --memory-limit SIZE  Fail any conversion whose tracked memory would\n"
+        "                           exceed SIZE (default: unlimited)\n"
+        "      --sheet-threads N    Threads splitting each sheet's rows (default 1)\n"
+        "      --parser auto|fast|libxml   Worksheet parser backend\n"
+        "      --shared-strings auto|memory|external|lazy   Shared strings mode\n"
+        "      --mmap               Memory-map input workbooks instead of reading them\n"
+        "      --pipelined-inflate  Inflate on a background thread while parsing\n"
+        "      --cache-dir DIR      Reuse CSV of sheets whose parts and options are\n"
+        "                           unchanged since an earlier run\n"
+        "      --cache-limit SIZE   Bytes the cache directory may hold (default 1G)\n"
+        "      --fail-fast          Stop starting new files after the first failure\n"
+        "  -q, --quiet              Only report errors\n"
+        "  -v, --verbose            Report every converted sheet\n"
+        "      --stats              Print per-stage throughput when done\n"
+        "  -h, --help               Show this help\n",
+        PROGRAM);
+}
+
+class UsageError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+struct CliOptions {
+    xlsxcsv::CsvOptions csv;
+    std::optional<std::variant<std::string, int>> sheet;
+    bool allSheets = false;
+    bool hiddenSheets = false;
+    bool recursive = false;
+    std::string output;
+    unsigned jobs = 0;
+    uint64_t memoryBudget = 0; // 0 = unlimited
+    bool failFast = false;
+    bool quiet = false;
+    bool verbose = false;
+    bool stats = false;
+    std::vector<std::string> inputs;
+};
+
+uint64_t parseSize(const std::string& text) {
+    size_t consumed = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(text, &consumed);
+    } catch (const std::exception&) {
+        throw UsageError("invalid size '" + text + "'");
+    }
+    std::string suffix = text.substr(consumed);
+    if (!suffix.empty() && (suffix.back() == 'B' || suffix.back() == 'b')) {
+        suffix.pop_back();
+    }
+    uint64_t scale = 1;
+    if (suffix == "K" || suffix == "k") {
+        scale = 1ULL << 10;
+    } else if (suffix == "M" || suffix == "m") {
+        scale = 1ULL << 20;
+    } else if (suffix == "G" || suffix == "g") {
+        scale = 1ULL << 30;
+    } else if (!suffix.empty()) {
+        throw UsageError("invalid size '" + text + "'");
+    }
+    if (value < 0.0) {
+        throw UsageError("invalid size '" + text + "'");
+    }
+    return static_cast<uint64_t>(value * static_cast<double>(scale));
+}
+
+unsigned parseCount(const std::string& text, const char* flag) {
+    try {
+        size_t consumed = 0;
+        const unsigned long value = std::stoul(text, &consumed);
+        if (consumed == text.size()) {
+            return static_cast<unsigned>(value);
+        }
+    } catch (const std::exception&) {
+    }
+    throw UsageError(std::string("invalid value '") + text + "' for " + flag);
+}
+
+// Comma-separated column letters, ranges and indexes; the converter validates letters
+std::vector<std::variant<std::string, int>> parseColumns(const std::string& text) {
+    std::vector<std::variant<std::string, int>> columns;
+    size_t start = 0;
+    while (start <= text.size()) {
+        const size_t comma = std::min(text.find(',', start), text.size());
+        const std::string item = text.substr(start, comma - start);
+        const bool numeric = !item.empty() &&
+            std::all_of(item.begin(), item.end(), [](unsigned char c) { return std::isdigit(c); });
+        if (item.empty()) {
+            throw UsageError("empty entry in --columns '" + text + "'");
+        }
+        if (numeric) {
+            columns.emplace_back(static_cast<int>(parseCount(item, "--columns")));
+        } else {
+            columns.emplace_back(item);
+        }
+        start = comma + 1;
+    }
+    return columns;
+}
+
+void readInputList(const std::string& listPath, std::vector<std::string>& inputs) {
+    std::ifstream file;
+    std::istream* in = &std::cin;
+    if (listPath != "-") {
+        file.open(listPath);
+        if (!file) {
+            throw UsageError("cannot open input list '" + listPath + "'");
+        }
+        in = &file;
+    }
+    std::string line;
+    while (std::getline(*in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            inputs.push_back(line);
+        }
+    }
+}
+
+CliOptions parseArguments(int argc, char** argv) {
+    CliOptions cli;
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    size_t i = 0;
+    std::optional<std::string> attached; // From --name=value or -j8
+    auto value = [&](const std::string& flag) -> std::string {
+        if (attached) {
+            return *std::exchange(attached, std::nullopt);
+        }
+        if (i + 1 >= args.size()) {
+            throw UsageError("missing value for " + flag);
+        }
+        return args[++i];
+    };
+
+    bool endOfOptions = false;
+    for (; i < args.size(); ++i) {
+        std::string arg = args[i];
+        attached.reset();
+        if (!endOfOptions && arg.rfind("--", 0) == 0 && arg.find('=') != std::string::npos) {
+            attached = arg.substr(arg.find('=') + 1);
+            arg.resize(arg.find('='));
+        } else if (!endOfOptions && arg.size() > 2 && arg.rfind("-j", 0) == 0) {
+            attached = arg.substr(2);
+            arg = "-j";
+        }
+        if (endOfOptions || arg.empty() || arg[0] != '-' || arg == "-") {
+            cli.inputs.push_back(arg);
+        } else if (arg == "--") {
+            endOfOptions = true;
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(stdout);
+            std::exit(0);
+        } else if (arg == "-s" || arg == "--sheet") {
+            const std::string sheet = value(arg);
+            const bool numeric = !sheet.empty() &&
+                std::all_of(sheet.begin(), sheet.end(), [](unsigned char c) { return std::isdigit(c); });
+            if (numeric) {
+                cli.sheet = static_cast<int>(parseCount(sheet, "--sheet"));
+            } else {
+                cli.sheet = sheet;
+            }
+        } else if (arg == "-a" || arg == "--all-sheets") {
+            cli.allSheets = true;
+        } else if (arg == "--hidden-sheets") {
+            cli.hiddenSheets = true;
+        } else if (arg == "-r" || arg == "--recursive") {
+            cli.recursive = true;
+        } else if (arg == "--files-from") {
+            readInputList(value(arg), cli.inputs);
+        } else if (arg == "--skip-rows") {
+            cli.csv.rowOffset = parseCount(value(arg), "--skip-rows");
+        } else if (arg == "--max-rows") {
+            cli.csv.rowLimit = parseCount(value(arg), "--max-rows");
+        } else if (arg == "--columns") {
+            cli.csv.columns = parseColumns(value(arg));
+        } else if (arg == "-o" || arg == "--output") {
+            cli.output = value(arg);
+        } else if (arg == "-d" || arg == "--delimiter") {
+            const std::string delimiter = value(arg);
+            if (delimiter == "tab" || delimiter == "\\t") {
+                cli.csv.delimiter = '\t';
+            } else if (delimiter.size() == 1) {
+                cli.csv.delimiter = delimiter[0];
+            } else {
+                throw UsageError("delimiter must be a single character");
+            }
+        } else if (arg == "--crlf") {
+            cli.csv.newline = xlsxcsv::CsvOptions::Newline::CRLF;
+        } else if (arg == "--bom") {
+            cli.csv.includeBom = true;
+        } else if (arg == "--shortest-numbers") {
+            cli.csv.numberFormat = xlsxcsv::CsvOptions::NumberFormat::SHORTEST;
+        } else if (arg == "--merged-propagate") {
+            cli.csv.mergedHandling = xlsxcsv::CsvOptions::MergedHandling::PROPAGATE;
+        } else if (arg == "--skip-hidden-rows") {
+            cli.csv.includeHiddenRows = false;
+        } else if (arg == "--skip-hidden-columns") {
+            cli.csv.includeHiddenColumns = false;
+        } else if (arg == "--compress") {
+            const std::string codec = value(arg);
+            if (codec == "gzip") {
+                cli.csv.outputCompression = xlsxcsv::CsvOptions::OutputCompression::GZIP;
+            } else if (codec == "zstd") {
+                cli.csv.outputCompression = xlsxcsv::CsvOptions::OutputCompression::ZSTD;
+                if (!xlsxcsv::CompressedOutputSink::supports(cli.csv.outputCompression)) {
+                    throw UsageError("this build has no zstd support");
+                }
+            } else {
+                throw UsageError("unknown compression '" + codec + "'");
+            }
+        } else if (arg == "--compress-level") {
+            cli.csv.compressionLevel = static_cast<int>(parseCount(value(arg), "--compress-level"));
+        } else if (arg == "--compress-threads") {
+            cli.csv.compressionThreads = parseCount(value(arg), "--compress-threads");
+        } else if (arg == "-j" || arg == "--jobs") {
+            cli.jobs = parseCount(value(arg), "--jobs");
+        } else if (arg == "-m" || arg == "--memory-budget") {
+            cli.memoryBudget = parseSize(value(arg));
+        } else if (arg == "--memory-limit") {
+            cli.csv.memoryLimit = parseSize(value(arg));
+        } else if (arg == "--sheet-threads") {
+            cli.csv.sheetParseThreads = parseCount(value(arg), "--sheet-threads");
+        } else if (arg == "--mmap") {
+            cli.csv.memoryMap = true;
+        } else if (arg == "--pipelined-inflate") {
+            cli.csv.pipelinedInflate = true;
+        } else if (arg == "--cache-dir") {
+            cli.csv.resultCacheDir = value(arg);
+        } else if (arg == "--cache-limit") {
+            cli.csv.resultCacheLimit = parseSize(value(arg));
+        } else if (arg == "--parser") {
+            const std::string backend = value(arg);
+            if (backend == "auto") {
+                cli.csv.parserBackend = xlsxcsv::CsvOptions::ParserBackend::AUTO;
+            } else if (backend == "fast") {
+                cli.csv.parserBackend = xlsxcsv::CsvOptions::ParserBackend::FAST;
+            } else if (backend == "libxml") {
+                cli.csv.parserBackend = xlsxcsv::CsvOptions::ParserBackend::LIBXML;
+            } else {
+                throw UsageError("unknown parser '" + backend + "'");
+            }
+        } else if (arg == "--shared-strings") {
+            const std::string mode = value(arg);
+            using Mode = xlsxcsv::CsvOptions::SharedStringsMode;
+            if (mode == "auto") {
+                cli.csv.sharedStringsMode = Mode::AUTO;
+            } else if (mode == "memory") {
+                cli.csv.sharedStringsMode = Mode::IN_MEMORY;
+            } else if (mode == "external") {
+                cli.csv.sharedStringsMode = Mode::EXTERNAL;
+            } else if (mode == "lazy") {
+                cli.csv.sharedStringsMode = Mode::LAZY;
+            } else {
+                throw UsageError("unknown shared strings mode '" + mode + "'");
+            }
+        } else if (arg == "--fail-fast") {
+            cli.failFast = true;
+        } else if (arg == "-q" || arg == "--quiet") {
+            cli.quiet = true;
+        } else if (arg == "-v" || arg == "--verbose") {
+            cli.verbose = true;
+        } else if (arg == "--stats") {
+            cli.stats = true;
+            cli.csv.trackMemory = true;
+        } else {
+            throw UsageError("unknown option '" + arg + "'");
+        }
+        if (attached) {
+            throw UsageError("option '" + arg + "' takes no value");
+        }
+    }
+
+    if (cli.inputs.empty()) {
+        throw UsageError("no input files");
+    }
+    if (cli.allSheets && cli.sheet) {
+        throw UsageError("--sheet and --all-sheets are mutually exclusive");
+    }
+    if (cli.jobs == 0) {
+        cli.jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return cli;
+}
+
+// ---------------------------------------------------------------------------
+// Input discovery
+// ---------------------------------------------------------------------------
+
+struct InputFile {
+    fs::path path;
+    fs::path relative; // Output location relative to the output directory
+};
+
+bool hasWildcard(const std::string& text) {
+    return text.find_first_of("*?[") != std::string::npos;
+}
+
+// Shell-style match of a single path component: *, ? and [...] classes
+bool wildcardMatch(const char* pattern, const char* name) {
+    while (*pattern) {
+        if (*pattern == '*') {
+            while (*pattern == '*') {
+                ++pattern;
+            }
+            if (!*pattern) {
+                return true;
+            }
+            for (const char* rest = name; *rest; ++rest) {
+                if (wildcardMatch(pattern, rest)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        if (!*name) {
+            return false;
+        }
+        if (*pattern == '?') {
+            ++pattern;
+            ++name;
+            continue;
+        }
+        if (*pattern == '[') {
+            const char* close = std::strchr(pattern + 1, ']');
+            if (close) {
+                const bool negate = pattern[1] == '!' || pattern[1] == '^';
+                bool matched = false;
+                for (const char* c = pattern + (negate ? 2 : 1); c < close; ++c) {
+                    if (c + 2 < close && c[1] == '-') {
+                        matched = matched || (*name >= c[0] && *name <= c[2]);
+                        c += 2;
+                    } else {
+                        matched = matched || *name == *c;
+                    }
+                }
+                if (matched == negate) {
+                    return false;
+                }
+                pattern = close + 1;
+                ++name;
+                continue;
+            }
+        }
+        if (*pattern != *name) {
+            return false;
+        }
+        ++pattern;
+        ++name;
+    }
+    return !*name;
+}
+
+bool isWorkbookName(const fs::path& path) {
+    const std::string name = path.filename().string();
+    if (name.rfind("~$", 0) == 0) {
+        return false; // Office lock file
+    }
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".xlsx" || extension == ".xlsm";
+}
+
+void collectDirectory(const fs::path& root, bool recursive, std::vector<InputFile>& files) {
+    std::vector<InputFile> found;
+    auto visit = [&](const fs::directory_entry& entry) {
+        if (entry.is_regular_file() && isWorkbookName(entry.path())) {
+            found.push_back({entry.path(), entry.path().lexically_relative(root)});
+        }
+    };
+    if (recursive) {
+        for (const auto& entry : fs::recursive_directory_iterator(root)) {
+            visit(entry);
+        }
+    } else {
+        for (const auto& entry : fs::directory_iterator(root)) {
+            visit(entry);
+        }
+    }
+    std::sort(found.begin(), found.end(),
+              [](const InputFile& a, const InputFile& b) { return a.path < b.path; });
+    files.insert(files.end(), found.begin(), found.end());
+}
+
+void collectGlob(const std::string& pattern, std::vector<InputFile>& files) {
+    const fs::path patternPath(pattern);
+    const fs::path parent = patternPath.parent_path();
+    if (hasWildcard(parent.string())) {
+        throw UsageError("wildcards are only supported in the file name: '" + pattern + "'");
+    }
+    const std::string namePattern = patternPath.filename().string();
+    const fs::path directory = parent.empty() ? fs::path(".") : parent;
+
+    std::vector<InputFile> found;
+    std::error_code error;
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        const std::string name = it->path().filename().string();
+        if (it->is_regular_file() && wildcardMatch(namePattern.c_str(), name.c_str())) {
+            found.push_back({parent.empty() ? fs::path(name) : it->path(), fs::path(name)});
+        }
+    }
+    if (found.empty()) {
+        throw UsageError("no files match '" + pattern + "'");
+    }
+    std::sort(found.begin(), found.end(),
+              [](const InputFile& a, const InputFile& b) { return a.path < b.path; });
+    files.insert(files.end(), found.begin(), found.end());
+}
+
+std::vector<InputFile> discoverInputs(const CliOptions& cli) {
+    std::vector<InputFile> files;
+    for (const auto& input : cli.inputs) {
+        std::error_code error;
+        if (fs::is_directory(input, error)) {
+            collectDirectory(input, cli.recursive, files);
+        } else if (!fs::exists(input, error) && hasWildcard(input)) {
+            collectGlob(input, files);
+        } else {
+            files.push_back({fs::path(input), fs::path(input).filename()});
+        }
+    }
+    return files;
+}
+
+// ---------------------------------------------------------------------------
+// Output planning
+// ---------------------------------------------------------------------------
+
+enum class OutputMode { BESIDE_INPUT, DIRECTORY, SINGLE_FILE, STDOUT };
+
+// Suffix after ".csv" for the chosen --compress codec
+std::string compressionSuffix(const CliOptions& cli) {
+    switch (cli.csv.outputCompression) {
+        case xlsxcsv::CsvOptions::OutputCompression::GZIP:
+            return ".gz";
+        case xlsxcsv::CsvOptions::OutputCompression::ZSTD:
+            return ".zst";
+        default:
+            return "";
+    }
+}
+
+OutputMode resolveOutputMode(const CliOptions& cli, size_t fileCount) {
+    if (cli.output.empty()) {
+        return OutputMode::BESIDE_INPUT;
+    }
+    if (cli.output == "-") {
+        return OutputMode::STDOUT;
+    }
+    std::error_code error;
+    const fs::path output(cli.output);
+    const std::string suffix = compressionSuffix(cli);
+    const bool compressedCsv = !suffix.empty() && output.extension() == suffix && output.stem().extension() == ".csv";
+    const bool looksLikeFile = (output.extension() == ".csv" || compressedCsv) && !fs::is_directory(output, error);
+    if (looksLikeFile) {
+        if (fileCount != 1 || cli.allSheets) {
+            throw UsageError("-o names a single .csv file but several outputs would be written");
+        }
+        return OutputMode::SINGLE_FILE;
+    }
+    return OutputMode::DIRECTORY;
+}
+
+std::string sanitizeSheetName(const std::string& name) {
+    std::string result;
+    result.reserve(name.size());
+    for (unsigned char c : name) {
+        const bool safe = std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == ' ' || c >= 0x80;
+        result.push_back(safe ? static_cast<char>(c) : '_');
+    }
+    return result.empty() ? std::string("sheet") : result;
+}
+
+fs::path outputPathFor(const CliOptions& cli, OutputMode mode, const InputFile& input,
+                       const std::string* sheetName) {
+    if (mode == OutputMode::SINGLE_FILE) {
+        return fs::path(cli.output);
+    }
+    fs::path base = mode == OutputMode::DIRECTORY ? fs::path(cli.output) / input.relative : input.path;
+    std::string stem = base.stem().string();
+    if (sheetName) {
+        stem += "." + sanitizeSheetName(*sheetName);
+    }
+    return base.replace_filename(stem + ".csv" + compressionSuffix(cli));
+}
+
+// ---------------------------------------------------------------------------
+// Conversion
+// ---------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct StageTotals {
+    double inspectSeconds = 0.0; // Central directory and sheet list
+    double convertSeconds = 0.0; // Inflate, parse and encode (excluding writes)
+    double writeSeconds = 0.0;   // Time spent inside output writes
+    // Breakdown of convert from the library's ConversionStats
+    double openSeconds = 0.0;          // ZIP directory and workbook
+    double stylesSeconds = 0.0;
+    double sharedStringsSeconds = 0.0;
+    double parseSeconds = 0.0;         // Worksheet inflate, parse and encode
+    uint64_t sharedStringsXmlBytes = 0;
+    uint64_t worksheetXmlBytes = 0;
+    uint64_t inputBytes = 0;
+    uint64_t outputBytes = 0;
+    uint64_t compressedBytes = 0;      // Bytes written with --compress
+    uint64_t lines = 0;
+    size_t files = 0;
+    size_t sheets = 0;
+    size_t cachedSheets = 0;
+    size_t failures = 0;
+    uint64_t peakConversionBytes = 0;  // Largest tracked peak of one conversion
+
+    void add(const StageTotals& other) {
+        inspectSeconds += other.inspectSeconds;
+        convertSeconds += other.convertSeconds;
+        writeSeconds += other.writeSeconds;
+        openSeconds += other.openSeconds;
+        stylesSeconds += other.stylesSeconds;
+        sharedStringsSeconds += other.sharedStringsSeconds;
+        parseSeconds += other.parseSeconds;
+        sharedStringsXmlBytes += other.sharedStringsXmlBytes;
+        worksheetXmlBytes += other.worksheetXmlBytes;
+        inputBytes += other.inputBytes;
+        outputBytes += other.outputBytes;
+        compressedBytes += other.compressedBytes;
+        lines += other.lines;
+        files += other.files;
+        sheets += other.sheets;
+        cachedSheets += other.cachedSheets;
+        failures += other.failures;
+        peakConversionBytes = std::max(peakConversionBytes, other.peakConversionBytes);
+    }
+};
+
+// Forwards to the real sink while timing writes and counting output. With
+// --compress it sees the compressed stream, so lines are only counted here
+// for plain CSV.
+class MeteredSink : public xlsxcsv::OutputSink {
+public:
+    explicit MeteredSink(xlsxcsv::OutputSink& target) : m_target(target) {}
+
+    void write(const char* data, size_t size) override {
+        const auto start = Clock::now();
+        m_target.write(data, size);
+        m_seconds += secondsSince(start);
+        m_bytes += size;
+        m_lines += static_cast<uint64_t>(std::count(data, data + size, '\n'));
+    }
+
+    void flush() override {
+        const auto start = Clock::now();
+        m_target.flush();
+        m_seconds += secondsSince(start);
+    }
+
+    double seconds() const { return m_seconds; }
+    uint64_t bytes() const { return m_bytes; }
+    uint64_t lines() const { return m_lines; }
+
+private:
+    xlsxcsv::OutputSink& m_target;
+    double m_seconds = 0.0;
+    uint64_t m_bytes = 0;
+    uint64_t m_lines = 0;
+};
+
+class Reporter {
+public:
+    explicit Reporter(const CliOptions& cli) : m_cli(cli) {}
+
+    void error(const fs::path& input, const std::string& message) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::fprintf(stderr, "%s: %s: %s\n", PROGRAM, input.string().c_str(), message.c_str());
+    }
+
+    void converted(const fs::path& input, const std::string& destination, uint64_t lines, uint64_t bytes) {
+        if (!m_cli.verbose) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::fprintf(stderr, "%s -> %s (%llu lines, %llu bytes)\n",
+                     input.string().c_str(), destination.c_str(),
+                     static_cast<unsigned long long>(lines),
+                     static_cast<unsigned long long>(bytes));
+    }
+
+private:
+    const CliOptions& m_cli;
+    std::mutex m_mutex;
+};
+
+class Converter {
+public:
+    Converter(const CliOptions& cli, OutputMode mode, Reporter& reporter)
+        : m_cli(cli), m_mode(mode), m_reporter(reporter) {}
+
+    // Converts every selected sheet of one workbook; returns false on failure
+    bool convertFile(const InputFile& input, StageTotals& totals, xlsxcsv::OutputSink* stdoutSink) {
+        ++totals.files;
+        std::error_code error;
+        const auto size = fs::file_size(input.path, error);
+        if (!error) {
+            totals.inputBytes += size;
+        }
+
+        try {
+            auto start = Clock::now();
+            std::vector<std::pair<std::variant<std::string, int>, std::optional<std::string>>> sheets;
+            if (m_cli.allSheets) {
+                const auto list = m_cli.hiddenSheets ? xlsxcsv::getSheetList(input.path.string())
+                                                     : xlsxcsv::getVisibleSheets(input.path.string());
+                for (const auto& sheet : list) {
+                    sheets.emplace_back(sheet.name, sheet.name);
+                }
+            } else {
+                sheets.emplace_back(m_cli.sheet.value_or(std::variant<std::string, int>(-1)), std::nullopt);
+            }
+            totals.inspectSeconds += secondsSince(start);
+            if (!stdoutSink) {
+                claimOutputs(input, sheets);
+            }
+
+            for (const auto& [selector, name] : sheets) {
+                convertSheet(input, selector, name ? &*name : nullptr, totals, stdoutSink);
+                ++totals.sheets;
+            }
+            return true;
+        } catch (const std::exception& e) {
+            ++totals.failures;
+            m_reporter.error(input.path, e.what());
+            return false;
+        }
+    }
+
+private:
+    using SheetList = std::vector<std::pair<std::variant<std::string, int>, std::optional<std::string>>>;
+
+    // Reserves every output of a workbook before any is written. Sheet names
+    // only become known once a workbook is opened, so two sheets that
+    // sanitize to the same name, or workbooks whose stem and sheet names
+    // combine to the same file, are caught here rather than overwriting
+    // each other.
+    void claimOutputs(const InputFile& input, const SheetList& sheets) {
+        std::vector<std::string> destinations;
+        for (const auto& [selector, name] : sheets) {
+            destinations.push_back(
+                outputPathFor(m_cli, m_mode, input, name ? &*name : nullptr).lexically_normal().string());
+        }
+        std::lock_guard<std::mutex> lock(m_claimMutex);
+        for (size_t i = 0; i < destinations.size(); ++i) {
+            const bool repeated = std::find(destinations.begin(), destinations.begin() + i, destinations[i]) !=
+                                  destinations.begin() + i;
+            if (repeated || m_claimed.count(destinations[i])) {
+                throw std::runtime_error("output '" + destinations[i] + "' would be written twice" +
+                                         (repeated ? " (sheet names differ only in unsafe characters)" : ""));
+            }
+        }
+        m_claimed.insert(destinations.begin(), destinations.end());
+    }
+
+    // Unique per conversion, so concurrent writers never share a temporary file
+    static fs::path partialPathFor(const fs::path& destination) {
+        static const uint64_t processTag = std::random_device{}();
+        static std::atomic<uint64_t> sequence{0};
+        fs::path partial = destination;
+        partial += ".partial-" + std::to_string(processTag) + "-" + std::to_string(sequence++);
+        return partial;
+    }
+
+    void convertSheet(const InputFile& input, const std::variant<std::string, int>& selector,
+                      const std::string* sheetName, StageTotals& totals, xlsxcsv::OutputSink* stdoutSink) {
+        const auto start = Clock::now();
+        if (stdoutSink) {
+            MeteredSink metered(*stdoutSink);
+            xlsxcsv::ConversionStats stats;
+            xlsxcsv::convertSheet(input.path.string(), selector, metered, m_cli.csv, &stats);
+            metered.flush();
+            record(metered, stats, start, totals);
+            m_reporter.converted(input.path, "<stdout>", lines(metered, stats), metered.bytes());
+            return;
+        }
+
+        // Write under a temporary name so a failed or interrupted conversion
+        // never leaves a truncated CSV that looks complete
+        const fs::path destination = outputPathFor(m_cli, m_mode, input, sheetName);
+        const fs::path partial = partialPathFor(destination);
+        if (destination.has_parent_path()) {
+            fs::create_directories(destination.parent_path());
+        }
+        try {
+            xlsxcsv::FileOutputSink file(partial.string());
+            MeteredSink metered(file);
+            xlsxcsv::ConversionStats stats;
+            xlsxcsv::convertSheet(input.path.string(), selector, metered, m_cli.csv, &stats);
+            const auto closeStart = Clock::now();
+            file.close();
+            const double closeSeconds = secondsSince(closeStart);
+            fs::rename(partial, destination);
+            record(metered, stats, start, totals);
+            totals.writeSeconds += closeSeconds;
+            totals.convertSeconds -= closeSeconds;
+            m_reporter.converted(input.path, destination.string(), lines(metered, stats), metered.bytes());
+        } catch (...) {
+            std::error_code ignored;
+            fs::remove(partial, ignored);
+            throw;
+        }
+    }
+
+    bool compressed() const {
+        return m_cli.csv.outputCompression != xlsxcsv::CsvOptions::OutputCompression::NONE;
+    }
+
+    // Rows stand in for lines when the sink only saw compressed bytes
+    uint64_t lines(const MeteredSink& metered, const xlsxcsv::ConversionStats& stats) const {
+        return compressed() ? stats.rows : metered.lines();
+    }
+
+    void record(const MeteredSink& metered, const xlsxcsv::ConversionStats& stats,
+                Clock::time_point start, StageTotals& totals) const {
+        totals.convertSeconds += secondsSince(start) - metered.seconds();
+        totals.openSeconds += (stats.openMs + stats.workbookMs) / 1000.0;
+        totals.stylesSeconds += stats.stylesMs / 1000.0;
+        totals.sharedStringsSeconds += stats.sharedStringsMs / 1000.0;
+        // Sink writes happen inside the parse stage
+        totals.parseSeconds += std::max(0.0, stats.parseSheetMs / 1000.0 - metered.seconds());
+        totals.sharedStringsXmlBytes += stats.sharedStringsUncompressedBytes;
+        totals.worksheetXmlBytes += stats.worksheetUncompressedBytes;
+        totals.writeSeconds += metered.seconds();
+        totals.outputBytes += compressed() ? stats.outputBytes : metered.bytes();
+        totals.compressedBytes += compressed() ? metered.bytes() : 0;
+        totals.lines += lines(metered, stats);
+        totals.cachedSheets += stats.resultCacheHits;
+        totals.peakConversionBytes = std::max(totals.peakConversionBytes, stats.peakMemoryBytes);
+    }
+
+    const CliOptions& m_cli;
+    OutputMode m_mode;
+    Reporter& m_reporter;
+    std::mutex m_claimMutex;
+    std::set<std::string> m_claimed; // Normalized destinations already handed out
+};
+
+// Rejects inputs that would write the same file before any work starts. With
+// --all-sheets the sheet names are only known once each workbook is opened,
+// so workbooks sharing an output stem are rejected as they would write the
+// same <stem>.<sheet>.csv; Converter::claimOutputs catches the rest.
+void checkOutputCollisions(const CliOptions& cli, OutputMode mode, const std::vector<InputFile>& files) {
+    if (mode == OutputMode::STDOUT || mode == OutputMode::SINGLE_FILE) {
+        return;
+    }
+    std::vector<std::pair<std::string, const InputFile*>> targets;
+    targets.reserve(files.size());
+    for (const auto& file : files) {
+        fs::path target = outputPathFor(cli, mode, file, nullptr);
+        if (cli.allSheets) {
+            // Every sheet output shares the workbook's stem
+            const fs::path stem = mode == OutputMode::DIRECTORY ? fs::path(cli.output) / file.relative : file.path;
+            target = stem.parent_path() / (stem.stem().string() + ".<sheet>.csv" + compressionSuffix(cli));
+        }
+        targets.emplace_back(target.lexically_normal().string(), &file);
+    }
+    std::sort(targets.begin(), targets.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (size_t i = 1; i < targets.size(); ++i) {
+        if (targets[i].first == targets[i - 1].first) {
+            throw UsageError("'" + targets[i - 1].second->path.string() + "' and '" +
+                             targets[i].second->path.string() + "' would both write '" +
+                             targets[i].first + "'");
+        }
+    }
+}
+
+double megabytesPerSecond(uint64_t bytes, double seconds) {
+    return seconds > 0.0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0.0;
+}
+
+void printStats(const StageTotals& totals, double wallSeconds, unsigned jobs,
+                uint64_t budget, uint64_t peakReserved) {
+    const double mb = 1024.0 * 1024.0;
+    std::fprintf(stderr, "turboxl_cli stats\n");
+    std::fprintf(stderr, "  files      %zu (%zu sheets, %zu failed) on %u job(s)\n",
+                 totals.files, totals.sheets, totals.failures, jobs);
+    if (totals.cachedSheets > 0) {
+        std::fprintf(stderr, "  cache      %zu sheet(s) served from --cache-dir\n", totals.cachedSheets);
+    }
+    std::fprintf(stderr, "  input      %.1f MiB xlsx\n", static_cast<double>(totals.inputBytes) / mb);
+    std::fprintf(stderr, "  output     %.1f MiB csv, %llu lines\n",
+                 static_cast<double>(totals.outputBytes) / mb,
+                 static_cast<unsigned long long>(totals.lines));
+    if (totals.compressedBytes > 0) {
+        std::fprintf(stderr, "             %.1f MiB compressed (%.1f%%)\n",
+                     static_cast<double>(totals.compressedBytes) / mb,
+                     totals.outputBytes > 0 ? 100.0 * static_cast<double>(totals.compressedBytes) /
+                                                  static_cast<double>(totals.outputBytes) : 0.0);
+    }
+    const uint64_t writtenBytes = totals.compressedBytes > 0 ? totals.compressedBytes : totals.outputBytes;
+    std::fprintf(stderr, "  stage      thread-seconds  throughput\n");
+    std::fprintf(stderr, "  inspect    %14.3f  %.1f files/s\n", totals.inspectSeconds,
+                 totals.inspectSeconds > 0.0 ? static_cast<double>(totals.files) / totals.inspectSeconds : 0.0);
+    std::fprintf(stderr, "  convert    %14.3f  %.1f MiB/s xlsx in, %.1f MiB/s csv out\n",
+                 totals.convertSeconds,
+                 megabytesPerSecond(totals.inputBytes, totals.convertSeconds),
+                 megabytesPerSecond(totals.outputBytes, totals.convertSeconds));
+    std::fprintf(stderr, "    open     %14.3f\n", totals.openSeconds);
+    std::fprintf(stderr, "    styles   %14.3f\n", totals.stylesSeconds);
+    std::fprintf(stderr, "    strings  %14.3f  %.1f MiB/s xml\n", totals.sharedStringsSeconds,
+                 megabytesPerSecond(totals.sharedStringsXmlBytes, totals.sharedStringsSeconds));
+    std::fprintf(stderr, "    sheet    %14.3f  %.1f MiB/s xml\n", totals.parseSeconds,
+                 megabytesPerSecond(totals.worksheetXmlBytes, totals.parseSeconds));
+    std::fprintf(stderr, "  write      %14.3f  %.1f MiB/s\n", totals.writeSeconds,
+                 megabytesPerSecond(writtenBytes, totals.writeSeconds));
+    std::fprintf(stderr, "  wall       %14.3f  %.1f files/s, %.1f MiB/s csv\n", wallSeconds,
+                 wallSeconds > 0.0 ? static_cast<double>(totals.files) / wallSeconds : 0.0,
+                 megabytesPerSecond(totals.outputBytes, wallSeconds));
+    if (budget > 0) {
+        std::fprintf(stderr, "  memory     peak %.1f MiB of %.1f MiB budget reserved (estimated)\n",
+                     static_cast<double>(peakReserved) / mb, static_cast<double>(budget) / mb);
+    }
+    std::fprintf(stderr, "  memory     peak %.1f MiB tracked in one conversion\n",
+                 static_cast<double>(totals.peakConversionBytes) / mb);
+}
+
+// A selected sheet is sized by that sheet; with --all-sheets they convert
+// one after another, so the largest worksheet bounds the workbook
+uint64_t estimateMemory(const CliOptions& cli, OutputMode mode, const InputFile& file) {
+    if (cli.allSheets) {
+        return xlsxcsv::estimateConversionMemory(file.path.string(), cli.csv);
+    }
+    const xlsxcsv::FileConversionJob job{file.path.string(), cli.sheet.value_or(std::variant<std::string, int>(-1)),
+                                         outputPathFor(cli, mode, file, nullptr).string()};
+    return xlsxcsv::estimateConversionMemory(job, cli.csv);
+}
+
+int run(const CliOptions& cli) {
+    const auto wallStart = Clock::now();
+    const auto files = discoverInputs(cli);
+    const OutputMode mode = resolveOutputMode(cli, files.size());
+    checkOutputCollisions(cli, mode, files);
+
+    if (cli.csv.trackMemory || cli.csv.memoryLimit > 0) {
+        xlsxcsv::installMemoryHooks(); // Before any worker thread uses libxml2
+    }
+
+    Reporter reporter(cli);
+    Converter converter(cli, mode, reporter);
+    StageTotals totals;
+    uint64_t peakReserved = 0;
+
+    // Concatenated stdout output must keep input order, so it runs serially
+    const unsigned jobs = mode == OutputMode::STDOUT
+        ? 1u
+        : static_cast<unsigned>(std::min<size_t>(cli.jobs, std::max<size_t>(files.size(), 1)));
+
+    if (jobs == 1) {
+        std::optional<xlsxcsv::StdioOutputSink> stdoutSink;
+        if (mode == OutputMode::STDOUT) {
+            stdoutSink.emplace(stdout);
+        }
+        for (const auto& file : files) {
+            const bool ok = converter.convertFile(file, totals, stdoutSink ? &*stdoutSink : nullptr);
+            if (!ok && cli.failFast) {
+                break;
+            }
+        }
+    } else {
+        // Whole workbooks are the unit of work, as sheet names and output
+        // claims are only known once one is open; the scheduler admits them
+        // against the budget
+        std::vector<uint64_t> estimates(files.size(), 0);
+        if (cli.memoryBudget > 0) {
+            const auto inspectStart = Clock::now();
+            for (size_t i = 0; i < files.size(); ++i) {
+                estimates[i] = estimateMemory(cli, mode, files[i]);
+            }
+            totals.inspectSeconds += secondsSince(inspectStart);
+        }
+
+        xlsxcsv::ConversionScheduler scheduler(jobs, cli.memoryBudget);
+        std::mutex totalsMutex;
+        scheduler.run(estimates, [&](size_t index, bool skipped) {
+            if (skipped) {
+                return true;
+            }
+            StageTotals local;
+            const bool ok = converter.convertFile(files[index], local, nullptr);
+            std::lock_guard<std::mutex> lock(totalsMutex);
+            totals.add(local);
+            return ok || !cli.failFast;
+        });
+        peakReserved = scheduler.getPeakReservedMemory();
+    }
+
+    const double wallSeconds = secondsSince(wallStart);
+    if (cli.stats) {
+        printStats(totals, wallSeconds, jobs, cli.memoryBudget, peakReserved);
+    } else if (!cli.quiet && files.size() > 1) {
+        std::fprintf(stderr, "%s: converted %zu of %zu files (%zu sheets) in %.2fs\n", PROGRAM,
+                     totals.files - totals.failures, files.size(), totals.sheets, wallSeconds);
+    }
+    return totals.failures == 0 && totals.files == files.size() ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        return run(parseArguments(argc, argv));
+    } catch (const UsageError& e) {
+        std::fprintf(stderr, "%s: %s\n", PROGRAM, e.what());
+        std::fprintf(stderr, "Try '%s --help' for more information.\n", PROGRAM);
+        return 2;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s: %s\n", PROGRAM, e.what());
+        return 1;
+    }
+}
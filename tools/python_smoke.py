@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+"""Exercise the turboxl bindings that release or reacquire the GIL.
+
+Run against an installed wheel (CI runs it as the cibuildwheel test command).
+Builds a small workbook with the standard library, so it needs no fixtures.
+"""
+import os
+import sys
+import tempfile
+import threading
+import zipfile
+
+import turboxl
+
+ROWS = 2000
+
+CONTENT_TYPES = """<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">
+<Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>
+<Default Extension="xml" ContentType="application/xml"/>
+<Override PartName="/xl/workbook.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml"/>
+<Override PartName="/xl/worksheets/sheet1.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml"/>
+<Override PartName="/xl/sharedStrings.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.sharedStrings+xml"/>
+</Types>"""
+
+ROOT_RELS = """<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+<Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument" Target="xl/workbook.xml"/>
+</Relationships>"""
+
+WORKBOOK = """<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<workbook xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" xmlns:r="http://schemas.openxmlformats.org/officeDocument/2006/relationships">
+<sheets><sheet name="Data" sheetId="1" r:id="rId1"/></sheets>
+</workbook>"""
+
+WORKBOOK_RELS = """<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+<Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet" Target="worksheets/sheet1.xml"/>
+<Relationship Id="rId2" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/sharedStrings" Target="sharedStrings.xml"/>
+</Relationships>"""
+
+
+def write_workbook(path):
+    strings = "".join(f"<si><t>name {i}</t></si>" for i in range(ROWS))
+    rows = "".join(
+        f'<row r="{r}"><c r="A{r}"><v>{r}</v></c><c r="B{r}" t="s"><v>{r - 1}</v></c></row>'
+        for r in range(1, ROWS + 1)
+    )
+    with zipfile.ZipFile(path, "w", zipfile.ZIP_DEFLATED) as archive:
+        archive.writestr("[Content_Types].xml", CONTENT_TYPES)
+        archive.writestr("_rels/.rels", ROOT_RELS)
+        archive.writestr("xl/workbook.xml", WORKBOOK)
+        archive.writestr("xl/_rels/workbook.xml.rels", WORKBOOK_RELS)
+        archive.writestr(
+            "xl/sharedStrings.xml",
+            '<?xml version="1.0" encoding="UTF-8" standalone="yes"?>'
+            '<sst xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" '
+            f'count="{ROWS}" uniqueCount="{ROWS}">{strings}</sst>',
+        )
+        archive.writestr(
+            "xl/worksheets/sheet1.xml",
+            '<?xml version="1.0" encoding="UTF-8" standalone="yes"?>'
+            '<worksheet xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main">'
+            f"<sheetData>{rows}</sheetData></worksheet>",
+        )
+
+
+def check(condition, message):
+    if not condition:
+        raise AssertionError(message)
+
+
+def check_raises(call, message):
+    try:
+        call()
+    except Exception as error:  # noqa: BLE001 - any translated error will do
+        return error
+    raise AssertionError(message)
+
+
+def main():
+    expected = "".join(f"{r},name {r - 1}\n" for r in range(1, ROWS + 1))
+
+    with tempfile.TemporaryDirectory() as tmp:
+        xlsx = os.path.join(tmp, "smoke.xlsx")
+        write_workbook(xlsx)
+        check(turboxl.read_sheet_to_csv(xlsx) == expected, "read_sheet_to_csv")
+
+        # Keyword-only in-memory overload next to the path overload
+        with open(xlsx, "rb") as f:
+            data = f.read()
+        check(turboxl.read_sheet_to_csv(data=data) == expected, "read_sheet_to_csv(data=bytes)")
+        check(turboxl.read_sheet_to_csv(data=memoryview(data), sheet="Data") == expected,
+              "read_sheet_to_csv(data=memoryview)")
+        check_raises(lambda: turboxl.read_sheet_to_csv(data="not a buffer"), "data=str accepted")
+
+        # Chunks come from a background thread; dropping an iterator early
+        # stops it without holding the GIL
+        chunks = [bytes(chunk) for chunk in turboxl.iter_rows(xlsx, batch_size=4096)]
+        check(len(chunks) > 1, "iter_rows returned a single chunk")
+        check(b"".join(chunks).decode() == expected, "iter_rows")
+        for _ in range(8):
+            rows = turboxl.iter_rows(xlsx, batch_size=1024)
+            next(rows)
+            del rows
+        check_raises(lambda: list(turboxl.iter_rows(os.path.join(tmp, "missing.xlsx"))),
+                     "iter_rows on a missing file")
+
+        out = os.path.join(tmp, "out.csv")
+        stats = {}
+        turboxl.convert_to_file(xlsx, 0, out, stats=stats)
+        with open(out, encoding="utf-8", newline="") as f:
+            check(f.read() == expected, "convert_to_file")
+        check(stats["rows"] == ROWS, "convert_to_file stats")
+        stats = {}
+        check_raises(lambda: turboxl.convert_to_file(xlsx, "NoSuchSheet", out, stats=stats),
+                     "convert_to_file with a missing sheet")
+        check("total_ms" in stats, "stats not filled on failure")
+
+        # Document methods release the GIL and may run on several threads
+        document = turboxl.Document(xlsx)
+        results = []
+
+        def convert():
+            results.append(document.read_sheet_to_csv("Data"))
+
+        threads = [threading.Thread(target=convert) for _ in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        check(results == [expected] * 4, "Document from several threads")
+        check([s.name for s in document.get_sheet_list()] == ["Data"], "Document.get_sheet_list")
+        check(turboxl.Document.open_cached(xlsx).read_sheet_to_csv() == expected, "Document.open_cached")
+
+        # on_result runs on pool threads, which take the GIL for each call;
+        # an exception it raises comes back out of convert_files
+        jobs = [xlsx] * 6 + [turboxl.FileConversionJob(xlsx, "Data", os.path.join(tmp, "job.csv"))]
+        scheduler = turboxl.ConversionScheduler(threads=3, memory_budget=64 << 20)
+        seen = []
+        turboxl.convert_files(jobs, on_result=lambda r: seen.append((r.index, r.ok, r.csv)),
+                              scheduler=scheduler)
+        check(sorted(index for index, _, _ in seen) == list(range(len(jobs))), "on_result indices")
+        check(all(ok for _, ok, _ in seen), "convert_files failures")
+        check(all(csv == expected for index, _, csv in seen if index < 6), "convert_files csv")
+        check(scheduler.reserved_memory == 0, "budget still reserved")
+
+        def fail(result):
+            raise KeyError("consumer failed")
+
+        error = check_raises(lambda: turboxl.convert_files(jobs, on_result=fail, scheduler=scheduler),
+                             "on_result exception swallowed")
+        check(isinstance(error, KeyError), f"on_result raised {error!r}")
+        check(len(turboxl.convert_files(jobs, scheduler=scheduler)) == len(jobs), "scheduler after a failure")
+
+    print("turboxl python smoke test passed")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())